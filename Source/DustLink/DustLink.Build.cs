@@ -21,7 +21,11 @@ public class DustLink : ModuleRules
 		
 		PublicDependencyModuleNames.AddRange(new string[]
 			{
+				"Analytics",
 				"Core",
+				"Engine",
+				"HTTPServer",
+				"NetCore",
 				"OnlineSubsystem",
 				"OnlineSubsystemSteam",
 				"UMG",
@@ -33,9 +37,14 @@ public class DustLink : ModuleRules
 		PrivateDependencyModuleNames.AddRange(new string[]
 			{
 				"CoreUObject",
-				"Engine",
+				"HTTP",
+				"Icmp",
+				"Json",
+				"Projects",
+				"RenderCore",
 				"Slate",
-				"SlateCore"
+				"SlateCore",
+				"Sockets"
 			}
 		);
 	}
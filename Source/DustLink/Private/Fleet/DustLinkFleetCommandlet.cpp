@@ -0,0 +1,193 @@
+// Copyright Dustbyte Software. All Rights Reserved.
+
+#include "DustLink/Public/Fleet/DustLinkFleetCommandlet.h"
+
+#include "HttpManager.h"
+#include "HttpModule.h"
+#include "HttpPath.h"
+#include "HttpServerModule.h"
+#include "HttpServerRequest.h"
+#include "HttpServerResponse.h"
+#include "IHttpRouter.h"
+#include "Containers/Ticker.h"
+#include "DustLink/Public/Fleet/DustLinkServerAllocator.h"
+#include "DustLink/Public/Fleet/DustLinkServerPool.h"
+
+
+UDustLinkFleetCommandlet::UDustLinkFleetCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+/**
+ * @brief Runs the fleet agent until the process is asked to exit.
+ *
+ * @param Params The command line of the commandlet.
+ * @return The exit code of the process.
+ */
+int32 UDustLinkFleetCommandlet::Main(const FString& Params)
+{
+	FDustLinkServerPoolSettings Settings;
+	FParse::Value(*Params, TEXT("ServerMap="), Settings.ServerMap);
+	FParse::Value(*Params, TEXT("ServerArgs="), Settings.ExtraArgs);
+	FParse::Value(*Params, TEXT("Region="), Settings.Region);
+	FParse::Value(*Params, TEXT("WarmServers="), Settings.WarmServers);
+	FParse::Value(*Params, TEXT("MaxServers="), Settings.MaxServers);
+	FParse::Value(*Params, TEXT("BaseGamePort="), Settings.BaseGamePort);
+	FParse::Value(*Params, TEXT("BaseControlPort="), Settings.BaseControlPort);
+
+	FDustLinkAllocatorSettings AllocatorSettings;
+	FParse::Value(*Params, TEXT("QueueTimeout="), AllocatorSettings.QueueTimeout);
+
+	uint32 AgentPort = 8600;
+	FParse::Value(*Params, TEXT("AgentPort="), AgentPort);
+
+	int32 BenchmarkAllocations = 0;
+	FParse::Value(*Params, TEXT("Benchmark="), BenchmarkAllocations);
+
+	int32 BenchmarkConcurrency = 1;
+	FParse::Value(*Params, TEXT("Concurrency="), BenchmarkConcurrency);
+
+	const TSharedRef<FDustLinkServerPool> Pool = MakeShared<FDustLinkServerPool>();
+	Pool->Start(Settings);
+
+	const TSharedRef<FDustLinkServerAllocator> Allocator = MakeShared<FDustLinkServerAllocator>(AllocatorSettings);
+	Allocator->AddPool(Pool);
+
+	const TSharedPtr<IHttpRouter> Router = FHttpServerModule::Get().GetHttpRouter(AgentPort);
+
+	if (!Router.IsValid())
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s: Failed to bind agent port %u."), *GetClass()->GetName(), AgentPort);
+		return 1;
+	}
+
+	const FHttpRouteHandle AllocateRoute = Router->BindRoute(FHttpPath(TEXT("/allocate")), EHttpServerRequestVerbs::VERB_POST, FHttpRequestHandler::CreateLambda(
+		[Allocator](const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+	{
+		FUTF8ToTCHAR Body(reinterpret_cast<const ANSICHAR*>(Request.Body.GetData()), Request.Body.Num());
+		FDustLinkMatchConfig Config;
+
+		if (!FDustLinkMatchConfig::FromJson(FString(Body.Length(), Body.Get()), Config))
+		{
+			TUniquePtr<FHttpServerResponse> Response = FHttpServerResponse::Create(TEXT("Invalid match config"), TEXT("text/plain"));
+			Response->Code = EHttpServerResponseCodes::BadRequest;
+			OnComplete(MoveTemp(Response));
+			return true;
+		}
+
+		// The response is held until the match is placed, so every player of the match gets its connect info at once
+		Allocator->Allocate(Config, FDustLinkOnAllocationComplete::CreateLambda([OnComplete](const FDustLinkAllocation& Allocation)
+		{
+			TUniquePtr<FHttpServerResponse> Response = FHttpServerResponse::Create(Allocation.ToJson(), TEXT("application/json"));
+			Response->Code = Allocation.bWasSuccessful ? EHttpServerResponseCodes::Ok : EHttpServerResponseCodes::ServiceUnavail;
+			OnComplete(MoveTemp(Response));
+		}));
+
+		return true;
+	}));
+
+	const FHttpRouteHandle ReleaseRoute = Router->BindRoute(FHttpPath(TEXT("/release")), EHttpServerRequestVerbs::VERB_POST, FHttpRequestHandler::CreateLambda(
+		[Allocator](const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+	{
+		const FString* Region = Request.QueryParams.Find(TEXT("Region"));
+		const FString* ServerSlot = Request.QueryParams.Find(TEXT("ServerSlot"));
+
+		const bool bIsReleased = Region && ServerSlot && Allocator->Release(*Region, FCString::Atoi(**ServerSlot));
+
+		TUniquePtr<FHttpServerResponse> Response = FHttpServerResponse::Create(bIsReleased ? TEXT("Released") : TEXT("Server is not allocated"), TEXT("text/plain"));
+		Response->Code = bIsReleased ? EHttpServerResponseCodes::Ok : EHttpServerResponseCodes::BadRequest;
+		OnComplete(MoveTemp(Response));
+		return true;
+	}));
+
+	const FHttpRouteHandle PoolRoute = Router->BindRoute(FHttpPath(TEXT("/pool")), EHttpServerRequestVerbs::VERB_GET, FHttpRequestHandler::CreateLambda(
+		[Pool, Allocator](const FHttpServerRequest&, const FHttpResultCallback& OnComplete)
+	{
+		const FString Status = FString::Printf(TEXT("{\"Booting\":%d,\"Idle\":%d,\"Allocating\":%d,\"Allocated\":%d,\"Queued\":%d}"),
+			Pool->GetNumServers(EDustLinkPooledServerState::Booting), Pool->GetNumServers(EDustLinkPooledServerState::Idle),
+			Pool->GetNumServers(EDustLinkPooledServerState::Allocating), Pool->GetNumServers(EDustLinkPooledServerState::Allocated),
+			Allocator->GetQueueDepth());
+
+		OnComplete(FHttpServerResponse::Create(Status, TEXT("application/json")));
+		return true;
+	}));
+
+	FHttpServerModule::Get().StartAllListeners();
+
+	UE_LOG(LogTemp, Log, TEXT("%s: Keeping %d servers warm in region %s, allocating on port %u."), *GetClass()->GetName(), Settings.WarmServers, *Settings.Region, AgentPort);
+
+	// Benchmark state, every finished allocation releases its server and starts the next one
+	int32 NumStarted = 0;
+	int32 NumFinished = 0;
+	double BenchmarkStartTime = 0.0;
+
+	TFunction<void()> StartBenchmarkAllocation;
+	StartBenchmarkAllocation = [&]()
+	{
+		FDustLinkMatchConfig Match;
+		Match.Region = Settings.Region;
+		Match.ExpectedPlayers = { FString::Printf(TEXT("Bench%dA"), NumStarted), FString::Printf(TEXT("Bench%dB"), NumStarted) };
+		++NumStarted;
+
+		Allocator->Allocate(Match, FDustLinkOnAllocationComplete::CreateLambda([&](const FDustLinkAllocation& Allocation)
+		{
+			++NumFinished;
+
+			if (Allocation.bWasSuccessful) Allocator->Release(Allocation.Region, Allocation.ServerSlot);
+
+			if (NumStarted < BenchmarkAllocations) StartBenchmarkAllocation();
+		}));
+	};
+
+	double LastTime = FPlatformTime::Seconds();
+
+	while (!IsEngineExitRequested())
+	{
+		const double Now = FPlatformTime::Seconds();
+		const float DeltaTime = static_cast<float>(Now - LastTime);
+		LastTime = Now;
+
+		FTSTicker::GetCoreTicker().Tick(DeltaTime);
+		FHttpModule::Get().GetHttpManager().Tick(DeltaTime);
+		Pool->Tick(Now);
+		Allocator->Tick(Now);
+
+		if (BenchmarkAllocations > 0)
+		{
+			if (NumStarted == 0 && Pool->GetNumServers(EDustLinkPooledServerState::Idle) >= Settings.WarmServers)
+			{
+				UE_LOG(LogTemp, Log, TEXT("%s: Benchmarking %d allocations, %d at a time."), *GetClass()->GetName(), BenchmarkAllocations, BenchmarkConcurrency);
+
+				Allocator->ResetStats();
+				BenchmarkStartTime = Now;
+
+				for (int32 Index = 0; Index < FMath::Min(BenchmarkConcurrency, BenchmarkAllocations); ++Index) StartBenchmarkAllocation();
+			}
+
+			if (NumFinished >= BenchmarkAllocations)
+			{
+				const double Duration = Now - BenchmarkStartTime;
+
+				UE_LOG(LogTemp, Display, TEXT("%s: %d allocations succeeded, %d failed in %.2fs (%.1f/s). Latency p50 %.1fms, p95 %.1fms, p99 %.1fms, max %.1fms."),
+					*GetClass()->GetName(), Allocator->GetNumSucceeded(), Allocator->GetNumFailed(), Duration, NumFinished / FMath::Max(Duration, UE_SMALL_NUMBER),
+					Allocator->GetLatencyPercentile(50.f) * 1000.0, Allocator->GetLatencyPercentile(95.f) * 1000.0,
+					Allocator->GetLatencyPercentile(99.f) * 1000.0, Allocator->GetLatencyPercentile(100.f) * 1000.0);
+
+				break;
+			}
+		}
+
+		FPlatformProcess::Sleep(0.01f);
+	}
+
+	Router->UnbindRoute(AllocateRoute);
+	Router->UnbindRoute(ReleaseRoute);
+	Router->UnbindRoute(PoolRoute);
+	Pool->Stop();
+
+	return BenchmarkAllocations > 0 && Allocator->GetNumFailed() > 0 ? 1 : 0;
+}
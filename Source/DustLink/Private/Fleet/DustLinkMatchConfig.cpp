@@ -0,0 +1,67 @@
+// Copyright Dustbyte Software. All Rights Reserved.
+
+#include "DustLink/Public/Fleet/DustLinkMatchConfig.h"
+
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+
+/**
+ * @brief Encodes the config as a JSON object.
+ */
+FString FDustLinkMatchConfig::ToJson() const
+{
+	const TSharedRef<FJsonObject> Object = MakeShared<FJsonObject>();
+	Object->SetStringField(TEXT("MatchType"), MatchType);
+	Object->SetNumberField(TEXT("NumPublicConnections"), NumPublicConnections);
+	Object->SetStringField(TEXT("MatchMap"), MatchMap);
+	Object->SetStringField(TEXT("Region"), Region);
+
+	TArray<TSharedPtr<FJsonValue>> Players;
+
+	for (const FString& Player : ExpectedPlayers) Players.Add(MakeShared<FJsonValueString>(Player));
+
+	Object->SetArrayField(TEXT("ExpectedPlayers"), Players);
+
+	const TSharedRef<FJsonObject> Tokens = MakeShared<FJsonObject>();
+
+	for (const TPair<FString, FString>& Token : PlayerTokens) Tokens->SetStringField(Token.Key, Token.Value);
+
+	Object->SetObjectField(TEXT("PlayerTokens"), Tokens);
+
+	FString Json;
+	FJsonSerializer::Serialize(Object, TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Json));
+
+	return Json;
+}
+
+/**
+ * @brief Decodes a config produced by `ToJson`.
+ *
+ * @param Json The JSON object.
+ * @param OutConfig The decoded config.
+ * @return `true` if the JSON is a valid config.
+ */
+bool FDustLinkMatchConfig::FromJson(const FString& Json, FDustLinkMatchConfig& OutConfig)
+{
+	TSharedPtr<FJsonObject> Object;
+
+	if (!FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Json), Object) || !Object.IsValid()) return false;
+
+	OutConfig = FDustLinkMatchConfig();
+
+	if (!Object->TryGetStringField(TEXT("MatchType"), OutConfig.MatchType)) return false;
+
+	Object->TryGetNumberField(TEXT("NumPublicConnections"), OutConfig.NumPublicConnections);
+	Object->TryGetStringField(TEXT("MatchMap"), OutConfig.MatchMap);
+	Object->TryGetStringField(TEXT("Region"), OutConfig.Region);
+	Object->TryGetStringArrayField(TEXT("ExpectedPlayers"), OutConfig.ExpectedPlayers);
+
+	if (const TSharedPtr<FJsonObject>* Tokens = nullptr; Object->TryGetObjectField(TEXT("PlayerTokens"), Tokens))
+	{
+		for (const TPair<FString, TSharedPtr<FJsonValue>>& Token : (*Tokens)->Values) OutConfig.PlayerTokens.Add(Token.Key, Token.Value->AsString());
+	}
+
+	return OutConfig.NumPublicConnections > 0;
+}
@@ -0,0 +1,239 @@
+// Copyright Dustbyte Software. All Rights Reserved.
+
+#include "DustLink/Public/Fleet/DustLinkServerAllocator.h"
+
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonSerializer.h"
+#include "DustLink/Public/Fleet/DustLinkServerPool.h"
+
+
+/**
+ * @brief Encodes the allocation as a JSON object.
+ */
+FString FDustLinkAllocation::ToJson() const
+{
+	const TSharedRef<FJsonObject> Object = MakeShared<FJsonObject>();
+	Object->SetBoolField(TEXT("Success"), bWasSuccessful);
+	Object->SetStringField(TEXT("Region"), Region);
+	Object->SetNumberField(TEXT("ServerSlot"), ServerSlot);
+	Object->SetStringField(TEXT("ConnectInfo"), ConnectInfo);
+	Object->SetNumberField(TEXT("LatencyMs"), Latency * 1000.0);
+
+	const TSharedRef<FJsonObject> Players = MakeShared<FJsonObject>();
+
+	for (const TPair<FString, FString>& Player : PlayerConnectInfo) Players->SetStringField(Player.Key, Player.Value);
+
+	Object->SetObjectField(TEXT("Players"), Players);
+
+	FString Json;
+	FJsonSerializer::Serialize(Object, TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Json));
+
+	return Json;
+}
+
+/**
+ * @brief Constructs the allocator with the given tuning parameters.
+ *
+ * @param InSettings The tuning parameters to use.
+ */
+FDustLinkServerAllocator::FDustLinkServerAllocator(const FDustLinkAllocatorSettings& InSettings):
+	Settings(InSettings)
+{
+}
+
+/**
+ * @brief Registers the pool serving a region.
+ *
+ * @param Pool The pool, its `Region` setting names the region.
+ */
+void FDustLinkServerAllocator::AddPool(const TSharedRef<FDustLinkServerPool>& Pool)
+{
+	Pools.Add(Pool->GetSettings().Region, Pool);
+}
+
+/**
+ * @brief Places a match on an idle server of its region, or of any region if none is named.
+ *
+ * @param Match The match to place.
+ * @param OnComplete Called once the server created the session, or the allocation failed.
+ */
+void FDustLinkServerAllocator::Allocate(const FDustLinkMatchConfig& Match, const FDustLinkOnAllocationComplete& OnComplete)
+{
+	FPendingAllocation Pending { Match, OnComplete, FPlatformTime::Seconds() };
+
+	// Only the player handed a token can claim its slot, a player identifier alone is known to everyone in the match
+	for (const FString& Player : Pending.Match.ExpectedPlayers)
+	{
+		if (!Pending.Match.PlayerTokens.Contains(Player)) Pending.Match.PlayerTokens.Add(Player, FGuid::NewGuid().ToString(EGuidFormats::Digits));
+	}
+
+	if (!Match.Region.IsEmpty() && !Pools.Contains(Match.Region))
+	{
+		FDustLinkAllocation Allocation;
+		Allocation.Region = Match.Region;
+		Finish(Pending, Allocation);
+		return;
+	}
+
+	// Queued matches keep their order, a newer match must not overtake them
+	if (!Queue.IsEmpty() || !TryDispatch(Pending)) Queue.Add(MoveTemp(Pending));
+}
+
+/**
+ * @brief Returns the server of a finished match to its pool.
+ *
+ * @param Region The region reported by the allocation.
+ * @param ServerSlot The slot reported by the allocation.
+ * @return `false` if the server is not allocated.
+ */
+bool FDustLinkServerAllocator::Release(const FString& Region, const int32 ServerSlot)
+{
+	const TSharedRef<FDustLinkServerPool>* Pool = Pools.Find(Region);
+
+	return Pool && (*Pool)->Release(ServerSlot);
+}
+
+/**
+ * @brief Places queued matches on servers that became idle and fails those that waited too long.
+ *
+ * @param Now The current time, in seconds.
+ */
+void FDustLinkServerAllocator::Tick(const double Now)
+{
+	int32 Index = 0;
+
+	while (Index < Queue.Num())
+	{
+		if (TryDispatch(Queue[Index]))
+		{
+			Queue.RemoveAt(Index);
+			continue;
+		}
+
+		if (Now - Queue[Index].RequestTime > Settings.QueueTimeout)
+		{
+			const FPendingAllocation Pending = MoveTemp(Queue[Index]);
+			Queue.RemoveAt(Index);
+
+			FDustLinkAllocation Allocation;
+			Allocation.Region = Pending.Match.Region;
+			Finish(Pending, Allocation);
+			continue;
+		}
+
+		++Index;
+	}
+}
+
+/**
+ * @brief Returns a percentile of recent successful allocation latencies, in seconds.
+ *
+ * @param Percentile The percentile in the range [0, 100].
+ */
+double FDustLinkServerAllocator::GetLatencyPercentile(const float Percentile) const
+{
+	if (Latencies.IsEmpty()) return 0.0;
+
+	TArray<double> Sorted = Latencies;
+	Sorted.Sort();
+
+	const int32 Rank = FMath::Clamp(FMath::CeilToInt(Percentile / 100.f * Sorted.Num()) - 1, 0, Sorted.Num() - 1);
+
+	return Sorted[Rank];
+}
+
+/**
+ * @brief Forgets the recorded counts and latencies.
+ */
+void FDustLinkServerAllocator::ResetStats()
+{
+	Latencies.Reset();
+	NextLatencyIndex = 0;
+	NumSucceeded = 0;
+	NumFailed = 0;
+}
+
+/**
+ * @brief Pushes a match to an idle server of its region.
+ *
+ * @param Pending The match to place.
+ * @return `false` if no idle server is available.
+ */
+bool FDustLinkServerAllocator::TryDispatch(const FPendingAllocation& Pending)
+{
+	TWeakPtr<FDustLinkServerAllocator> WeakThis(AsShared());
+
+	for (const TPair<FString, TSharedRef<FDustLinkServerPool>>& Entry : Pools)
+	{
+		if (!Pending.Match.Region.IsEmpty() && Entry.Key != Pending.Match.Region) continue;
+
+		const FString Region = Entry.Key;
+
+		const bool bIsDispatched = Entry.Value->Allocate(Pending.Match, FDustLinkOnServerAllocated::CreateLambda(
+			[WeakThis, Pending, Region](const int32 ServerSlot, const FString& ConnectInfo, const bool bWasSuccessful)
+		{
+			const TSharedPtr<FDustLinkServerAllocator> This = WeakThis.Pin();
+
+			if (!This.IsValid()) return;
+
+			--This->NumInFlight;
+
+			FDustLinkAllocation Allocation;
+			Allocation.bWasSuccessful = bWasSuccessful;
+			Allocation.Region = Region;
+			Allocation.ServerSlot = ServerSlot;
+			Allocation.ConnectInfo = ConnectInfo;
+
+			if (bWasSuccessful)
+			{
+				for (const FString& Player : Pending.Match.ExpectedPlayers)
+				{
+					Allocation.PlayerConnectInfo.Add(Player, FString::Printf(TEXT("%s?DustLinkPlayer=%s?DustLinkToken=%s"),
+						*ConnectInfo, *Player, *Pending.Match.PlayerTokens.FindRef(Player)));
+				}
+			}
+
+			This->Finish(Pending, Allocation);
+		}));
+
+		if (bIsDispatched)
+		{
+			++NumInFlight;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/**
+ * @brief Reports a finished allocation and records its outcome.
+ *
+ * @param Pending The allocated match.
+ * @param Allocation The result to report.
+ */
+void FDustLinkServerAllocator::Finish(const FPendingAllocation& Pending, FDustLinkAllocation& Allocation)
+{
+	Allocation.Latency = FPlatformTime::Seconds() - Pending.RequestTime;
+
+	if (Allocation.bWasSuccessful)
+	{
+		++NumSucceeded;
+
+		if (Latencies.Num() < Settings.MaxLatencySamples)
+		{
+			Latencies.Add(Allocation.Latency);
+		}
+		else if (!Latencies.IsEmpty())
+		{
+			Latencies[NextLatencyIndex] = Allocation.Latency;
+			NextLatencyIndex = (NextLatencyIndex + 1) % Latencies.Num();
+		}
+	}
+	else
+	{
+		++NumFailed;
+	}
+
+	Pending.OnComplete.ExecuteIfBound(Allocation);
+}
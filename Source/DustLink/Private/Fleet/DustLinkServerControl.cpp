@@ -0,0 +1,176 @@
+// Copyright Dustbyte Software. All Rights Reserved.
+
+#include "DustLink/Public/Fleet/DustLinkServerControl.h"
+
+#include "HttpPath.h"
+#include "HttpServerModule.h"
+#include "HttpServerRequest.h"
+#include "HttpServerResponse.h"
+#include "IHttpRouter.h"
+
+
+FDustLinkServerControl::~FDustLinkServerControl()
+{
+	Stop();
+}
+
+/**
+ * @brief Starts serving the control routes on the given port.
+ *
+ * @param Port The local port to listen on.
+ * @return Returns `true` if the routes were bound successfully.
+ */
+bool FDustLinkServerControl::Start(const uint32 Port)
+{
+	if (IsRunning()) return true;
+
+	Router = FHttpServerModule::Get().GetHttpRouter(Port);
+
+	if (!Router.IsValid())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("FDustLinkServerControl: Failed to bind port %u."), Port);
+		return false;
+	}
+
+	StatusRouteHandle = Router->BindRoute(FHttpPath(TEXT("/status")), EHttpServerRequestVerbs::VERB_GET, FHttpRequestHandler::CreateLambda([this](const FHttpServerRequest&, const FHttpResultCallback& OnComplete)
+	{
+		static const TCHAR* StateNames[] = { TEXT("Idle"), TEXT("Allocating"), TEXT("Allocated"), TEXT("Releasing") };
+
+		OnComplete(FHttpServerResponse::Create(StateNames[static_cast<uint8>(State)], TEXT("text/plain")));
+		return true;
+	}));
+
+	MatchRouteHandle = Router->BindRoute(FHttpPath(TEXT("/match")), EHttpServerRequestVerbs::VERB_POST, FHttpRequestHandler::CreateLambda([this](const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+	{
+		FUTF8ToTCHAR Body(reinterpret_cast<const ANSICHAR*>(Request.Body.GetData()), Request.Body.Num());
+
+		HandleMatchRequest(FString(Body.Length(), Body.Get()), OnComplete);
+		return true;
+	}));
+
+	ReleaseRouteHandle = Router->BindRoute(FHttpPath(TEXT("/release")), EHttpServerRequestVerbs::VERB_POST, FHttpRequestHandler::CreateLambda([this](const FHttpServerRequest&, const FHttpResultCallback& OnComplete)
+	{
+		if (State != EDustLinkServerState::Allocated)
+		{
+			TUniquePtr<FHttpServerResponse> Response = FHttpServerResponse::Create(TEXT("Server is not allocated"), TEXT("text/plain"));
+			Response->Code = EHttpServerResponseCodes::Conflict;
+			OnComplete(MoveTemp(Response));
+			return true;
+		}
+
+		// Answered by CompleteRelease, the owner may finish synchronously when there is nothing to tear down
+		State = EDustLinkServerState::Releasing;
+		PendingReleaseResponse = OnComplete;
+
+		if (OnMatchReleased.IsBound()) OnMatchReleased.Execute();
+		else CompleteRelease();
+
+		return true;
+	}));
+
+	FHttpServerModule::Get().StartAllListeners();
+
+	UE_LOG(LogTemp, Log, TEXT("FDustLinkServerControl: Accepting matches on port %u."), Port);
+	return StatusRouteHandle.IsValid() && MatchRouteHandle.IsValid() && ReleaseRouteHandle.IsValid();
+}
+
+/**
+ * @brief Stops serving the control routes and fails a pending match request.
+ */
+void FDustLinkServerControl::Stop()
+{
+	if (PendingMatchResponse) CompleteMatch(false, FString());
+	if (PendingReleaseResponse) CompleteRelease();
+
+	if (Router.IsValid())
+	{
+		if (StatusRouteHandle.IsValid()) Router->UnbindRoute(StatusRouteHandle);
+		if (MatchRouteHandle.IsValid()) Router->UnbindRoute(MatchRouteHandle);
+		if (ReleaseRouteHandle.IsValid()) Router->UnbindRoute(ReleaseRouteHandle);
+	}
+
+	StatusRouteHandle.Reset();
+	MatchRouteHandle.Reset();
+	ReleaseRouteHandle.Reset();
+	Router.Reset();
+}
+
+/**
+ * @brief Answers the pending match request once the session was created or failed to be created.
+ *
+ * @param bWasSuccessful Whether the session was created.
+ * @param ConnectInfo The address players travel to.
+ */
+void FDustLinkServerControl::CompleteMatch(const bool bWasSuccessful, const FString& ConnectInfo)
+{
+	if (State != EDustLinkServerState::Allocating) return;
+
+	State = bWasSuccessful ? EDustLinkServerState::Allocated : EDustLinkServerState::Idle;
+
+	const FHttpResultCallback OnComplete = MoveTemp(PendingMatchResponse);
+	PendingMatchResponse = nullptr;
+
+	if (!OnComplete) return;
+
+	TUniquePtr<FHttpServerResponse> Response = FHttpServerResponse::Create(bWasSuccessful ? ConnectInfo : TEXT("Session creation failed"), TEXT("text/plain"));
+	Response->Code = bWasSuccessful ? EHttpServerResponseCodes::Ok : EHttpServerResponseCodes::ServerError;
+
+	OnComplete(MoveTemp(Response));
+}
+
+/**
+ * @brief Answers the pending release request once the server is ready for the next match.
+ */
+void FDustLinkServerControl::CompleteRelease()
+{
+	if (State != EDustLinkServerState::Releasing) return;
+
+	State = EDustLinkServerState::Idle;
+
+	const FHttpResultCallback OnComplete = MoveTemp(PendingReleaseResponse);
+	PendingReleaseResponse = nullptr;
+
+	if (OnComplete) OnComplete(FHttpServerResponse::Ok());
+}
+
+/**
+ * @brief Handles a match request.
+ *
+ * @param Body The body of the request.
+ * @param OnComplete Sends the response.
+ */
+void FDustLinkServerControl::HandleMatchRequest(const FString& Body, const FHttpResultCallback& OnComplete)
+{
+	auto Respond = [&OnComplete](const EHttpServerResponseCodes Code, const FString& Text)
+	{
+		TUniquePtr<FHttpServerResponse> Response = FHttpServerResponse::Create(Text, TEXT("text/plain"));
+		Response->Code = Code;
+
+		OnComplete(MoveTemp(Response));
+	};
+
+	if (State != EDustLinkServerState::Idle)
+	{
+		Respond(EHttpServerResponseCodes::Conflict, TEXT("Server is not idle"));
+		return;
+	}
+
+	FDustLinkMatchConfig Config;
+
+	if (!FDustLinkMatchConfig::FromJson(Body, Config))
+	{
+		Respond(EHttpServerResponseCodes::BadRequest, TEXT("Invalid match config"));
+		return;
+	}
+
+	if (!OnMatchConfigReceived.IsBound())
+	{
+		Respond(EHttpServerResponseCodes::ServiceUnavail, TEXT("Server cannot host matches"));
+		return;
+	}
+
+	State = EDustLinkServerState::Allocating;
+	PendingMatchResponse = OnComplete;
+
+	OnMatchConfigReceived.Execute(Config);
+}
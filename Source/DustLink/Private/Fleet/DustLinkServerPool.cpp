@@ -0,0 +1,288 @@
+// Copyright Dustbyte Software. All Rights Reserved.
+
+#include "DustLink/Public/Fleet/DustLinkServerPool.h"
+
+#include "HttpModule.h"
+#include "Interfaces/IHttpRequest.h"
+#include "Interfaces/IHttpResponse.h"
+#include "Misc/Paths.h"
+
+
+FDustLinkServerPool::~FDustLinkServerPool()
+{
+	Stop();
+}
+
+/**
+ * @brief Starts filling the pool.
+ *
+ * @param InSettings The tuning parameters to use.
+ */
+void FDustLinkServerPool::Start(const FDustLinkServerPoolSettings& InSettings)
+{
+	Settings = InSettings;
+	bIsRunning = true;
+}
+
+/**
+ * @brief Terminates every server process owned by the pool.
+ */
+void FDustLinkServerPool::Stop()
+{
+	bIsRunning = false;
+
+	for (FDustLinkPooledServer& Server : Servers)
+	{
+		if (FPlatformProcess::IsProcRunning(Server.Process)) FPlatformProcess::TerminateProc(Server.Process, true);
+
+		FPlatformProcess::CloseProc(Server.Process);
+	}
+
+	Servers.Reset();
+}
+
+/**
+ * @brief Reaps exited servers, probes booting ones and boots replacements.
+ *
+ * @param Now The current time, in seconds.
+ */
+void FDustLinkServerPool::Tick(const double Now)
+{
+	for (int32 Index = Servers.Num() - 1; Index >= 0; --Index)
+	{
+		FDustLinkPooledServer& Server = Servers[Index];
+		const bool bHasBootTimedOut = Server.State == EDustLinkPooledServerState::Booting && Now - Server.StateTime > Settings.BootTimeout;
+		const bool bHasAllocateTimedOut = Server.State == EDustLinkPooledServerState::Allocating && Now - Server.StateTime > Settings.AllocateTimeout;
+		const bool bHasTimedOut = bHasBootTimedOut || bHasAllocateTimedOut;
+
+		if (bHasTimedOut)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("FDustLinkServerPool: Server on port %d did not %s in time."), Server.GamePort, bHasBootTimedOut ? TEXT("boot") : TEXT("host its match"));
+			FPlatformProcess::TerminateProc(Server.Process, true);
+		}
+
+		if (!bHasTimedOut && FPlatformProcess::IsProcRunning(Server.Process)) continue;
+
+		FPlatformProcess::CloseProc(Server.Process);
+		Servers.RemoveAt(Index);
+	}
+
+	if (!bIsRunning) return;
+
+	for (FDustLinkPooledServer& Server : Servers)
+	{
+		if (Server.State == EDustLinkPooledServerState::Booting && !Server.bIsProbing && Now - Server.LastProbeTime >= Settings.ReadyPollInterval)
+		{
+			ProbeServer(Server, Now);
+		}
+	}
+
+	int32 NumWarm = GetNumServers(EDustLinkPooledServerState::Booting) + GetNumServers(EDustLinkPooledServerState::Idle);
+
+	while (NumWarm < Settings.WarmServers && Servers.Num() < Settings.MaxServers && BootServer(Now)) ++NumWarm;
+}
+
+/**
+ * @brief Places a match on an idle server.
+ *
+ * @param Config The match to host.
+ * @param OnComplete Called with the connect info once the server created the session.
+ * @return `false` if no server is idle, `OnComplete` is not called in that case.
+ */
+bool FDustLinkServerPool::Allocate(const FDustLinkMatchConfig& Config, const FDustLinkOnServerAllocated& OnComplete)
+{
+	FDustLinkPooledServer* Server = Servers.FindByPredicate([](const FDustLinkPooledServer& Candidate)
+	{
+		return Candidate.State == EDustLinkPooledServerState::Idle;
+	});
+
+	if (!Server) return false;
+
+	Server->State = EDustLinkPooledServerState::Allocating;
+	Server->StateTime = FPlatformTime::Seconds();
+
+	const TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = FHttpModule::Get().CreateRequest();
+	Request->SetURL(MakeControlUrl(*Server, TEXT("/match")));
+	Request->SetVerb(TEXT("POST"));
+	Request->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
+	Request->SetContentAsString(Config.ToJson());
+	Request->SetTimeout(Settings.AllocateTimeout);
+
+	TWeakPtr<FDustLinkServerPool> WeakThis(AsShared());
+	const int32 Slot = Server->Slot;
+
+	Request->OnProcessRequestComplete().BindLambda([WeakThis, Slot, OnComplete](FHttpRequestPtr, const FHttpResponsePtr Response, const bool bConnectedSuccessfully)
+	{
+		const bool bWasSuccessful = bConnectedSuccessfully && Response.IsValid() && EHttpResponseCodes::IsOk(Response->GetResponseCode());
+		const FString ConnectInfo = bWasSuccessful ? Response->GetContentAsString() : FString();
+
+		if (const TSharedPtr<FDustLinkServerPool> This = WeakThis.Pin())
+		{
+			// The slot may already hold a replacement if the server was reaped after timing out
+			if (FDustLinkPooledServer* AllocatedServer = This->FindServer(Slot); AllocatedServer && AllocatedServer->State == EDustLinkPooledServerState::Allocating)
+			{
+				// A server that refused the match is still warm and goes back to the pool, one that never answered is replaced
+				AllocatedServer->State = bWasSuccessful ? EDustLinkPooledServerState::Allocated : EDustLinkPooledServerState::Idle;
+				AllocatedServer->StateTime = FPlatformTime::Seconds();
+
+				if (!bConnectedSuccessfully || !Response.IsValid())
+				{
+					UE_LOG(LogTemp, Warning, TEXT("FDustLinkServerPool: Server on port %d did not answer its match."), AllocatedServer->GamePort);
+					FPlatformProcess::TerminateProc(AllocatedServer->Process, true);
+				}
+			}
+		}
+
+		OnComplete.ExecuteIfBound(Slot, ConnectInfo, bWasSuccessful && !ConnectInfo.IsEmpty());
+	});
+
+	Request->ProcessRequest();
+	return true;
+}
+
+/**
+ * @brief Ends the match of an allocated server and returns the server to the pool.
+ *
+ * @param ServerSlot The slot reported when the server was allocated.
+ * @return `false` if no allocated server occupies the slot.
+ */
+bool FDustLinkServerPool::Release(const int32 ServerSlot)
+{
+	FDustLinkPooledServer* Server = FindServer(ServerSlot);
+
+	if (!Server || Server->State != EDustLinkPooledServerState::Allocated) return false;
+
+	const TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = FHttpModule::Get().CreateRequest();
+	Request->SetURL(MakeControlUrl(*Server, TEXT("/release")));
+	Request->SetVerb(TEXT("POST"));
+
+	TWeakPtr<FDustLinkServerPool> WeakThis(AsShared());
+
+	Request->OnProcessRequestComplete().BindLambda([WeakThis, ServerSlot](FHttpRequestPtr, const FHttpResponsePtr Response, const bool bConnectedSuccessfully)
+	{
+		const TSharedPtr<FDustLinkServerPool> This = WeakThis.Pin();
+		FDustLinkPooledServer* ReleasedServer = This.IsValid() ? This->FindServer(ServerSlot) : nullptr;
+
+		if (!ReleasedServer || !bConnectedSuccessfully || !Response.IsValid() || !EHttpResponseCodes::IsOk(Response->GetResponseCode())) return;
+
+		ReleasedServer->State = EDustLinkPooledServerState::Idle;
+		ReleasedServer->StateTime = FPlatformTime::Seconds();
+	});
+
+	Request->ProcessRequest();
+	return true;
+}
+
+/**
+ * @brief Returns the number of servers in the given state.
+ *
+ * @param State The state to count.
+ */
+int32 FDustLinkServerPool::GetNumServers(const EDustLinkPooledServerState State) const
+{
+	int32 Count = 0;
+
+	for (const FDustLinkPooledServer& Server : Servers)
+	{
+		if (Server.State == State) ++Count;
+	}
+
+	return Count;
+}
+
+/**
+ * @brief Boots a server process in the lowest free slot.
+ *
+ * @param Now The current time, in seconds.
+ * @return `true` if the process was started.
+ */
+bool FDustLinkServerPool::BootServer(const double Now)
+{
+	int32 Slot = 0;
+
+	while (FindServer(Slot)) ++Slot;
+
+	FDustLinkPooledServer Server;
+	Server.Slot = Slot;
+	Server.GamePort = Settings.BaseGamePort + Slot;
+	Server.ControlPort = Settings.BaseControlPort + Slot;
+	Server.StateTime = Now;
+	Server.LastProbeTime = Now;
+
+	const FString Params = FString::Printf(TEXT("\"%s\" %s -server -nullrhi -unattended -nosound -log -port=%d -DustLinkControlPort=%d %s"),
+		*FPaths::ConvertRelativePathToFull(FPaths::GetProjectFilePath()), *Settings.ServerMap, Server.GamePort, Server.ControlPort, *Settings.ExtraArgs);
+
+	Server.Process = FPlatformProcess::CreateProc(FPlatformProcess::ExecutablePath(), *Params, true, true, true, nullptr, 0, nullptr, nullptr);
+
+	if (!Server.Process.IsValid())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("FDustLinkServerPool: Failed to boot server on port %d."), Server.GamePort);
+		return false;
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("FDustLinkServerPool: Booting server on port %d."), Server.GamePort);
+
+	Servers.Add(MoveTemp(Server));
+	return true;
+}
+
+/**
+ * @brief Asks a booting server whether it is ready to host a match.
+ *
+ * @param Server The server to probe.
+ * @param Now The current time, in seconds.
+ */
+void FDustLinkServerPool::ProbeServer(FDustLinkPooledServer& Server, const double Now)
+{
+	Server.bIsProbing = true;
+	Server.LastProbeTime = Now;
+
+	const TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = FHttpModule::Get().CreateRequest();
+	Request->SetURL(MakeControlUrl(Server, TEXT("/status")));
+	Request->SetVerb(TEXT("GET"));
+	Request->SetTimeout(Settings.ReadyPollInterval * 4.f);
+
+	TWeakPtr<FDustLinkServerPool> WeakThis(AsShared());
+	const int32 Slot = Server.Slot;
+
+	Request->OnProcessRequestComplete().BindLambda([WeakThis, Slot](FHttpRequestPtr, const FHttpResponsePtr Response, const bool bConnectedSuccessfully)
+	{
+		const TSharedPtr<FDustLinkServerPool> This = WeakThis.Pin();
+		FDustLinkPooledServer* ProbedServer = This.IsValid() ? This->FindServer(Slot) : nullptr;
+
+		if (!ProbedServer) return;
+
+		ProbedServer->bIsProbing = false;
+
+		if (!bConnectedSuccessfully || !Response.IsValid() || Response->GetContentAsString() != TEXT("Idle")) return;
+
+		UE_LOG(LogTemp, Log, TEXT("FDustLinkServerPool: Server on port %d is warm after %.1f s."),
+			ProbedServer->GamePort, FPlatformTime::Seconds() - ProbedServer->StateTime);
+
+		ProbedServer->State = EDustLinkPooledServerState::Idle;
+		ProbedServer->StateTime = FPlatformTime::Seconds();
+	});
+
+	Request->ProcessRequest();
+}
+
+/**
+ * @brief Returns the server in a slot, or `nullptr` if the slot is free.
+ *
+ * @param Slot The slot of the server.
+ */
+FDustLinkPooledServer* FDustLinkServerPool::FindServer(const int32 Slot)
+{
+	return Servers.FindByPredicate([Slot](const FDustLinkPooledServer& Server) { return Server.Slot == Slot; });
+}
+
+/**
+ * @brief Builds the URL of a route on a server's control channel.
+ *
+ * @param Server The server to address.
+ * @param Route The route, e.g. "/status".
+ */
+FString FDustLinkServerPool::MakeControlUrl(const FDustLinkPooledServer& Server, const TCHAR* Route)
+{
+	return FString::Printf(TEXT("http://127.0.0.1:%d%s"), Server.ControlPort, Route);
+}
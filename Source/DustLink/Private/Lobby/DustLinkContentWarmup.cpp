@@ -0,0 +1,99 @@
+// Copyright Dustbyte Software. All Rights Reserved.
+
+#include "DustLink/Public/Lobby/DustLinkContentWarmup.h"
+
+#include "ShaderPipelineCache.h"
+#include "Engine/Engine.h"
+#include "Misc/PackageName.h"
+#include "UObject/UObjectGlobals.h"
+#include "DustLink/Public/Online/DustLinkContentManifest.h"
+
+
+FDustLinkContentWarmup::~FDustLinkContentWarmup()
+{
+	RestoreShaderPipelineCache();
+}
+
+/**
+ * @brief Starts warming up for the given map.
+ *
+ * @param MapPath The path to the match level, optionally followed by URL options.
+ */
+void FDustLinkContentWarmup::Begin(const FString& MapPath)
+{
+	FString PackageName;
+	MapPath.Split(TEXT("?"), &PackageName, nullptr);
+
+	if (PackageName.IsEmpty()) PackageName = MapPath;
+
+	if (PackageName == MapPackageName && (LoadedMapPackage.IsValid() || bIsLoading)) return;
+
+	Cancel();
+
+	// Collect while players are idle, before the loaded map adds to the heap
+	if (GEngine) GEngine->ForceGarbageCollection(true);
+
+	if (!IsRunningDedicatedServer())
+	{
+		FShaderPipelineCache::SetBatchMode(FShaderPipelineCache::BatchMode::Fast);
+		FShaderPipelineCache::ResumeBatching();
+		bIsShaderCacheBoosted = true;
+	}
+
+	// Mount chunks the match map lives in before the client travels instead of streaming them after
+	FDustLinkContentManifest::Build(PackageName).RequestContent();
+
+	if (!FPackageName::DoesPackageExist(PackageName))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("FDustLinkContentWarmup: Match map %s not found."), *PackageName);
+		return;
+	}
+
+	MapPackageName = PackageName;
+	bIsLoading = true;
+
+	TWeakPtr<FDustLinkContentWarmup> WeakThis(AsShared());
+	const uint32 LoadGeneration = Generation;
+
+	LoadPackageAsync(PackageName, FLoadPackageAsyncDelegate::CreateLambda(
+		[WeakThis, LoadGeneration](const FName& LoadedPackageName, UPackage* LoadedPackage, EAsyncLoadingResult::Type Result)
+	{
+		const TSharedPtr<FDustLinkContentWarmup> This = WeakThis.Pin();
+
+		if (!This.IsValid() || This->Generation != LoadGeneration) return;
+
+		This->bIsLoading = false;
+
+		if (Result != EAsyncLoadingResult::Succeeded || !LoadedPackage)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("FDustLinkContentWarmup: Failed to preload %s."), *LoadedPackageName.ToString());
+			return;
+		}
+
+		This->LoadedMapPackage.Reset(LoadedPackage);
+	}), 0, PKG_ContainsMap);
+}
+
+/**
+ * @brief Stops warming up and releases the preloaded map, e.g. when the countdown was cancelled.
+ */
+void FDustLinkContentWarmup::Cancel()
+{
+	++Generation;
+	bIsLoading = false;
+	LoadedMapPackage.Reset();
+	MapPackageName.Reset();
+
+	RestoreShaderPipelineCache();
+}
+
+/**
+ * @brief Restores the shader pipeline cache batching mode used outside of warmup.
+ */
+void FDustLinkContentWarmup::RestoreShaderPipelineCache()
+{
+	if (!bIsShaderCacheBoosted) return;
+
+	FShaderPipelineCache::SetBatchMode(FShaderPipelineCache::BatchMode::Background);
+	bIsShaderCacheBoosted = false;
+}
@@ -0,0 +1,215 @@
+// Copyright Dustbyte Software. All Rights Reserved.
+
+#include "DustLink/Public/Lobby/DustLinkLobbyGameMode.h"
+
+#include "OnlineSessionSettings.h"
+#include "OnlineSubsystemUtils.h"
+#include "TimerManager.h"
+#include "GameFramework/PlayerState.h"
+#include "DustLink/Public/Online/DustLinkSubsystem.h"
+#include "DustLink/Public/Lobby/DustLinkLobbyGameState.h"
+#include "DustLink/Public/Lobby/DustLinkLobbyPlayerController.h"
+#include "DustLink/Public/Lobby/DustLinkLobbyRoster.h"
+
+
+/**
+ * @brief Default constructor for the lobby game mode.
+ *
+ * Selects the DustLink lobby game state and player controller and enables seamless travel.
+ */
+ADustLinkLobbyGameMode::ADustLinkLobbyGameMode()
+{
+	GameStateClass = ADustLinkLobbyGameState::StaticClass();
+	PlayerControllerClass = ADustLinkLobbyPlayerController::StaticClass();
+	bUseSeamlessTravel = true;
+}
+
+/**
+ * @brief Sizes the roster from the current session once play begins.
+ */
+void ADustLinkLobbyGameMode::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (ADustLinkLobbyGameState* LobbyGameState = GetGameState<ADustLinkLobbyGameState>()) LobbyGameState->SetMatchMapPath(MatchMapPath);
+
+	ADustLinkLobbyRoster* Roster = GetRoster();
+
+	if (!Roster) return;
+
+	Roster->SetMaxPlayers(GetSessionMaxPlayers());
+	Roster->OnRosterChanged.AddUObject(this, &ThisClass::EvaluateAutoStart);
+
+	EvaluateAutoStart();
+}
+
+/**
+ * @brief Sets the ready flag of a player.
+ *
+ * @param PlayerController The controller of the player.
+ * @param bIsReady Whether the player is ready for the match to start.
+ */
+void ADustLinkLobbyGameMode::SetPlayerReady(const APlayerController* PlayerController, const bool bIsReady)
+{
+	ADustLinkLobbyRoster* Roster = GetRoster();
+
+	if (!Roster || !PlayerController) return;
+
+	Roster->SetPlayerReady(PlayerController->PlayerState, bIsReady);
+}
+
+void ADustLinkLobbyGameMode::PostLogin(APlayerController* NewPlayer)
+{
+	Super::PostLogin(NewPlayer);
+
+	AddPlayerToRoster(NewPlayer);
+}
+
+void ADustLinkLobbyGameMode::Logout(AController* Exiting)
+{
+	if (ADustLinkLobbyRoster* Roster = GetRoster(); Roster && Exiting) Roster->RemovePlayer(Exiting->PlayerState);
+
+	Super::Logout(Exiting);
+}
+
+void ADustLinkLobbyGameMode::HandleSeamlessTravelPlayer(AController*& Controller)
+{
+	Super::HandleSeamlessTravelPlayer(Controller);
+
+	AddPlayerToRoster(Controller);
+}
+
+/**
+ * @brief Returns the lobby roster of the current game state.
+ */
+ADustLinkLobbyRoster* ADustLinkLobbyGameMode::GetRoster() const
+{
+	const ADustLinkLobbyGameState* LobbyGameState = GetGameState<ADustLinkLobbyGameState>();
+
+	return LobbyGameState ? LobbyGameState->GetRoster() : nullptr;
+}
+
+/**
+ * @brief Adds a player to the lobby roster.
+ *
+ * @param Controller The controller of the player.
+ */
+void ADustLinkLobbyGameMode::AddPlayerToRoster(const AController* Controller)
+{
+	ADustLinkLobbyRoster* Roster = GetRoster();
+
+	if (!Roster || !Controller || !Controller->PlayerState) return;
+
+	if (Roster->AddPlayer(Controller->PlayerState) == INDEX_NONE)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("%s: No free lobby slot for %s."), *GetClass()->GetName(), *Controller->PlayerState->GetPlayerName());
+	}
+}
+
+/**
+ * @brief Returns the number of slots of the current session.
+ *
+ * Reads `NumPublicConnections` from the session settings, falling back to `DefaultMaxPlayers`.
+ */
+int32 ADustLinkLobbyGameMode::GetSessionMaxPlayers() const
+{
+	const IOnlineSessionPtr SessionInterface = Online::GetSessionInterface(GetWorld());
+	const FNamedOnlineSession* Session = SessionInterface.IsValid() ? SessionInterface->GetNamedSession(NAME_GameSession) : nullptr;
+
+	return Session ? Session->SessionSettings.NumPublicConnections : DefaultMaxPlayers;
+}
+
+
+/**
+ * @brief Starts or cancels the countdown based on the lobby fill and ready quorum.
+ */
+void ADustLinkLobbyGameMode::EvaluateAutoStart()
+{
+	const ADustLinkLobbyRoster* Roster = GetRoster();
+	ADustLinkLobbyGameState* LobbyGameState = GetGameState<ADustLinkLobbyGameState>();
+
+	if (!Roster || !LobbyGameState || bIsStartingMatch) return;
+
+	const int32 NumPlayers = Roster->GetPlayers().Num();
+	const bool bIsFull = Roster->GetMaxPlayers() > 0 && NumPlayers >= Roster->GetMaxPlayers();
+	const bool bHasQuorum = NumPlayers >= MinPlayersToStart && Roster->GetNumReadyPlayers() >= FMath::CeilToInt(NumPlayers * ReadyQuorum);
+
+	FTimerManager& TimerManager = GetWorldTimerManager();
+
+	if (!bIsFull && !bHasQuorum)
+	{
+		if (TimerManager.IsTimerActive(CountdownTimerHandle))
+		{
+			TimerManager.ClearTimer(CountdownTimerHandle);
+			LobbyGameState->SetCountdown(-1.f);
+		}
+
+		return;
+	}
+
+	const float Duration = bIsFull ? FullLobbyCountdownDuration : ReadyCountdownDuration;
+
+	// Keep a running countdown unless filling the lobby shortens it
+	if (TimerManager.IsTimerActive(CountdownTimerHandle) && TimerManager.GetTimerRemaining(CountdownTimerHandle) <= Duration) return;
+
+	TimerManager.SetTimer(CountdownTimerHandle, this, &ThisClass::OnCountdownComplete, FMath::Max(Duration, UE_KINDA_SMALL_NUMBER), false);
+	LobbyGameState->SetCountdown(Duration);
+}
+
+/**
+ * @brief Timer callback that starts the session once the countdown completed.
+ */
+void ADustLinkLobbyGameMode::OnCountdownComplete()
+{
+	bIsStartingMatch = true;
+
+	const UGameInstance* GameInstance = GetGameInstance();
+	UDustLinkSubsystem* DustLinkSubsystem = GameInstance ? GameInstance->GetSubsystem<UDustLinkSubsystem>() : nullptr;
+	const IOnlineSessionPtr SessionInterface = Online::GetSessionInterface(GetWorld());
+
+	// Without a backend session (e.g. when playing in the editor) there is nothing to start
+	if (!DustLinkSubsystem || !SessionInterface.IsValid() || !SessionInterface->GetNamedSession(NAME_GameSession))
+	{
+		TravelToMatch();
+		return;
+	}
+
+	StartSessionSubscription = DustLinkSubsystem->Subscribe(DustLinkSubsystem->DustLinkOnStartSessionCompleteNative, this, &ThisClass::OnStartSession);
+	DustLinkSubsystem->StartSession();
+}
+
+/**
+ * @brief Callback for handling the completion of starting the session.
+ *
+ * Travels to the match map on success, otherwise re-evaluates the countdown.
+ *
+ * @param bWasSuccessful Indicates whether the session start was successful.
+ */
+void ADustLinkLobbyGameMode::OnStartSession(const bool bWasSuccessful)
+{
+	StartSessionSubscription.Reset();
+
+	if (!bWasSuccessful)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("%s: Failed to start session, match start aborted."), *GetClass()->GetName());
+
+		bIsStartingMatch = false;
+
+		if (ADustLinkLobbyGameState* LobbyGameState = GetGameState<ADustLinkLobbyGameState>()) LobbyGameState->SetCountdown(-1.f);
+
+		EvaluateAutoStart();
+		return;
+	}
+
+	TravelToMatch();
+}
+
+/**
+ * @brief Travels every player to the match map.
+ */
+void ADustLinkLobbyGameMode::TravelToMatch()
+{
+	const ADustLinkLobbyGameState* LobbyGameState = GetGameState<ADustLinkLobbyGameState>();
+
+	if (UWorld* World = GetWorld()) World->ServerTravel(LobbyGameState ? LobbyGameState->GetMatchMapPath() : MatchMapPath);
+}
\ No newline at end of file
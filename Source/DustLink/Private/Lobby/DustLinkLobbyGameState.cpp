@@ -0,0 +1,139 @@
+// Copyright Dustbyte Software. All Rights Reserved.
+
+#include "DustLink/Public/Lobby/DustLinkLobbyGameState.h"
+
+#include "OnlineSessionSettings.h"
+#include "OnlineSubsystemUtils.h"
+#include "Engine/GameInstance.h"
+#include "Net/UnrealNetwork.h"
+#include "DustLink/Public/Lobby/DustLinkLobbyRoster.h"
+#include "DustLink/Public/Online/DustLinkSubsystem.h"
+
+
+/**
+ * @brief Marks the player idle and spawns the lobby roster on the server.
+ */
+void ADustLinkLobbyGameState::PostInitializeComponents()
+{
+	Super::PostInitializeComponents();
+
+	OnCountdownChanged.AddUObject(this, &ThisClass::UpdateContentWarmup);
+
+	// Waiting in the lobby is idle time, garbage is collected on a timer until the match map loads
+	if (const UGameInstance* GameInstance = GetGameInstance())
+	{
+		if (UDustLinkSubsystem* DustLinkSubsystem = GameInstance->GetSubsystem<UDustLinkSubsystem>()) DustLinkSubsystem->SetIdle(true);
+	}
+
+	if (!HasAuthority()) return;
+
+	UWorld* World = GetWorld();
+
+	if (!World)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("%s: Failed to retrieve world context."), *GetClass()->GetName());
+		return;
+	}
+
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.Owner = this;
+	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	Roster = World->SpawnActor<ADustLinkLobbyRoster>(SpawnParameters);
+}
+
+/**
+ * @brief Sets the match map travelled to after the countdown, on the server.
+ *
+ * Clients prefer the `MatchMap` session setting and fall back to this replicated value.
+ *
+ * @param InMatchMapPath The path to the match level.
+ */
+void ADustLinkLobbyGameState::SetMatchMapPath(const FString& InMatchMapPath)
+{
+	if (HasAuthority()) MatchMapPath = InMatchMapPath;
+}
+
+/**
+ * @brief Returns the match map travelled to after the countdown.
+ */
+FString ADustLinkLobbyGameState::GetMatchMapPath() const
+{
+	const IOnlineSessionPtr SessionInterface = Online::GetSessionInterface(GetWorld());
+	const FNamedOnlineSession* Session = SessionInterface.IsValid() ? SessionInterface->GetNamedSession(NAME_GameSession) : nullptr;
+
+	if (FString SessionMatchMap; Session && Session->SessionSettings.Get(FName("MatchMap"), SessionMatchMap) && !SessionMatchMap.IsEmpty())
+	{
+		return SessionMatchMap;
+	}
+
+	return MatchMapPath;
+}
+
+/**
+ * @brief Starts or cancels the lobby countdown on the server.
+ *
+ * @param Duration The countdown length in seconds, or a negative value to cancel it.
+ */
+void ADustLinkLobbyGameState::SetCountdown(const float Duration)
+{
+	if (!HasAuthority()) return;
+
+	CountdownEndTime = Duration >= 0.f ? static_cast<float>(GetServerWorldTimeSeconds()) + Duration : -1.f;
+	OnCountdownChanged.Broadcast(IsCountingDown());
+}
+
+/**
+ * @brief Returns the seconds left until the match starts, synced to server time.
+ *
+ * @return The remaining seconds, or a negative value if no countdown is running.
+ */
+float ADustLinkLobbyGameState::GetCountdownRemaining() const
+{
+	if (!IsCountingDown()) return -1.f;
+
+	return FMath::Max(0.f, CountdownEndTime - static_cast<float>(GetServerWorldTimeSeconds()));
+}
+
+/**
+ * @brief Called on clients when the countdown end time was replicated.
+ */
+void ADustLinkLobbyGameState::OnRep_CountdownEndTime()
+{
+	OnCountdownChanged.Broadcast(IsCountingDown());
+}
+
+/**
+ * @brief Starts warming up for the match when the countdown starts and stops when it is cancelled.
+ *
+ * @param bIsCountingDown Whether a countdown is running.
+ */
+void ADustLinkLobbyGameState::UpdateContentWarmup(const bool bIsCountingDown)
+{
+	const UGameInstance* GameInstance = GetGameInstance();
+	UDustLinkSubsystem* DustLinkSubsystem = GameInstance ? GameInstance->GetSubsystem<UDustLinkSubsystem>() : nullptr;
+
+	if (!DustLinkSubsystem) return;
+
+	if (!bIsCountingDown)
+	{
+		DustLinkSubsystem->CancelContentWarmup();
+		return;
+	}
+
+	const FString MatchMap = GetMatchMapPath();
+
+	if (MatchMap.IsEmpty()) return;
+
+	// The subsystem holds the warmup, the preload must survive this game state being torn down by travel
+	DustLinkSubsystem->BeginContentWarmup(MatchMap);
+}
+
+void ADustLinkLobbyGameState::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME(ADustLinkLobbyGameState, Roster);
+	DOREPLIFETIME(ADustLinkLobbyGameState, CountdownEndTime);
+	DOREPLIFETIME(ADustLinkLobbyGameState, MatchMapPath);
+}
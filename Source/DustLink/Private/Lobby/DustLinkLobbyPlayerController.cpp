@@ -0,0 +1,21 @@
+// Copyright Dustbyte Software. All Rights Reserved.
+
+#include "DustLink/Public/Lobby/DustLinkLobbyPlayerController.h"
+
+#include "DustLink/Public/Lobby/DustLinkLobbyGameMode.h"
+
+
+/**
+ * @brief Asks the server to set the ready flag of this player.
+ *
+ * @param bIsReady Whether the player is ready for the match to start.
+ */
+void ADustLinkLobbyPlayerController::ServerSetReady_Implementation(const bool bIsReady)
+{
+	const UWorld* World = GetWorld();
+
+	if (ADustLinkLobbyGameMode* GameMode = World ? World->GetAuthGameMode<ADustLinkLobbyGameMode>() : nullptr)
+	{
+		GameMode->SetPlayerReady(this, bIsReady);
+	}
+}
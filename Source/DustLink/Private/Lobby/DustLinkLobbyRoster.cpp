@@ -0,0 +1,170 @@
+// Copyright Dustbyte Software. All Rights Reserved.
+
+#include "DustLink/Public/Lobby/DustLinkLobbyRoster.h"
+
+#include "Algo/Count.h"
+#include "GameFramework/PlayerState.h"
+#include "Net/UnrealNetwork.h"
+
+
+/**
+ * @brief Called on clients after the entry was added by replication.
+ */
+void FDustLinkLobbyPlayer::PostReplicatedAdd(const FDustLinkLobbyRosterArray& InArraySerializer)
+{
+	if (InArraySerializer.Owner) InArraySerializer.Owner->OnRosterChanged.Broadcast();
+}
+
+/**
+ * @brief Called on clients after the entry was changed by replication.
+ */
+void FDustLinkLobbyPlayer::PostReplicatedChange(const FDustLinkLobbyRosterArray& InArraySerializer)
+{
+	if (InArraySerializer.Owner) InArraySerializer.Owner->OnRosterChanged.Broadcast();
+}
+
+/**
+ * @brief Called on clients before the entry is removed by replication.
+ */
+void FDustLinkLobbyPlayer::PreReplicatedRemove(const FDustLinkLobbyRosterArray& InArraySerializer)
+{
+	if (InArraySerializer.Owner) InArraySerializer.Owner->OnRosterChanged.Broadcast();
+}
+
+/**
+ * @brief Default constructor for the lobby roster.
+ *
+ * Enables replication to every connection and makes the actor dormant until its first change.
+ */
+ADustLinkLobbyRoster::ADustLinkLobbyRoster()
+{
+	bReplicates = true;
+	bAlwaysRelevant = true;
+	NetDormancy = DORM_DormantAll;
+
+	Roster.Owner = this;
+}
+
+/**
+ * @brief Adds a player to the lowest free slot.
+ *
+ * @param PlayerState The player state of the joining player.
+ * @return The assigned slot, or `INDEX_NONE` if every slot is taken.
+ */
+int32 ADustLinkLobbyRoster::AddPlayer(APlayerState* PlayerState)
+{
+	if (!HasAuthority() || !PlayerState) return INDEX_NONE;
+
+	if (const FDustLinkLobbyPlayer* Existing = FindPlayer(PlayerState)) return Existing->SlotIndex;
+
+	TBitArray<> TakenSlots(false, FMath::Max(MaxPlayers, Roster.Players.Num() + 1));
+
+	for (const FDustLinkLobbyPlayer& Player : Roster.Players)
+	{
+		if (TakenSlots.IsValidIndex(Player.SlotIndex)) TakenSlots[Player.SlotIndex] = true;
+	}
+
+	const int32 SlotIndex = TakenSlots.Find(false);
+
+	if (SlotIndex == INDEX_NONE || (MaxPlayers > 0 && SlotIndex >= MaxPlayers)) return INDEX_NONE;
+
+	FDustLinkLobbyPlayer& Player = Roster.Players.AddDefaulted_GetRef();
+	Player.PlayerState = PlayerState;
+	Player.SlotIndex = SlotIndex;
+
+	Roster.MarkItemDirty(Player);
+	NotifyRosterChanged();
+
+	return SlotIndex;
+}
+
+/**
+ * @brief Removes a player from the roster, freeing the player's slot.
+ *
+ * @param PlayerState The player state of the leaving player.
+ */
+void ADustLinkLobbyRoster::RemovePlayer(const APlayerState* PlayerState)
+{
+	if (!HasAuthority()) return;
+
+	if (Roster.Players.RemoveAll([PlayerState](const FDustLinkLobbyPlayer& Player) { return Player.PlayerState == PlayerState; }) == 0) return;
+
+	Roster.MarkArrayDirty();
+	NotifyRosterChanged();
+}
+
+/**
+ * @brief Sets the ready flag of a player.
+ *
+ * @param PlayerState The player state of the player.
+ * @param bIsReady Whether the player is ready.
+ */
+void ADustLinkLobbyRoster::SetPlayerReady(const APlayerState* PlayerState, const bool bIsReady)
+{
+	if (!HasAuthority()) return;
+
+	FDustLinkLobbyPlayer* Player = Roster.Players.FindByPredicate([PlayerState](const FDustLinkLobbyPlayer& Entry) { return Entry.PlayerState == PlayerState; });
+
+	if (!Player || Player->bIsReady == bIsReady) return;
+
+	Player->bIsReady = bIsReady;
+
+	Roster.MarkItemDirty(*Player);
+	NotifyRosterChanged();
+}
+
+/**
+ * @brief Sets the number of slots in the lobby.
+ *
+ * @param InMaxPlayers The number of slots.
+ */
+void ADustLinkLobbyRoster::SetMaxPlayers(const int32 InMaxPlayers)
+{
+	if (!HasAuthority() || MaxPlayers == InMaxPlayers) return;
+
+	MaxPlayers = InMaxPlayers;
+	NotifyRosterChanged();
+}
+
+/**
+ * @brief Returns the roster entry of a player, or `nullptr` if the player is not in the lobby.
+ */
+const FDustLinkLobbyPlayer* ADustLinkLobbyRoster::FindPlayer(const APlayerState* PlayerState) const
+{
+	return Roster.Players.FindByPredicate([PlayerState](const FDustLinkLobbyPlayer& Player) { return Player.PlayerState == PlayerState; });
+}
+
+/**
+ * @brief Returns the number of players that are ready.
+ */
+int32 ADustLinkLobbyRoster::GetNumReadyPlayers() const
+{
+	return Algo::CountIf(Roster.Players, [](const FDustLinkLobbyPlayer& Player) { return Player.bIsReady; });
+}
+
+/**
+ * @brief Notifies the roster about a change, waking it up for replication on the server.
+ */
+void ADustLinkLobbyRoster::NotifyRosterChanged()
+{
+	// Replicate the change once, then fall back asleep
+	if (HasAuthority()) FlushNetDormancy();
+
+	OnRosterChanged.Broadcast();
+}
+
+/**
+ * @brief Called on clients when the number of slots was replicated.
+ */
+void ADustLinkLobbyRoster::OnRep_MaxPlayers()
+{
+	OnRosterChanged.Broadcast();
+}
+
+void ADustLinkLobbyRoster::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME(ADustLinkLobbyRoster, Roster);
+	DOREPLIFETIME(ADustLinkLobbyRoster, MaxPlayers);
+}
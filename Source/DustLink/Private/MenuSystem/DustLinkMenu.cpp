@@ -13,7 +13,7 @@
 /**
  * @brief Sets up the menu and its components.
  *
- * This function initializes the menu widget, binds necessary events, and prepares it for display.
+ * This function shows the menu widget, lets its callbacks react to session events, and prepares it for input.
  * It also configures the default session settings, such as the number of public connections,
  * the type of match, and the path to the lobby level. This method should be called before adding
  * the widget to the viewport.
@@ -24,7 +24,9 @@
  */
 void UDustLinkMenu::MenuSetup(const int32 NumberOfPublicConnections, FString TypeOfMatch, FString LobbyPath)
 {
-	AddToViewport();
+	bIsOpen = true;
+
+	if (!IsInViewport()) AddToViewport();
 	SetVisibility(ESlateVisibility::Visible);
 	SetIsFocusable(true);
 
@@ -51,29 +53,18 @@ void UDustLinkMenu::MenuSetup(const int32 NumberOfPublicConnections, FString Typ
 	PlayerController->SetInputMode(InputModeUI);
 	PlayerController->SetShowMouseCursor(true);
 
-	const UGameInstance* GameInstance = GetGameInstance();
-	
-	if (!GameInstance)
+	// Bound once in Initialize, only a menu created without a game instance binds here
+	if (SubsystemSubscriptions.IsEmpty()) BindSubsystem();
+
+	if (DustLinkSubsystem)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("%s: Failed to retrieve Game Instance."), *GetClass()->GetName());
-		return;
+		DustLinkSubsystem->RecordFunnelEvent(EDustLinkFunnelEvent::MenuOpened);
+		DustLinkSubsystem->SetIdle(true);
 	}
 
-	DustLinkSubsystem = GameInstance->GetSubsystem<UDustLinkSubsystem>();
-
 	NumPublicConnections = NumberOfPublicConnections;
 	MatchType = TypeOfMatch;
 	PathToLobby = FString::Printf(TEXT("%s?listen"), *LobbyPath);
-
-	if (DustLinkSubsystem)
-	{
-		DustLinkSubsystem->DustLinkOnCreateSessionComplete.AddDynamic(this, &ThisClass::OnCreateSession);
-		DustLinkSubsystem->DustLinkOnDestroySessionComplete.AddDynamic(this, &ThisClass::OnDestroySession);
-		DustLinkSubsystem->DustLinkOnStartSessionComplete.AddDynamic(this, &ThisClass::OnStartSession);
-		
-		DustLinkSubsystem->DustLinkOnFindSessionsComplete.AddUObject(this, &ThisClass::OnFindSessions);
-		DustLinkSubsystem->DustLinkOnJoinSessionComplete.AddUObject(this, &ThisClass::OnJoinSession);
-	}
 }
 
 /**
@@ -84,8 +75,12 @@ void UDustLinkMenu::MenuSetup(const int32 NumberOfPublicConnections, FString Typ
  */
 void UDustLinkMenu::MenuTearDown()
 {
+	// The subscriptions stay bound for the next opening of the pooled menu, the handlers ignore events while closed
+	bIsOpen = false;
 	RemoveFromParent();
 
+	if (DustLinkSubsystem) DustLinkSubsystem->SetIdle(false);
+
 	const UWorld* World = GetWorld();
 
 	if (!World)
@@ -107,6 +102,48 @@ void UDustLinkMenu::MenuTearDown()
 	PlayerController->SetShowMouseCursor(false);
 }
 
+/**
+ * @brief Joins a private lobby by its short join code.
+ *
+ * The code is resolved straight to connect info through the DustLink subsystem's listing provider,
+ * so no session search is performed. Intended to be bound to a join code text box.
+ *
+ * @param JoinCode The code shared by the host.
+ */
+void UDustLinkMenu::JoinByCode(const FString& JoinCode)
+{
+	JoinButton->SetIsEnabled(false);
+
+	if (!DustLinkSubsystem) 
+	{
+		UE_LOG(LogTemp, Warning, TEXT("%s: Failed to retrieve DustLink subsystem."), *GetClass()->GetName());
+		return;
+	}
+
+	DustLinkSubsystem->JoinSessionByCode(JoinCode);
+}
+
+/**
+ * @brief Connects directly to a host address entered by the player.
+ *
+ * The address is resolved through the DustLink subsystem without performing a session search.
+ * Intended to be bound to a direct connect text box.
+ *
+ * @param Address A host name or IP address, optionally followed by ":<Port>".
+ */
+void UDustLinkMenu::ConnectToAddress(const FString& Address)
+{
+	JoinButton->SetIsEnabled(false);
+
+	if (!DustLinkSubsystem) 
+	{
+		UE_LOG(LogTemp, Warning, TEXT("%s: Failed to retrieve DustLink subsystem."), *GetClass()->GetName());
+		return;
+	}
+
+	DustLinkSubsystem->ConnectToAddress(Address);
+}
+
 /**
  * @brief Initializes the widget when it is constructed.
  *
@@ -122,10 +159,37 @@ bool UDustLinkMenu::Initialize()
 	
 	if (HostButton) HostButton->OnClicked.AddDynamic(this, &ThisClass::HostButtonClicked);
 	if (JoinButton) JoinButton->OnClicked.AddDynamic(this, &ThisClass::JoinButtonClicked);
+
+	BindSubsystem();
 	
 	return true;
 }
 
+/**
+ * @brief Subscribes the menu callbacks to the DustLink subsystem's delegates, once for the lifetime of the widget.
+ */
+void UDustLinkMenu::BindSubsystem()
+{
+	const UGameInstance* GameInstance = GetGameInstance();
+
+	// Widgets previewed in the designer have no game instance
+	if (!GameInstance || !SubsystemSubscriptions.IsEmpty()) return;
+
+	DustLinkSubsystem = GameInstance->GetSubsystem<UDustLinkSubsystem>();
+
+	if (!DustLinkSubsystem) return;
+
+	SubsystemSubscriptions.Reserve(7);
+	SubsystemSubscriptions.Add(DustLinkSubsystem->Subscribe(DustLinkSubsystem->DustLinkOnCreateSessionCompleteNative, this, &ThisClass::OnCreateSession));
+	SubsystemSubscriptions.Add(DustLinkSubsystem->Subscribe(DustLinkSubsystem->DustLinkOnDestroySessionCompleteNative, this, &ThisClass::OnDestroySession));
+	SubsystemSubscriptions.Add(DustLinkSubsystem->Subscribe(DustLinkSubsystem->DustLinkOnStartSessionCompleteNative, this, &ThisClass::OnStartSession));
+
+	SubsystemSubscriptions.Add(DustLinkSubsystem->Subscribe(DustLinkSubsystem->DustLinkOnFindSessionsComplete, this, &ThisClass::OnFindSessions));
+	SubsystemSubscriptions.Add(DustLinkSubsystem->Subscribe(DustLinkSubsystem->DustLinkOnJoinSessionComplete, this, &ThisClass::OnJoinSession));
+	SubsystemSubscriptions.Add(DustLinkSubsystem->Subscribe(DustLinkSubsystem->DustLinkOnConnectInfoResolved, this, &ThisClass::OnConnectInfoResolved));
+	SubsystemSubscriptions.Add(DustLinkSubsystem->Subscribe(DustLinkSubsystem->DustLinkOnPreTravel, this, &ThisClass::OnPreTravel));
+}
+
 /**
  * @brief Called when the widget is about to be destroyed.
  *
@@ -135,7 +199,7 @@ bool UDustLinkMenu::Initialize()
  */
 void UDustLinkMenu::NativeDestruct()
 {
-	MenuTearDown();
+	if (bIsOpen) MenuTearDown();
 
 	Super::NativeDestruct();
 }
@@ -150,6 +214,8 @@ void UDustLinkMenu::NativeDestruct()
  */
 void UDustLinkMenu::OnCreateSession(const bool bWasSuccessful)
 {
+	if (!bIsOpen) return;
+
 	if (!bWasSuccessful)
 	{
 		HostButton->SetIsEnabled(true);
@@ -157,7 +223,7 @@ void UDustLinkMenu::OnCreateSession(const bool bWasSuccessful)
 	}
 
 	// Send player to the multiplayer map
-	if (UWorld* World = GetWorld()) World->ServerTravel(PathToLobby);
+	Travel(PathToLobby, true);
 }
 
 /**
@@ -170,9 +236,9 @@ void UDustLinkMenu::OnCreateSession(const bool bWasSuccessful)
  */
 void UDustLinkMenu::OnDestroySession(const bool bWasSuccessful)
 {
-	if (!bWasSuccessful) return;
+	if (!bIsOpen || !bWasSuccessful) return;
 
-	if (UWorld* World = GetWorld()) World->ServerTravel("/Game/ThirdPerson/Maps/ThirdPerson");
+	Travel(TEXT("/Game/ThirdPerson/Maps/ThirdPerson"), true);
 }
 
 /**
@@ -185,7 +251,7 @@ void UDustLinkMenu::OnDestroySession(const bool bWasSuccessful)
  */
 void UDustLinkMenu::OnStartSession(const bool bWasSuccessful)
 {
-	if (!bWasSuccessful) return;
+	if (!bIsOpen || !bWasSuccessful) return;
 
 	if (GEngine)
 	{
@@ -204,13 +270,19 @@ void UDustLinkMenu::OnStartSession(const bool bWasSuccessful)
  */
 void UDustLinkMenu::OnFindSessions(const TArray<FOnlineSessionSearchResult>& SessionResults, const bool bWasSuccessful)
 {
+	if (!bIsOpen) return;
+
 	if (!DustLinkSubsystem) 
 	{
 		UE_LOG(LogTemp, Warning, TEXT("%s: Failed to retrieve DustLink subsystem."), *GetClass()->GetName());
 		return;
 	}
 	
-	for (auto Result : SessionResults)
+	// Prefer close, lightly loaded hosts that can hold their tick rate
+	TArray<FOnlineSessionSearchResult> RankedResults = SessionResults;
+	DustLinkSubsystem->RankSessions(RankedResults);
+
+	for (auto Result : RankedResults)
 	{
 		FString SettingsValue;
 		Result.Session.SessionSettings.Get(FName("MatchType"), SettingsValue);
@@ -238,6 +310,8 @@ void UDustLinkMenu::OnFindSessions(const TArray<FOnlineSessionSearchResult>& Ses
  */
 void UDustLinkMenu::OnJoinSession(const EOnJoinSessionCompleteResult::Type Result)
 {
+	if (!bIsOpen) return;
+
 	const IOnlineSubsystem* Subsystem = Online::GetSubsystem(GetWorld());
 
 	if (!Subsystem)
@@ -257,6 +331,65 @@ void UDustLinkMenu::OnJoinSession(const EOnJoinSessionCompleteResult::Type Resul
 	FString Address;
 	SessionInterface->GetResolvedConnectString(NAME_GameSession, Address);
 
+	if (Result != EOnJoinSessionCompleteResult::Success) JoinButton->SetIsEnabled(true);
+
+	Travel(Address, false);
+}
+
+/**
+ * @brief Callback for handling the completion of resolving a join code or a direct address.
+ *
+ * This method is triggered after connect info was resolved. On success it travels straight
+ * to the provided address, otherwise it re-enables the join button.
+ *
+ * @param ConnectInfo The address of the session, empty if it could not be resolved.
+ * @param bWasSuccessful Indicates whether the connect info was resolved.
+ */
+void UDustLinkMenu::OnConnectInfoResolved(const FString& ConnectInfo, const bool bWasSuccessful)
+{
+	if (!bIsOpen) return;
+
+	if (!bWasSuccessful)
+	{
+		JoinButton->SetIsEnabled(true);
+		return;
+	}
+
+	Travel(ConnectInfo, false);
+}
+
+/**
+ * @brief Callback for when a map is about to be loaded.
+ *
+ * Tears the menu down so it is released by the purge of the map load instead of surviving into the match.
+ *
+ * @param MapName The name of the map being loaded.
+ */
+void UDustLinkMenu::OnPreTravel(const FString& MapName)
+{
+	if (bIsOpen) MenuTearDown();
+}
+
+/**
+ * @brief Travels to a URL as listen server or as client, unless travel is overridden.
+ *
+ * @param URL The map or address to travel to.
+ * @param bIsServerTravel Whether the world travels with its clients rather than the local player alone.
+ */
+void UDustLinkMenu::Travel(const FString& URL, const bool bIsServerTravel)
+{
+	if (TravelOverride)
+	{
+		TravelOverride(URL);
+		return;
+	}
+
+	if (bIsServerTravel)
+	{
+		if (UWorld* World = GetWorld()) World->ServerTravel(URL);
+		return;
+	}
+
 	APlayerController* PlayerController = GetGameInstance()->GetFirstLocalPlayerController();
 
 	if (!PlayerController)
@@ -265,9 +398,7 @@ void UDustLinkMenu::OnJoinSession(const EOnJoinSessionCompleteResult::Type Resul
 		return;
 	}
 
-	if (Result != EOnJoinSessionCompleteResult::Success) JoinButton->SetIsEnabled(true);
-
-	PlayerController->ClientTravel(Address, ETravelType::TRAVEL_Absolute);
+	PlayerController->ClientTravel(URL, ETravelType::TRAVEL_Absolute);
 }
 
 /**
@@ -0,0 +1,149 @@
+// Copyright Dustbyte Software. All Rights Reserved.
+
+#include "DustLink/Public/MenuSystem/DustLinkMenuManager.h"
+
+#include "Blueprint/UserWidget.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+#include "DustLink/Public/MenuSystem/DustLinkMenu.h"
+#include "DustLink/Public/Online/DustLinkSubsystem.h"
+
+
+UDustLinkMenuManager::UDustLinkMenuManager():
+	MenuClass(FSoftObjectPath(TEXT("/DustLink/MenuSystem/WBP_DustLinkMenu.WBP_DustLinkMenu_C")))
+{
+}
+
+/**
+ * @brief Starts loading the menu widget class on clients.
+ *
+ * @param Collection The subsystem collection the subsystem is initialized in.
+ */
+void UDustLinkMenuManager::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	if (IsRunningDedicatedServer() || MenuClass.IsNull()) return;
+
+	if (UDustLinkSubsystem* DustLinkSubsystem = Collection.InitializeDependency<UDustLinkSubsystem>())
+	{
+		PreTravelHandle = DustLinkSubsystem->DustLinkOnPreTravel.AddUObject(this, &ThisClass::OnPreTravel);
+	}
+
+	MenuClassHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(
+		MenuClass.ToSoftObjectPath(), FStreamableDelegate::CreateUObject(this, &ThisClass::OnMenuClassLoaded));
+}
+
+/**
+ * @brief Cancels the pending load and releases the pooled menu.
+ */
+void UDustLinkMenuManager::Deinitialize()
+{
+	if (MenuClassHandle.IsValid())
+	{
+		MenuClassHandle->CancelHandle();
+		MenuClassHandle.Reset();
+	}
+
+	if (UDustLinkSubsystem* DustLinkSubsystem = GetGameInstance()->GetSubsystem<UDustLinkSubsystem>())
+	{
+		DustLinkSubsystem->DustLinkOnPreTravel.Remove(PreTravelHandle);
+	}
+
+	PooledMenu = nullptr;
+	bIsOpenPending = false;
+
+	Super::Deinitialize();
+}
+
+/**
+ * @brief Opens the menu, reusing the pooled instance when there is one.
+ *
+ * If the menu class is still loading, the menu opens as soon as the load completes.
+ *
+ * @param NumberOfPublicConnections The default number of player slots available in the session.
+ * @param TypeOfMatch A string identifier for the session type.
+ * @param LobbyPath The path to the lobby level where players gather before starting the session.
+ */
+void UDustLinkMenuManager::OpenMenu(const int32 NumberOfPublicConnections, FString TypeOfMatch, FString LobbyPath)
+{
+	if (!IsMenuClassLoaded())
+	{
+		bIsOpenPending = true;
+		PendingNumPublicConnections = NumberOfPublicConnections;
+		PendingMatchType = MoveTemp(TypeOfMatch);
+		PendingLobbyPath = MoveTemp(LobbyPath);
+
+		if (!MenuClassHandle.IsValid())
+		{
+			UE_LOG(LogTemp, Warning, TEXT("%s: Menu class %s is not being loaded."), *GetClass()->GetName(), *MenuClass.ToString());
+		}
+
+		return;
+	}
+
+	UDustLinkMenu* Menu = GetOrCreateMenu();
+
+	if (!Menu)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("%s: Failed to create the menu."), *GetClass()->GetName());
+		return;
+	}
+
+	Menu->MenuSetup(NumberOfPublicConnections, TypeOfMatch, LobbyPath);
+}
+
+/**
+ * @brief Hides the menu while keeping its instance pooled for the next `OpenMenu`.
+ */
+void UDustLinkMenuManager::CloseMenu()
+{
+	bIsOpenPending = false;
+
+	if (PooledMenu && PooledMenu->IsInViewport()) PooledMenu->MenuTearDown();
+}
+
+/**
+ * @brief Callback for when the menu widget class finished loading.
+ */
+void UDustLinkMenuManager::OnMenuClassLoaded()
+{
+	if (!IsMenuClassLoaded())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("%s: Failed to load menu class %s."), *GetClass()->GetName(), *MenuClass.ToString());
+		return;
+	}
+
+	if (!bIsOpenPending) return;
+
+	bIsOpenPending = false;
+	OpenMenu(PendingNumPublicConnections, MoveTemp(PendingMatchType), MoveTemp(PendingLobbyPath));
+}
+
+/**
+ * @brief Callback for when a map is about to be loaded, releases the pooled menu.
+ *
+ * @param MapName The name of the map being loaded.
+ */
+void UDustLinkMenuManager::OnPreTravel(const FString& MapName)
+{
+	PooledMenu = nullptr;
+}
+
+/**
+ * @brief Returns the pooled menu, creating it on first use.
+ *
+ * @return The menu instance, or `nullptr` if the class is not loaded.
+ */
+UDustLinkMenu* UDustLinkMenuManager::GetOrCreateMenu()
+{
+	if (PooledMenu) return PooledMenu;
+
+	UClass* LoadedClass = MenuClass.Get();
+
+	if (!LoadedClass) return nullptr;
+
+	PooledMenu = CreateWidget<UDustLinkMenu>(GetGameInstance(), LoadedClass);
+
+	return PooledMenu;
+}
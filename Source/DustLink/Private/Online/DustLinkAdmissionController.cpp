@@ -0,0 +1,51 @@
+// Copyright Dustbyte Software. All Rights Reserved.
+
+#include "DustLink/Public/Online/DustLinkAdmissionController.h"
+
+
+/**
+ * @brief Constructs the controller with the given tuning parameters.
+ *
+ * @param InSettings The tuning parameters to use.
+ */
+FDustLinkAdmissionController::FDustLinkAdmissionController(const FDustLinkAdmissionSettings& InSettings):
+	Settings(InSettings)
+{
+}
+
+/**
+ * @brief Reopens the host and forgets when it was closed.
+ */
+void FDustLinkAdmissionController::Reset()
+{
+	bIsAdmitting = true;
+	ClosedTime = 0.0;
+}
+
+/**
+ * @brief Re-evaluates the admission state from the latest tick time.
+ *
+ * @param TickTimeMs The smoothed game thread work per frame, in milliseconds.
+ * @param TickBudgetMs The work per frame the host can afford, in milliseconds.
+ * @param Now The current time, in seconds.
+ * @return `true` if the host was opened or closed by this update.
+ */
+bool FDustLinkAdmissionController::Update(const float TickTimeMs, const float TickBudgetMs, const double Now)
+{
+	const float Usage = TickTimeMs / FMath::Max(TickBudgetMs, KINDA_SMALL_NUMBER);
+
+	if (bIsAdmitting && Usage > Settings.CloseThreshold)
+	{
+		bIsAdmitting = false;
+		ClosedTime = Now;
+		return true;
+	}
+
+	if (!bIsAdmitting && Usage < Settings.ReopenThreshold && Now - ClosedTime >= Settings.MinClosedTime)
+	{
+		bIsAdmitting = true;
+		return true;
+	}
+
+	return false;
+}
@@ -0,0 +1,319 @@
+// Copyright Dustbyte Software. All Rights Reserved.
+
+#include "DustLink/Public/Online/DustLinkAnalytics.h"
+
+#include "Async/Async.h"
+#include "Dom/JsonObject.h"
+#include "Misc/Compression.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Guid.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+
+
+/**
+ * @brief Constructs the exporter for the given provider.
+ *
+ * @param InProvider The provider events are exported to.
+ * @param InSettings The tuning parameters to use.
+ */
+FDustLinkAnalytics::FDustLinkAnalytics(const TSharedRef<IAnalyticsProvider>& InProvider, const FDustLinkAnalyticsSettings& InSettings):
+	Provider(InProvider),
+	Settings(InSettings),
+	StartTime(FPlatformTime::Seconds())
+{
+	Settings.BlockSize = FMath::Max<int32>(Settings.BlockSize, sizeof(FRecord));
+	CurrentBlock.Reserve(Settings.BlockSize);
+}
+
+/**
+ * @brief Buffers one funnel event.
+ *
+ * @param Event The funnel stage that was reached.
+ * @param bWasSuccessful Whether the stage succeeded, meaningful for completions.
+ * @param Value A stage specific count, e.g. the number of candidates a search returned.
+ * @param LatencyMs Time the stage took, in milliseconds, negative if not applicable.
+ */
+void FDustLinkAnalytics::RecordEvent(const EDustLinkFunnelEvent Event, const bool bWasSuccessful, const int32 Value, const double LatencyMs)
+{
+	if (Event == EDustLinkFunnelEvent::MenuOpened) ++AttemptId;
+
+	if (CurrentBlock.Num() + static_cast<int32>(sizeof(FRecord)) > Settings.BlockSize) CompressBlock();
+
+	FRecord Record;
+	FMemory::Memzero(Record);
+	Record.Time = static_cast<float>(FPlatformTime::Seconds() - StartTime);
+	Record.AttemptId = AttemptId;
+	Record.Value = Value;
+	Record.LatencyMs = static_cast<float>(LatencyMs);
+	Record.Event = static_cast<uint8>(Event);
+	Record.bWasSuccessful = bWasSuccessful ? 1 : 0;
+
+	CurrentBlock.Append(reinterpret_cast<const uint8*>(&Record), sizeof(FRecord));
+	++NumBufferedEvents;
+}
+
+/**
+ * @brief Exports all buffered events to the provider and asks it to flush.
+ */
+void FDustLinkAnalytics::Flush()
+{
+	if (NumBufferedEvents == 0) return;
+
+	TArray<uint8> Block;
+
+	for (TFuture<FCompressedBlock>& Future : CompressedBlocks)
+	{
+		// Compressing a block takes far less than the flush interval, so this rarely waits
+		const FCompressedBlock& Compressed = Future.Get();
+
+		if (!Compressed.bIsCompressed)
+		{
+			ExportBlock(Compressed.Data.GetData(), Compressed.Data.Num());
+			continue;
+		}
+
+		Block.SetNumUninitialized(Compressed.UncompressedSize, EAllowShrinking::No);
+
+		if (!FCompression::UncompressMemory(NAME_Zlib, Block.GetData(), Block.Num(), Compressed.Data.GetData(), Compressed.Data.Num()))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("FDustLinkAnalytics: Dropping a corrupt event block."));
+			continue;
+		}
+
+		ExportBlock(Block.GetData(), Block.Num());
+	}
+
+	ExportBlock(CurrentBlock.GetData(), CurrentBlock.Num());
+
+	CompressedBlocks.Reset();
+	CurrentBlock.Reset();
+	NumBufferedEvents = 0;
+
+	Provider->FlushEvents();
+}
+
+/**
+ * @brief Returns the name of a funnel stage, as used in event names.
+ */
+const TCHAR* FDustLinkAnalytics::GetEventName(const EDustLinkFunnelEvent Event)
+{
+	static const TCHAR* Names[] = { TEXT("MenuOpened"), TEXT("SearchStarted"), TEXT("SearchCompleted"), TEXT("JoinAttempted"), TEXT("JoinCompleted"), TEXT("TravelStarted"), TEXT("Arrived") };
+	static_assert(UE_ARRAY_COUNT(Names) == static_cast<uint8>(EDustLinkFunnelEvent::Num), "Every funnel event needs a name.");
+
+	return Names[static_cast<uint8>(Event)];
+}
+
+/**
+ * @brief Hands the current block to the thread pool for compression and starts a new one.
+ */
+void FDustLinkAnalytics::CompressBlock()
+{
+	if (CurrentBlock.IsEmpty()) return;
+
+	CompressedBlocks.Add(Async(EAsyncExecution::ThreadPool, [Block = MoveTemp(CurrentBlock)]()
+	{
+		return CompressRecords(Block);
+	}));
+
+	// The task owns the full block now, so the next one is preallocated once per block rather than per event
+	CurrentBlock.Reset(Settings.BlockSize);
+}
+
+/**
+ * @brief Compresses a block of records, falling back to the raw records if they do not compress.
+ *
+ * @param Block The raw records.
+ */
+FDustLinkAnalytics::FCompressedBlock FDustLinkAnalytics::CompressRecords(const TArray<uint8>& Block)
+{
+	FCompressedBlock Compressed;
+	Compressed.UncompressedSize = Block.Num();
+
+	int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Zlib, Block.Num());
+	Compressed.Data.SetNumUninitialized(CompressedSize);
+
+	if (FCompression::CompressMemory(NAME_Zlib, Compressed.Data.GetData(), CompressedSize, Block.GetData(), Block.Num()))
+	{
+		Compressed.Data.SetNum(CompressedSize);
+	}
+	else
+	{
+		// Keep the events even if they do not compress
+		Compressed.Data = Block;
+		Compressed.bIsCompressed = false;
+	}
+
+	return Compressed;
+}
+
+/**
+ * @brief Hands the records of a raw block to the provider.
+ *
+ * @param Block The raw records.
+ * @param Size The number of bytes of `Block` holding records.
+ */
+void FDustLinkAnalytics::ExportBlock(const uint8* Block, const int32 Size) const
+{
+	TArray<FAnalyticsEventAttribute> Attributes;
+
+	for (int32 Offset = 0; Offset + static_cast<int32>(sizeof(FRecord)) <= Size; Offset += sizeof(FRecord))
+	{
+		FRecord Record;
+		FMemory::Memcpy(&Record, Block + Offset, sizeof(FRecord));
+
+		if (Record.Event >= static_cast<uint8>(EDustLinkFunnelEvent::Num)) continue;
+
+		Attributes.Reset();
+		Attributes.Emplace(TEXT("AttemptId"), Record.AttemptId);
+		Attributes.Emplace(TEXT("Time"), Record.Time);
+		Attributes.Emplace(TEXT("Success"), Record.bWasSuccessful != 0);
+		Attributes.Emplace(TEXT("Value"), Record.Value);
+
+		if (Record.LatencyMs >= 0.f) Attributes.Emplace(TEXT("LatencyMs"), Record.LatencyMs);
+
+		Provider->RecordEvent(FString::Printf(TEXT("DustLink.Funnel.%s"), GetEventName(static_cast<EDustLinkFunnelEvent>(Record.Event))), Attributes);
+	}
+}
+
+/**
+ * @brief Constructs the provider writing to the given directory.
+ *
+ * @param InDirectory Directory event files are written to, the default location if empty.
+ */
+FDustLinkFileAnalyticsProvider::FDustLinkFileAnalyticsProvider(const FString& InDirectory):
+	Directory(InDirectory.IsEmpty() ? FPaths::ProjectSavedDir() / TEXT("DustLink") / TEXT("Analytics") : InDirectory)
+{
+}
+
+FDustLinkFileAnalyticsProvider::~FDustLinkFileAnalyticsProvider()
+{
+	if (bSessionInProgress) EndSession();
+}
+
+/**
+ * @brief Starts a new session, writing its events to a new file.
+ *
+ * @param Attributes Attributes recorded with the session start event.
+ * @return Always `true`.
+ */
+bool FDustLinkFileAnalyticsProvider::StartSession(const TArray<FAnalyticsEventAttribute>& Attributes)
+{
+	if (bSessionInProgress) EndSession();
+
+	// Processes started within the same millisecond still get their own file
+	if (SessionId.IsEmpty()) SessionId = FDateTime::Now().ToString(TEXT("%Y%m%d-%H%M%S-%s-")) + FGuid::NewGuid().ToString(EGuidFormats::Digits);
+
+	bSessionInProgress = true;
+	RecordEvent(TEXT("SessionStart"), Attributes);
+
+	return true;
+}
+
+/**
+ * @brief Ends the current session and writes its remaining events.
+ */
+void FDustLinkFileAnalyticsProvider::EndSession()
+{
+	if (!bSessionInProgress) return;
+
+	RecordEvent(TEXT("SessionEnd"), {});
+	FlushEvents();
+
+	bSessionInProgress = false;
+	SessionId.Reset();
+}
+
+/**
+ * @brief Appends the pending events to the session file.
+ */
+void FDustLinkFileAnalyticsProvider::FlushEvents()
+{
+	if (PendingLines.IsEmpty()) return;
+
+	if (!FFileHelper::SaveStringToFile(PendingLines, *GetFilePath(), FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM, &IFileManager::Get(), FILEWRITE_Append))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("FDustLinkFileAnalyticsProvider: Failed to write events to %s."), *GetFilePath());
+	}
+
+	PendingLines.Reset();
+}
+
+/**
+ * @brief Changes the session identifier, only possible before a session is started.
+ *
+ * @param InSessionID The new identifier.
+ * @return `true` if the identifier was changed.
+ */
+bool FDustLinkFileAnalyticsProvider::SetSessionID(const FString& InSessionID)
+{
+	if (bSessionInProgress) return false;
+
+	SessionId = InSessionID;
+
+	return true;
+}
+
+/**
+ * @brief Encodes an event as a JSON line waiting to be written.
+ *
+ * @param EventName The name of the event.
+ * @param Attributes The attributes of the event.
+ */
+void FDustLinkFileAnalyticsProvider::RecordEvent(const FString& EventName, const TArray<FAnalyticsEventAttribute>& Attributes)
+{
+	if (!bSessionInProgress) return;
+
+	const TSharedRef<FJsonObject> Object = MakeShared<FJsonObject>();
+	Object->SetStringField(TEXT("Event"), EventName);
+	Object->SetStringField(TEXT("UserId"), UserId);
+
+	SetAttributes(*Object, DefaultAttributes);
+	SetAttributes(*Object, Attributes);
+
+	FString Line;
+	FJsonSerializer::Serialize(Object, TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Line));
+
+	PendingLines += Line;
+	PendingLines += TEXT("\n");
+}
+
+/**
+ * @brief Returns the file events of the current session are written to.
+ */
+FString FDustLinkFileAnalyticsProvider::GetFilePath() const
+{
+	return Directory / SessionId + TEXT(".jsonl");
+}
+
+/**
+ * @brief Adds attributes as fields of an event object, JSON fragments as their parsed value.
+ *
+ * @param Object The event object to add the fields to.
+ * @param Attributes The attributes to add.
+ */
+void FDustLinkFileAnalyticsProvider::SetAttributes(FJsonObject& Object, const TArray<FAnalyticsEventAttribute>& Attributes)
+{
+	for (const FAnalyticsEventAttribute& Attribute : Attributes)
+	{
+		if (Attribute.IsJsonFragment())
+		{
+			// Numbers, booleans and nested values arrive as fragments, wrapped so scalars parse as well
+			TSharedPtr<FJsonObject> Wrapper;
+
+			if (FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(TEXT("{\"Value\":") + Attribute.GetValue() + TEXT("}")), Wrapper) && Wrapper.IsValid())
+			{
+				if (const TSharedPtr<FJsonValue> Value = Wrapper->TryGetField(TEXT("Value")))
+				{
+					Object.SetField(Attribute.GetName(), Value);
+					continue;
+				}
+			}
+
+			UE_LOG(LogTemp, Warning, TEXT("FDustLinkFileAnalyticsProvider: Attribute %s is not valid JSON, recording it as a string."), *Attribute.GetName());
+		}
+
+		Object.SetStringField(Attribute.GetName(), Attribute.GetValue());
+	}
+}
@@ -0,0 +1,211 @@
+// Copyright Dustbyte Software. All Rights Reserved.
+
+#include "DustLink/Public/Online/DustLinkContentManifest.h"
+
+#include "AssetRegistry/IAssetRegistry.h"
+#include "GenericPlatform/GenericPlatformChunkInstall.h"
+#include "Interfaces/IPluginManager.h"
+#include "Misc/PackageName.h"
+
+
+/**
+ * @brief Builds the manifest of the local installation for a map.
+ *
+ * @param InMapPath The package path of the map, may be empty.
+ * @return The manifest describing the map's chunks and the local content plugins.
+ */
+FDustLinkContentManifest FDustLinkContentManifest::Build(const FString& InMapPath)
+{
+	FDustLinkContentManifest Manifest;
+	Manifest.MapPath = InMapPath;
+
+	if (IAssetRegistry* AssetRegistry = IAssetRegistry::Get(); AssetRegistry && !InMapPath.IsEmpty())
+	{
+		TArray<FAssetData> Assets;
+		AssetRegistry->GetAssetsByPackageName(FName(*InMapPath), Assets);
+
+		for (const FAssetData& Asset : Assets)
+		{
+			for (const int32 ChunkId : Asset.GetChunkIDs())
+			{
+				if (ChunkId != 0) Manifest.ChunkIds.AddUnique(ChunkId);
+			}
+		}
+
+		Manifest.ChunkIds.Sort();
+	}
+
+	for (const TSharedRef<IPlugin>& Plugin : IPluginManager::Get().GetEnabledPluginsWithContent())
+	{
+		if (Plugin->GetLoadedFrom() != EPluginLoadedFrom::Project) continue;
+
+		Manifest.PluginVersions.Add(Plugin->GetName(), Plugin->GetDescriptor().VersionName);
+	}
+
+	Manifest.PluginVersions.KeySort(TLess<FString>());
+
+	return Manifest;
+}
+
+/**
+ * @brief Reads the manifest advertised in session settings.
+ *
+ * @param SessionSettings The settings of the session.
+ * @param OutManifest The parsed manifest.
+ * @return `true` if the session advertises a manifest.
+ */
+bool FDustLinkContentManifest::FromSessionSettings(const FOnlineSessionSettings& SessionSettings, FDustLinkContentManifest& OutManifest)
+{
+	FString Encoded;
+
+	if (!SessionSettings.Get(FName("ContentManifest"), Encoded)) return false;
+
+	return FromString(Encoded, OutManifest);
+}
+
+/**
+ * @brief Writes the manifest into session settings.
+ *
+ * @param SessionSettings The settings to advertise the manifest in.
+ */
+void FDustLinkContentManifest::ToSessionSettings(FOnlineSessionSettings& SessionSettings) const
+{
+	SessionSettings.Set(FName("ContentManifest"), ToString(), EOnlineDataAdvertisementType::ViaOnlineService);
+}
+
+/**
+ * @brief Encodes the manifest as `<Map>|<Chunk>,<Chunk>|<Plugin>=<Version>,<Plugin>=<Version>`.
+ */
+FString FDustLinkContentManifest::ToString() const
+{
+	TArray<FString> Chunks;
+
+	for (const int32 ChunkId : ChunkIds) Chunks.Add(FString::FromInt(ChunkId));
+
+	TArray<FString> Plugins;
+
+	for (const TPair<FString, FString>& Plugin : PluginVersions) Plugins.Add(FString::Printf(TEXT("%s=%s"), *Plugin.Key, *Plugin.Value));
+
+	return FString::Printf(TEXT("%s|%s|%s"), *MapPath, *FString::Join(Chunks, TEXT(",")), *FString::Join(Plugins, TEXT(",")));
+}
+
+/**
+ * @brief Decodes a manifest produced by `ToString`.
+ *
+ * @param Encoded The encoded manifest.
+ * @param OutManifest The decoded manifest.
+ * @return `true` if the string is a well-formed manifest.
+ */
+bool FDustLinkContentManifest::FromString(const FString& Encoded, FDustLinkContentManifest& OutManifest)
+{
+	TArray<FString> Sections;
+	Encoded.ParseIntoArray(Sections, TEXT("|"), false);
+
+	if (Sections.Num() != 3) return false;
+
+	OutManifest = FDustLinkContentManifest();
+	OutManifest.MapPath = Sections[0];
+
+	TArray<FString> Chunks;
+	Sections[1].ParseIntoArray(Chunks, TEXT(","));
+
+	for (const FString& Chunk : Chunks)
+	{
+		if (!Chunk.IsNumeric()) return false;
+
+		OutManifest.ChunkIds.Add(FCString::Atoi(*Chunk));
+	}
+
+	TArray<FString> Plugins;
+	Sections[2].ParseIntoArray(Plugins, TEXT(","));
+
+	for (const FString& Plugin : Plugins)
+	{
+		FString Name;
+		FString Version;
+
+		if (!Plugin.Split(TEXT("="), &Name, &Version)) return false;
+
+		OutManifest.PluginVersions.Add(Name, Version);
+	}
+
+	return true;
+}
+
+/**
+ * @brief Checks whether the local installation can satisfy the manifest.
+ *
+ * Chunks that are known but not yet installed count as satisfiable, since they can be requested before travel.
+ *
+ * @param OutReason Describes the first unsatisfied requirement.
+ * @return `true` if every plugin version matches and every chunk and the map are installed or installable.
+ */
+bool FDustLinkContentManifest::IsSatisfiedLocally(FString& OutReason) const
+{
+	for (const TPair<FString, FString>& Plugin : PluginVersions)
+	{
+		const TSharedPtr<IPlugin> LocalPlugin = IPluginManager::Get().FindPlugin(Plugin.Key);
+
+		if (!LocalPlugin || !LocalPlugin->IsEnabled())
+		{
+			OutReason = FString::Printf(TEXT("Plugin %s is not enabled."), *Plugin.Key);
+			return false;
+		}
+
+		if (LocalPlugin->GetDescriptor().VersionName != Plugin.Value)
+		{
+			OutReason = FString::Printf(TEXT("Plugin %s is at version %s, the session requires %s."),
+				*Plugin.Key, *LocalPlugin->GetDescriptor().VersionName, *Plugin.Value);
+			return false;
+		}
+	}
+
+	bool bHasPendingChunks = false;
+
+	if (IPlatformChunkInstall* ChunkInstall = FPlatformMisc::GetPlatformChunkInstall())
+	{
+		for (const int32 ChunkId : ChunkIds)
+		{
+			const EChunkLocation::Type Location = ChunkInstall->GetPakchunkLocation(ChunkId);
+
+			if (Location == EChunkLocation::DoesNotExist)
+			{
+				OutReason = FString::Printf(TEXT("Chunk %d is not available on this platform."), ChunkId);
+				return false;
+			}
+
+			bHasPendingChunks |= Location == EChunkLocation::NotAvailable;
+		}
+	}
+
+	if (!MapPath.IsEmpty() && !bHasPendingChunks && !FPackageName::DoesPackageExist(MapPath))
+	{
+		OutReason = FString::Printf(TEXT("Map %s is not installed."), *MapPath);
+		return false;
+	}
+
+	return true;
+}
+
+/**
+ * @brief Asks the platform chunk installer to fetch every chunk of the manifest that is not installed yet.
+ *
+ * @return The number of chunks that were requested.
+ */
+int32 FDustLinkContentManifest::RequestContent() const
+{
+	IPlatformChunkInstall* ChunkInstall = FPlatformMisc::GetPlatformChunkInstall();
+
+	if (!ChunkInstall) return 0;
+
+	int32 NumRequested = 0;
+
+	for (const int32 ChunkId : ChunkIds)
+	{
+		if (ChunkInstall->GetPakchunkLocation(ChunkId) != EChunkLocation::NotAvailable) continue;
+
+		if (ChunkInstall->PrioritizePakchunk(ChunkId, EChunkPriority::Immediate)) ++NumRequested;
+	}
+
+	return NumRequested;
+}
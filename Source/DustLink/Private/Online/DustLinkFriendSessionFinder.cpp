@@ -0,0 +1,168 @@
+// Copyright Dustbyte Software. All Rights Reserved.
+
+#include "DustLink/Public/Online/DustLinkFriendSessionFinder.h"
+
+
+/**
+ * @brief Replaces the source of friends and their sessions, dropping all cached answers.
+ *
+ * @param InProvider The provider to query.
+ */
+void FDustLinkFriendSessionFinder::SetProvider(const TSharedPtr<IDustLinkPresenceProvider>& InProvider)
+{
+	Provider = InProvider;
+	InvalidateCache();
+}
+
+/**
+ * @brief Discovers the sessions of all joinable friends.
+ *
+ * A discovery already in progress is abandoned and its callback is never invoked.
+ *
+ * @param LocalUserNum The local user whose friends are queried.
+ * @param MaxConcurrentQueries The maximum number of friend session queries in flight.
+ * @param CacheLifetime How long a friend's session stays cached, in seconds.
+ * @param OnComplete Called with the sessions once every joinable friend was answered.
+ */
+void FDustLinkFriendSessionFinder::Find(const int32 LocalUserNum, const int32 MaxConcurrentQueries, const float CacheLifetime, const FDustLinkOnFriendSessionsFound& OnComplete)
+{
+	if (!Provider.IsValid())
+	{
+		OnComplete.ExecuteIfBound(TArray<FOnlineSessionSearchResult>(), false);
+		return;
+	}
+
+	const uint32 Generation = ++CurrentGeneration;
+
+	QueuedFriends.Reset();
+	DiscoveredFriendIds.Reset();
+	PendingOnComplete = OnComplete;
+	CurrentLocalUserNum = LocalUserNum;
+	CurrentMaxConcurrentQueries = FMath::Max(1, MaxConcurrentQueries);
+	CurrentCacheLifetime = CacheLifetime;
+	NumQueriesInFlight = 0;
+
+	TWeakPtr<FDustLinkFriendSessionFinder> WeakThis(AsShared());
+
+	Provider->ReadJoinableFriends(LocalUserNum, FDustLinkOnFriendsRead::CreateLambda([WeakThis, Generation](const TArray<FDustLinkFriend>& Friends, const bool bWasSuccessful)
+	{
+		if (const TSharedPtr<FDustLinkFriendSessionFinder> This = WeakThis.Pin()) This->OnFriendsRead(Generation, Friends, bWasSuccessful);
+	}));
+}
+
+/**
+ * @brief Callback for when the provider read the joinable friends.
+ *
+ * @param Generation The discovery the answer belongs to.
+ * @param Friends The friends in a joinable session.
+ * @param bWasSuccessful Whether the friends list could be read.
+ */
+void FDustLinkFriendSessionFinder::OnFriendsRead(const uint32 Generation, const TArray<FDustLinkFriend>& Friends, const bool bWasSuccessful)
+{
+	if (Generation != CurrentGeneration) return;
+
+	if (!bWasSuccessful)
+	{
+		const FDustLinkOnFriendSessionsFound OnComplete = MoveTemp(PendingOnComplete);
+		OnComplete.ExecuteIfBound(TArray<FOnlineSessionSearchResult>(), false);
+		return;
+	}
+
+	const double Now = FPlatformTime::Seconds();
+
+	for (const FDustLinkFriend& Friend : Friends)
+	{
+		DiscoveredFriendIds.Add(Friend.FriendId);
+
+		if (const FCacheEntry* Entry = Cache.Find(Friend.FriendId); Entry && Now - Entry->Time < CurrentCacheLifetime) continue;
+
+		QueuedFriends.Add(Friend);
+	}
+
+	if (QueuedFriends.Num() == 0)
+	{
+		Finish();
+		return;
+	}
+
+	IssueQueries();
+}
+
+/**
+ * @brief Callback for when the provider answered a friend session query.
+ *
+ * @param Generation The discovery the answer belongs to.
+ * @param FriendId The friend whose session was queried.
+ * @param SessionResults The sessions found for the friend.
+ * @param bWasSuccessful Whether the query succeeded.
+ */
+void FDustLinkFriendSessionFinder::OnFriendSessionFound(const uint32 Generation, const FString FriendId, const TArray<FOnlineSessionSearchResult>& SessionResults, const bool bWasSuccessful)
+{
+	if (bWasSuccessful) Cache.Add(FriendId, { SessionResults, FPlatformTime::Seconds() });
+
+	if (Generation != CurrentGeneration) return;
+
+	--NumQueriesInFlight;
+
+	if (QueuedFriends.Num() > 0)
+	{
+		IssueQueries();
+		return;
+	}
+
+	if (NumQueriesInFlight == 0) Finish();
+}
+
+/**
+ * @brief Issues queued friend session queries until the concurrency limit is reached.
+ */
+void FDustLinkFriendSessionFinder::IssueQueries()
+{
+	TWeakPtr<FDustLinkFriendSessionFinder> WeakThis(AsShared());
+	const uint32 Generation = CurrentGeneration;
+
+	while (QueuedFriends.Num() > 0 && NumQueriesInFlight < CurrentMaxConcurrentQueries)
+	{
+		const FDustLinkFriend Friend = QueuedFriends.Pop();
+		++NumQueriesInFlight;
+
+		Provider->FindFriendSession(CurrentLocalUserNum, Friend, FDustLinkOnFriendSessionFound::CreateLambda(
+			[WeakThis, Generation, FriendId = Friend.FriendId](const TArray<FOnlineSessionSearchResult>& SessionResults, const bool bWasSuccessful)
+		{
+			if (const TSharedPtr<FDustLinkFriendSessionFinder> This = WeakThis.Pin()) This->OnFriendSessionFound(Generation, FriendId, SessionResults, bWasSuccessful);
+		}));
+
+		// The provider may answer synchronously and start a new discovery from the callback
+		if (Generation != CurrentGeneration) return;
+	}
+}
+
+/**
+ * @brief Gathers the sessions of all friends of the current discovery and invokes its callback.
+ */
+void FDustLinkFriendSessionFinder::Finish()
+{
+	TArray<FOnlineSessionSearchResult> SessionResults;
+	TSet<FString> SeenSessionIds;
+
+	for (const FString& FriendId : DiscoveredFriendIds)
+	{
+		const FCacheEntry* Entry = Cache.Find(FriendId);
+
+		if (!Entry) continue;
+
+		// Several friends in the same session report it once
+		for (const FOnlineSessionSearchResult& Result : Entry->SessionResults)
+		{
+			bool bIsAlreadySeen = false;
+			SeenSessionIds.Add(Result.GetSessionIdStr(), &bIsAlreadySeen);
+
+			if (!bIsAlreadySeen) SessionResults.Add(Result);
+		}
+	}
+
+	++CurrentGeneration;
+
+	const FDustLinkOnFriendSessionsFound OnComplete = MoveTemp(PendingOnComplete);
+	OnComplete.ExecuteIfBound(SessionResults, true);
+}
@@ -0,0 +1,126 @@
+// Copyright Dustbyte Software. All Rights Reserved.
+
+#include "DustLink/Public/Online/DustLinkLatencyHistogram.h"
+
+
+/**
+ * @brief Records one latency.
+ *
+ * @param LatencyMs The latency, in milliseconds.
+ */
+void FDustLinkLatencyHistogram::Record(const double LatencyMs)
+{
+	constexpr uint64 MaxTrackable = (uint64(1) << MaxValueBits) - 1;
+	const uint64 Microseconds = FMath::Min(static_cast<uint64>(FMath::Max(0.0, LatencyMs) * 1000.0), MaxTrackable);
+
+	Buckets[GetBucketIndex(Microseconds)].fetch_add(1, std::memory_order_relaxed);
+	Count.fetch_add(1, std::memory_order_relaxed);
+	SumMicroseconds.fetch_add(Microseconds, std::memory_order_relaxed);
+
+	uint64 CurrentMax = MaxMicroseconds.load(std::memory_order_relaxed);
+
+	while (Microseconds > CurrentMax && !MaxMicroseconds.compare_exchange_weak(CurrentMax, Microseconds, std::memory_order_relaxed))
+	{
+	}
+}
+
+/**
+ * @brief Returns the latency below which the given share of recorded latencies fall, in milliseconds.
+ *
+ * @param Percentile The percentile in the range [0, 100].
+ * @return The latency, or zero if nothing was recorded.
+ */
+double FDustLinkLatencyHistogram::GetPercentile(const double Percentile) const
+{
+	const uint64 Total = GetCount();
+
+	if (Total == 0) return 0.0;
+
+	const uint64 Rank = FMath::Max<uint64>(1, static_cast<uint64>(FMath::CeilToDouble(FMath::Clamp(Percentile, 0.0, 100.0) / 100.0 * Total)));
+	uint64 Cumulative = 0;
+
+	for (int32 Index = 0; Index < NumBuckets; ++Index)
+	{
+		Cumulative += Buckets[Index].load(std::memory_order_relaxed);
+
+		if (Cumulative < Rank) continue;
+
+		// The middle of the bucket halves the worst-case error, but never exceeds the largest sample
+		const uint64 Middle = GetBucketLowerBound(Index) + GetBucketWidth(Index) / 2;
+		return FMath::Min(Middle, MaxMicroseconds.load(std::memory_order_relaxed)) / 1000.0;
+	}
+
+	return GetMaxMs();
+}
+
+/**
+ * @brief Returns the mean of all recorded latencies, in milliseconds.
+ */
+double FDustLinkLatencyHistogram::GetMeanMs() const
+{
+	const uint64 Total = GetCount();
+
+	return Total > 0 ? GetSumMs() / Total : 0.0;
+}
+
+/**
+ * @brief Forgets all recorded latencies.
+ *
+ * Latencies recorded concurrently with a reset may be partially kept.
+ */
+void FDustLinkLatencyHistogram::Reset()
+{
+	for (std::atomic<uint32>& Bucket : Buckets) Bucket.store(0, std::memory_order_relaxed);
+
+	Count.store(0, std::memory_order_relaxed);
+	SumMicroseconds.store(0, std::memory_order_relaxed);
+	MaxMicroseconds.store(0, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Formats the count and the usual percentiles on one line, e.g. for console output.
+ */
+FString FDustLinkLatencyHistogram::ToSummaryString() const
+{
+	return FString::Printf(TEXT("n=%llu mean=%.2fms p50=%.2fms p90=%.2fms p99=%.2fms p99.9=%.2fms max=%.2fms"),
+		GetCount(), GetMeanMs(), GetPercentile(50.0), GetPercentile(90.0), GetPercentile(99.0), GetPercentile(99.9), GetMaxMs());
+}
+
+/**
+ * @brief Returns the bucket a latency falls into.
+ *
+ * @param Microseconds The latency, already clamped to the trackable range.
+ */
+int32 FDustLinkLatencyHistogram::GetBucketIndex(const uint64 Microseconds)
+{
+	if (Microseconds < SubBucketCount) return static_cast<int32>(Microseconds);
+
+	// Shift the value so its top bits land in [SubBucketHalfCount, SubBucketCount)
+	const int32 Shift = static_cast<int32>(FMath::FloorLog2_64(Microseconds)) - (SubBucketBits - 1);
+	const int32 SubBucket = static_cast<int32>(Microseconds >> Shift) - SubBucketHalfCount;
+
+	return SubBucketCount + (Shift - 1) * SubBucketHalfCount + SubBucket;
+}
+
+/**
+ * @brief Returns the smallest latency of a bucket, in microseconds.
+ */
+uint64 FDustLinkLatencyHistogram::GetBucketLowerBound(const int32 Index)
+{
+	if (Index < SubBucketCount) return Index;
+
+	const int32 Shift = (Index - SubBucketCount) / SubBucketHalfCount + 1;
+	const int32 SubBucket = (Index - SubBucketCount) % SubBucketHalfCount + SubBucketHalfCount;
+
+	return static_cast<uint64>(SubBucket) << Shift;
+}
+
+/**
+ * @brief Returns the width of a bucket, in microseconds.
+ */
+uint64 FDustLinkLatencyHistogram::GetBucketWidth(const int32 Index)
+{
+	if (Index < SubBucketCount) return 1;
+
+	return uint64(1) << ((Index - SubBucketCount) / SubBucketHalfCount + 1);
+}
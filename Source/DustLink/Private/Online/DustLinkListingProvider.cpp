@@ -0,0 +1,147 @@
+// Copyright Dustbyte Software. All Rights Reserved.
+
+#include "DustLink/Public/Online/DustLinkListingProvider.h"
+
+#include "HttpModule.h"
+#include "GenericPlatform/GenericPlatformHttp.h"
+#include "Interfaces/IHttpRequest.h"
+#include "Interfaces/IHttpResponse.h"
+
+
+/**
+ * @brief Constructs a provider for the master server at the given base URL.
+ *
+ * @param InBaseUrl The base URL of the master server, e.g. "http://127.0.0.1:8810".
+ */
+FDustLinkHttpListingProvider::FDustLinkHttpListingProvider(const FString& InBaseUrl):
+	BaseUrl(InBaseUrl)
+{
+	BaseUrl.RemoveFromEnd(TEXT("/"));
+}
+
+/**
+ * @brief Registers the connect info of a hosted session under a join code.
+ *
+ * @param JoinCode The normalized join code.
+ * @param ConnectInfo The address clients travel to.
+ * @param Secret The secret of a previous registration of the code when renewing it, empty for a new code.
+ * @param OnComplete Called once the provider accepted or rejected the registration.
+ */
+void FDustLinkHttpListingProvider::RegisterJoinCode(const FString& JoinCode, const FString& ConnectInfo, const FString& Secret, const FDustLinkOnJoinCodeRegisterComplete& OnComplete)
+{
+	const TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = FHttpModule::Get().CreateRequest();
+	Request->SetURL(MakeCodeUrl(JoinCode, Secret));
+	Request->SetVerb(TEXT("PUT"));
+	Request->SetHeader(TEXT("Content-Type"), TEXT("text/plain"));
+	Request->SetContentAsString(ConnectInfo);
+
+	Request->OnProcessRequestComplete().BindLambda([OnComplete](FHttpRequestPtr, const FHttpResponsePtr Response, const bool bConnectedSuccessfully)
+	{
+		const int32 ResponseCode = bConnectedSuccessfully && Response.IsValid() ? Response->GetResponseCode() : 0;
+		const bool bWasSuccessful = EHttpResponseCodes::IsOk(ResponseCode);
+
+		OnComplete.ExecuteIfBound(bWasSuccessful, ResponseCode == EHttpResponseCodes::Conflict, bWasSuccessful ? Response->GetContentAsString() : FString());
+	});
+
+	Request->ProcessRequest();
+}
+
+/**
+ * @brief Removes a join code, e.g. when its session is destroyed.
+ *
+ * @param JoinCode The normalized join code.
+ * @param Secret The secret returned by the registration of the code.
+ */
+void FDustLinkHttpListingProvider::UnregisterJoinCode(const FString& JoinCode, const FString& Secret)
+{
+	const TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = FHttpModule::Get().CreateRequest();
+	Request->SetURL(MakeCodeUrl(JoinCode, Secret));
+	Request->SetVerb(TEXT("DELETE"));
+	Request->ProcessRequest();
+}
+
+/**
+ * @brief Resolves a join code to the connect info of its session.
+ *
+ * @param JoinCode The normalized join code.
+ * @param OnComplete Called with the connect info once the provider answered.
+ */
+void FDustLinkHttpListingProvider::ResolveJoinCode(const FString& JoinCode, const FDustLinkOnJoinCodeResolved& OnComplete)
+{
+	const TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = FHttpModule::Get().CreateRequest();
+	Request->SetURL(MakeCodeUrl(JoinCode));
+	Request->SetVerb(TEXT("GET"));
+
+	Request->OnProcessRequestComplete().BindLambda([OnComplete](FHttpRequestPtr, const FHttpResponsePtr Response, const bool bConnectedSuccessfully)
+	{
+		if (!bConnectedSuccessfully || !Response.IsValid() || !EHttpResponseCodes::IsOk(Response->GetResponseCode()))
+		{
+			OnComplete.ExecuteIfBound(FString(), false);
+			return;
+		}
+
+		const FString ConnectInfo = Response->GetContentAsString();
+		OnComplete.ExecuteIfBound(ConnectInfo, !ConnectInfo.IsEmpty());
+	});
+
+	Request->ProcessRequest();
+}
+
+/**
+ * @brief Builds the URL of a join code entry.
+ *
+ * @param JoinCode The normalized join code.
+ * @param Secret The secret of the registration, omitted if empty.
+ * @return The URL addressing the entry on the master server.
+ */
+FString FDustLinkHttpListingProvider::MakeCodeUrl(const FString& JoinCode, const FString& Secret) const
+{
+	FString Url = FString::Printf(TEXT("%s/codes?code=%s"), *BaseUrl, *FGenericPlatformHttp::UrlEncode(JoinCode));
+
+	if (!Secret.IsEmpty()) Url += TEXT("&secret=") + FGenericPlatformHttp::UrlEncode(Secret);
+
+	return Url;
+}
+
+/**
+ * @brief Generates a random join code from an alphabet without easily confused characters.
+ *
+ * @param Length The number of characters of the code.
+ * @return The generated code.
+ */
+FString DustLinkJoinCode::Generate(const int32 Length)
+{
+	static const TCHAR Alphabet[] = TEXT("ABCDEFGHJKLMNPQRSTUVWXYZ23456789");
+	constexpr int32 AlphabetSize = UE_ARRAY_COUNT(Alphabet) - 1;
+
+	FString JoinCode;
+	JoinCode.Reserve(Length);
+
+	for (int32 Index = 0; Index < Length; ++Index)
+	{
+		JoinCode.AppendChar(Alphabet[FMath::RandRange(0, AlphabetSize - 1)]);
+	}
+
+	return JoinCode;
+}
+
+/**
+ * @brief Normalizes a code entered by a player, dropping whitespace and dashes and upper-casing it.
+ *
+ * @param JoinCode The code as entered by the player.
+ * @return The normalized code.
+ */
+FString DustLinkJoinCode::Normalize(const FString& JoinCode)
+{
+	FString Normalized;
+	Normalized.Reserve(JoinCode.Len());
+
+	for (const TCHAR Character : JoinCode)
+	{
+		if (FChar::IsWhitespace(Character) || Character == TEXT('-')) continue;
+
+		Normalized.AppendChar(FChar::ToUpper(Character));
+	}
+
+	return Normalized;
+}
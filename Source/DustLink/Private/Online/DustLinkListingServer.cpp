@@ -0,0 +1,121 @@
+// Copyright Dustbyte Software. All Rights Reserved.
+
+#include "DustLink/Public/Online/DustLinkListingServer.h"
+
+#include "HttpPath.h"
+#include "HttpServerModule.h"
+#include "HttpServerRequest.h"
+#include "HttpServerResponse.h"
+#include "IHttpRouter.h"
+#include "Misc/Guid.h"
+#include "DustLink/Public/Online/DustLinkListingProvider.h"
+
+
+FDustLinkListingServer::~FDustLinkListingServer()
+{
+	Stop();
+}
+
+/**
+ * @brief Starts serving join codes on the given port.
+ *
+ * @param Port The local port to listen on.
+ * @return Returns `true` if the route was bound successfully.
+ */
+bool FDustLinkListingServer::Start(const uint32 Port)
+{
+	if (IsRunning()) return true;
+
+	Router = FHttpServerModule::Get().GetHttpRouter(Port);
+
+	if (!Router.IsValid())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("FDustLinkListingServer: Failed to bind port %u."), Port);
+		return false;
+	}
+
+	const EHttpServerRequestVerbs Verbs = EHttpServerRequestVerbs::VERB_GET | EHttpServerRequestVerbs::VERB_PUT | EHttpServerRequestVerbs::VERB_DELETE;
+
+	RouteHandle = Router->BindRoute(FHttpPath(TEXT("/codes")), Verbs, FHttpRequestHandler::CreateLambda([this](const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+	{
+		const TPair<int32, FString> Result = HandleRequest(Request);
+
+		TUniquePtr<FHttpServerResponse> Response = FHttpServerResponse::Create(Result.Value, TEXT("text/plain"));
+		Response->Code = static_cast<EHttpServerResponseCodes>(Result.Key);
+
+		OnComplete(MoveTemp(Response));
+		return true;
+	}));
+
+	FHttpServerModule::Get().StartAllListeners();
+
+	UE_LOG(LogTemp, Log, TEXT("FDustLinkListingServer: Serving join codes on port %u."), Port);
+	return RouteHandle.IsValid();
+}
+
+/**
+ * @brief Stops serving join codes and forgets all registered codes.
+ */
+void FDustLinkListingServer::Stop()
+{
+	if (Router.IsValid() && RouteHandle.IsValid()) Router->UnbindRoute(RouteHandle);
+
+	RouteHandle.Reset();
+	Router.Reset();
+	JoinCodes.Reset();
+}
+
+/**
+ * @brief Handles a request to the join code route.
+ *
+ * A new code is registered with a fresh secret, answered as body. Renewing or removing a code
+ * requires its secret, a taken code is refused with 409 and a removal without the secret with 403.
+ * Public so the protocol can be exercised without a socket.
+ *
+ * @param Request The incoming request.
+ * @return The response status and body to send back.
+ */
+TPair<int32, FString> FDustLinkListingServer::HandleRequest(const FHttpServerRequest& Request)
+{
+	const FString* Code = Request.QueryParams.Find(TEXT("code"));
+
+	if (!Code || Code->IsEmpty()) return { 400, TEXT("Missing code") };
+
+	const FString JoinCode = DustLinkJoinCode::Normalize(*Code);
+	const FString* Secret = Request.QueryParams.Find(TEXT("secret"));
+	const FRegistration* Existing = JoinCodes.Find(JoinCode);
+
+	// Connect info is handed to every client that resolves the code, only the secret proves the registering host
+	const bool bIsOwner = Existing && Secret && *Secret == Existing->Secret;
+
+	switch (Request.Verb)
+	{
+	case EHttpServerRequestVerbs::VERB_PUT:
+		{
+			FUTF8ToTCHAR Body(reinterpret_cast<const ANSICHAR*>(Request.Body.GetData()), Request.Body.Num());
+			const FString ConnectInfo(Body.Length(), Body.Get());
+
+			if (ConnectInfo.IsEmpty()) return { 400, TEXT("Missing connect info") };
+
+			if (Existing && !bIsOwner) return { 409, TEXT("Code is taken") };
+
+			const FString RegistrationSecret = Existing ? Existing->Secret : FGuid::NewGuid().ToString(EGuidFormats::Digits);
+
+			JoinCodes.Add(JoinCode, { ConnectInfo, RegistrationSecret });
+			return { 200, RegistrationSecret };
+		}
+
+	case EHttpServerRequestVerbs::VERB_DELETE:
+		if (!Existing) return { 200, FString() };
+
+		if (!bIsOwner) return { 403, TEXT("Code belongs to another host") };
+
+		JoinCodes.Remove(JoinCode);
+		return { 200, FString() };
+
+	default:
+		if (Existing) return { 200, Existing->ConnectInfo };
+
+		return { 404, TEXT("Unknown code") };
+	}
+}
@@ -0,0 +1,158 @@
+// Copyright Dustbyte Software. All Rights Reserved.
+
+#include "DustLink/Public/Online/DustLinkLoadMonitor.h"
+
+
+/**
+ * @brief Constructs the monitor with the given tuning parameters.
+ *
+ * @param InSettings The tuning parameters to use.
+ */
+FDustLinkLoadMonitor::FDustLinkLoadMonitor(const FDustLinkLoadSettings& InSettings):
+	Settings(InSettings)
+{
+}
+
+/**
+ * @brief Forgets all samples and the last advertisement.
+ */
+void FDustLinkLoadMonitor::Reset()
+{
+	SmoothedTickTimeMs = 0.f;
+	SmoothedCpuUsage = 0.f;
+	SmoothedBandwidthUsage = 0.f;
+	FrameTickTimeMsSum = 0.0;
+	FrameCpuUsageSum = 0.0;
+	NumFrames = 0;
+	bHasSamples = false;
+	LastAdvertisedLoad = INDEX_NONE;
+	LastAdvertiseTime = 0.0;
+}
+
+/**
+ * @brief Accumulates the work of one frame towards the next sample.
+ *
+ * @param TickTimeMs Game thread work of the frame, without idle time, in milliseconds.
+ * @param CpuUsage Fraction of the machine's CPU used by the process, in the range [0, 1].
+ */
+void FDustLinkLoadMonitor::AddFrame(const float TickTimeMs, const float CpuUsage)
+{
+	FrameTickTimeMsSum += FMath::Max(0.f, TickTimeMs);
+	FrameCpuUsageSum += FMath::Clamp(CpuUsage, 0.f, 1.f);
+	++NumFrames;
+}
+
+/**
+ * @brief Feeds the average of the frames accumulated since the last sample into the moving averages.
+ *
+ * Does nothing if no frame was accumulated.
+ *
+ * @param BandwidthUsage Fraction of the outgoing bandwidth budget in use, in the range [0, 1].
+ */
+void FDustLinkLoadMonitor::AddSampleFromFrames(const float BandwidthUsage)
+{
+	if (NumFrames == 0) return;
+
+	AddSample(static_cast<float>(FrameTickTimeMsSum / NumFrames), static_cast<float>(FrameCpuUsageSum / NumFrames), BandwidthUsage);
+
+	FrameTickTimeMsSum = 0.0;
+	FrameCpuUsageSum = 0.0;
+	NumFrames = 0;
+}
+
+/**
+ * @brief Feeds a sample into the moving averages.
+ *
+ * @param TickTimeMs Game thread work of the last frame, without idle time, in milliseconds.
+ * @param CpuUsage Fraction of the machine's CPU used by the process, in the range [0, 1].
+ * @param BandwidthUsage Fraction of the outgoing bandwidth budget in use, in the range [0, 1].
+ */
+void FDustLinkLoadMonitor::AddSample(const float TickTimeMs, const float CpuUsage, const float BandwidthUsage)
+{
+	// The first sample seeds the averages instead of being pulled towards zero
+	const float Alpha = bHasSamples ? Settings.SmoothingAlpha : 1.f;
+	bHasSamples = true;
+
+	SmoothedTickTimeMs = FMath::Lerp(SmoothedTickTimeMs, FMath::Max(0.f, TickTimeMs), Alpha);
+	SmoothedCpuUsage = FMath::Lerp(SmoothedCpuUsage, FMath::Clamp(CpuUsage, 0.f, 1.f), Alpha);
+	SmoothedBandwidthUsage = FMath::Lerp(SmoothedBandwidthUsage, FMath::Max(0.f, BandwidthUsage), Alpha);
+}
+
+/**
+ * @brief Returns the smoothed load in percent, where 100 means one of the resources is at its budget.
+ */
+int32 FDustLinkLoadMonitor::GetLoad() const
+{
+	const float TickUsage = SmoothedTickTimeMs / FMath::Max(Settings.TickBudgetMs, KINDA_SMALL_NUMBER);
+	const float Usage = FMath::Max3(TickUsage, SmoothedCpuUsage, SmoothedBandwidthUsage);
+
+	return FMath::Clamp(FMath::RoundToInt(Usage * 100.f), 0, 999);
+}
+
+/**
+ * @brief Returns `true` if the load changed enough since the last advertisement and the rate limit allows another one.
+ *
+ * @param Now The current time, in seconds.
+ */
+bool FDustLinkLoadMonitor::ShouldAdvertise(const double Now) const
+{
+	if (!bHasSamples) return false;
+
+	if (LastAdvertisedLoad == INDEX_NONE) return true;
+
+	if (Now - LastAdvertiseTime < Settings.MinAdvertiseInterval) return false;
+
+	return FMath::Abs(GetLoad() - LastAdvertisedLoad) >= Settings.AdvertiseThreshold;
+}
+
+/**
+ * @brief Records that the current load was advertised.
+ *
+ * @param Now The current time, in seconds.
+ */
+void FDustLinkLoadMonitor::MarkAdvertised(const double Now)
+{
+	LastAdvertisedLoad = GetLoad();
+	LastAdvertiseTime = Now;
+}
+
+/**
+ * @brief Reads the load a host advertised in its session settings.
+ *
+ * @param SessionSettings The settings of the session.
+ * @return The advertised load in percent, or `INDEX_NONE` if the host does not advertise it.
+ */
+int32 FDustLinkLoadMonitor::GetAdvertisedLoad(const FOnlineSessionSettings& SessionSettings)
+{
+	int32 Load = INDEX_NONE;
+
+	return SessionSettings.Get(FName("HostLoad"), Load) ? Load : INDEX_NONE;
+}
+
+/**
+ * @brief Orders search results by preference, lowest ping first with lightly loaded hosts ahead of overloaded ones.
+ *
+ * @param SessionResults The search results to sort in place.
+ * @param InSettings The penalties to apply.
+ */
+void FDustLinkLoadMonitor::RankSessions(TArray<FOnlineSessionSearchResult>& SessionResults, const FDustLinkLoadSettings& InSettings)
+{
+	auto GetCost = [&InSettings](const FOnlineSessionSearchResult& Result)
+	{
+		const int32 Load = GetAdvertisedLoad(Result.Session.SessionSettings);
+		float Cost = static_cast<float>(Result.PingInMs);
+
+		if (Load == INDEX_NONE) return Cost;
+
+		Cost += Load * InSettings.LoadPenaltyMs;
+
+		if (Load >= InSettings.OverloadedLoad) Cost += InSettings.OverloadPenaltyMs;
+
+		return Cost;
+	};
+
+	SessionResults.StableSort([&GetCost](const FOnlineSessionSearchResult& A, const FOnlineSessionSearchResult& B)
+	{
+		return GetCost(A) < GetCost(B);
+	});
+}
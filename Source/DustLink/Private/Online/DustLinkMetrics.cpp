@@ -0,0 +1,368 @@
+// Copyright Dustbyte Software. All Rights Reserved.
+
+#include "DustLink/Public/Online/DustLinkMetrics.h"
+
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonSerializer.h"
+
+
+namespace DustLinkMetrics
+{
+	/** Quantiles exported for every latency histogram. */
+	constexpr double Quantiles[] = { 0.5, 0.9, 0.99, 0.999 };
+
+	/**
+	 * @brief Appends a latency histogram as a Prometheus summary.
+	 *
+	 * @param Builder The exposition being written.
+	 * @param MetricName The name of the summary.
+	 * @param LabelName The label distinguishing the histograms of the summary.
+	 * @param LabelValue The label value of this histogram.
+	 * @param Latency The histogram to export.
+	 */
+	void AppendPrometheusSummary(FStringBuilderBase& Builder, const TCHAR* MetricName, const TCHAR* LabelName, const TCHAR* LabelValue, const FDustLinkLatencyHistogram& Latency)
+	{
+		for (const double Quantile : Quantiles)
+		{
+			Builder.Appendf(TEXT("%s{%s=\"%s\",quantile=\"%g\"} %.3f\n"), MetricName, LabelName, LabelValue, Quantile, Latency.GetPercentile(Quantile * 100.0));
+		}
+
+		Builder.Appendf(TEXT("%s_sum{%s=\"%s\"} %.3f\n"), MetricName, LabelName, LabelValue, Latency.GetSumMs());
+		Builder.Appendf(TEXT("%s_count{%s=\"%s\"} %llu\n"), MetricName, LabelName, LabelValue, Latency.GetCount());
+	}
+
+	/**
+	 * @brief Encodes the count, mean, maximum and percentiles of a latency histogram as a JSON object.
+	 *
+	 * @param Latency The histogram to encode.
+	 */
+	TSharedRef<FJsonObject> MakeJsonLatency(const FDustLinkLatencyHistogram& Latency)
+	{
+		const TSharedRef<FJsonObject> Object = MakeShared<FJsonObject>();
+		Object->SetNumberField(TEXT("Count"), Latency.GetCount());
+		Object->SetNumberField(TEXT("MeanMs"), Latency.GetMeanMs());
+		Object->SetNumberField(TEXT("MaxMs"), Latency.GetMaxMs());
+
+		for (const double Quantile : Quantiles)
+		{
+			Object->SetNumberField(FString::Printf(TEXT("P%gMs"), Quantile * 100.0), Latency.GetPercentile(Quantile * 100.0));
+		}
+
+		return Object;
+	}
+}
+
+/**
+ * @brief Formats the event on one line.
+ */
+FString FDustLinkTelemetryEvent::ToString() const
+{
+	const bool bIsOperation = Type == EDustLinkTelemetryEventType::OperationBegin || Type == EDustLinkTelemetryEventType::OperationEnd;
+	const bool bIsBegin = Type == EDustLinkTelemetryEventType::OperationBegin || Type == EDustLinkTelemetryEventType::PhaseBegin;
+
+	const TCHAR* TargetName = bIsOperation
+		? FDustLinkMetrics::GetOperationName(static_cast<EDustLinkSessionOperation>(Target))
+		: FDustLinkMetrics::GetPhaseName(static_cast<EDustLinkLatencyPhase>(Target));
+
+	if (bIsBegin) return FString::Printf(TEXT("%.3f %s %s begin"), Time, bIsOperation ? TEXT("operation") : TEXT("phase"), TargetName);
+
+	return FString::Printf(TEXT("%.3f %s %s %s %.2fms"), Time, bIsOperation ? TEXT("operation") : TEXT("phase"), TargetName,
+		bWasSuccessful ? TEXT("succeeded") : TEXT("failed"), LatencyMs);
+}
+
+/**
+ * @brief Counts a session operation as started and remembers when it started.
+ *
+ * @param Operation The operation that was issued.
+ */
+void FDustLinkMetrics::BeginOperation(const EDustLinkSessionOperation Operation)
+{
+	if (bIsSuspended) return;
+
+	FOperationMetrics& Metrics = Operations[static_cast<uint8>(Operation)];
+
+	Metrics.Started.fetch_add(1, std::memory_order_relaxed);
+	Metrics.StartTime = FPlatformTime::Seconds();
+
+	EmitEvent(EDustLinkTelemetryEventType::OperationBegin, static_cast<uint8>(Operation), false, -1.0);
+}
+
+/**
+ * @brief Counts a session operation as finished and records its latency if its start is known.
+ *
+ * @param Operation The operation that completed.
+ * @param bWasSuccessful Whether the operation succeeded.
+ */
+void FDustLinkMetrics::EndOperation(const EDustLinkSessionOperation Operation, const bool bWasSuccessful)
+{
+	if (bIsSuspended) return;
+
+	FOperationMetrics& Metrics = Operations[static_cast<uint8>(Operation)];
+
+	(bWasSuccessful ? Metrics.Succeeded : Metrics.Failed).fetch_add(1, std::memory_order_relaxed);
+
+	double LatencyMs = -1.0;
+
+	if (Metrics.StartTime > 0.0)
+	{
+		LatencyMs = (FPlatformTime::Seconds() - Metrics.StartTime) * 1000.0;
+		Metrics.Latency.Record(LatencyMs);
+		Metrics.StartTime = 0.0;
+	}
+
+	EmitEvent(EDustLinkTelemetryEventType::OperationEnd, static_cast<uint8>(Operation), bWasSuccessful, LatencyMs);
+}
+
+/**
+ * @brief Remembers when a phase started, restarting it if it was already running.
+ *
+ * @param Phase The phase that started.
+ */
+void FDustLinkMetrics::BeginPhase(const EDustLinkLatencyPhase Phase)
+{
+	if (bIsSuspended) return;
+
+	PhaseStartTimes[static_cast<uint8>(Phase)] = FPlatformTime::Seconds();
+
+	EmitEvent(EDustLinkTelemetryEventType::PhaseBegin, static_cast<uint8>(Phase), false, -1.0);
+}
+
+/**
+ * @brief Records the duration of a phase if it is running.
+ *
+ * @param Phase The phase that ended.
+ * @param bWasSuccessful Whether the phase reached its goal, only successful phases are recorded.
+ */
+void FDustLinkMetrics::EndPhase(const EDustLinkLatencyPhase Phase, const bool bWasSuccessful)
+{
+	if (bIsSuspended) return;
+
+	double& StartTime = PhaseStartTimes[static_cast<uint8>(Phase)];
+
+	if (StartTime <= 0.0) return;
+
+	const double LatencyMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+	StartTime = 0.0;
+
+	if (bWasSuccessful) Phases[static_cast<uint8>(Phase)].Record(LatencyMs);
+
+	EmitEvent(EDustLinkTelemetryEventType::PhaseEnd, static_cast<uint8>(Phase), bWasSuccessful, LatencyMs);
+}
+
+/**
+ * @brief Forgets all recorded latencies, keeping the counters.
+ */
+void FDustLinkMetrics::ResetLatencies()
+{
+	for (FOperationMetrics& Operation : Operations) Operation.Latency.Reset();
+	for (FDustLinkLatencyHistogram& Phase : Phases) Phase.Reset();
+}
+
+/**
+ * @brief Stops or resumes recording operations and phases, e.g. while a soak run floods the session lifecycle.
+ *
+ * No counters, latencies or telemetry events are recorded while suspended. Running operations and phases
+ * are forgotten on suspension, so none of them straddles the pause.
+ *
+ * @param bInSuspended Whether recording stops.
+ */
+void FDustLinkMetrics::SetSuspended(const bool bInSuspended)
+{
+	bIsSuspended = bInSuspended;
+
+	if (!bIsSuspended) return;
+
+	for (FOperationMetrics& Operation : Operations) Operation.StartTime = 0.0;
+	for (double& StartTime : PhaseStartTimes) StartTime = 0.0;
+}
+
+/**
+ * @brief Formats the latency percentiles of every operation and phase that recorded something.
+ */
+FString FDustLinkMetrics::ToLatencyReport() const
+{
+	TStringBuilder<2048> Builder;
+
+	for (uint8 Index = 0; Index < static_cast<uint8>(EDustLinkSessionOperation::Num); ++Index)
+	{
+		const EDustLinkSessionOperation Operation = static_cast<EDustLinkSessionOperation>(Index);
+
+		if (GetLatency(Operation).GetCount() == 0) continue;
+
+		Builder.Appendf(TEXT("operation %-8s %s\n"), GetOperationName(Operation), *GetLatency(Operation).ToSummaryString());
+	}
+
+	for (uint8 Index = 0; Index < static_cast<uint8>(EDustLinkLatencyPhase::Num); ++Index)
+	{
+		const EDustLinkLatencyPhase Phase = static_cast<EDustLinkLatencyPhase>(Index);
+
+		if (GetLatency(Phase).GetCount() == 0) continue;
+
+		Builder.Appendf(TEXT("phase     %-8s %s\n"), GetPhaseName(Phase), *GetLatency(Phase).ToSummaryString());
+	}
+
+	return Builder.Len() > 0 ? FString(Builder.ToView()) : FString(TEXT("No latencies recorded.\n"));
+}
+
+/**
+ * @brief Encodes all metrics in the Prometheus text exposition format.
+ */
+FString FDustLinkMetrics::ToPrometheus() const
+{
+	constexpr uint8 NumOperations = static_cast<uint8>(EDustLinkSessionOperation::Num);
+	TStringBuilder<4096> Builder;
+
+	Builder << TEXT("# HELP dustlink_session_operations_total Session operations by outcome.\n");
+	Builder << TEXT("# TYPE dustlink_session_operations_total counter\n");
+
+	for (uint8 Index = 0; Index < NumOperations; ++Index)
+	{
+		const EDustLinkSessionOperation Operation = static_cast<EDustLinkSessionOperation>(Index);
+		const TCHAR* Name = GetOperationName(Operation);
+
+		Builder.Appendf(TEXT("dustlink_session_operations_total{operation=\"%s\",result=\"started\"} %llu\n"), Name, GetNumStarted(Operation));
+		Builder.Appendf(TEXT("dustlink_session_operations_total{operation=\"%s\",result=\"succeeded\"} %llu\n"), Name, GetNumSucceeded(Operation));
+		Builder.Appendf(TEXT("dustlink_session_operations_total{operation=\"%s\",result=\"failed\"} %llu\n"), Name, GetNumFailed(Operation));
+	}
+
+	Builder << TEXT("# HELP dustlink_session_operation_latency_ms Time from issuing a session operation to its completion.\n");
+	Builder << TEXT("# TYPE dustlink_session_operation_latency_ms summary\n");
+
+	for (uint8 Index = 0; Index < NumOperations; ++Index)
+	{
+		const EDustLinkSessionOperation Operation = static_cast<EDustLinkSessionOperation>(Index);
+
+		DustLinkMetrics::AppendPrometheusSummary(Builder, TEXT("dustlink_session_operation_latency_ms"), TEXT("operation"), GetOperationName(Operation), GetLatency(Operation));
+	}
+
+	Builder << TEXT("# HELP dustlink_phase_latency_ms Time players spend in each phase of getting into a match.\n");
+	Builder << TEXT("# TYPE dustlink_phase_latency_ms summary\n");
+
+	for (uint8 Index = 0; Index < static_cast<uint8>(EDustLinkLatencyPhase::Num); ++Index)
+	{
+		const EDustLinkLatencyPhase Phase = static_cast<EDustLinkLatencyPhase>(Index);
+
+		DustLinkMetrics::AppendPrometheusSummary(Builder, TEXT("dustlink_phase_latency_ms"), TEXT("phase"), GetPhaseName(Phase), GetLatency(Phase));
+	}
+
+	for (uint8 Index = 0; Index < static_cast<uint8>(EDustLinkGauge::Num); ++Index)
+	{
+		const EDustLinkGauge Gauge = static_cast<EDustLinkGauge>(Index);
+
+		Builder.Appendf(TEXT("# TYPE dustlink_%s gauge\ndustlink_%s %lld\n"), GetGaugeName(Gauge), GetGaugeName(Gauge), GetGauge(Gauge));
+	}
+
+	return FString(Builder.ToView());
+}
+
+/**
+ * @brief Encodes all metrics as a JSON object.
+ */
+FString FDustLinkMetrics::ToJson() const
+{
+	FString Json;
+	FJsonSerializer::Serialize(ToJsonObject(), TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Json));
+
+	return Json;
+}
+
+/**
+ * @brief Returns all metrics as a JSON object, e.g. to embed them in a larger document.
+ */
+TSharedRef<FJsonObject> FDustLinkMetrics::ToJsonObject() const
+{
+	const TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+	const TSharedRef<FJsonObject> OperationsObject = MakeShared<FJsonObject>();
+
+	for (uint8 Index = 0; Index < static_cast<uint8>(EDustLinkSessionOperation::Num); ++Index)
+	{
+		const EDustLinkSessionOperation Operation = static_cast<EDustLinkSessionOperation>(Index);
+		const FDustLinkLatencyHistogram& Latency = GetLatency(Operation);
+
+		const TSharedRef<FJsonObject> OperationObject = MakeShared<FJsonObject>();
+		OperationObject->SetNumberField(TEXT("Started"), GetNumStarted(Operation));
+		OperationObject->SetNumberField(TEXT("Succeeded"), GetNumSucceeded(Operation));
+		OperationObject->SetNumberField(TEXT("Failed"), GetNumFailed(Operation));
+		OperationObject->SetObjectField(TEXT("Latency"), DustLinkMetrics::MakeJsonLatency(Latency));
+		OperationsObject->SetObjectField(GetOperationName(Operation), OperationObject);
+	}
+
+	Root->SetObjectField(TEXT("Operations"), OperationsObject);
+
+	const TSharedRef<FJsonObject> PhasesObject = MakeShared<FJsonObject>();
+
+	for (uint8 Index = 0; Index < static_cast<uint8>(EDustLinkLatencyPhase::Num); ++Index)
+	{
+		const EDustLinkLatencyPhase Phase = static_cast<EDustLinkLatencyPhase>(Index);
+		PhasesObject->SetObjectField(GetPhaseName(Phase), DustLinkMetrics::MakeJsonLatency(GetLatency(Phase)));
+	}
+
+	Root->SetObjectField(TEXT("Phases"), PhasesObject);
+
+	const TSharedRef<FJsonObject> GaugesObject = MakeShared<FJsonObject>();
+
+	for (uint8 Index = 0; Index < static_cast<uint8>(EDustLinkGauge::Num); ++Index)
+	{
+		const EDustLinkGauge Gauge = static_cast<EDustLinkGauge>(Index);
+		GaugesObject->SetNumberField(GetGaugeName(Gauge), GetGauge(Gauge));
+	}
+
+	Root->SetObjectField(TEXT("Gauges"), GaugesObject);
+
+	return Root;
+}
+
+/**
+ * @brief Returns the lower case name of an operation, as used in metric labels.
+ */
+const TCHAR* FDustLinkMetrics::GetOperationName(const EDustLinkSessionOperation Operation)
+{
+	static const TCHAR* Names[] = { TEXT("create"), TEXT("find"), TEXT("join"), TEXT("destroy"), TEXT("start"), TEXT("end"), TEXT("update") };
+	static_assert(UE_ARRAY_COUNT(Names) == static_cast<uint8>(EDustLinkSessionOperation::Num), "Every operation needs a name.");
+
+	return Names[static_cast<uint8>(Operation)];
+}
+
+/**
+ * @brief Returns the lower case name of a phase, as used in metric labels.
+ */
+const TCHAR* FDustLinkMetrics::GetPhaseName(const EDustLinkLatencyPhase Phase)
+{
+	static const TCHAR* Names[] = { TEXT("search"), TEXT("join"), TEXT("travel"), TEXT("load") };
+	static_assert(UE_ARRAY_COUNT(Names) == static_cast<uint8>(EDustLinkLatencyPhase::Num), "Every phase needs a name.");
+
+	return Names[static_cast<uint8>(Phase)];
+}
+
+/**
+ * @brief Returns the snake case name of a gauge, as used in metric names.
+ */
+const TCHAR* FDustLinkMetrics::GetGaugeName(const EDustLinkGauge Gauge)
+{
+	static const TCHAR* Names[] = { TEXT("players"), TEXT("host_load_percent"), TEXT("admitting"), TEXT("ping_probes_in_flight"), TEXT("friend_queries_queued"), TEXT("friend_queries_in_flight") };
+	static_assert(UE_ARRAY_COUNT(Names) == static_cast<uint8>(EDustLinkGauge::Num), "Every gauge needs a name.");
+
+	return Names[static_cast<uint8>(Gauge)];
+}
+
+/**
+ * @brief Broadcasts a telemetry event if anyone listens.
+ *
+ * @param Type The kind of the event.
+ * @param Target The operation or phase of the event.
+ * @param bWasSuccessful Whether the operation or phase succeeded.
+ * @param LatencyMs The duration of the operation or phase, negative if unknown.
+ */
+void FDustLinkMetrics::EmitEvent(const EDustLinkTelemetryEventType Type, const uint8 Target, const bool bWasSuccessful, const double LatencyMs) const
+{
+	if (!OnTelemetryEvent.IsBound()) return;
+
+	FDustLinkTelemetryEvent Event;
+	Event.Time = FPlatformTime::Seconds();
+	Event.Type = Type;
+	Event.Target = Target;
+	Event.bWasSuccessful = bWasSuccessful;
+	Event.LatencyMs = LatencyMs;
+
+	OnTelemetryEvent.Broadcast(Event);
+}
@@ -0,0 +1,104 @@
+// Copyright Dustbyte Software. All Rights Reserved.
+
+#include "DustLink/Public/Online/DustLinkMetricsServer.h"
+
+#include "HttpPath.h"
+#include "HttpServerModule.h"
+#include "HttpServerRequest.h"
+#include "HttpServerResponse.h"
+#include "IHttpRouter.h"
+#include "IPAddress.h"
+
+
+/**
+ * @brief Constructs the server for the given metrics.
+ *
+ * @param InMetrics The metrics to serve.
+ */
+FDustLinkMetricsServer::FDustLinkMetricsServer(const TSharedRef<const FDustLinkMetrics>& InMetrics):
+	Metrics(InMetrics)
+{
+}
+
+FDustLinkMetricsServer::~FDustLinkMetricsServer()
+{
+	Stop();
+}
+
+/**
+ * @brief Starts serving the metrics routes on the given port.
+ *
+ * @param Port The local port to listen on.
+ * @return Returns `true` if the routes were bound successfully.
+ */
+bool FDustLinkMetricsServer::Start(const uint32 Port)
+{
+	if (IsRunning()) return true;
+
+	Router = FHttpServerModule::Get().GetHttpRouter(Port);
+
+	if (!Router.IsValid())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("FDustLinkMetricsServer: Failed to bind port %u."), Port);
+		return false;
+	}
+
+	const auto BindMetricsRoute = [this](const TCHAR* Path, const bool bIsJson)
+	{
+		return Router->BindRoute(FHttpPath(Path), EHttpServerRequestVerbs::VERB_GET, FHttpRequestHandler::CreateLambda([this, bIsJson](const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+		{
+			if (!IsLocalRequest(Request))
+			{
+				TUniquePtr<FHttpServerResponse> Response = FHttpServerResponse::Create(TEXT("Metrics are only served locally"), TEXT("text/plain"));
+				Response->Code = EHttpServerResponseCodes::Forbidden;
+				OnComplete(MoveTemp(Response));
+				return true;
+			}
+
+			OnMetricsRequested.ExecuteIfBound();
+
+			OnComplete(bIsJson
+				? FHttpServerResponse::Create(Metrics->ToJson(), TEXT("application/json"))
+				: FHttpServerResponse::Create(Metrics->ToPrometheus(), TEXT("text/plain; version=0.0.4")));
+			return true;
+		}));
+	};
+
+	PrometheusRouteHandle = BindMetricsRoute(TEXT("/metrics"), false);
+	JsonRouteHandle = BindMetricsRoute(TEXT("/metrics/json"), true);
+
+	FHttpServerModule::Get().StartAllListeners();
+
+	UE_LOG(LogTemp, Log, TEXT("FDustLinkMetricsServer: Serving metrics on port %u."), Port);
+	return PrometheusRouteHandle.IsValid() && JsonRouteHandle.IsValid();
+}
+
+/**
+ * @brief Stops serving the metrics routes.
+ */
+void FDustLinkMetricsServer::Stop()
+{
+	if (Router.IsValid())
+	{
+		if (PrometheusRouteHandle.IsValid()) Router->UnbindRoute(PrometheusRouteHandle);
+		if (JsonRouteHandle.IsValid()) Router->UnbindRoute(JsonRouteHandle);
+	}
+
+	PrometheusRouteHandle.Reset();
+	JsonRouteHandle.Reset();
+	Router.Reset();
+}
+
+/**
+ * @brief Returns `true` if the request was sent from this machine.
+ *
+ * @param Request The incoming request.
+ */
+bool FDustLinkMetricsServer::IsLocalRequest(const FHttpServerRequest& Request)
+{
+	if (!Request.PeerAddress.IsValid()) return false;
+
+	const FString Address = Request.PeerAddress->ToString(false);
+
+	return Address.StartsWith(TEXT("127.")) || Address == TEXT("::1") || Address.StartsWith(TEXT("::ffff:127."));
+}
@@ -0,0 +1,242 @@
+// Copyright Dustbyte Software. All Rights Reserved.
+
+#include "DustLink/Public/Online/DustLinkNetworkProfile.h"
+
+#include "Engine/NetConnection.h"
+#include "Engine/NetDriver.h"
+
+
+/**
+ * @brief Applies lag, loss and bandwidth cap to a net driver and its open connections.
+ *
+ * @param NetDriver The net driver to configure.
+ * @param UserConditions The lag and loss the net driver was created with, restored by profiles without lag and loss.
+ */
+void FDustLinkNetworkProfile::ApplyToNetDriver(UNetDriver* NetDriver, const FDustLinkNetworkProfile& UserConditions) const
+{
+	if (!NetDriver) return;
+
+#if DO_ENABLE_NET_TEST
+	const FDustLinkNetworkProfile& Conditions = HasPacketSimulation() ? *this : UserConditions;
+
+	// Only lag and loss are emulated, duplication, reordering and the rest stay as the user configured them
+	FPacketSimulationSettings Settings = NetDriver->PacketSimulationSettings;
+	Settings.PktLag = Conditions.PktLag;
+	Settings.PktLagVariance = Conditions.PktLagVariance;
+	Settings.PktLoss = Conditions.PktLoss;
+	NetDriver->SetPacketSimulationSettings(Settings);
+#else
+	if (HasPacketSimulation())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("FDustLinkNetworkProfile: Packet simulation is compiled out, only the bandwidth cap of %s applies."), *Name);
+	}
+#endif
+
+	// An uncapped profile restores the rates the net driver class is configured with
+	const UNetDriver* Defaults = GetDefault<UNetDriver>(NetDriver->GetClass());
+
+	NetDriver->MaxClientRate = MaxBandwidth > 0 ? MaxBandwidth : Defaults->MaxClientRate;
+	NetDriver->MaxInternetClientRate = MaxBandwidth > 0 ? MaxBandwidth : Defaults->MaxInternetClientRate;
+
+	if (NetDriver->ServerConnection && MaxBandwidth > 0)
+	{
+		NetDriver->ServerConnection->CurrentNetSpeed = FMath::Min(NetDriver->ServerConnection->CurrentNetSpeed, MaxBandwidth);
+	}
+
+	for (UNetConnection* Connection : NetDriver->ClientConnections)
+	{
+		if (Connection) Connection->CurrentNetSpeed = NetDriver->MaxInternetClientRate;
+	}
+}
+
+/**
+ * @brief Returns the lag and loss a net driver currently simulates, none in builds without `DO_ENABLE_NET_TEST`.
+ *
+ * @param NetDriver The net driver to read.
+ */
+FDustLinkNetworkProfile FDustLinkNetworkProfile::FromNetDriver(const UNetDriver* NetDriver)
+{
+	FDustLinkNetworkProfile Conditions;
+	Conditions.Name = TEXT("User");
+
+#if DO_ENABLE_NET_TEST
+	if (NetDriver)
+	{
+		Conditions.PktLag = NetDriver->PacketSimulationSettings.PktLag;
+		Conditions.PktLagVariance = NetDriver->PacketSimulationSettings.PktLagVariance;
+		Conditions.PktLoss = NetDriver->PacketSimulationSettings.PktLoss;
+	}
+#endif
+
+	return Conditions;
+}
+
+/**
+ * @brief Draws the delay of one backend answer, in seconds.
+ *
+ * @param PayloadBytes Approximate size of the answer, used with the bandwidth cap.
+ */
+float FDustLinkNetworkProfile::SampleBackendDelay(const int32 PayloadBytes) const
+{
+	// A request and its answer each cross the link once
+	const float LagMs = 2.f * FMath::Max(0.f, PktLag + FMath::FRandRange(-1.f, 1.f) * PktLagVariance);
+	const float TransferSeconds = MaxBandwidth > 0 ? static_cast<float>(PayloadBytes) / MaxBandwidth : 0.f;
+
+	return LagMs / 1000.f + TransferSeconds;
+}
+
+/**
+ * @brief Draws whether one backend answer is lost.
+ */
+bool FDustLinkNetworkProfile::SampleBackendLoss() const
+{
+	return PktLoss > 0 && FMath::RandRange(0, 99) < PktLoss;
+}
+
+/**
+ * @brief Formats the conditions of the profile on one line.
+ */
+FString FDustLinkNetworkProfile::ToString() const
+{
+	return FString::Printf(TEXT("%s: lag %d ms +/- %d ms, loss %d%%, bandwidth %s"), *Name, PktLag, PktLagVariance, PktLoss,
+		MaxBandwidth > 0 ? *FString::Printf(TEXT("%d B/s"), MaxBandwidth) : TEXT("uncapped"));
+}
+
+/**
+ * @brief Returns the built-in profiles, from ideal to poor links.
+ */
+const TArray<FDustLinkNetworkProfile>& FDustLinkNetworkProfile::GetBuiltInProfiles()
+{
+	static const TArray<FDustLinkNetworkProfile> Profiles
+	{
+		{ TEXT("Loopback"), 0, 0, 0, 0 },
+		{ TEXT("Lan"), 2, 1, 0, 0 },
+		{ TEXT("Broadband"), 30, 10, 1, 0 },
+		{ TEXT("Wifi"), 60, 30, 2, 250000 },
+		{ TEXT("Mobile"), 120, 50, 3, 100000 },
+		{ TEXT("Degraded"), 250, 100, 8, 32000 }
+	};
+
+	return Profiles;
+}
+
+/**
+ * @brief Finds a built-in profile by name, ignoring case.
+ *
+ * @param InName The name of the profile.
+ * @return The profile, or `nullptr` if no profile has this name.
+ */
+const FDustLinkNetworkProfile* FDustLinkNetworkProfile::Find(const FString& InName)
+{
+	return GetBuiltInProfiles().FindByPredicate([&InName](const FDustLinkNetworkProfile& Profile) { return Profile.Name.Equals(InName, ESearchCase::IgnoreCase); });
+}
+
+/**
+ * @brief Records later phase latencies under a profile, replacing an earlier run of it.
+ *
+ * @param ProfileName The profile that is emulated from now on.
+ */
+void FDustLinkNetworkBenchmark::SetProfile(const FString& ProfileName)
+{
+	const TUniquePtr<FRun>* Existing = Runs.FindByPredicate([&ProfileName](const TUniquePtr<FRun>& Run) { return Run->ProfileName == ProfileName; });
+
+	if (!Existing)
+	{
+		Existing = &Runs.Add_GetRef(MakeUnique<FRun>());
+		(*Existing)->ProfileName = ProfileName;
+	}
+
+	CurrentRun = Existing->Get();
+
+	for (FDustLinkLatencyHistogram& Latency : CurrentRun->Phases) Latency.Reset();
+}
+
+/**
+ * @brief Records the latency of a finished phase under the current profile.
+ *
+ * @param Phase The phase that ended.
+ * @param bWasSuccessful Whether the phase reached its goal, only successful phases are recorded.
+ * @param LatencyMs The duration of the phase, in milliseconds.
+ */
+void FDustLinkNetworkBenchmark::RecordPhase(const EDustLinkLatencyPhase Phase, const bool bWasSuccessful, const double LatencyMs)
+{
+	if (!CurrentRun || !bWasSuccessful || LatencyMs < 0.0 || Phase >= EDustLinkLatencyPhase::Num) return;
+
+	CurrentRun->Phases[static_cast<uint8>(Phase)].Record(LatencyMs);
+}
+
+/**
+ * @brief Forgets all runs, including the samples of the current profile.
+ */
+void FDustLinkNetworkBenchmark::Reset()
+{
+	const FString CurrentProfileName = CurrentRun ? CurrentRun->ProfileName : FString();
+
+	Runs.Reset();
+	CurrentRun = nullptr;
+
+	if (!CurrentProfileName.IsEmpty()) SetProfile(CurrentProfileName);
+}
+
+/**
+ * @brief Returns `true` if any phase recorded a latency.
+ */
+bool FDustLinkNetworkBenchmark::FRun::HasSamples() const
+{
+	for (const FDustLinkLatencyHistogram& Latency : Phases)
+	{
+		if (Latency.GetCount() > 0) return true;
+	}
+
+	return false;
+}
+
+/**
+ * @brief Formats the p50 and p95 of every phase per profile and their ratio to the baseline.
+ */
+FString FDustLinkNetworkBenchmark::ToReport() const
+{
+	TArray<const FRun*> Recorded;
+
+	for (const TUniquePtr<FRun>& Run : Runs)
+	{
+		if (Run->HasSamples()) Recorded.Add(Run.Get());
+	}
+
+	if (Recorded.IsEmpty()) return TEXT("No network profile runs recorded.");
+
+	TStringBuilder<2048> Builder;
+	Builder.Appendf(TEXT("Baseline: %s\n"), *Recorded[0]->ProfileName);
+
+	for (uint8 Index = 0; Index < static_cast<uint8>(EDustLinkLatencyPhase::Num); ++Index)
+	{
+		const FDustLinkLatencyHistogram& Baseline = Recorded[0]->Phases[Index];
+
+		Builder.Appendf(TEXT("%s\n"), FDustLinkMetrics::GetPhaseName(static_cast<EDustLinkLatencyPhase>(Index)));
+
+		for (const FRun* Run : Recorded)
+		{
+			const FDustLinkLatencyHistogram& Phase = Run->Phases[Index];
+
+			if (Phase.GetCount() == 0)
+			{
+				Builder.Appendf(TEXT("  %-10s no samples\n"), *Run->ProfileName);
+				continue;
+			}
+
+			const double P50 = Phase.GetPercentile(50.0);
+			const double P95 = Phase.GetPercentile(95.0);
+
+			Builder.Appendf(TEXT("  %-10s n=%-6llu p50 %8.1f ms  p95 %8.1f ms"), *Run->ProfileName, Phase.GetCount(), P50, P95);
+
+			if (Run != Recorded[0] && Baseline.GetCount() > 0 && Baseline.GetPercentile(50.0) > 0.0 && Baseline.GetPercentile(95.0) > 0.0)
+			{
+				Builder.Appendf(TEXT("  (p50 x%.2f, p95 x%.2f)"), P50 / Baseline.GetPercentile(50.0), P95 / Baseline.GetPercentile(95.0));
+			}
+
+			Builder.Append(TEXT("\n"));
+		}
+	}
+
+	return FString(Builder.ToView());
+}
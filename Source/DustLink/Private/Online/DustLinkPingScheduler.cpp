@@ -0,0 +1,112 @@
+// Copyright Dustbyte Software. All Rights Reserved.
+
+#include "DustLink/Public/Online/DustLinkPingScheduler.h"
+
+
+/**
+ * @brief Updates the set of sessions eligible for probing.
+ *
+ * @param VisibleSessionIds The sessions currently displayed by the server browser.
+ * @param SessionOrder All sessions of the current result store, in display order, used to pick the lookahead.
+ */
+void FDustLinkPingScheduler::SetVisibleSessions(const TArray<FString>& VisibleSessionIds, const TArray<FString>& SessionOrder)
+{
+	Candidates.Reset(VisibleSessionIds.Num() + Settings.Lookahead);
+
+	int32 LastVisibleIndex = INDEX_NONE;
+
+	for (const FString& SessionId : VisibleSessionIds)
+	{
+		AddCandidate(SessionId);
+		LastVisibleIndex = FMath::Max(LastVisibleIndex, SessionOrder.IndexOfByPredicate([&SessionId](const FString& OrderedId)
+		{
+			return FDustLinkSessionIdKeyFuncs::Matches(OrderedId, SessionId);
+		}));
+	}
+
+	if (LastVisibleIndex == INDEX_NONE) return;
+
+	const int32 LastLookaheadIndex = FMath::Min(SessionOrder.Num() - 1, LastVisibleIndex + Settings.Lookahead);
+
+	for (int32 Index = LastVisibleIndex + 1; Index <= LastLookaheadIndex; ++Index)
+	{
+		AddCandidate(SessionOrder[Index]);
+	}
+}
+
+/**
+ * @brief Returns the sessions that should be probed now and marks them as in flight.
+ *
+ * @param Now The current time, in seconds.
+ * @return The sessions to probe, limited by the free concurrency slots.
+ */
+TArray<FString> FDustLinkPingScheduler::CollectDueProbes(const double Now)
+{
+	TArray<FString> DueProbes;
+
+	for (const FString& SessionId : Candidates)
+	{
+		if (InFlightProbes.Num() >= Settings.MaxConcurrentProbes) break;
+
+		if (InFlightProbes.Contains(SessionId) || UnpingableSessions.Contains(SessionId)) continue;
+
+		if (const double* LastProbeTime = LastProbeTimes.Find(SessionId); LastProbeTime && Now - *LastProbeTime < Settings.ReprobeInterval) continue;
+
+		LastProbeTimes.Add(SessionId, Now);
+		InFlightProbes.Add(SessionId);
+		DueProbes.Add(SessionId);
+	}
+
+	return DueProbes;
+}
+
+/**
+ * @brief Marks a probe as finished, freeing its concurrency slot.
+ *
+ * @param SessionId The session whose probe finished.
+ */
+void FDustLinkPingScheduler::OnProbeComplete(const FString& SessionId)
+{
+	InFlightProbes.Remove(SessionId);
+}
+
+/**
+ * @brief Forgets the probing state of sessions that left the result store.
+ *
+ * @param SessionIds The sessions to forget.
+ */
+void FDustLinkPingScheduler::Forget(const TArray<FString>& SessionIds)
+{
+	for (const FString& SessionId : SessionIds)
+	{
+		Candidates.RemoveAll([&SessionId](const FString& Candidate) { return FDustLinkSessionIdKeyFuncs::Matches(Candidate, SessionId); });
+		LastProbeTimes.Remove(SessionId);
+		UnpingableSessions.Remove(SessionId);
+	}
+}
+
+/**
+ * @brief Stops probing and forgets all probing state.
+ */
+void FDustLinkPingScheduler::Reset()
+{
+	Candidates.Reset();
+	LastProbeTimes.Reset();
+	InFlightProbes.Reset();
+	UnpingableSessions.Reset();
+}
+
+/**
+ * @brief Appends a session to the candidates unless it is already one, comparing identifiers case-sensitively.
+ *
+ * @param SessionId The session to probe.
+ */
+void FDustLinkPingScheduler::AddCandidate(const FString& SessionId)
+{
+	const bool bIsCandidate = Candidates.ContainsByPredicate([&SessionId](const FString& Candidate)
+	{
+		return FDustLinkSessionIdKeyFuncs::Matches(Candidate, SessionId);
+	});
+
+	if (!bIsCandidate) Candidates.Add(SessionId);
+}
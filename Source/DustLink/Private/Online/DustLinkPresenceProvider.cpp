@@ -0,0 +1,343 @@
+// Copyright Dustbyte Software. All Rights Reserved.
+
+#include "DustLink/Public/Online/DustLinkPresenceProvider.h"
+
+#include "OnlineSubsystem.h"
+#include "OnlineSubsystemTypes.h"
+#include "Dom/JsonObject.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Interfaces/OnlineFriendsInterface.h"
+#include "Interfaces/OnlinePresenceInterface.h"
+
+
+namespace DustLinkPresence
+{
+	/** Approximate wire size of one friend entry, in bytes. */
+	constexpr int32 FriendPayloadBytes { 128 };
+
+	/**
+	 * @class FMockSessionInfo
+	 * @brief Session info of a fake session, valid so results are told apart by their session identifier.
+	 */
+	class FMockSessionInfo : public FOnlineSessionInfo
+	{
+	public:
+		explicit FMockSessionInfo(const FString& InSessionId):
+			SessionId(FUniqueNetIdString::Create(InSessionId, FName(TEXT("DustLinkMock"))))
+		{
+		}
+
+		virtual const uint8* GetBytes() const override { return nullptr; }
+		virtual int32 GetSize() const override { return 0; }
+		virtual bool IsValid() const override { return true; }
+		virtual const FUniqueNetId& GetSessionId() const override { return *SessionId; }
+		virtual FString ToString() const override { return SessionId->ToString(); }
+		virtual FString ToDebugString() const override { return FString::Printf(TEXT("Mock session %s"), *SessionId->ToString()); }
+
+	private:
+		/** Identifier derived from the host's name. */
+		FUniqueNetIdRef SessionId;
+	};
+}
+
+/**
+ * @brief Constructs a provider for the given online subsystem.
+ *
+ * @param InSubsystem The online subsystem to query.
+ */
+FDustLinkOnlinePresenceProvider::FDustLinkOnlinePresenceProvider(IOnlineSubsystem* InSubsystem):
+	Subsystem(InSubsystem)
+{
+}
+
+FDustLinkOnlinePresenceProvider::~FDustLinkOnlinePresenceProvider()
+{
+	const IOnlineSessionPtr SessionInterface = Subsystem ? Subsystem->GetSessionInterface() : nullptr;
+
+	if (!SessionInterface.IsValid()) return;
+
+	for (TPair<int32, FDelegateHandle>& Entry : FindFriendSessionCompleteDelegateHandles)
+	{
+		SessionInterface->ClearOnFindFriendSessionCompleteDelegate_Handle(Entry.Key, Entry.Value);
+	}
+}
+
+/**
+ * @brief Reads the friends list and keeps only friends whose presence reports a joinable session.
+ *
+ * @param LocalUserNum The local user whose friends are read.
+ * @param OnComplete Called with the friends once the list was read.
+ */
+void FDustLinkOnlinePresenceProvider::ReadJoinableFriends(const int32 LocalUserNum, const FDustLinkOnFriendsRead& OnComplete)
+{
+	const IOnlineFriendsPtr FriendsInterface = Subsystem ? Subsystem->GetFriendsInterface() : nullptr;
+
+	if (!FriendsInterface.IsValid())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("FDustLinkOnlinePresenceProvider: Friends interface not found."));
+		OnComplete.ExecuteIfBound(TArray<FDustLinkFriend>(), false);
+		return;
+	}
+
+	TWeakPtr<FDustLinkOnlinePresenceProvider> WeakThis(AsShared());
+
+	FriendsInterface->ReadFriendsList(LocalUserNum, EFriendsLists::ToString(EFriendsLists::Default), FOnReadFriendsListComplete::CreateLambda(
+		[WeakThis, OnComplete](const int32 UserNum, const bool bWasSuccessful, const FString& ListName, const FString& ErrorStr)
+	{
+		const TSharedPtr<FDustLinkOnlinePresenceProvider> This = WeakThis.Pin();
+
+		if (!This.IsValid() || !bWasSuccessful)
+		{
+			OnComplete.ExecuteIfBound(TArray<FDustLinkFriend>(), false);
+			return;
+		}
+
+		const IOnlineFriendsPtr Friends = This->Subsystem->GetFriendsInterface();
+		const IOnlinePresencePtr Presence = This->Subsystem->GetPresenceInterface();
+
+		TArray<TSharedRef<FOnlineFriend>> FriendList;
+		Friends->GetFriendsList(UserNum, ListName, FriendList);
+
+		TArray<FDustLinkFriend> JoinableFriends;
+
+		for (const TSharedRef<FOnlineFriend>& Friend : FriendList)
+		{
+			FOnlineUserPresence FriendPresence = Friend->GetPresence();
+
+			// Prefer fresher presence from the presence interface when it is cached
+			if (TSharedPtr<FOnlineUserPresence> CachedPresence; Presence.IsValid() &&
+				Presence->GetCachedPresence(*Friend->GetUserId(), CachedPresence) == EOnlineCachedResult::Success && CachedPresence.IsValid())
+			{
+				FriendPresence = *CachedPresence;
+			}
+
+			if (!FriendPresence.bIsOnline || !FriendPresence.bIsPlayingThisGame || !FriendPresence.bIsJoinable) continue;
+
+			JoinableFriends.Add({ Friend->GetUserId()->ToString(), Friend->GetDisplayName(), Friend->GetUserId() });
+		}
+
+		OnComplete.ExecuteIfBound(JoinableFriends, true);
+	}));
+}
+
+/**
+ * @brief Queries the session of a single friend directly, without a global search.
+ *
+ * @param LocalUserNum The local user issuing the query.
+ * @param Friend The friend whose session is queried.
+ * @param OnComplete Called with the friend's session once the query finished.
+ */
+void FDustLinkOnlinePresenceProvider::FindFriendSession(const int32 LocalUserNum, const FDustLinkFriend& Friend, const FDustLinkOnFriendSessionFound& OnComplete)
+{
+	const IOnlineSessionPtr SessionInterface = Subsystem ? Subsystem->GetSessionInterface() : nullptr;
+
+	if (!SessionInterface.IsValid() || !Friend.UserId.IsValid())
+	{
+		OnComplete.ExecuteIfBound(TArray<FOnlineSessionSearchResult>(), false);
+		return;
+	}
+
+	if (!FindFriendSessionCompleteDelegateHandles.Contains(LocalUserNum))
+	{
+		FindFriendSessionCompleteDelegateHandles.Add(LocalUserNum, SessionInterface->AddOnFindFriendSessionCompleteDelegate_Handle(LocalUserNum,
+			FOnFindFriendSessionCompleteDelegate::CreateSP(this, &FDustLinkOnlinePresenceProvider::OnFindFriendSessionComplete)));
+	}
+
+	QueuedQueries.FindOrAdd(LocalUserNum).Add({ Friend, OnComplete, ++LastQuerySerial });
+	IssueNextQuery(LocalUserNum);
+}
+
+/**
+ * @brief Issues the next queued friend session query of a local user, unless one is in flight.
+ *
+ * @param LocalUserNum The local user whose queue is served.
+ */
+void FDustLinkOnlinePresenceProvider::IssueNextQuery(const int32 LocalUserNum)
+{
+	const IOnlineSessionPtr SessionInterface = Subsystem ? Subsystem->GetSessionInterface() : nullptr;
+	const TSharedRef<FDustLinkOnlinePresenceProvider> KeepAlive = AsShared();
+
+	while (SessionInterface.IsValid() && !InFlightQueries.Contains(LocalUserNum))
+	{
+		TArray<FPendingQuery>* Queue = QueuedQueries.Find(LocalUserNum);
+
+		if (!Queue || Queue->IsEmpty()) return;
+
+		const FPendingQuery Query = (*Queue)[0];
+		Queue->RemoveAt(0);
+		InFlightQueries.Add(LocalUserNum, Query);
+
+		if (SessionInterface->FindFriendSession(LocalUserNum, *Query.Friend.UserId)) return;
+
+		// Some subsystems report the failure through the delegate before returning, which already completed the query
+		if (const FPendingQuery* InFlight = InFlightQueries.Find(LocalUserNum); InFlight && InFlight->Serial == Query.Serial)
+		{
+			InFlightQueries.Remove(LocalUserNum);
+			Query.OnComplete.ExecuteIfBound(TArray<FOnlineSessionSearchResult>(), false);
+		}
+	}
+}
+
+/**
+ * @brief Callback for when the session interface finished a friend session query.
+ *
+ * The session interface does not report which friend a completion belongs to, and a friend
+ * who joined someone else's session is not its owner. Each local user therefore has a single
+ * query in flight, and the completion is keyed by the friend that query was issued for.
+ *
+ * @param LocalUserNum The local user who issued the query.
+ * @param bWasSuccessful Whether the query succeeded.
+ * @param SessionResults The sessions found.
+ */
+void FDustLinkOnlinePresenceProvider::OnFindFriendSessionComplete(int32 LocalUserNum, bool bWasSuccessful, const TArray<FOnlineSessionSearchResult>& SessionResults)
+{
+	FPendingQuery Query;
+
+	if (!InFlightQueries.RemoveAndCopyValue(LocalUserNum, Query)) return;
+
+	// The callback may replace the provider of the finder, which releases this one
+	const TSharedRef<FDustLinkOnlinePresenceProvider> KeepAlive = AsShared();
+
+	Query.OnComplete.ExecuteIfBound(SessionResults, bWasSuccessful);
+	IssueNextQuery(LocalUserNum);
+}
+
+/**
+ * @brief Adds a fake friend.
+ *
+ * @param Friend The friend to add.
+ * @param SessionResult The session the friend is in, unset if the friend is not joinable.
+ */
+void FDustLinkMockPresenceProvider::AddFriend(const FDustLinkFriend& Friend, const TOptional<FOnlineSessionSearchResult>& SessionResult)
+{
+	Friends.Add(Friend.FriendId, { Friend, SessionResult });
+}
+
+/**
+ * @brief Adds the fake friends listed in a JSON file.
+ *
+ * The file holds a `Friends` array whose entries have an `Id`, an optional `Name` and an optional
+ * `Session` object with `MatchType`, `OpenSlots`, `MaxPlayers` and `Ping`. Friends without a session are not joinable.
+ *
+ * @param Path The file to read.
+ * @return `true` if the file was read and parsed.
+ */
+bool FDustLinkMockPresenceProvider::LoadFromFile(const FString& Path)
+{
+	FString Json;
+	TSharedPtr<FJsonObject> Object;
+	const TArray<TSharedPtr<FJsonValue>>* Entries = nullptr;
+
+	if (!FFileHelper::LoadFileToString(Json, *Path) || !FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Json), Object) ||
+		!Object.IsValid() || !Object->TryGetArrayField(TEXT("Friends"), Entries))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("FDustLinkMockPresenceProvider: Failed to read mock friends from %s."), *Path);
+		return false;
+	}
+
+	for (const TSharedPtr<FJsonValue>& Entry : *Entries)
+	{
+		const TSharedPtr<FJsonObject>* FriendObject = nullptr;
+		FDustLinkFriend Friend;
+
+		if (!Entry->TryGetObject(FriendObject) || !(*FriendObject)->TryGetStringField(TEXT("Id"), Friend.FriendId)) continue;
+
+		if (!(*FriendObject)->TryGetStringField(TEXT("Name"), Friend.DisplayName)) Friend.DisplayName = Friend.FriendId;
+
+		TOptional<FOnlineSessionSearchResult> SessionResult;
+
+		if (const TSharedPtr<FJsonObject>* SessionObject = nullptr; (*FriendObject)->TryGetObjectField(TEXT("Session"), SessionObject))
+		{
+			FString MatchType { TEXT("Error404") };
+			int32 NumOpenSlots { 1 };
+			int32 MaxPlayers { 4 };
+			int32 PingInMs { 50 };
+
+			(*SessionObject)->TryGetStringField(TEXT("MatchType"), MatchType);
+			(*SessionObject)->TryGetNumberField(TEXT("OpenSlots"), NumOpenSlots);
+			(*SessionObject)->TryGetNumberField(TEXT("MaxPlayers"), MaxPlayers);
+			(*SessionObject)->TryGetNumberField(TEXT("Ping"), PingInMs);
+
+			SessionResult = MakeSessionResult(Friend.DisplayName, MatchType, NumOpenSlots, MaxPlayers, PingInMs);
+		}
+
+		AddFriend(Friend, SessionResult);
+	}
+
+	return true;
+}
+
+/**
+ * @brief Builds a search result for a fake session hosted by a fake friend.
+ *
+ * @param OwnerName The display name of the host, also used to derive the session identifier.
+ * @param MatchType The value of the session's `MatchType` setting.
+ * @param NumOpenSlots The number of free player slots.
+ * @param MaxPlayers The total number of player slots.
+ * @param PingInMs The ping reported for the session.
+ */
+FOnlineSessionSearchResult FDustLinkMockPresenceProvider::MakeSessionResult(const FString& OwnerName, const FString& MatchType, const int32 NumOpenSlots, const int32 MaxPlayers, const int32 PingInMs)
+{
+	FOnlineSessionSearchResult Result;
+	Result.PingInMs = PingInMs;
+	Result.Session.OwningUserName = OwnerName;
+	Result.Session.NumOpenPublicConnections = FMath::Clamp(NumOpenSlots, 0, MaxPlayers);
+	Result.Session.SessionInfo = MakeShared<DustLinkPresence::FMockSessionInfo>(TEXT("Mock-") + OwnerName);
+	Result.Session.SessionSettings.NumPublicConnections = MaxPlayers;
+	Result.Session.SessionSettings.bShouldAdvertise = true;
+	Result.Session.SessionSettings.bAllowJoinInProgress = true;
+	Result.Session.SessionSettings.Set(FName("MatchType"), MatchType, EOnlineDataAdvertisementType::ViaOnlineServiceAndPing);
+
+	return Result;
+}
+
+void FDustLinkMockPresenceProvider::ReadJoinableFriends(const int32 LocalUserNum, const FDustLinkOnFriendsRead& OnComplete)
+{
+	TArray<FDustLinkFriend> JoinableFriends;
+
+	for (const auto& Entry : Friends)
+	{
+		if (Entry.Value.Value.IsSet()) JoinableFriends.Add(Entry.Value.Key);
+	}
+
+	Deliver(DustLinkPresence::FriendPayloadBytes * JoinableFriends.Num(), [OnComplete, JoinableFriends](const bool bArrived)
+	{
+		OnComplete.ExecuteIfBound(bArrived ? JoinableFriends : TArray<FDustLinkFriend>(), bArrived);
+	});
+}
+
+void FDustLinkMockPresenceProvider::FindFriendSession(const int32 LocalUserNum, const FDustLinkFriend& Friend, const FDustLinkOnFriendSessionFound& OnComplete)
+{
+	TArray<FOnlineSessionSearchResult> SessionResults;
+
+	if (const auto* Entry = Friends.Find(Friend.FriendId); Entry && Entry->Value.IsSet())
+	{
+		SessionResults.Add(Entry->Value.GetValue());
+	}
+
+	Deliver(FDustLinkNetworkProfile::SessionPayloadBytes * SessionResults.Num(), [OnComplete, SessionResults](const bool bArrived)
+	{
+		OnComplete.ExecuteIfBound(bArrived ? SessionResults : TArray<FOnlineSessionSearchResult>(), bArrived);
+	});
+}
+
+/**
+ * @brief Delivers an answer after the simulated latency.
+ *
+ * @param PayloadBytes Approximate size of the answer on the wire.
+ * @param Answer The function that invokes the caller's callback, told whether the answer arrived.
+ */
+void FDustLinkMockPresenceProvider::Deliver(const int32 PayloadBytes, TFunction<void(bool)>&& Answer) const
+{
+	// The friend finder has no timeout, so a lost answer surfaces as a failed query instead of never arriving
+	const bool bArrived = !NetworkProfile.SampleBackendLoss();
+	const float Delay = Latency + NetworkProfile.SampleBackendDelay(FDustLinkNetworkProfile::EnvelopePayloadBytes + PayloadBytes);
+
+	FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([Answer = MoveTemp(Answer), bArrived](float)
+	{
+		Answer(bArrived);
+		return false;
+	}), Delay);
+}
@@ -0,0 +1,45 @@
+// Copyright Dustbyte Software. All Rights Reserved.
+
+#include "DustLink/Public/Online/DustLinkRefreshPolicy.h"
+
+
+/**
+ * @brief Constructs the policy with the given tuning parameters.
+ *
+ * @param InSettings The tuning parameters to use.
+ */
+FDustLinkRefreshPolicy::FDustLinkRefreshPolicy(const FDustLinkRefreshPolicySettings& InSettings):
+	Settings(InSettings)
+{
+	Reset();
+}
+
+/**
+ * @brief Restores the initial interval and forgets the churn history.
+ */
+void FDustLinkRefreshPolicy::Reset()
+{
+	Interval = FMath::Clamp(Settings.InitialInterval, Settings.MinInterval, Settings.MaxInterval);
+	SmoothedChurn = 0.f;
+}
+
+/**
+ * @brief Feeds the result of a completed search into the policy.
+ *
+ * @param Churn Fraction of sessions that appeared or disappeared in the search, in the range [0, 1].
+ * @param bIsFocused Whether the game window currently has focus.
+ * @return The interval until the next refresh, in seconds.
+ */
+float FDustLinkRefreshPolicy::OnSearchComplete(const float Churn, const bool bIsFocused)
+{
+	SmoothedChurn = FMath::Lerp(SmoothedChurn, FMath::Clamp(Churn, 0.f, 1.f), Settings.SmoothingAlpha);
+
+	if (SmoothedChurn >= Settings.HighChurn) Interval *= Settings.SpeedupFactor;
+	else if (SmoothedChurn <= Settings.LowChurn) Interval *= Settings.BackoffFactor;
+
+	Interval = FMath::Clamp(Interval, Settings.MinInterval, Settings.MaxInterval);
+
+	if (bIsFocused) return Interval;
+
+	return FMath::Min(Interval * Settings.UnfocusedMultiplier, Settings.MaxUnfocusedInterval);
+}
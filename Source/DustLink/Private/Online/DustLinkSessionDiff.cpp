@@ -0,0 +1,98 @@
+// Copyright Dustbyte Software. All Rights Reserved.
+
+#include "DustLink/Public/Online/DustLinkSessionDiff.h"
+
+
+/**
+ * @brief Computes the difference between two session result stores.
+ *
+ * @param Previous The result store of the previous search.
+ * @param Current The result store of the new search.
+ * @return The added, removed and changed sessions.
+ */
+FDustLinkSessionDiff FDustLinkSessionDiff::Compute(const FDustLinkSessionResultStore& Previous, const FDustLinkSessionResultStore& Current)
+{
+	FDustLinkSessionDiff Diff;
+
+	for (const TPair<FString, FOnlineSessionSearchResult>& Entry : Current)
+	{
+		const FOnlineSessionSearchResult* PreviousResult = Previous.Find(Entry.Key);
+
+		if (!PreviousResult)
+		{
+			Diff.Added.Add(Entry.Key);
+			continue;
+		}
+
+		if (const EDustLinkSessionChange Fields = CompareFields(*PreviousResult, Entry.Value); Fields != EDustLinkSessionChange::None)
+		{
+			Diff.Changed.Add({ Entry.Key, Fields });
+		}
+	}
+
+	for (const TPair<FString, FOnlineSessionSearchResult>& Entry : Previous)
+	{
+		if (!Current.Contains(Entry.Key)) Diff.Removed.Add(Entry.Key);
+	}
+
+	return Diff;
+}
+
+/**
+ * @brief Returns the identifier used to key a search result.
+ *
+ * Kept as a string rather than an `FName`, so searches of thousands of sessions do not grow the name table.
+ *
+ * @param Result The search result to identify.
+ * @return The session identifier, or an empty string if the result carries no session info.
+ */
+FString FDustLinkSessionDiff::GetSessionKey(const FOnlineSessionSearchResult& Result)
+{
+	// Only the session info is needed, results without an owning user id are still told apart
+	if (!Result.IsSessionInfoValid()) return FString();
+
+	return Result.GetSessionIdStr();
+}
+
+/**
+ * @brief Compares the fields of the same session across two searches.
+ *
+ * @param Previous The session as seen by the previous search.
+ * @param Current The session as seen by the new search.
+ * @return Flags for every field that differs.
+ */
+EDustLinkSessionChange FDustLinkSessionDiff::CompareFields(const FOnlineSessionSearchResult& Previous, const FOnlineSessionSearchResult& Current)
+{
+	EDustLinkSessionChange Fields = EDustLinkSessionChange::None;
+
+	if (Previous.PingInMs != Current.PingInMs) Fields |= EDustLinkSessionChange::Ping;
+
+	if (Previous.Session.NumOpenPublicConnections != Current.Session.NumOpenPublicConnections ||
+		Previous.Session.NumOpenPrivateConnections != Current.Session.NumOpenPrivateConnections)
+	{
+		Fields |= EDustLinkSessionChange::OpenConnections;
+	}
+
+	if (Previous.Session.OwningUserName != Current.Session.OwningUserName) Fields |= EDustLinkSessionChange::Owner;
+
+	const FSessionSettings& PreviousSettings = Previous.Session.SessionSettings.Settings;
+	const FSessionSettings& CurrentSettings = Current.Session.SessionSettings.Settings;
+
+	if (PreviousSettings.Num() != CurrentSettings.Num())
+	{
+		return Fields | EDustLinkSessionChange::Settings;
+	}
+
+	for (const TPair<FName, FOnlineSessionSetting>& Setting : CurrentSettings)
+	{
+		const FOnlineSessionSetting* PreviousSetting = PreviousSettings.Find(Setting.Key);
+
+		if (!PreviousSetting || !(PreviousSetting->Data == Setting.Value.Data))
+		{
+			Fields |= EDustLinkSessionChange::Settings;
+			break;
+		}
+	}
+
+	return Fields;
+}
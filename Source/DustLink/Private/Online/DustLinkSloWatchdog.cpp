@@ -0,0 +1,194 @@
+// Copyright Dustbyte Software. All Rights Reserved.
+
+#include "DustLink/Public/Online/DustLinkSloWatchdog.h"
+
+#include "Async/Async.h"
+#include "Dom/JsonObject.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "ProfilingDebugging/TraceAuxiliary.h"
+#include "Serialization/JsonSerializer.h"
+
+
+/**
+ * @brief Constructs the watchdog and subscribes to the telemetry events of the metrics.
+ *
+ * @param InMetrics The metrics to watch.
+ * @param InSettings The objectives and capture parameters to use.
+ */
+FDustLinkSloWatchdog::FDustLinkSloWatchdog(const TSharedRef<FDustLinkMetrics>& InMetrics, const FDustLinkSloSettings& InSettings):
+	Metrics(InMetrics),
+	Settings(InSettings)
+{
+	ResetBuffers();
+	TelemetryEventHandle = Metrics->OnTelemetryEvent.AddRaw(this, &FDustLinkSloWatchdog::HandleTelemetryEvent);
+}
+
+FDustLinkSloWatchdog::~FDustLinkSloWatchdog()
+{
+	Metrics->OnTelemetryEvent.Remove(TelemetryEventHandle);
+}
+
+/**
+ * @brief Replaces the objectives and capture parameters, forgetting recent latencies and events.
+ *
+ * @param InSettings The objectives and capture parameters to use.
+ */
+void FDustLinkSloWatchdog::SetSettings(const FDustLinkSloSettings& InSettings)
+{
+	Settings = InSettings;
+	ResetBuffers();
+}
+
+/**
+ * @brief Writes a snapshot of the recent telemetry right away, regardless of objectives and cooldown.
+ *
+ * @param Reason A short label included in the snapshot and its file name.
+ * @return The file the snapshot is written to.
+ */
+FString FDustLinkSloWatchdog::CaptureSnapshot(const FString& Reason)
+{
+	const FString Directory = Settings.OutputDirectory.IsEmpty() ? FPaths::ProjectSavedDir() / TEXT("DustLink") / TEXT("Slo") : Settings.OutputDirectory;
+	const FString BaseName = FString::Printf(TEXT("%s-%s"), *FDateTime::Now().ToString(TEXT("%Y%m%d-%H%M%S")), *Reason);
+	const FString SnapshotPath = Directory / BaseName + TEXT(".json");
+
+	// The ring buffer is unrolled oldest first while still on the game thread, only the disk write is deferred
+	TArray<TSharedPtr<FJsonValue>> EventValues;
+	EventValues.Reserve(Events.Num());
+
+	for (int32 Offset = 0; Offset < Events.Num(); ++Offset)
+	{
+		const int32 Index = Events.Num() < Settings.RingCapacity ? Offset : (NextEventIndex + Offset) % Events.Num();
+
+		EventValues.Add(MakeShared<FJsonValueString>(Events[Index].ToString()));
+	}
+
+	const TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+	Root->SetStringField(TEXT("Reason"), Reason);
+	Root->SetStringField(TEXT("Time"), FDateTime::UtcNow().ToIso8601());
+	Root->SetArrayField(TEXT("Events"), EventValues);
+	Root->SetObjectField(TEXT("Metrics"), Metrics->ToJsonObject());
+
+	// The writer escapes quotes and backslashes, e.g. in a reason passed in by a caller
+	FString Snapshot;
+	FJsonSerializer::Serialize(Root, TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Snapshot));
+
+	Async(EAsyncExecution::ThreadPool, [SnapshotPath, Snapshot = MoveTemp(Snapshot)]()
+	{
+		if (!FFileHelper::SaveStringToFile(Snapshot, *SnapshotPath))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("FDustLinkSloWatchdog: Failed to write snapshot %s."), *SnapshotPath);
+		}
+	});
+
+	// Writes the tail of the in-memory trace buffer, which only holds data if tracing runs with a tail buffer
+	if (Settings.bCaptureTrace)
+	{
+		const FString TracePath = Directory / BaseName + TEXT(".utrace");
+
+		if (!FTraceAuxiliary::WriteSnapshot(*TracePath))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("FDustLinkSloWatchdog: Failed to write trace snapshot %s."), *TracePath);
+		}
+	}
+
+	return SnapshotPath;
+}
+
+/**
+ * @brief Callback for every telemetry event of the watched metrics.
+ *
+ * @param Event The recorded event.
+ */
+void FDustLinkSloWatchdog::HandleTelemetryEvent(const FDustLinkTelemetryEvent& Event)
+{
+	if (Events.Num() < Settings.RingCapacity)
+	{
+		Events.Add(Event);
+	}
+	else if (!Events.IsEmpty())
+	{
+		Events[NextEventIndex] = Event;
+		NextEventIndex = (NextEventIndex + 1) % Events.Num();
+	}
+
+	if (Event.Type != EDustLinkTelemetryEventType::OperationEnd || Event.LatencyMs < 0.0) return;
+
+	TArray<double>& Window = Windows[Event.Target];
+	int32& NextWindowIndex = NextWindowIndices[Event.Target];
+
+	if (Window.Num() < Settings.WindowSize)
+	{
+		Window.Add(Event.LatencyMs);
+	}
+	else if (!Window.IsEmpty())
+	{
+		Window[NextWindowIndex] = Event.LatencyMs;
+		NextWindowIndex = (NextWindowIndex + 1) % Window.Num();
+	}
+
+	EvaluateSlos(static_cast<EDustLinkSessionOperation>(Event.Target));
+}
+
+/**
+ * @brief Evaluates the objectives of an operation after one of its latencies was added.
+ *
+ * @param Operation The operation that completed.
+ */
+void FDustLinkSloWatchdog::EvaluateSlos(const EDustLinkSessionOperation Operation)
+{
+	if (Windows[static_cast<uint8>(Operation)].Num() < Settings.MinSamples) return;
+
+	const double Now = FPlatformTime::Seconds();
+
+	for (const FDustLinkSlo& Slo : Settings.Slos)
+	{
+		if (Slo.Operation != Operation) continue;
+
+		const double ObservedMs = GetWindowPercentile(Operation, Slo.Percentile);
+
+		if (ObservedMs <= Slo.ThresholdMs || Now - LastCaptureTime < Settings.CaptureCooldown) continue;
+
+		LastCaptureTime = Now;
+
+		const FString SnapshotPath = CaptureSnapshot(FString::Printf(TEXT("%s-p%g"), FDustLinkMetrics::GetOperationName(Operation), Slo.Percentile));
+
+		UE_LOG(LogTemp, Warning, TEXT("FDustLinkSloWatchdog: %s p%g is %.0f ms, above its objective of %.0f ms. Snapshot written to %s."),
+			FDustLinkMetrics::GetOperationName(Operation), Slo.Percentile, ObservedMs, Slo.ThresholdMs, *SnapshotPath);
+
+		OnSloBreached.Broadcast(Slo, ObservedMs, SnapshotPath);
+	}
+}
+
+/**
+ * @brief Returns a percentile of the recent latencies of an operation, in milliseconds.
+ *
+ * @param Operation The operation to evaluate.
+ * @param Percentile The percentile in the range [0, 100].
+ */
+double FDustLinkSloWatchdog::GetWindowPercentile(const EDustLinkSessionOperation Operation, const float Percentile) const
+{
+	TArray<double> Sorted = Windows[static_cast<uint8>(Operation)];
+
+	if (Sorted.IsEmpty()) return 0.0;
+
+	Sorted.Sort();
+
+	const int32 Rank = FMath::Clamp(FMath::CeilToInt(Percentile / 100.f * Sorted.Num()) - 1, 0, Sorted.Num() - 1);
+
+	return Sorted[Rank];
+}
+
+/**
+ * @brief Forgets recent latencies and events and sizes the buffers for the current settings.
+ */
+void FDustLinkSloWatchdog::ResetBuffers()
+{
+	Events.Reset(Settings.RingCapacity);
+	NextEventIndex = 0;
+
+	for (TArray<double>& Window : Windows) Window.Reset(Settings.WindowSize);
+
+	for (int32& NextWindowIndex : NextWindowIndices) NextWindowIndex = 0;
+}
@@ -0,0 +1,554 @@
+// Copyright Dustbyte Software. All Rights Reserved.
+
+#include "DustLink/Public/Online/DustLinkSoakTest.h"
+
+#include "Blueprint/UserWidget.h"
+#include "Components/Button.h"
+#include "Engine/GameInstance.h"
+#include "Engine/LocalPlayer.h"
+#include "HAL/MemoryBase.h"
+#include "HAL/PlatformMemory.h"
+#include "UObject/UObjectArray.h"
+#include "UObject/UObjectIterator.h"
+#include "DustLink/Public/MenuSystem/DustLinkMenu.h"
+#include "DustLink/Public/MenuSystem/DustLinkMenuManager.h"
+#include "DustLink/Public/Online/DustLinkSubsystem.h"
+
+
+namespace DustLinkSoak
+{
+	/** Clicks a button of a menu by its widget name, as a player would. Returns `false` if the menu has no such button. */
+	bool ClickButton(UDustLinkMenu* Menu, const FName ButtonName)
+	{
+		UButton* Button = Cast<UButton>(Menu->GetWidgetFromName(ButtonName));
+
+		if (!Button) return false;
+
+		Button->OnClicked.Broadcast();
+		return true;
+	}
+
+	/** Returns the memory handed out by the allocator in megabytes, or the physical memory used if the allocator does not report it. */
+	double GetHeapMb()
+	{
+		// Pooling allocators keep freed pages resident, so the resident size hides leaks until the pools are exhausted
+		FGenericMemoryStats AllocatorStats;
+		GMalloc->GetAllocatorStats(AllocatorStats);
+
+		if (const SIZE_T* TotalAllocated = AllocatorStats.Data.Find(TEXT("TotalAllocated"))) return *TotalAllocated / (1024.0 * 1024.0);
+
+		return FPlatformMemory::GetStats().UsedPhysical / (1024.0 * 1024.0);
+	}
+}
+
+
+/**
+ * @brief Constructs a soak run against the given subsystem.
+ *
+ * @param InSubsystem The subsystem whose session lifecycle is exercised.
+ * @param InSettings The length and tolerances of the run.
+ */
+FDustLinkSoakTest::FDustLinkSoakTest(UDustLinkSubsystem* InSubsystem, const FDustLinkSoakSettings& InSettings):
+	Subsystem(InSubsystem),
+	Settings(InSettings)
+{
+	Settings.NumCycles = FMath::Max(Settings.NumCycles, 1);
+	Settings.WarmupCycles = FMath::Clamp(Settings.WarmupCycles, 1, FMath::Max(Settings.NumCycles / 10, 1));
+	Settings.SampleInterval = FMath::Max(Settings.SampleInterval, 1);
+}
+
+FDustLinkSoakTest::~FDustLinkSoakTest()
+{
+	FTSTicker::GetCoreTicker().RemoveTicker(TimeoutTickerHandle);
+	TearDownMenu();
+}
+
+/**
+ * @brief Subscribes to the subsystem and starts the first cycle.
+ */
+void FDustLinkSoakTest::Start()
+{
+	UDustLinkSubsystem* Owner = Subsystem.Get();
+
+	if (!Owner || bIsRunning) return;
+
+	bIsRunning = true;
+	NumCompletedCycles = 0;
+	NumFailedSteps = 0;
+	NumFullCycles = 0;
+	NumJoinedCycles = 0;
+	MaxLeakedOnlineHandles = 0;
+	Samples.Reset();
+	CycleTimes.Reset();
+
+	for (FDustLinkLatencyHistogram& StepHistogram : StepTimes) StepHistogram.Reset();
+
+	UGameInstance* GameInstance = Owner->GetGameInstance();
+
+	if (UDustLinkMenuManager* MenuManager = GameInstance ? GameInstance->GetSubsystem<UDustLinkMenuManager>() : nullptr)
+	{
+		MenuManager->CloseMenu();
+	}
+
+	// Closed menus stay subscribed but ignore session events, an open one would answer the soak's sessions with travel
+	int32 NumOpenMenus = 0;
+
+	for (TObjectIterator<UDustLinkMenu> It; It; ++It)
+	{
+		if (It->IsOpen() && It->GetGameInstance() == GameInstance) ++NumOpenMenus;
+	}
+
+	if (NumOpenMenus > 0)
+	{
+		// Reported on the next tick, so the caller can bind OnComplete first
+		FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateSPLambda(this, [this, NumOpenMenus](float)
+		{
+			Abort(FString::Printf(TEXT("%d menus are still open, tear down every menu before the run"), NumOpenMenus));
+			return false;
+		}));
+		return;
+	}
+
+	// The run would flood the metrics, trip the SLO watchdog and upload thousands of funnel events
+	Owner->SetTelemetrySuspended(true);
+
+	Owner->DustLinkOnCreateSessionCompleteNative.AddSPLambda(this, [this](const bool bWasSuccessful) { CompleteStep(EStep::Create, bWasSuccessful); });
+	Owner->DustLinkOnStartSessionCompleteNative.AddSPLambda(this, [this](const bool bWasSuccessful) { CompleteStep(EStep::Start, bWasSuccessful); });
+
+	Owner->DustLinkOnFindSessionsComplete.AddSPLambda(this, [this](const TArray<FOnlineSessionSearchResult>& SessionResults, const bool bWasSuccessful)
+	{
+		if (CurrentStep != EStep::Find) return;
+
+		JoinCandidate.Reset();
+
+		if (bWasSuccessful && !SessionResults.IsEmpty()) JoinCandidate = SessionResults[0];
+
+		CompleteStep(EStep::Find, bWasSuccessful);
+	});
+
+	Owner->DustLinkOnJoinSessionComplete.AddSPLambda(this, [this](const EOnJoinSessionCompleteResult::Type Result)
+	{
+		CompleteStep(EStep::Join, Result == EOnJoinSessionCompleteResult::Success);
+	});
+
+	// The session is destroyed twice per cycle, once as host and once after joining
+	Owner->DustLinkOnDestroySessionCompleteNative.AddSPLambda(this, [this](const bool bWasSuccessful)
+	{
+		CompleteStep(CurrentStep == EStep::LeaveJoined ? EStep::LeaveJoined : EStep::Destroy, bWasSuccessful);
+	});
+
+	TimeoutTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateSP(this, &FDustLinkSoakTest::CheckStepTimeout), 1.f);
+
+	UE_LOG(LogTemp, Log, TEXT("FDustLinkSoakTest: Starting %d session lifecycles."), Settings.NumCycles);
+
+	ScheduleStep(EStep::Create);
+}
+
+/**
+ * @brief Aborts the run, reporting it as failed.
+ *
+ * @param Reason Why the run was aborted.
+ */
+void FDustLinkSoakTest::Abort(const FString& Reason)
+{
+	if (!bIsRunning) return;
+
+	End(false, FString::Printf(TEXT("aborted after %d cycles, %s"), NumCompletedCycles, *Reason));
+}
+
+/**
+ * @brief Issues a step on the next tick, so completions never re-enter the subsystem from its own broadcast.
+ *
+ * @param Step The step to issue.
+ */
+void FDustLinkSoakTest::ScheduleStep(const EStep Step)
+{
+	CurrentStep = Step;
+	StepStartTime = FPlatformTime::Seconds();
+
+	FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateSPLambda(this, [this, Step](float)
+	{
+		if (bIsRunning && CurrentStep == Step) RunStep(Step);
+		return false;
+	}));
+}
+
+/**
+ * @brief Issues a step now.
+ *
+ * @param Step The step to issue.
+ */
+void FDustLinkSoakTest::RunStep(const EStep Step)
+{
+	UDustLinkSubsystem* Owner = Subsystem.Get();
+
+	if (!Owner)
+	{
+		Abort(TEXT("the subsystem is gone"));
+		return;
+	}
+
+	StepStartTime = FPlatformTime::Seconds();
+
+	switch (Step)
+	{
+	case EStep::Create:
+		CycleStartTime = StepStartTime;
+		NumSucceededCycleSteps = 0;
+		JoinCandidate.Reset();
+		SetupMenu();
+
+		if (!Menu.IsValid())
+		{
+			Owner->CreateSession(4, TEXT("DustLinkSoak"));
+		}
+		else if (!DustLinkSoak::ClickButton(Menu.Get(), TEXT("HostButton")))
+		{
+			Abort(TEXT("the menu has no HostButton"));
+		}
+		break;
+
+	case EStep::Start:
+		Owner->StartSession();
+		break;
+
+	case EStep::Find:
+		// The menu joins its own search result right away, which is refused while this process still hosts
+		if (!Menu.IsValid())
+		{
+			Owner->FindSessions(10);
+		}
+		else if (!DustLinkSoak::ClickButton(Menu.Get(), TEXT("JoinButton")))
+		{
+			Abort(TEXT("the menu has no JoinButton"));
+		}
+		break;
+
+	case EStep::Destroy:
+	case EStep::LeaveJoined:
+		Owner->DestroySession();
+		break;
+
+	case EStep::Join:
+		{
+			FOnlineSessionSearchResult SessionResult = JoinCandidate.GetValue();
+			Owner->JoinSession(SessionResult);
+		}
+		break;
+
+	default:
+		break;
+	}
+}
+
+/**
+ * @brief Completes the current step and moves on to the next one.
+ *
+ * @param Step The step that completed, ignored if it is not the current one.
+ * @param bWasSuccessful Whether the step succeeded.
+ */
+void FDustLinkSoakTest::CompleteStep(const EStep Step, const bool bWasSuccessful)
+{
+	if (!bIsRunning || Step != CurrentStep) return;
+
+	if (Step == EStep::Join) ++NumJoinedCycles;
+
+	if (bWasSuccessful)
+	{
+		StepTimes[static_cast<uint8>(Step)].Record((FPlatformTime::Seconds() - StepStartTime) * 1000.0);
+		++NumSucceededCycleSteps;
+	}
+	else
+	{
+		++NumFailedSteps;
+		UE_LOG(LogTemp, Verbose, TEXT("FDustLinkSoakTest: %s failed in cycle %d."), GetStepName(Step), NumCompletedCycles + 1);
+	}
+
+	const UDustLinkSubsystem* Owner = Subsystem.Get();
+	const UWorld* World = Owner ? Owner->GetWorld() : nullptr;
+	const bool bCanJoin = JoinCandidate.IsSet() && World && World->GetFirstLocalPlayerFromController();
+
+	EStep NextStep = EStep::Done;
+
+	switch (Step)
+	{
+	case EStep::Create:		NextStep = bWasSuccessful ? EStep::Start : EStep::Done; break;
+	case EStep::Start:		NextStep = EStep::Find; break;
+	case EStep::Find:		NextStep = EStep::Destroy; break;
+	case EStep::Destroy:	NextStep = bCanJoin ? EStep::Join : EStep::Done; break;
+	case EStep::Join:		NextStep = bWasSuccessful ? EStep::LeaveJoined : EStep::Done; break;
+	default:				break;
+	}
+
+	if (NextStep == EStep::Done)
+	{
+		CompleteCycle();
+		return;
+	}
+
+	ScheduleStep(NextStep);
+}
+
+/**
+ * @brief Finishes a cycle, samples resource usage when due and starts the next cycle or ends the run.
+ */
+void FDustLinkSoakTest::CompleteCycle()
+{
+	CurrentStep = EStep::Done;
+	CycleTimes.Record((FPlatformTime::Seconds() - CycleStartTime) * 1000.0);
+	++NumCompletedCycles;
+
+	// Steps are skipped after a failure, so only a cycle that ran all of them counts every step as succeeded
+	if (NumSucceededCycleSteps == NumSteps) ++NumFullCycles;
+
+	// Torn down before sampling, its subscriptions must be gone and the widget collectable
+	TearDownMenu();
+
+	if (const UDustLinkSubsystem* Owner = Subsystem.Get())
+	{
+		MaxLeakedOnlineHandles = FMath::Max(MaxLeakedOnlineHandles, Owner->GetNumOnlineDelegateHandles());
+	}
+
+	const int32 CyclesSinceWarmup = NumCompletedCycles - Settings.WarmupCycles;
+
+	if (CyclesSinceWarmup >= 0 && (CyclesSinceWarmup % Settings.SampleInterval == 0 || NumCompletedCycles == Settings.NumCycles))
+	{
+		Samples.Add(TakeSample());
+	}
+
+	if (NumCompletedCycles >= Settings.NumCycles)
+	{
+		Finish();
+		return;
+	}
+
+	ScheduleStep(EStep::Create);
+}
+
+/**
+ * @brief Sets up a fresh menu with its travel stubbed out, if a menu class is loaded and a player controller exists.
+ */
+void FDustLinkSoakTest::SetupMenu()
+{
+	TearDownMenu();
+
+	const UDustLinkSubsystem* Owner = Subsystem.Get();
+	const UWorld* World = Owner ? Owner->GetWorld() : nullptr;
+
+	if (!Settings.bCycleMenu || !World || !World->GetFirstPlayerController()) return;
+
+	UGameInstance* GameInstance = Owner->GetGameInstance();
+	const UDustLinkMenuManager* MenuManager = GameInstance ? GameInstance->GetSubsystem<UDustLinkMenuManager>() : nullptr;
+	UClass* MenuClass = MenuManager ? MenuManager->GetMenuClass() : nullptr;
+
+	if (!MenuClass) return;
+
+	// A fresh menu every cycle, its subscriptions must be gone once it is torn down and collected
+	Menu.Reset(CreateWidget<UDustLinkMenu>(GameInstance, MenuClass));
+
+	if (!Menu.IsValid()) return;
+
+	// Hosting and joining would otherwise travel away from the world the run lives in
+	Menu->SetTravelOverride([](const FString& URL)
+	{
+		UE_LOG(LogTemp, Verbose, TEXT("FDustLinkSoakTest: Skipped travel to %s."), *URL);
+	});
+
+	Menu->MenuSetup(4, TEXT("DustLinkSoak"));
+}
+
+/**
+ * @brief Tears down and releases the menu of the current cycle.
+ */
+void FDustLinkSoakTest::TearDownMenu()
+{
+	if (!Menu.IsValid()) return;
+
+	Menu->MenuTearDown();
+	Menu->SetTravelOverride(nullptr);
+	Menu.Reset();
+}
+
+/**
+ * @brief Collects garbage and measures resource usage.
+ */
+FDustLinkSoakSample FDustLinkSoakTest::TakeSample()
+{
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+	FDustLinkSoakSample Sample;
+	Sample.Cycle = NumCompletedCycles;
+	Sample.HeapMb = DustLinkSoak::GetHeapMb();
+	Sample.NumObjects = GUObjectArray.GetObjectArrayNumMinusAvailable();
+	Sample.NumSubscriptions = Subsystem.IsValid() ? Subsystem->GetNumSubscriptions() : 0;
+	Sample.CycleP95Ms = CycleTimes.GetCount() > 0 ? CycleTimes.GetPercentile(95.0) : 0.0;
+
+	CycleTimes.Reset();
+
+	for (FDustLinkLatencyHistogram& StepHistogram : StepTimes)
+	{
+		Sample.StepP95Ms.Add(StepHistogram.GetCount() > 0 ? StepHistogram.GetPercentile(95.0) : 0.0);
+		StepHistogram.Reset();
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("FDustLinkSoakTest: Cycle %d, heap %.1f MB, %d objects, %d subscriptions, cycle p95 %.1f ms."),
+		Sample.Cycle, Sample.HeapMb, Sample.NumObjects, Sample.NumSubscriptions, Sample.CycleP95Ms);
+
+	return Sample;
+}
+
+/**
+ * @brief Compares the samples against the baseline and ends the run.
+ */
+void FDustLinkSoakTest::Finish()
+{
+	if (Samples.Num() < 2)
+	{
+		End(false, TEXT("too few cycles to compare against the baseline"));
+		return;
+	}
+
+	// The baseline window still holds warmup cycles, latency drift is measured from the first full window
+	const FDustLinkSoakSample& Baseline = Samples[0];
+	const FDustLinkSoakSample& FirstWindow = Samples[1];
+	const FDustLinkSoakSample& Last = Samples.Last();
+
+	TArray<FString> Failures;
+
+	if (const double HeapGrowth = Last.HeapMb - Baseline.HeapMb; HeapGrowth > Settings.MaxHeapGrowthMb)
+	{
+		Failures.Add(FString::Printf(TEXT("heap grew by %.1f MB"), HeapGrowth));
+	}
+
+	if (const int32 ObjectGrowth = Last.NumObjects - Baseline.NumObjects; ObjectGrowth > Settings.MaxObjectGrowth)
+	{
+		Failures.Add(FString::Printf(TEXT("%d objects leaked"), ObjectGrowth));
+	}
+
+	if (Last.NumSubscriptions > Baseline.NumSubscriptions)
+	{
+		Failures.Add(FString::Printf(TEXT("%d subscriptions leaked"), Last.NumSubscriptions - Baseline.NumSubscriptions));
+	}
+
+	if (MaxLeakedOnlineHandles > 0)
+	{
+		Failures.Add(FString::Printf(TEXT("up to %d online delegate handles left bound after a cycle"), MaxLeakedOnlineHandles));
+	}
+
+	// A cycle that skips its join still passes every check above, while half of the lifecycle goes untested
+	if (NumJoinedCycles == 0)
+	{
+		Failures.Add(TEXT("no cycle reached the join"));
+	}
+
+	if (NumFailedSteps > 0)
+	{
+		Failures.Add(FString::Printf(TEXT("%d steps failed"), NumFailedSteps));
+	}
+
+	// Per step, a slowing search would otherwise hide behind the frame-bound steps that make up most of a cycle
+	for (int32 Index = 0; Index < NumSteps; ++Index)
+	{
+		const double FirstP95Ms = FirstWindow.StepP95Ms[Index];
+		const double LastP95Ms = Last.StepP95Ms[Index];
+
+		// Steps completing within a frame or two are dominated by scheduling noise
+		if (FirstP95Ms < Settings.MinDriftLatencyMs) continue;
+
+		if (LastP95Ms / FirstP95Ms > Settings.MaxLatencyDrift)
+		{
+			Failures.Add(FString::Printf(TEXT("%s p95 drifted from %.1f ms to %.1f ms"), GetStepName(static_cast<EStep>(Index)), FirstP95Ms, LastP95Ms));
+		}
+	}
+
+	End(Failures.IsEmpty(), Failures.IsEmpty() ? TEXT("no growth") : FString::Join(Failures, TEXT(", ")));
+}
+
+/**
+ * @brief Ends the run and reports its outcome.
+ *
+ * @param bPassed Whether the run passed.
+ * @param Verdict Why the run passed or failed.
+ */
+void FDustLinkSoakTest::End(const bool bPassed, const FString& Verdict)
+{
+	bIsRunning = false;
+	CurrentStep = EStep::Done;
+
+	FTSTicker::GetCoreTicker().RemoveTicker(TimeoutTickerHandle);
+	TimeoutTickerHandle.Reset();
+	TearDownMenu();
+
+	if (UDustLinkSubsystem* Owner = Subsystem.Get())
+	{
+		Owner->SetTelemetrySuspended(false);
+		Owner->DustLinkOnCreateSessionCompleteNative.RemoveAll(this);
+		Owner->DustLinkOnStartSessionCompleteNative.RemoveAll(this);
+		Owner->DustLinkOnFindSessionsComplete.RemoveAll(this);
+		Owner->DustLinkOnJoinSessionComplete.RemoveAll(this);
+		Owner->DustLinkOnDestroySessionCompleteNative.RemoveAll(this);
+	}
+
+	TStringBuilder<4096> Builder;
+	Builder.Appendf(TEXT("Soak %s after %d cycles, %d of them running every step, with %d failed steps: %s\n"),
+		bPassed ? TEXT("passed") : TEXT("failed"), NumCompletedCycles, NumFullCycles, NumFailedSteps, *Verdict);
+
+	for (const FDustLinkSoakSample& Sample : Samples)
+	{
+		Builder.Appendf(TEXT("  cycle %6d  heap %8.1f MB  objects %7d  subscriptions %3d  cycle p95 %8.1f ms  step p95"),
+			Sample.Cycle, Sample.HeapMb, Sample.NumObjects, Sample.NumSubscriptions, Sample.CycleP95Ms);
+
+		for (int32 Index = 0; Index < Sample.StepP95Ms.Num(); ++Index)
+		{
+			Builder.Appendf(TEXT(" %s %.1f"), GetStepName(static_cast<EStep>(Index)), Sample.StepP95Ms[Index]);
+		}
+
+		Builder.AppendChar(TEXT('\n'));
+	}
+
+	const FString Report(Builder.ToView());
+
+	if (bPassed)
+	{
+		UE_LOG(LogTemp, Log, TEXT("FDustLinkSoakTest: %s"), *Report);
+	}
+	else
+	{
+		UE_LOG(LogTemp, Warning, TEXT("FDustLinkSoakTest: %s"), *Report);
+	}
+
+	OnComplete.Broadcast(bPassed, Report);
+}
+
+/**
+ * @brief Ticker callback that aborts the run if the current step stalled.
+ */
+bool FDustLinkSoakTest::CheckStepTimeout(float DeltaTime)
+{
+	if (!bIsRunning) return false;
+
+	if (CurrentStep != EStep::Done && FPlatformTime::Seconds() - StepStartTime > Settings.StepTimeout)
+	{
+		Abort(FString::Printf(TEXT("%s did not complete within %.0f s"), GetStepName(CurrentStep), Settings.StepTimeout));
+		return false;
+	}
+
+	return true;
+}
+
+/**
+ * @brief Returns the name of a step, for the report.
+ */
+const TCHAR* FDustLinkSoakTest::GetStepName(const EStep Step)
+{
+	switch (Step)
+	{
+	case EStep::Create:			return TEXT("Create");
+	case EStep::Start:			return TEXT("Start");
+	case EStep::Find:			return TEXT("Find");
+	case EStep::Destroy:		return TEXT("Destroy");
+	case EStep::Join:			return TEXT("Join");
+	case EStep::LeaveJoined:	return TEXT("LeaveJoined");
+	default:					return TEXT("Done");
+	}
+}
@@ -0,0 +1,30 @@
+// Copyright Dustbyte Software. All Rights Reserved.
+
+#include "DustLink/Public/Online/DustLinkSubscription.h"
+
+
+FDustLinkSubscription& FDustLinkSubscription::operator=(FDustLinkSubscription&& Other) noexcept
+{
+	if (this != &Other)
+	{
+		Reset();
+		Unsubscribe = MoveTemp(Other.Unsubscribe);
+		Other.Unsubscribe = nullptr;
+	}
+
+	return *this;
+}
+
+/**
+ * @brief Removes the binding now, if it is still active.
+ */
+void FDustLinkSubscription::Reset()
+{
+	if (!Unsubscribe) return;
+
+	// Cleared before the call so a subscriber destroyed by its own unbinding cannot unbind twice
+	const TFunction<void()> UnsubscribeNow = MoveTemp(Unsubscribe);
+	Unsubscribe = nullptr;
+
+	UnsubscribeNow();
+}
@@ -5,9 +5,176 @@
 #include "OnlineSessionSettings.h"
 #include "OnlineSubsystem.h"
 #include "OnlineSubsystemUtils.h"
+#include "Icmp.h"
+#include "Async/Async.h"
+#include "SocketSubsystem.h"
+#include "Interfaces/OnlineIdentityInterface.h"
+#include "TimerManager.h"
+#include "Engine/NetConnection.h"
+#include "Engine/NetDriver.h"
+#include "Engine/PendingNetGame.h"
+#include "Misc/App.h"
+#include "HAL/IConsoleManager.h"
+#include "GameFramework/GameModeBase.h"
+#include "GameFramework/OnlineReplStructs.h"
+#include "Kismet/GameplayStatics.h"
+#include "Framework/Application/SlateApplication.h"
 #include "Online/OnlineSessionNames.h"
+#include "DustLink/Public/Online/DustLinkContentManifest.h"
 
 
+namespace DustLinkConsole
+{
+	/** Prints the latency percentiles of the session operations and phases, or clears them with `reset`. */
+	static FAutoConsoleCommandWithWorldArgsAndOutputDevice LatencyCommand(
+		TEXT("DustLink.Latency"),
+		TEXT("Prints latency percentiles of DustLink session operations and phases. Pass \"reset\" to clear them."),
+		FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Output)
+	{
+		const UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+		UDustLinkSubsystem* Subsystem = GameInstance ? GameInstance->GetSubsystem<UDustLinkSubsystem>() : nullptr;
+
+		if (!Subsystem)
+		{
+			Output.Log(TEXT("DustLink subsystem is not available in this world."));
+			return;
+		}
+
+		if (Args.Num() > 0 && Args[0] == TEXT("reset"))
+		{
+			Subsystem->ResetLatencies();
+			Output.Log(TEXT("DustLink latencies cleared."));
+			return;
+		}
+
+		TArray<FString> Lines;
+		Subsystem->GetMetrics().ToLatencyReport().ParseIntoArrayLines(Lines);
+
+		for (const FString& Line : Lines) Output.Log(Line);
+	}));
+
+#if !UE_BUILD_SHIPPING
+	/** Switches the emulated network profile, or prints how each phase degraded across the profiles run so far with `report`. */
+	static FAutoConsoleCommandWithWorldArgsAndOutputDevice NetProfileCommand(
+		TEXT("DustLink.NetProfile"),
+		TEXT("Emulates a named network profile on the net driver and the mock backend. Pass \"report\" to compare phase latencies across profiles."),
+		FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Output)
+	{
+		const UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+		UDustLinkSubsystem* Subsystem = GameInstance ? GameInstance->GetSubsystem<UDustLinkSubsystem>() : nullptr;
+
+		if (!Subsystem)
+		{
+			Output.Log(TEXT("DustLink subsystem is not available in this world."));
+			return;
+		}
+
+		if (Args.Num() > 0 && Args[0] == TEXT("report"))
+		{
+			TArray<FString> Lines;
+			Subsystem->GetNetworkProfileReport().ParseIntoArrayLines(Lines);
+
+			for (const FString& Line : Lines) Output.Log(Line);
+			return;
+		}
+
+		if (Args.Num() > 0 && !Subsystem->SetNetworkProfile(Args[0]))
+		{
+			Output.Logf(TEXT("Unknown network profile %s."), *Args[0]);
+		}
+
+		Output.Logf(TEXT("Emulating %s"), *Subsystem->GetNetworkProfile().ToString());
+		Output.Log(TEXT("Available profiles:"));
+
+		for (const FDustLinkNetworkProfile& Profile : FDustLinkNetworkProfile::GetBuiltInProfiles()) Output.Logf(TEXT("  %s"), *Profile.ToString());
+	}));
+#endif
+
+	/** Seeds the mock presence backend with fake friends, installing it if the online friends are in use. */
+	static FAutoConsoleCommandWithWorldArgsAndOutputDevice MockFriendCommand(
+		TEXT("DustLink.MockFriend"),
+		TEXT("Seeds mock friends: \"add <Name> [OpenSlots] [MaxPlayers] [MatchType]\", \"offline <Name>\", \"remove <Name>\", \"load <File>\" or \"clear\"."),
+		FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Output)
+	{
+		const UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+		UDustLinkSubsystem* Subsystem = GameInstance ? GameInstance->GetSubsystem<UDustLinkSubsystem>() : nullptr;
+
+		if (!Subsystem)
+		{
+			Output.Log(TEXT("DustLink subsystem is not available in this world."));
+			return;
+		}
+
+		const FString Action = Args.Num() > 0 ? Args[0] : FString();
+		const TSharedRef<FDustLinkMockPresenceProvider> MockProvider = Subsystem->UseMockPresenceProvider();
+
+		if (Action == TEXT("clear"))
+		{
+			MockProvider->Reset();
+		}
+		else if (Action == TEXT("load") && Args.Num() > 1)
+		{
+			if (!MockProvider->LoadFromFile(Args[1])) Output.Logf(TEXT("Failed to read mock friends from %s."), *Args[1]);
+		}
+		else if (Action == TEXT("remove") && Args.Num() > 1)
+		{
+			MockProvider->RemoveFriend(Args[1]);
+		}
+		else if (Action == TEXT("offline") && Args.Num() > 1)
+		{
+			MockProvider->AddFriend({ Args[1], Args[1], nullptr }, TOptional<FOnlineSessionSearchResult>());
+		}
+		else if (Action == TEXT("add") && Args.Num() > 1)
+		{
+			const int32 NumOpenSlots = Args.Num() > 2 ? FCString::Atoi(*Args[2]) : 1;
+			const int32 MaxPlayers = Args.Num() > 3 ? FCString::Atoi(*Args[3]) : 4;
+			const FString MatchType = Args.Num() > 4 ? Args[4] : FString(TEXT("Error404"));
+
+			MockProvider->AddFriend({ Args[1], Args[1], nullptr }, FDustLinkMockPresenceProvider::MakeSessionResult(Args[1], MatchType, NumOpenSlots, MaxPlayers, 50));
+		}
+		else if (!Action.IsEmpty())
+		{
+			Output.Logf(TEXT("Unknown mock friend action %s."), *Action);
+		}
+
+		Output.Logf(TEXT("The mock presence backend has %d friends."), MockProvider->GetNumFriends());
+	}));
+
+	/** Starts a soak test of the session lifecycle with the given number of cycles, or aborts the running one with `stop`. */
+	static FAutoConsoleCommandWithWorldArgsAndOutputDevice SoakCommand(
+		TEXT("DustLink.Soak"),
+		TEXT("Runs DustLink session lifecycles and fails on heap, object, binding or latency growth. Pass a cycle count, or \"stop\" to abort."),
+		FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Output)
+	{
+		const UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+		UDustLinkSubsystem* Subsystem = GameInstance ? GameInstance->GetSubsystem<UDustLinkSubsystem>() : nullptr;
+
+		if (!Subsystem)
+		{
+			Output.Log(TEXT("DustLink subsystem is not available in this world."));
+			return;
+		}
+
+		if (Args.Num() > 0 && Args[0] == TEXT("stop"))
+		{
+			if (const TSharedPtr<FDustLinkSoakTest> Soak = Subsystem->GetSoakTest()) Soak->Abort(TEXT("stopped from the console"));
+			return;
+		}
+
+		FDustLinkSoakSettings Settings;
+
+		if (Args.Num() > 0) Settings.NumCycles = FCString::Atoi(*Args[0]);
+
+		if (!Subsystem->StartSoakTest(Settings))
+		{
+			Output.Log(TEXT("A DustLink soak test is already running."));
+			return;
+		}
+
+		Output.Log(TEXT("DustLink soak test started, the report is logged once it completes."));
+	}));
+}
+
 /**
  * @brief Default constructor for the DustLink subsystem.
  *
@@ -19,11 +186,229 @@ UDustLinkSubsystem::UDustLinkSubsystem():
 	FindSessionsCompleteDelegate(FOnFindSessionsCompleteDelegate::CreateUObject(this, &ThisClass::OnFindSessionComplete)),
 	JoinSessionCompleteDelegate(FOnJoinSessionCompleteDelegate::CreateUObject(this, &ThisClass::OnJoinSessionComplete)),
 	DestroySessionCompleteDelegate(FOnDestroySessionCompleteDelegate::CreateUObject(this, &ThisClass::OnDestroySessionComplete)),
-	StartSessionCompleteDelegate(FOnStartSessionCompleteDelegate::CreateUObject(this, &ThisClass::OnStartSessionComplete))
+	StartSessionCompleteDelegate(FOnStartSessionCompleteDelegate::CreateUObject(this, &ThisClass::OnStartSessionComplete)),
+	SessionUserInviteAcceptedDelegate(FOnSessionUserInviteAcceptedDelegate::CreateUObject(this, &ThisClass::OnSessionUserInviteAccepted)),
+	EndSessionCompleteDelegate(FOnEndSessionCompleteDelegate::CreateUObject(this, &ThisClass::OnEndSessionComplete)),
+	UpdateSessionCompleteDelegate(FOnUpdateSessionCompleteDelegate::CreateUObject(this, &ThisClass::OnUpdateSessionComplete)),
+	Metrics(MakeShared<FDustLinkMetrics>()),
+	FriendSessionFinder(MakeShared<FDustLinkFriendSessionFinder>())
 {
 	InitializeOnlineSessionInterface();
 }
 
+/**
+ * @brief Sets up optional services requested on the command line.
+ *
+ * `-DustLinkListingUrl=<Url>` selects the HTTP listing provider used for join codes and
+ * `-DustLinkListingServerPort=<Port>` starts the local master server stand-in in this process.
+ * `-DustLinkMockPresence[=<File>]` replaces the online presence provider with `FDustLinkMockPresenceProvider`, seeded from the file.
+ * `-DustLinkControlPort=<Port>` opens the control channel a fleet agent uses to hand this dedicated server a match.
+ * `-DustLinkMetricsPort=<Port>` serves the session metrics to local monitoring agents.
+ * `-DustLinkSloTrace` lets the SLO watchdog write the tail of the Unreal Insights trace on a breach.
+ * `-DustLinkAnalyticsFile` exports session funnel events to `FDustLinkFileAnalyticsProvider`.
+ * `-DustLinkNetProfile=<Name>` emulates one of the built-in `FDustLinkNetworkProfile` link conditions, except in shipping builds.
+ * `-DustLinkSoak=<Cycles>` runs a soak test once the world begins play and exits with its outcome.
+ *
+ * @param Collection The subsystem collection the subsystem is initialized in.
+ */
+void UDustLinkSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	if (!OnlineSessionInterface.IsValid()) InitializeOnlineSessionInterface();
+
+	if (OnlineSessionInterface.IsValid())
+	{
+		SessionUserInviteAcceptedDelegateHandle = OnlineSessionInterface->AddOnSessionUserInviteAcceptedDelegate_Handle(SessionUserInviteAcceptedDelegate);
+	}
+
+	// Every completion funnels through the native delegates, recording there covers synchronous failures too
+	DustLinkOnCreateSessionCompleteNative.AddWeakLambda(this, [this](const bool bWasSuccessful) { Metrics->EndOperation(EDustLinkSessionOperation::Create, bWasSuccessful); });
+	DustLinkOnDestroySessionCompleteNative.AddWeakLambda(this, [this](const bool bWasSuccessful) { Metrics->EndOperation(EDustLinkSessionOperation::Destroy, bWasSuccessful); });
+	DustLinkOnStartSessionCompleteNative.AddWeakLambda(this, [this](const bool bWasSuccessful) { Metrics->EndOperation(EDustLinkSessionOperation::Start, bWasSuccessful); });
+	DustLinkOnEndSessionCompleteNative.AddWeakLambda(this, [this](const bool bWasSuccessful) { Metrics->EndOperation(EDustLinkSessionOperation::End, bWasSuccessful); });
+	DustLinkOnUpdateSessionCompleteNative.AddWeakLambda(this, [this](const bool bWasSuccessful) { Metrics->EndOperation(EDustLinkSessionOperation::Update, bWasSuccessful); });
+
+	DustLinkOnFindSessionsComplete.AddWeakLambda(this, [this](const TArray<FOnlineSessionSearchResult>&, const bool bWasSuccessful)
+	{
+		Metrics->EndOperation(EDustLinkSessionOperation::Find, bWasSuccessful);
+		Metrics->EndPhase(EDustLinkLatencyPhase::Search, bWasSuccessful);
+	});
+
+	DustLinkOnSessionsRefreshed.AddWeakLambda(this, [this](const TArray<FOnlineSessionSearchResult>&, const bool bWasSuccessful)
+	{
+		Metrics->EndOperation(EDustLinkSessionOperation::Find, bWasSuccessful);
+	});
+
+	DustLinkOnJoinSessionComplete.AddWeakLambda(this, [this](const EOnJoinSessionCompleteResult::Type Result)
+	{
+		Metrics->EndOperation(EDustLinkSessionOperation::Join, Result == EOnJoinSessionCompleteResult::Success);
+		OnJoinPhaseComplete(Result == EOnJoinSessionCompleteResult::Success);
+	});
+
+	DustLinkOnConnectInfoResolved.AddWeakLambda(this, [this](const FString&, const bool bWasSuccessful)
+	{
+		OnJoinPhaseComplete(bWasSuccessful);
+	});
+
+	FDustLinkSloSettings SloSettings;
+	SloSettings.bCaptureTrace = FParse::Param(FCommandLine::Get(), TEXT("DustLinkSloTrace"));
+
+	SloWatchdog = MakeUnique<FDustLinkSloWatchdog>(Metrics, SloSettings);
+	SloWatchdog->OnSloBreached.AddWeakLambda(this, [this](const FDustLinkSlo& Slo, const double ObservedMs, const FString& SnapshotPath)
+	{
+		DustLinkOnSloBreached.Broadcast(Slo, ObservedMs, SnapshotPath);
+	});
+
+	Metrics->OnTelemetryEvent.AddUObject(this, &ThisClass::OnTelemetryEvent);
+
+	if (FParse::Param(FCommandLine::Get(), TEXT("DustLinkAnalyticsFile")))
+	{
+		SetAnalyticsProvider(MakeShared<FDustLinkFileAnalyticsProvider>());
+	}
+
+	if (uint32 MetricsPort = 0; FParse::Value(FCommandLine::Get(), TEXT("DustLinkMetricsPort="), MetricsPort))
+	{
+		MetricsServer = MakeUnique<FDustLinkMetricsServer>(Metrics);
+		MetricsServer->OnMetricsRequested.BindUObject(this, &ThisClass::CollectMetrics);
+		MetricsServer->Start(MetricsPort);
+	}
+
+	if (uint32 ListingServerPort = 0; FParse::Value(FCommandLine::Get(), TEXT("DustLinkListingServerPort="), ListingServerPort))
+	{
+		ListingServer = MakeUnique<FDustLinkListingServer>();
+		ListingServer->Start(ListingServerPort);
+	}
+
+	if (uint32 ControlPort = 0; FParse::Value(FCommandLine::Get(), TEXT("DustLinkControlPort="), ControlPort))
+	{
+		FParse::Value(FCommandLine::Get(), TEXT("DustLinkPublicAddress="), PublicAddress);
+
+		ServerControl = MakeUnique<FDustLinkServerControl>();
+		ServerControl->OnMatchConfigReceived.BindUObject(this, &ThisClass::HostMatch);
+		ServerControl->OnMatchReleased.BindUObject(this, &ThisClass::ReleaseMatch);
+		DustLinkOnCreateSessionCompleteNative.AddUObject(this, &ThisClass::OnHostedMatchCreated);
+		ServerControl->Start(ControlPort);
+	}
+
+	// Every game mode broadcasts its pre-login, so allocated servers admit players whichever game mode the match map uses
+	GameModePreLoginHandle = FGameModeEvents::GameModePreLoginEvent.AddUObject(this, &ThisClass::OnGameModePreLogin);
+
+	if (FString ListingUrl; FParse::Value(FCommandLine::Get(), TEXT("DustLinkListingUrl="), ListingUrl))
+	{
+		ListingProvider = MakeShared<FDustLinkHttpListingProvider>(ListingUrl);
+	}
+
+	if (FString MockFriendsPath; FParse::Value(FCommandLine::Get(), TEXT("DustLinkMockPresence="), MockFriendsPath))
+	{
+		UseMockPresenceProvider()->LoadFromFile(MockFriendsPath);
+	}
+	else if (FParse::Param(FCommandLine::Get(), TEXT("DustLinkMockPresence")))
+	{
+		UseMockPresenceProvider();
+	}
+
+	NetworkBenchmark.SetProfile(NetworkProfile.Name);
+	PendingNetGameConnectionCreatedHandle = FNetDelegates::OnPendingNetGameConnectionCreated.AddUObject(this, &ThisClass::OnPendingNetGameConnectionCreated);
+
+#if !UE_BUILD_SHIPPING
+	if (FString ProfileName; FParse::Value(FCommandLine::Get(), TEXT("DustLinkNetProfile="), ProfileName) && !SetNetworkProfile(ProfileName))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("%s: Unknown network profile %s."), *GetClass()->GetName(), *ProfileName);
+	}
+#endif
+
+	// The soak needs a world that began play, which does not exist yet while the game instance initializes
+	if (int32 SoakCycles = 0; FParse::Value(FCommandLine::Get(), TEXT("DustLinkSoak="), SoakCycles) && SoakCycles > 0)
+	{
+		FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateWeakLambda(this, [this, SoakCycles](float)
+		{
+			const UWorld* World = GetWorld();
+
+			if (!World || !World->HasBegunPlay()) return true;
+
+			FDustLinkSoakSettings SoakSettings;
+			SoakSettings.NumCycles = SoakCycles;
+
+			if (const TSharedPtr<FDustLinkSoakTest> Soak = StartSoakTest(SoakSettings))
+			{
+				Soak->OnComplete.AddLambda([](const bool bPassed, const FString&) { FPlatformMisc::RequestExitWithStatus(false, bPassed ? 0 : 1); });
+			}
+
+			return false;
+		}), 0.5f);
+	}
+
+	TravelMemoryScheduler = MakeUnique<FDustLinkTravelMemoryScheduler>(GetGameInstance());
+	TravelMemoryScheduler->OnPreTravel.AddWeakLambda(this, [this](const FString& MapName)
+	{
+		Metrics->EndPhase(EDustLinkLatencyPhase::Travel, true);
+		Metrics->BeginPhase(EDustLinkLatencyPhase::Load);
+
+		DustLinkOnPreTravel.Broadcast(MapName);
+	});
+
+	TravelMemoryScheduler->OnPostTravel.AddWeakLambda(this, [this](UWorld*)
+	{
+		Metrics->EndPhase(EDustLinkLatencyPhase::Load, true);
+
+		// A listen server opened a new net driver with the map, a client keeps the one of its join
+		ApplyNetworkProfile();
+
+		// The loaded map references its own packages now, the preload only has to last until here
+		CancelContentWarmup();
+
+		if (PendingMatchConnectInfo.IsSet() && ServerControl)
+		{
+			const FString ConnectInfo = PendingMatchConnectInfo.GetValue();
+			PendingMatchConnectInfo.Reset();
+
+			ServerControl->CompleteMatch(true, ConnectInfo);
+		}
+
+		if (bIsReleaseAwaitingIdleMap)
+		{
+			bIsReleaseAwaitingIdleMap = false;
+			CompleteReleaseIfDone();
+		}
+	});
+}
+
+/**
+ * @brief Releases timers and bindings owned by the subsystem.
+ *
+ * Called by the game instance when the subsystem is about to be destroyed.
+ */
+void UDustLinkSubsystem::Deinitialize()
+{
+	if (SoakTest) SoakTest->Abort(TEXT("the subsystem was deinitialized"));
+
+	StopAutoRefresh();
+	StopLoadMonitor();
+	SetVisibleSessions(TArray<FString>());
+	UnregisterJoinCode();
+
+	if (ListingServer) ListingServer->Stop();
+	if (ServerControl) ServerControl->Stop();
+	if (MetricsServer) MetricsServer->Stop();
+
+	FGameModeEvents::GameModePreLoginEvent.Remove(GameModePreLoginHandle);
+	FNetDelegates::OnPendingNetGameConnectionCreated.Remove(PendingNetGameConnectionCreatedHandle);
+
+	TravelMemoryScheduler.Reset();
+	ContentWarmup.Reset();
+	SloWatchdog.Reset();
+	SetAnalyticsProvider(nullptr);
+	Metrics->OnTelemetryEvent.RemoveAll(this);
+
+	if (OnlineSessionInterface.IsValid())
+	{
+		OnlineSessionInterface->ClearOnSessionUserInviteAcceptedDelegate_Handle(SessionUserInviteAcceptedDelegateHandle);
+	}
+
+	Super::Deinitialize();
+}
+
 /**
  * @brief Initializes the OnlineSessionInterface.
  *
@@ -55,6 +440,8 @@ void UDustLinkSubsystem::InitializeOnlineSessionInterface()
  * @brief Creates a new online session.
  * 
  * This method initializes a new session with the specified number of public connections and match type.
+ * If the local player already hosts a session that is not in progress, its settings are updated
+ * instead of destroying and recreating it.
  * 
  * @param NumPublicConnections The number of available slots for players in the session.
  * @param MatchType A string identifier for the type of match (e.g., "Deathmatch", "Coop").
@@ -67,6 +454,21 @@ void UDustLinkSubsystem::CreateSession(const int32 NumPublicConnections, const F
 		return;
 	}
 
+	Metrics->BeginOperation(EDustLinkSessionOperation::Create);
+
+	// Reuse the hosted session between matches instead of destroying and recreating it
+	if (const FNamedOnlineSession* ExistingSession = OnlineSessionInterface->GetNamedSession(NAME_GameSession);
+		ExistingSession && ExistingSession->bHosting && ExistingSession->SessionState != EOnlineSessionState::InProgress)
+	{
+		bCreateSessionOnUpdate = true;
+		CreateSessionSettings(NumPublicConnections, MatchType);
+
+		if (!JoinCode.IsEmpty()) LastSessionSettings->Set(FName("JoinCode"), JoinCode, EOnlineDataAdvertisementType::DontAdvertise);
+
+		UpdateSession();
+		return;
+	}
+
 	// Destroy existing session
 	if (OnlineSessionInterface->GetNamedSession(NAME_GameSession))
 	{
@@ -80,12 +482,26 @@ void UDustLinkSubsystem::CreateSession(const int32 NumPublicConnections, const F
 	// Store the registered Delegate, so that it can be later removed from delegate list
 	CreateSessionCompleteDelegateHandle = OnlineSessionInterface->AddOnCreateSessionCompleteDelegate_Handle(CreateSessionCompleteDelegate);
 	CreateSessionSettings(NumPublicConnections, MatchType);
+	JoinCode = DustLinkJoinCode::Generate();
+	JoinCodeSecret.Reset();
+
+	// The code is private to the host, players reach it through the listing provider and never through a search
+	LastSessionSettings->Set(FName("JoinCode"), JoinCode, EOnlineDataAdvertisementType::DontAdvertise);
 
-	if (const ULocalPlayer* LocalPlayer = GetWorld()->GetFirstLocalPlayerFromController(); !OnlineSessionInterface->CreateSession(*LocalPlayer->GetPreferredUniqueNetId(), NAME_GameSession, *LastSessionSettings))
+	// Dedicated servers have no local player and host as the server's own identity, player index 0 if it has none
+	const ULocalPlayer* LocalPlayer = GetWorld()->GetFirstLocalPlayerFromController();
+	const IOnlineIdentityPtr IdentityInterface = IsRunningDedicatedServer() ? Online::GetIdentityInterface(GetWorld()) : nullptr;
+	const FUniqueNetIdPtr HostId = LocalPlayer ? LocalPlayer->GetPreferredUniqueNetId().GetUniqueNetId() : IdentityInterface.IsValid() ? IdentityInterface->GetUniquePlayerId(0) : nullptr;
+
+	const bool bIsCreating = HostId.IsValid()
+		? OnlineSessionInterface->CreateSession(*HostId, NAME_GameSession, *LastSessionSettings)
+		: OnlineSessionInterface->CreateSession(0, NAME_GameSession, *LastSessionSettings);
+
+	if (!bIsCreating)
 	{
 		UE_LOG(LogTemp, Warning, TEXT("%s: Couldn't create session."), *GetClass()->GetName());
 		OnlineSessionInterface->ClearOnCreateSessionCompleteDelegate_Handle(CreateSessionCompleteDelegateHandle);
-		DustLinkOnCreateSessionComplete.Broadcast(false);
+		BroadcastSessionEvent(DustLinkOnCreateSessionCompleteNative, DustLinkOnCreateSessionComplete, false);
 	}
 }
 
@@ -106,10 +522,17 @@ void UDustLinkSubsystem::CreateSessionSettings(const int32 NumPublicConnections,
 	LastSessionSettings->bAllowJoinInProgress = true;
 	LastSessionSettings->bAllowJoinInProgress = true;
 	LastSessionSettings->bShouldAdvertise = true;
-	LastSessionSettings->bUsesPresence = true;
-	LastSessionSettings->bUseLobbiesIfAvailable = true;
 	LastSessionSettings->BuildUniqueId = 1;
+
+	// Headless servers have no user to attach presence or a lobby to, backends such as Steam refuse such sessions
+	LastSessionSettings->bIsDedicated = IsRunningDedicatedServer();
+	LastSessionSettings->bUsesPresence = !LastSessionSettings->bIsDedicated;
+	LastSessionSettings->bUseLobbiesIfAvailable = !LastSessionSettings->bIsDedicated;
 	LastSessionSettings->Set(FName("MatchType"), MatchType, EOnlineDataAdvertisementType::ViaOnlineServiceAndPing);
+
+	if (!MatchMap.IsEmpty()) LastSessionSettings->Set(FName("MatchMap"), MatchMap, EOnlineDataAdvertisementType::ViaOnlineService);
+
+	FDustLinkContentManifest::Build(MatchMap).ToSessionSettings(*LastSessionSettings);
 }
 
 /**
@@ -120,6 +543,18 @@ void UDustLinkSubsystem::CreateSessionSettings(const int32 NumPublicConnections,
  * @param MaxSearchResults The maximum number of results to retrieve.
  */
 void UDustLinkSubsystem::FindSessions(const int32 MaxSearchResults)
+{
+	Metrics->BeginPhase(EDustLinkLatencyPhase::Search);
+	StartSessionSearch(MaxSearchResults, false);
+}
+
+/**
+ * @brief Queries the online subsystem for sessions, shared by player searches and background refreshes.
+ *
+ * @param MaxSearchResults The maximum number of results to retrieve.
+ * @param bIsBackgroundRefresh Whether the search is a background refresh rather than a player's search.
+ */
+void UDustLinkSubsystem::StartSessionSearch(const int32 MaxSearchResults, const bool bIsBackgroundRefresh)
 {
 	if (!OnlineSessionInterface.IsValid())
 	{
@@ -127,6 +562,9 @@ void UDustLinkSubsystem::FindSessions(const int32 MaxSearchResults)
 		return;
 	}
 
+	Metrics->BeginOperation(EDustLinkSessionOperation::Find);
+	bIsBackgroundSearch = bIsBackgroundRefresh;
+
 	FindSessionsCompleteDelegateHandle = OnlineSessionInterface->AddOnFindSessionsCompleteDelegate_Handle(FindSessionsCompleteDelegate);
 	
 	LastSessionSearch = MakeShareable(new FOnlineSessionSearch());
@@ -137,8 +575,27 @@ void UDustLinkSubsystem::FindSessions(const int32 MaxSearchResults)
 	if (const ULocalPlayer* LocalPlayer = GetWorld()->GetFirstLocalPlayerFromController(); !OnlineSessionInterface->FindSessions(*LocalPlayer->GetPreferredUniqueNetId(), LastSessionSearch.ToSharedRef()))
 	{
 		OnlineSessionInterface->ClearOnFindSessionsCompleteDelegate_Handle(FindSessionsCompleteDelegateHandle);
-		DustLinkOnFindSessionsComplete.Broadcast(TArray<FOnlineSessionSearchResult>(), false);
+		BroadcastSearchComplete(TArray<FOnlineSessionSearchResult>(), false);
+
+		if (bAutoRefreshEnabled) ScheduleAutoRefresh(0.f);
+	}
+}
+
+/**
+ * @brief Broadcasts the outcome of a search to the delegate matching its origin.
+ *
+ * @param SessionResults The found sessions.
+ * @param bWasSuccessful Whether the search succeeded.
+ */
+void UDustLinkSubsystem::BroadcastSearchComplete(const TArray<FOnlineSessionSearchResult>& SessionResults, const bool bWasSuccessful)
+{
+	if (bIsBackgroundSearch)
+	{
+		DustLinkOnSessionsRefreshed.Broadcast(SessionResults, bWasSuccessful);
+		return;
 	}
+
+	DustLinkOnFindSessionsComplete.Broadcast(SessionResults, bWasSuccessful);
 }
 
 /**
@@ -150,6 +607,11 @@ void UDustLinkSubsystem::FindSessions(const int32 MaxSearchResults)
  */
 void UDustLinkSubsystem::JoinSession(FOnlineSessionSearchResult& SessionResult)
 {
+	Metrics->BeginOperation(EDustLinkSessionOperation::Join);
+
+	// Accepted invites already started the phase before leaving the previous session
+	if (!Metrics->IsPhaseRunning(EDustLinkLatencyPhase::Join)) Metrics->BeginPhase(EDustLinkLatencyPhase::Join);
+
 	if (!OnlineSessionInterface.IsValid())
 	{
 		DustLinkOnJoinSessionComplete.Broadcast(EOnJoinSessionCompleteResult::UnknownError);
@@ -160,6 +622,12 @@ void UDustLinkSubsystem::JoinSession(FOnlineSessionSearchResult& SessionResult)
 	SessionResult.Session.SessionSettings.bUsesPresence = true;
 	SessionResult.Session.SessionSettings.bUseLobbiesIfAvailable = true;
 
+	// Start fetching missing chunks now so they are mounted by the time the client travels
+	if (FDustLinkContentManifest Manifest; FDustLinkContentManifest::FromSessionSettings(SessionResult.Session.SessionSettings, Manifest))
+	{
+		Manifest.RequestContent();
+	}
+
 	JoinSessionCompleteDelegateHandle = OnlineSessionInterface->AddOnJoinSessionCompleteDelegate_Handle(JoinSessionCompleteDelegate);
 
 	if (const ULocalPlayer* LocalPlayer = GetWorld()->GetFirstLocalPlayerFromController(); !OnlineSessionInterface->JoinSession(*LocalPlayer->GetPreferredUniqueNetId(), NAME_GameSession, SessionResult))
@@ -176,20 +644,20 @@ void UDustLinkSubsystem::JoinSession(FOnlineSessionSearchResult& SessionResult)
  */
 void UDustLinkSubsystem::DestroySession()
 {
+	Metrics->BeginOperation(EDustLinkSessionOperation::Destroy);
+
 	if (!OnlineSessionInterface.IsValid())
 	{
-		DustLinkOnDestroySessionComplete.Broadcast(false);
+		BroadcastSessionEvent(DustLinkOnDestroySessionCompleteNative, DustLinkOnDestroySessionComplete, false);
 		UE_LOG(LogTemp, Warning, TEXT("%s: Session is no longer valid to process deletion."), *GetClass()->GetName());
 		return;
 	}
 
+	UnregisterJoinCode();
+
 	DestroySessionCompleteDelegateHandle = OnlineSessionInterface->AddOnDestroySessionCompleteDelegate_Handle(DestroySessionCompleteDelegate);
 
-	if (!OnlineSessionInterface->DestroySession(NAME_GameSession))
-	{
-		OnlineSessionInterface->ClearOnDestroySessionCompleteDelegate_Handle(DestroySessionCompleteDelegateHandle);
-		DustLinkOnDestroySessionComplete.Broadcast(false);
-	}
+	if (!OnlineSessionInterface->DestroySession(NAME_GameSession)) OnDestroySessionComplete(NAME_GameSession, false);
 }
 
 /**
@@ -206,118 +674,1504 @@ void UDustLinkSubsystem::StartSession()
 		return;
 	}
 
+	Metrics->BeginOperation(EDustLinkSessionOperation::Start);
+
 	StartSessionCompleteDelegateHandle = OnlineSessionInterface->AddOnStartSessionCompleteDelegate_Handle(StartSessionCompleteDelegate);
 
 	if (!OnlineSessionInterface->StartSession(NAME_GameSession))
 	{
 		OnlineSessionInterface->ClearOnStartSessionCompleteDelegate_Handle(StartSessionCompleteDelegateHandle);
-		DustLinkOnStartSessionComplete.Broadcast(false);
+		BroadcastSessionEvent(DustLinkOnStartSessionCompleteNative, DustLinkOnStartSessionComplete, false);
 	}
 }
 
 /**
- * @brief Callback for when session creation is complete.
+ * @brief Ends the current session without destroying it.
  *
- * This method is triggered by the `FOnCreateSessionCompleteDelegate` when the session creation process finishes.
- * 
- * @param SessionName The name of the session that was created.
- * @param bWasSuccessful Whether the session creation was successful.
+ * Marks the match as over while keeping the backend session, so it can be started again
+ * for the next match.
  */
-void UDustLinkSubsystem::OnCreateSessionComplete(FName SessionName, const bool bWasSuccessful)
+void UDustLinkSubsystem::EndSession()
 {
-	if (!OnlineSessionInterface)
+	Metrics->BeginOperation(EDustLinkSessionOperation::End);
+
+	if (!OnlineSessionInterface.IsValid())
 	{
-		UE_LOG(LogTemp, Warning, TEXT("%s: Session Interface is not defined."), *GetClass()->GetName());
+		BroadcastSessionEvent(DustLinkOnEndSessionCompleteNative, DustLinkOnEndSessionComplete, false);
+		UE_LOG(LogTemp, Warning, TEXT("%s: Session is no longer valid to process session end."), *GetClass()->GetName());
 		return;
 	}
-	
-	OnlineSessionInterface->ClearOnCreateSessionCompleteDelegate_Handle(CreateSessionCompleteDelegateHandle);
-	DustLinkOnCreateSessionComplete.Broadcast(bWasSuccessful);
+
+	EndSessionCompleteDelegateHandle = OnlineSessionInterface->AddOnEndSessionCompleteDelegate_Handle(EndSessionCompleteDelegate);
+
+	if (!OnlineSessionInterface->EndSession(NAME_GameSession))
+	{
+		OnlineSessionInterface->ClearOnEndSessionCompleteDelegate_Handle(EndSessionCompleteDelegateHandle);
+		OnEndSessionComplete(NAME_GameSession, false);
+	}
 }
 
 /**
- * @brief Callback for when session search is complete.
- *
- * This method is triggered by the `FOnFindSessionsCompleteDelegate` when the session search process finishes.
- * 
- * @param bWasSuccessful Whether the session search was successful.
+ * @brief Pushes the settings stored in `LastSessionSettings` to the current session.
  */
-void UDustLinkSubsystem::OnFindSessionComplete(bool bWasSuccessful)
+void UDustLinkSubsystem::UpdateSession()
 {
-	if (!OnlineSessionInterface)
+	Metrics->BeginOperation(EDustLinkSessionOperation::Update);
+
+	if (!OnlineSessionInterface.IsValid() || !LastSessionSettings.IsValid())
 	{
-		UE_LOG(LogTemp, Warning, TEXT("%s: Session Interface is not defined."), *GetClass()->GetName());
+		UE_LOG(LogTemp, Warning, TEXT("%s: Session is no longer valid to process session update."), *GetClass()->GetName());
+		OnUpdateSessionComplete(NAME_GameSession, false);
 		return;
 	}
-	
-	if (LastSessionSearch->SearchResults.Num() <= 0) bWasSuccessful = false;
 
-	OnlineSessionInterface->ClearOnFindSessionsCompleteDelegate_Handle(FindSessionsCompleteDelegateHandle);
-	DustLinkOnFindSessionsComplete.Broadcast(LastSessionSearch->SearchResults, bWasSuccessful);
+	UpdateSessionCompleteDelegateHandle = OnlineSessionInterface->AddOnUpdateSessionCompleteDelegate_Handle(UpdateSessionCompleteDelegate);
+
+	if (!OnlineSessionInterface->UpdateSession(NAME_GameSession, *LastSessionSettings, true))
+	{
+		OnlineSessionInterface->ClearOnUpdateSessionCompleteDelegate_Handle(UpdateSessionCompleteDelegateHandle);
+		OnUpdateSessionComplete(NAME_GameSession, false);
+	}
 }
 
 /**
- * @brief Callback for when joining a session is complete.
+ * @brief Ends the current match and brings the party back to the lobby, keeping the same backend session.
  *
- * This method is triggered by the `FOnJoinSessionCompleteDelegate` when joining a session finishes.
- * 
- * @param SessionName The name of the session that was joined.
- * @param Result The result of the join operation, indicating success or the type of failure.
+ * Ends the session, re-opens it for joining through `UpdateSession` and travels to the lobby. Compared to
+ * destroying and recreating the session this saves two backend round trips, and with seamless travel
+ * enabled on the game mode the party stays connected. Call `StartSession` again when the next match begins.
+ *
+ * @param LobbyPath The path to the lobby level, e.g. "/Game/ThirdPerson/Maps/Lobby".
  */
-void UDustLinkSubsystem::OnJoinSessionComplete(FName SessionName, EOnJoinSessionCompleteResult::Type Result)
+void UDustLinkSubsystem::ReturnToLobby(const FString& LobbyPath)
 {
-	if (!OnlineSessionInterface)
+	const FNamedOnlineSession* Session = OnlineSessionInterface.IsValid() ? OnlineSessionInterface->GetNamedSession(NAME_GameSession) : nullptr;
+
+	if (!Session || !Session->bHosting)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("%s: Session Interface is not defined."), *GetClass()->GetName());
+		UE_LOG(LogTemp, Warning, TEXT("%s: Only the host of a session can return it to the lobby."), *GetClass()->GetName());
 		return;
 	}
 
-	OnlineSessionInterface->ClearOnJoinSessionCompleteDelegate_Handle(JoinSessionCompleteDelegateHandle);
-	DustLinkOnJoinSessionComplete.Broadcast(Result);
+	PendingLobbyPath = LobbyPath;
+
+	// Re-open the session for players joining between matches
+	LastSessionSettings = MakeShared<FOnlineSessionSettings>(Session->SessionSettings);
+	LastSessionSettings->bAllowJoinInProgress = true;
+	LastSessionSettings->bShouldAdvertise = true;
+
+	if (Session->SessionState == EOnlineSessionState::InProgress)
+	{
+		EndSession();
+		return;
+	}
+
+	UpdateSession();
 }
 
 /**
- * @brief Callback for when session destruction is complete.
+ * @brief Advertises the map of the next match in the session settings.
  *
- * This method is triggered by the `FOnDestroySessionCompleteDelegate` when the session destruction process finishes.
- * 
- * @param SessionName The name of the session that was destroyed.
- * @param bWasSuccessful Whether the session was successfully destroyed.
+ * Lobbies read it to travel to the match and to preload its content during the countdown.
+ * If a session is already hosted, its settings are updated.
+ *
+ * @param MapPath The path to the match level, e.g. "/Game/ThirdPerson/Maps/ThirdPerson".
  */
-void UDustLinkSubsystem::OnDestroySessionComplete(FName SessionName, const bool bWasSuccessful)
+void UDustLinkSubsystem::SetMatchMap(const FString& MapPath)
 {
-	if (!OnlineSessionInterface)
-	{
-		UE_LOG(LogTemp, Warning, TEXT("%s: Session Interface is not defined."), *GetClass()->GetName());
-		return;
-	}
+	MatchMap = MapPath;
 
-	OnlineSessionInterface->ClearOnDestroySessionCompleteDelegate_Handle(DestroySessionCompleteDelegateHandle);
-	DustLinkOnDestroySessionComplete.Broadcast(bWasSuccessful);
+	const FNamedOnlineSession* Session = OnlineSessionInterface.IsValid() ? OnlineSessionInterface->GetNamedSession(NAME_GameSession) : nullptr;
 
-	if (bWasSuccessful && bCreateSessionOnDestroy)
-	{
-		bCreateSessionOnDestroy = false;
-		CreateSession(LastNumPublicConnections, LastMatchType);
-	}
+	if (!Session || !Session->bHosting) return;
+
+	LastSessionSettings = MakeShared<FOnlineSessionSettings>(Session->SessionSettings);
+	LastSessionSettings->Set(FName("MatchMap"), MatchMap, EOnlineDataAdvertisementType::ViaOnlineService);
+	FDustLinkContentManifest::Build(MatchMap).ToSessionSettings(*LastSessionSettings);
+
+	UpdateSession();
 }
 
 /**
- * @brief Callback for when session start is complete.
+ * @brief Marks whether the player idles in a menu or lobby, where garbage is collected on a timer.
  *
- * This method is triggered by the `FOnStartSessionCompleteDelegate` when the session start process finishes.
- * 
- * @param SessionName The name of the session that was started.
- * @param bWasSuccessful Whether the session was successfully started.
+ * Menus and lobbies set it when they open, it is cleared on join, on session start and whenever a map starts loading.
+ *
+ * @param bIsIdle Whether the player is idle.
  */
-void UDustLinkSubsystem::OnStartSessionComplete(FName SessionName, bool bWasSuccessful)
+void UDustLinkSubsystem::SetIdle(const bool bIsIdle)
 {
-	if (!OnlineSessionInterface)
-	{
-		UE_LOG(LogTemp, Warning, TEXT("%s: Session Interface is not defined."), *GetClass()->GetName());
-		return;
-	}
+	if (TravelMemoryScheduler) TravelMemoryScheduler->SetIdle(bIsIdle);
+}
 
-	OnlineSessionInterface->ClearOnStartSessionCompleteDelegate_Handle(StartSessionCompleteDelegateHandle);
-	DustLinkOnStartSessionComplete.Broadcast(bWasSuccessful);
+/**
+ * @brief Starts warming up the content of the next match, e.g. when the lobby countdown starts.
+ *
+ * The warmup outlives the lobby world, so the preloaded map stays resident through travel
+ * and is only released once the next map finished loading.
+ *
+ * @param MapPath The path to the match level, optionally followed by URL options.
+ */
+void UDustLinkSubsystem::BeginContentWarmup(const FString& MapPath)
+{
+	if (!ContentWarmup.IsValid()) ContentWarmup = MakeShared<FDustLinkContentWarmup>();
+
+	ContentWarmup->Begin(MapPath);
+}
+
+/**
+ * @brief Stops warming up and releases the preloaded match content, e.g. when the countdown was cancelled.
+ */
+void UDustLinkSubsystem::CancelContentWarmup()
+{
+	if (ContentWarmup.IsValid()) ContentWarmup->Cancel();
+}
+
+/**
+ * @brief Looks up a session from the most recent search by its identifier.
+ *
+ * Intended for widgets that patch individual rows in response to `DustLinkOnSessionListChanged`.
+ *
+ * @param SessionId The identifier reported by the session list diff.
+ * @return The stored search result, or `nullptr` if the session is not part of the current result store.
+ */
+const FOnlineSessionSearchResult* UDustLinkSubsystem::FindSessionResult(const FString& SessionId) const
+{
+	return SessionResultStore.Find(SessionId);
+}
+
+/**
+ * @brief Returns the most recent ping of a session from the result store.
+ *
+ * @param SessionId The identifier reported by the session list diff.
+ * @return The latest probe of the session if it was probed, otherwise the ping reported by the search, or `-1` if unknown.
+ */
+int32 UDustLinkSubsystem::GetSessionPing(const FString& SessionId) const
+{
+	if (const int32* ProbedPing = ProbedPings.Find(SessionId)) return *ProbedPing;
+
+	const FOnlineSessionSearchResult* Result = SessionResultStore.Find(SessionId);
+
+	return Result ? Result->PingInMs : -1;
+}
+
+/**
+ * @brief Enables the adaptive background refresh of the server list.
+ *
+ * Re-queries sessions on an interval computed by `FDustLinkRefreshPolicy` from the churn seen in recent
+ * diffs. The interval backs off while the list is stable or the window is unfocused and shrinks while
+ * sessions are turning over. Results are delivered through the regular search delegates.
+ *
+ * @param MaxSearchResults The maximum number of results to retrieve on every refresh.
+ * @param Settings Tuning parameters for the refresh interval.
+ */
+void UDustLinkSubsystem::StartAutoRefresh(const int32 MaxSearchResults, const FDustLinkRefreshPolicySettings& Settings)
+{
+	const UGameInstance* GameInstance = GetGameInstance();
+
+	if (!GameInstance)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("%s: Failed to retrieve Game Instance."), *GetClass()->GetName());
+		return;
+	}
+
+	bAutoRefreshEnabled = true;
+	AutoRefreshMaxSearchResults = MaxSearchResults;
+	AutoRefreshPolicy = FDustLinkRefreshPolicy(Settings);
+
+	GameInstance->GetTimerManager().SetTimer(AutoRefreshTimerHandle, this, &ThisClass::OnAutoRefreshTimer, AutoRefreshPolicy.GetInterval(), false);
+}
+
+/**
+ * @brief Disables the adaptive background refresh of the server list.
+ */
+void UDustLinkSubsystem::StopAutoRefresh()
+{
+	bAutoRefreshEnabled = false;
+
+	if (const UGameInstance* GameInstance = GetGameInstance())
+	{
+		GameInstance->GetTimerManager().ClearTimer(AutoRefreshTimerHandle);
+	}
+}
+
+/**
+ * @brief Schedules the next background refresh based on the outcome of the last search.
+ *
+ * @param Churn Fraction of sessions that appeared or disappeared in the last search.
+ */
+void UDustLinkSubsystem::ScheduleAutoRefresh(const float Churn)
+{
+	const UGameInstance* GameInstance = GetGameInstance();
+
+	if (!GameInstance) return;
+
+	const float Interval = AutoRefreshPolicy.OnSearchComplete(Churn, IsApplicationFocused());
+	GameInstance->GetTimerManager().SetTimer(AutoRefreshTimerHandle, this, &ThisClass::OnAutoRefreshTimer, Interval, false);
+}
+
+/**
+ * @brief Timer callback that issues a background refresh.
+ *
+ * Skips the refresh while a search is still in flight, that search's completion schedules the next one.
+ */
+void UDustLinkSubsystem::OnAutoRefreshTimer()
+{
+	if (!bAutoRefreshEnabled) return;
+
+	// A search started by the menu is still running, its completion will reschedule the refresh
+	if (FindSessionsCompleteDelegateHandle.IsValid()) return;
+
+	if (!OnlineSessionInterface.IsValid())
+	{
+		ScheduleAutoRefresh(0.f);
+		return;
+	}
+
+	StartSessionSearch(AutoRefreshMaxSearchResults, true);
+}
+
+/**
+ * @brief Returns `true` if the game window has focus or no window exists (e.g. dedicated servers).
+ */
+bool UDustLinkSubsystem::IsApplicationFocused()
+{
+	return !FSlateApplication::IsInitialized() || FSlateApplication::Get().IsActive();
+}
+
+/**
+ * @brief Reports which server browser rows are currently visible.
+ *
+ * Only these sessions, plus a small lookahead following the last visible row, are re-probed on a
+ * rolling schedule with limited concurrency. Passing an empty array stops probing.
+ *
+ * @param VisibleSessionIds The identifiers of the sessions displayed by the server browser.
+ */
+void UDustLinkSubsystem::SetVisibleSessions(const TArray<FString>& VisibleSessionIds)
+{
+	const UGameInstance* GameInstance = GetGameInstance();
+
+	if (!GameInstance) return;
+
+	PingScheduler.SetVisibleSessions(VisibleSessionIds, SessionResultOrder);
+
+	FTimerManager& TimerManager = GameInstance->GetTimerManager();
+
+	if (!PingScheduler.HasCandidates())
+	{
+		TimerManager.ClearTimer(PingTimerHandle);
+		return;
+	}
+
+	if (!TimerManager.IsTimerActive(PingTimerHandle))
+	{
+		TimerManager.SetTimer(PingTimerHandle, this, &ThisClass::OnPingTimer, PingScheduler.GetSettings().TickInterval, true, 0.f);
+	}
+}
+
+/**
+ * @brief Timer callback that starts the probes that are due on the rolling ping schedule.
+ */
+void UDustLinkSubsystem::OnPingTimer()
+{
+	if (!OnlineSessionInterface.IsValid()) return;
+
+	for (const FString& SessionId : PingScheduler.CollectDueProbes(FPlatformTime::Seconds()))
+	{
+		const FOnlineSessionSearchResult* Result = SessionResultStore.Find(SessionId);
+		ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+		FString Address;
+
+		if (!Result || !SocketSubsystem || !OnlineSessionInterface->GetResolvedConnectString(*Result, NAME_GamePort, Address))
+		{
+			OnPingProbeComplete(SessionId, false, true, 0);
+			continue;
+		}
+
+		// ICMP probes the host only, the parsed address drops the game port and handles IPv6 literals
+		const TSharedPtr<FInternetAddr> HostAddr = SocketSubsystem->GetAddressFromString(Address);
+
+		if (!HostAddr.IsValid() || !HostAddr->IsValid())
+		{
+			OnPingProbeComplete(SessionId, false, true, 0);
+			continue;
+		}
+
+		const FString Host = HostAddr->ToString(false);
+
+		TWeakObjectPtr<UDustLinkSubsystem> WeakThis(this);
+
+		FIcmp::IcmpEcho(Host, PingScheduler.GetSettings().ProbeTimeout, [WeakThis, SessionId](const FIcmpEchoResult EchoResult)
+		{
+			UDustLinkSubsystem* Subsystem = WeakThis.Get();
+
+			if (!Subsystem) return;
+
+			const bool bIsUnpingable = EchoResult.Status == EIcmpResponseStatus::Unresolvable ||
+				EchoResult.Status == EIcmpResponseStatus::NotImplemented;
+
+			Subsystem->OnPingProbeComplete(SessionId, EchoResult.Status == EIcmpResponseStatus::Success, bIsUnpingable, FMath::RoundToInt(EchoResult.Time * 1000.f));
+		});
+	}
+}
+
+/**
+ * @brief Callback for when a ping probe of a session finishes.
+ *
+ * @param SessionId The identifier of the probed session.
+ * @param bWasSuccessful Whether the probe received a reply.
+ * @param bIsUnpingable Whether the address of the session cannot be probed at all.
+ * @param PingInMs The measured round trip time in milliseconds.
+ */
+void UDustLinkSubsystem::OnPingProbeComplete(const FString& SessionId, const bool bWasSuccessful, const bool bIsUnpingable, const int32 PingInMs)
+{
+	PingScheduler.OnProbeComplete(SessionId);
+
+	if (bIsUnpingable) PingScheduler.MarkUnpingable(SessionId);
+
+	if (!bWasSuccessful || !SessionResultStore.Contains(SessionId)) return;
+
+	// Kept apart from the search snapshot, so a measured ping never shows up as a changed row in the next diff
+	ProbedPings.Add(SessionId, PingInMs);
+	DustLinkOnSessionPingUpdated.Broadcast(SessionId, PingInMs);
+}
+
+/**
+ * @brief Checks whether a connecting player may join, called for the pre-login of every game mode.
+ *
+ * Players are refused while the host is over its tick budget and, on servers that were handed a
+ * match with a player list, unless they present the admission token the allocator issued for them.
+ * A token admits its player once and is consumed by the admission. Matches without tokens admit the
+ * listed players by unique net ID.
+ *
+ * @param Options The URL options of the connecting player, which may carry `DustLinkPlayer=<Id>?DustLinkToken=<Token>`.
+ * @param UniqueId The unique net ID of the connecting player.
+ * @param OutErrorMessage Set to the reason the player is refused.
+ * @return `true` if the player may join.
+ */
+bool UDustLinkSubsystem::CanAdmitPlayer(const FString& Options, const FUniqueNetIdRepl& UniqueId, FString& OutErrorMessage)
+{
+	if (!AdmissionController.IsAdmitting())
+	{
+		OutErrorMessage = TEXT("Server is busy, try again shortly.");
+		return false;
+	}
+
+	if (ExpectedPlayers.IsEmpty()) return true;
+
+	// The player identifier in the URL is chosen by the client, only the token proves the slot was handed to it
+	if (bIsTokenAdmission)
+	{
+		const FString Player = UGameplayStatics::ParseOption(Options, TEXT("DustLinkPlayer"));
+		const FString* ExpectedToken = ExpectedPlayerTokens.Find(Player);
+
+		// Consumed, so a leaked connect URL cannot be replayed once the player is in
+		if (ExpectedToken && *ExpectedToken == UGameplayStatics::ParseOption(Options, TEXT("DustLinkToken")))
+		{
+			ExpectedPlayerTokens.Remove(Player);
+			return true;
+		}
+	}
+	else if (UniqueId.IsValid() && ExpectedPlayers.Contains(UniqueId->ToString()))
+	{
+		return true;
+	}
+
+	OutErrorMessage = TEXT("Player is not assigned to this match.");
+	return false;
+}
+
+/**
+ * @brief Samples player counts, admission state and queue depths into the gauges of the metrics.
+ */
+void UDustLinkSubsystem::CollectMetrics()
+{
+	const UWorld* World = GetWorld();
+	const AGameModeBase* GameMode = World ? World->GetAuthGameMode() : nullptr;
+
+	Metrics->SetGauge(EDustLinkGauge::Players, GameMode ? GameMode->GetNumPlayers() : 0);
+	Metrics->SetGauge(EDustLinkGauge::HostLoad, LoadMonitor.GetLoad());
+	Metrics->SetGauge(EDustLinkGauge::Admitting, AdmissionController.IsAdmitting() ? 1 : 0);
+	Metrics->SetGauge(EDustLinkGauge::PingProbesInFlight, PingScheduler.GetNumInFlight());
+	Metrics->SetGauge(EDustLinkGauge::FriendQueriesQueued, FriendSessionFinder->GetNumQueuedQueries());
+	Metrics->SetGauge(EDustLinkGauge::FriendQueriesInFlight, FriendSessionFinder->GetNumQueriesInFlight());
+}
+
+/**
+ * @brief Ends the join phase and, once the player has somewhere to go, starts the travel phase.
+ *
+ * @param bWasSuccessful Whether the player obtained connect info.
+ */
+void UDustLinkSubsystem::OnJoinPhaseComplete(const bool bWasSuccessful)
+{
+	if (!Metrics->IsPhaseRunning(EDustLinkLatencyPhase::Join)) return;
+
+	Metrics->EndPhase(EDustLinkLatencyPhase::Join, bWasSuccessful);
+
+	if (bWasSuccessful) Metrics->BeginPhase(EDustLinkLatencyPhase::Travel);
+}
+
+/**
+ * @brief Starts sampling the load of this host, called once it hosts a session.
+ */
+void UDustLinkSubsystem::StartLoadMonitor()
+{
+	const UGameInstance* GameInstance = GetGameInstance();
+
+	if (!GameInstance) return;
+
+	LoadMonitor.Reset();
+	AdmissionController.Reset();
+	bIsAdmissionStateDirty = false;
+
+	GameInstance->GetTimerManager().SetTimer(LoadSampleTimerHandle, this, &ThisClass::OnLoadSampleTimer, LoadMonitor.GetSettings().SampleInterval, true);
+
+	if (!LoadFrameTickerHandle.IsValid())
+	{
+		LoadFrameTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &ThisClass::OnLoadFrameTick));
+	}
+}
+
+/**
+ * @brief Replaces the analytics provider session funnel events are exported to.
+ *
+ * Events buffered for the previous provider are flushed to it and its session is ended.
+ *
+ * @param Provider The provider to use, or `nullptr` to stop recording funnel events.
+ * @param Settings The batching parameters to use.
+ */
+void UDustLinkSubsystem::SetAnalyticsProvider(const TSharedPtr<IAnalyticsProvider>& Provider, const FDustLinkAnalyticsSettings& Settings)
+{
+	const UGameInstance* GameInstance = GetGameInstance();
+
+	if (Analytics)
+	{
+		Analytics->Flush();
+		Analytics.Reset();
+	}
+
+	if (AnalyticsProvider.IsValid()) AnalyticsProvider->EndSession();
+
+	AnalyticsProvider = Provider;
+
+	if (GameInstance) GameInstance->GetTimerManager().ClearTimer(AnalyticsFlushTimerHandle);
+
+	if (!Provider.IsValid()) return;
+
+	Provider->StartSession();
+	Analytics = MakeUnique<FDustLinkAnalytics>(Provider.ToSharedRef(), Settings);
+
+	if (GameInstance && Settings.FlushInterval > 0.f)
+	{
+		GameInstance->GetTimerManager().SetTimer(AnalyticsFlushTimerHandle, this, &ThisClass::OnAnalyticsFlushTimer, Settings.FlushInterval, true);
+	}
+}
+
+/**
+ * @brief Records a session funnel event if an analytics provider is set and telemetry is not suspended.
+ *
+ * Search, join, travel and arrival are recorded by the subsystem itself, menus record `MenuOpened`.
+ *
+ * @param Event The funnel stage that was reached.
+ * @param bWasSuccessful Whether the stage succeeded.
+ * @param Value A stage specific count.
+ */
+void UDustLinkSubsystem::RecordFunnelEvent(const EDustLinkFunnelEvent Event, const bool bWasSuccessful, const int32 Value)
+{
+	if (Analytics && !Metrics->IsSuspended()) Analytics->RecordEvent(Event, bWasSuccessful, Value);
+}
+
+/**
+ * @brief Records finished phases for the network benchmark and translates phase events into session funnel events.
+ *
+ * @param Event The recorded telemetry event.
+ */
+void UDustLinkSubsystem::OnTelemetryEvent(const FDustLinkTelemetryEvent& Event)
+{
+	if (Event.Type == EDustLinkTelemetryEventType::PhaseEnd)
+	{
+		NetworkBenchmark.RecordPhase(static_cast<EDustLinkLatencyPhase>(Event.Target), Event.bWasSuccessful, Event.LatencyMs);
+	}
+
+	if (!Analytics) return;
+
+	const bool bIsBegin = Event.Type == EDustLinkTelemetryEventType::PhaseBegin;
+
+	if (!bIsBegin && Event.Type != EDustLinkTelemetryEventType::PhaseEnd) return;
+
+	switch (static_cast<EDustLinkLatencyPhase>(Event.Target))
+	{
+	case EDustLinkLatencyPhase::Search:
+		if (bIsBegin)
+		{
+			Analytics->RecordEvent(EDustLinkFunnelEvent::SearchStarted);
+		}
+		else
+		{
+			const int32 NumCandidates = Event.bWasSuccessful && LastSessionSearch.IsValid() ? LastSessionSearch->SearchResults.Num() : 0;
+			Analytics->RecordEvent(EDustLinkFunnelEvent::SearchCompleted, Event.bWasSuccessful, NumCandidates, Event.LatencyMs);
+		}
+		break;
+
+	case EDustLinkLatencyPhase::Join:
+		if (bIsBegin) Analytics->RecordEvent(EDustLinkFunnelEvent::JoinAttempted);
+		else Analytics->RecordEvent(EDustLinkFunnelEvent::JoinCompleted, Event.bWasSuccessful, 0, Event.LatencyMs);
+		break;
+
+	case EDustLinkLatencyPhase::Travel:
+		if (bIsBegin) Analytics->RecordEvent(EDustLinkFunnelEvent::TravelStarted);
+		break;
+
+	case EDustLinkLatencyPhase::Load:
+		if (!bIsBegin) Analytics->RecordEvent(EDustLinkFunnelEvent::Arrived, Event.bWasSuccessful, 0, Event.LatencyMs);
+		break;
+
+	default:
+		break;
+	}
+}
+
+/**
+ * @brief Timer callback that exports the buffered funnel events.
+ */
+void UDustLinkSubsystem::OnAnalyticsFlushTimer()
+{
+	if (Analytics) Analytics->Flush();
+}
+
+/**
+ * @brief Replaces the source of friends and their sessions, e.g. with `FDustLinkMockPresenceProvider` in local tests.
+ *
+ * @param Provider The provider to query.
+ */
+void UDustLinkSubsystem::SetPresenceProvider(const TSharedPtr<IDustLinkPresenceProvider>& Provider)
+{
+	FriendSessionFinder->SetProvider(Provider);
+	MockPresenceProvider.Reset();
+}
+
+/**
+ * @brief Returns the mock presence backend, installing an empty one as the provider if another is in use.
+ *
+ * Cached friend sessions are dropped, as the caller is about to change the fake friends.
+ */
+TSharedRef<FDustLinkMockPresenceProvider> UDustLinkSubsystem::UseMockPresenceProvider()
+{
+	if (!MockPresenceProvider.IsValid())
+	{
+		const TSharedRef<FDustLinkMockPresenceProvider> MockProvider = MakeShared<FDustLinkMockPresenceProvider>();
+
+		SetPresenceProvider(MockProvider);
+		MockPresenceProvider = MockProvider;
+		MockPresenceProvider->SetNetworkProfile(NetworkProfile);
+	}
+
+	FriendSessionFinder->InvalidateCache();
+
+	return MockPresenceProvider.ToSharedRef();
+}
+
+/**
+ * @brief Emulates the link conditions of a built-in network profile.
+ *
+ * The profile is applied to the net driver of the current world, to the net drivers of later joins and
+ * travel, to the completions of session searches and joins, and to the mock presence backend. Phase
+ * latencies from now on are recorded for `GetNetworkProfileReport` under this profile, apart from the
+ * histograms of `GetMetrics`.
+ *
+ * @param ProfileName The name of the profile, e.g. `Loopback`, `Broadband` or `Mobile`.
+ * @return `true` if a profile with this name exists, always `false` in shipping builds.
+ */
+bool UDustLinkSubsystem::SetNetworkProfile(const FString& ProfileName)
+{
+#if UE_BUILD_SHIPPING
+	UE_LOG(LogTemp, Warning, TEXT("%s: Network profiles are compiled out of shipping builds."), *GetClass()->GetName());
+	return false;
+#else
+	const FDustLinkNetworkProfile* Profile = FDustLinkNetworkProfile::Find(ProfileName);
+
+	if (!Profile) return false;
+
+	NetworkProfile = *Profile;
+	NetworkBenchmark.SetProfile(NetworkProfile.Name);
+	ApplyNetworkProfile();
+
+	UE_LOG(LogTemp, Log, TEXT("%s: Emulating network profile %s."), *GetClass()->GetName(), *NetworkProfile.ToString());
+
+	return true;
+#endif
+}
+
+/**
+ * @brief Starts a soak test cycling sessions and a menu through this subsystem, see `FDustLinkSoakTest`.
+ *
+ * @param Settings The length and tolerances of the run.
+ * @return The run, or `nullptr` if one is already in progress.
+ */
+TSharedPtr<FDustLinkSoakTest> UDustLinkSubsystem::StartSoakTest(const FDustLinkSoakSettings& Settings)
+{
+	if (SoakTest && SoakTest->IsRunning()) return nullptr;
+
+	// Background searches would complete in the middle of the soak's own lifecycle steps
+	StopAutoRefresh();
+
+	SoakTest = MakeShared<FDustLinkSoakTest>(this, Settings);
+	SoakTest->Start();
+
+	return SoakTest;
+}
+
+/**
+ * @brief Returns the number of completion delegates still bound on the online session interface.
+ *
+ * Every operation clears its binding once it completes, so this is zero whenever no operation is in flight.
+ */
+int32 UDustLinkSubsystem::GetNumOnlineDelegateHandles() const
+{
+	const FDelegateHandle* Handles[] =
+	{
+		&CreateSessionCompleteDelegateHandle, &FindSessionsCompleteDelegateHandle, &JoinSessionCompleteDelegateHandle,
+		&DestroySessionCompleteDelegateHandle, &StartSessionCompleteDelegateHandle, &EndSessionCompleteDelegateHandle,
+		&UpdateSessionCompleteDelegateHandle
+	};
+
+	int32 NumHandles = 0;
+
+	for (const FDelegateHandle* Handle : Handles) NumHandles += Handle->IsValid() ? 1 : 0;
+
+	return NumHandles;
+}
+
+/**
+ * @brief Applies the emulated link conditions to the current net driver and the mock backend.
+ */
+void UDustLinkSubsystem::ApplyNetworkProfile()
+{
+	if (const UWorld* World = GetWorld()) ApplyNetworkProfileToNetDriver(World->GetNetDriver());
+
+	if (MockPresenceProvider) MockPresenceProvider->SetNetworkProfile(NetworkProfile);
+}
+
+/**
+ * @brief Applies the emulated link conditions to one net driver, remembering the conditions the user gave it.
+ *
+ * @param NetDriver The net driver to configure.
+ */
+void UDustLinkSubsystem::ApplyNetworkProfileToNetDriver(UNetDriver* NetDriver)
+{
+	if (!NetDriver) return;
+
+	// Net drivers of earlier maps are gone, their entries would only accumulate
+	for (auto It = NetDriverUserConditions.CreateIterator(); It; ++It)
+	{
+		if (!It.Key().ResolveObjectPtr()) It.RemoveCurrent();
+	}
+
+	// A driver starts with the lag and loss from the config and command line, which a profile without them restores
+	const FDustLinkNetworkProfile* UserConditions = NetDriverUserConditions.Find(NetDriver);
+
+	if (!UserConditions) UserConditions = &NetDriverUserConditions.Add(NetDriver, FDustLinkNetworkProfile::FromNetDriver(NetDriver));
+
+	NetworkProfile.ApplyToNetDriver(NetDriver, *UserConditions);
+}
+
+/**
+ * @brief Callback for every connection a pending join opens, applies the emulated link conditions to it.
+ *
+ * @param PendingNetGame The pending join that created its net driver.
+ */
+void UDustLinkSubsystem::OnPendingNetGameConnectionCreated(UPendingNetGame* PendingNetGame)
+{
+	const FWorldContext* WorldContext = PendingNetGame && GEngine ? GEngine->GetWorldContextFromPendingNetGame(PendingNetGame) : nullptr;
+
+	// The delegate is global, other game instances in the same process emulate their own profile
+	if (!WorldContext || WorldContext->OwningGameInstance != GetGameInstance()) return;
+
+	ApplyNetworkProfileToNetDriver(PendingNetGame->GetNetDriver());
+}
+
+/**
+ * @brief Runs a completion after the lag and transfer time of the emulated network profile.
+ *
+ * Runs the completion right away if the profile does not change the link, and always in shipping builds.
+ *
+ * @param PayloadBytes Approximate size of the answer's entries on the wire.
+ * @param bCanBeLost Whether the answer may be lost with the profile's loss probability.
+ * @param Completion The completion, told whether the answer arrived.
+ */
+void UDustLinkSubsystem::DelayThroughNetworkProfile(const int32 PayloadBytes, const bool bCanBeLost, TFunction<void(bool)>&& Completion)
+{
+#if !UE_BUILD_SHIPPING
+	if (NetworkProfile.HasConditions())
+	{
+		const bool bArrived = !bCanBeLost || !NetworkProfile.SampleBackendLoss();
+		const float Delay = NetworkProfile.SampleBackendDelay(FDustLinkNetworkProfile::EnvelopePayloadBytes + PayloadBytes);
+
+		FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateWeakLambda(this, [Completion = MoveTemp(Completion), bArrived](float)
+		{
+			Completion(bArrived);
+			return false;
+		}), Delay);
+
+		return;
+	}
+#endif
+
+	Completion(true);
+}
+
+/**
+ * @brief Stops sampling the load of this host.
+ */
+void UDustLinkSubsystem::StopLoadMonitor()
+{
+	if (const UGameInstance* GameInstance = GetGameInstance()) GameInstance->GetTimerManager().ClearTimer(LoadSampleTimerHandle);
+
+	FTSTicker::GetCoreTicker().RemoveTicker(LoadFrameTickerHandle);
+	LoadFrameTickerHandle.Reset();
+
+	AdmissionController.Reset();
+	bIsAdmissionStateDirty = false;
+}
+
+/**
+ * @brief Ticker callback that accumulates the tick time and CPU usage of every frame towards the next load sample.
+ *
+ * @param DeltaTime Time since the last frame, in seconds.
+ * @return Always `true` to keep ticking.
+ */
+bool UDustLinkSubsystem::OnLoadFrameTick(float DeltaTime)
+{
+	// Frame time minus the time spent sleeping to hold the tick rate is the work the host actually did
+	const float TickTimeMs = static_cast<float>(FMath::Max(0.0, FApp::GetDeltaTime() - FApp::GetIdleTime()) * 1000.0);
+
+	LoadMonitor.AddFrame(TickTimeMs, FPlatformTime::GetCPUTime().CPUTimePctRelative / 100.f);
+
+	return true;
+}
+
+/**
+ * @brief Timer callback that samples the frames since the last sample and bandwidth usage, and advertises the load when it moved.
+ */
+void UDustLinkSubsystem::OnLoadSampleTimer()
+{
+	float BandwidthUsage = 0.f;
+
+	if (const UNetDriver* NetDriver = GetWorld() ? GetWorld()->GetNetDriver() : nullptr; NetDriver && NetDriver->ClientConnections.Num() > 0)
+	{
+		const float BandwidthBudget = static_cast<float>(NetDriver->ClientConnections.Num()) * FMath::Max(1, NetDriver->MaxClientRate);
+		BandwidthUsage = NetDriver->OutBytesPerSecond / BandwidthBudget;
+	}
+
+	// One slow frame per interval would otherwise be missed or dominate, depending on when the timer fires
+	LoadMonitor.AddSampleFromFrames(BandwidthUsage);
+
+	const double Now = FPlatformTime::Seconds();
+
+	if (AdmissionController.Update(LoadMonitor.GetSmoothedTickTimeMs(), LoadMonitor.GetSettings().TickBudgetMs, Now))
+	{
+		UE_LOG(LogTemp, Log, TEXT("%s: Host %s new players at %.1f ms per tick."), *GetClass()->GetName(),
+			AdmissionController.IsAdmitting() ? TEXT("admits") : TEXT("stopped admitting"), LoadMonitor.GetSmoothedTickTimeMs());
+
+		bIsAdmissionStateDirty = true;
+	}
+
+	if (bIsAdmissionStateDirty || LoadMonitor.ShouldAdvertise(Now)) AdvertiseLoad();
+}
+
+/**
+ * @brief Publishes the current load in the `HostLoad` setting of the hosted session and hides
+ * the session from searches while the host does not admit players.
+ *
+ * Skipped while another session update is in flight, the next sample retries.
+ */
+void UDustLinkSubsystem::AdvertiseLoad()
+{
+	if (UpdateSessionCompleteDelegateHandle.IsValid() || bCreateSessionOnUpdate || !PendingLobbyPath.IsEmpty()) return;
+
+	const FNamedOnlineSession* Session = OnlineSessionInterface.IsValid() ? OnlineSessionInterface->GetNamedSession(NAME_GameSession) : nullptr;
+
+	if (!Session || !Session->bHosting) return;
+
+	LastSessionSettings = MakeShared<FOnlineSessionSettings>(Session->SessionSettings);
+	LastSessionSettings->Set(FName("HostLoad"), LoadMonitor.GetLoad(), EOnlineDataAdvertisementType::ViaOnlineServiceAndPing);
+	LastSessionSettings->bShouldAdvertise = AdmissionController.IsAdmitting();
+	LoadMonitor.MarkAdvertised(FPlatformTime::Seconds());
+	bIsAdmissionStateDirty = false;
+
+	UpdateSession();
+}
+
+/**
+ * @brief Resolves a join code straight to connect info, skipping the session search.
+ *
+ * The result is delivered through `DustLinkOnConnectInfoResolved`.
+ *
+ * @param Code The join code as entered by the player.
+ */
+void UDustLinkSubsystem::JoinSessionByCode(const FString& Code)
+{
+	const FString NormalizedCode = DustLinkJoinCode::Normalize(Code);
+	Metrics->BeginPhase(EDustLinkLatencyPhase::Join);
+
+	if (!ListingProvider.IsValid() || NormalizedCode.IsEmpty())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("%s: No listing provider available to resolve join code."), *GetClass()->GetName());
+		DustLinkOnConnectInfoResolved.Broadcast(FString(), false);
+		return;
+	}
+
+	TWeakObjectPtr<UDustLinkSubsystem> WeakThis(this);
+
+	ListingProvider->ResolveJoinCode(NormalizedCode, FDustLinkOnJoinCodeResolved::CreateLambda([WeakThis](const FString& ConnectInfo, const bool bWasSuccessful)
+	{
+		if (UDustLinkSubsystem* Subsystem = WeakThis.Get()) Subsystem->DustLinkOnConnectInfoResolved.Broadcast(ConnectInfo, bWasSuccessful);
+	}));
+}
+
+/**
+ * @brief Resolves a direct address entered by the player, skipping the session search.
+ *
+ * Host names are resolved asynchronously. The result is delivered through `DustLinkOnConnectInfoResolved`.
+ *
+ * @param Address A host name or IP address, optionally followed by ":<Port>".
+ */
+void UDustLinkSubsystem::ConnectToAddress(const FString& Address)
+{
+	Metrics->BeginPhase(EDustLinkLatencyPhase::Join);
+
+	ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+	FString Host = Address.TrimStartAndEnd();
+	FString Port;
+
+	if (!SocketSubsystem || Host.IsEmpty())
+	{
+		DustLinkOnConnectInfoResolved.Broadcast(FString(), false);
+		return;
+	}
+
+	// Bracketed IPv6 literals and bare IPv6 addresses carry colons of their own
+	if (Host.StartsWith(TEXT("[")))
+	{
+		Host.Split(TEXT("]:"), &Host, &Port);
+		Host.RemoveFromStart(TEXT("["));
+		Host.RemoveFromEnd(TEXT("]"));
+	}
+	else if (int32 ColonIndex; Host.FindChar(TEXT(':'), ColonIndex) && ColonIndex == Host.Find(TEXT(":"), ESearchCase::CaseSensitive, ESearchDir::FromEnd))
+	{
+		Port = Host.Mid(ColonIndex + 1);
+		Host.LeftInline(ColonIndex);
+	}
+
+	const auto MakeConnectInfo = [](const FString& ResolvedHost, const FString& ResolvedPort)
+	{
+		const FString HostPart = ResolvedHost.Contains(TEXT(":")) ? FString::Printf(TEXT("[%s]"), *ResolvedHost) : ResolvedHost;
+		return ResolvedPort.IsEmpty() ? HostPart : FString::Printf(TEXT("%s:%s"), *HostPart, *ResolvedPort);
+	};
+
+	// Literal addresses need no lookup
+	if (SocketSubsystem->GetAddressFromString(Host).IsValid())
+	{
+		DustLinkOnConnectInfoResolved.Broadcast(MakeConnectInfo(Host, Port), true);
+		return;
+	}
+
+	TWeakObjectPtr<UDustLinkSubsystem> WeakThis(this);
+
+	SocketSubsystem->GetAddressInfoAsync([WeakThis, Port, MakeConnectInfo](const FAddressInfoResult& Result)
+	{
+		const bool bWasSuccessful = Result.ReturnCode == SE_NO_ERROR && Result.Results.Num() > 0;
+		const FString ResolvedHost = bWasSuccessful ? Result.Results[0].Address->ToString(false) : FString();
+
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, ResolvedHost, Port, MakeConnectInfo, bWasSuccessful]()
+		{
+			UDustLinkSubsystem* Subsystem = WeakThis.Get();
+
+			if (!Subsystem) return;
+
+			Subsystem->DustLinkOnConnectInfoResolved.Broadcast(bWasSuccessful ? MakeConnectInfo(ResolvedHost, Port) : FString(), bWasSuccessful);
+		});
+	}, *Host, nullptr, EAddressInfoFlags::Default, NAME_None, ESocketType::SOCKTYPE_Datagram);
+}
+
+/**
+ * @brief Creates a session for a match handed to this dedicated server and travels to its map.
+ *
+ * Called by the control channel. The fleet agent receives the connect info once the session exists and the match map loaded.
+ *
+ * @param Config The match to host.
+ */
+void UDustLinkSubsystem::HostMatch(const FDustLinkMatchConfig& Config)
+{
+	if (!OnlineSessionInterface.IsValid())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("%s: Session is no longer valid to host a match."), *GetClass()->GetName());
+		OnHostedMatchCreated(false);
+		return;
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("%s: Hosting %s match on %s."), *GetClass()->GetName(), *Config.MatchType, *Config.MatchMap);
+
+	if (const UWorld* World = GetWorld()) IdleMapPath = World->URL.Map;
+
+	MatchMap = Config.MatchMap;
+	ExpectedPlayers = Config.ExpectedPlayers;
+	ExpectedPlayerTokens = Config.PlayerTokens;
+	bIsTokenAdmission = !ExpectedPlayerTokens.IsEmpty();
+	CreateSession(Config.NumPublicConnections, Config.MatchType);
+}
+
+/**
+ * @brief Ends the match handed to this dedicated server and travels back to the map it idles on.
+ *
+ * Called by the control channel when the fleet agent releases the server.
+ */
+void UDustLinkSubsystem::ReleaseMatch()
+{
+	UE_LOG(LogTemp, Log, TEXT("%s: Match released, returning to %s."), *GetClass()->GetName(), *IdleMapPath);
+
+	ExpectedPlayers.Reset();
+	ExpectedPlayerTokens.Reset();
+	bIsTokenAdmission = false;
+	MatchMap.Reset();
+
+	UWorld* World = GetWorld();
+
+	// Both are set before either can complete, a synchronous destroy must not answer while the travel is still ahead
+	bIsReleaseAwaitingDestroy = OnlineSessionInterface.IsValid();
+	bIsReleaseAwaitingIdleMap = World && !IdleMapPath.IsEmpty() && World->URL.Map != IdleMapPath;
+
+	if (bIsReleaseAwaitingIdleMap)
+	{
+		Metrics->BeginPhase(EDustLinkLatencyPhase::Travel);
+
+		if (!World->ServerTravel(IdleMapPath))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("%s: Failed to travel back to idle map %s."), *GetClass()->GetName(), *IdleMapPath);
+			bIsReleaseAwaitingIdleMap = false;
+		}
+	}
+
+	DestroySession();
+	CompleteReleaseIfDone();
+}
+
+/**
+ * @brief Answers the control channel once the match was torn down: its session destroyed and the idle map loaded.
+ */
+void UDustLinkSubsystem::CompleteReleaseIfDone()
+{
+	if (bIsReleaseAwaitingDestroy || bIsReleaseAwaitingIdleMap || !ServerControl) return;
+
+	ServerControl->CompleteRelease();
+}
+
+/**
+ * @brief Applies `CanAdmitPlayer` to the pre-login of any game mode of this game instance.
+ *
+ * The URL options of the player are read from its pending connection, as the event does not carry them.
+ *
+ * @param GameMode The game mode the player logs in to.
+ * @param UniqueId The unique net ID of the connecting player.
+ * @param ErrorMessage Set to the reason the player is refused.
+ */
+void UDustLinkSubsystem::OnGameModePreLogin(AGameModeBase* GameMode, const FUniqueNetIdRepl& UniqueId, FString& ErrorMessage)
+{
+	if (!ErrorMessage.IsEmpty() || !GameMode || GameMode->GetGameInstance() != GetGameInstance()) return;
+
+	FString Options;
+
+	if (const UNetDriver* NetDriver = GameMode->GetWorld() ? GameMode->GetWorld()->GetNetDriver() : nullptr)
+	{
+		for (const UNetConnection* Connection : NetDriver->ClientConnections)
+		{
+			if (!Connection || Connection->PlayerController || Connection->PlayerId != UniqueId) continue;
+
+			for (const FString& Option : Connection->RequestURL.Op) Options += TEXT("?") + Option;
+
+			break;
+		}
+	}
+
+	CanAdmitPlayer(Options, UniqueId, ErrorMessage);
+}
+
+/**
+ * @brief Travels to the map of a handed over match once its session was created, and answers the control
+ * channel right away if there is nothing to travel to.
+ *
+ * Otherwise the answer is sent once the match map finished loading.
+ *
+ * @param bWasSuccessful Whether the session was created.
+ */
+void UDustLinkSubsystem::OnHostedMatchCreated(const bool bWasSuccessful)
+{
+	if (!ServerControl || ServerControl->GetState() != EDustLinkServerState::Allocating) return;
+
+	UWorld* World = GetWorld();
+	FString ConnectInfo;
+
+	if (bWasSuccessful && !PublicAddress.IsEmpty() && World)
+	{
+		// A bare host in the option gets the port this server listens on
+		const bool bHasPort = PublicAddress.StartsWith(TEXT("[")) ? PublicAddress.Contains(TEXT("]:")) : PublicAddress.Contains(TEXT(":"));
+		ConnectInfo = bHasPort ? PublicAddress : FString::Printf(TEXT("%s:%d"), *PublicAddress, World->URL.Port);
+	}
+	else if (bWasSuccessful && OnlineSessionInterface.IsValid() && !OnlineSessionInterface->GetResolvedConnectString(NAME_GameSession, ConnectInfo))
+	{
+		ConnectInfo.Reset();
+	}
+
+	// A loopback fallback would be useless to every remote player, the agent retries on another server instead
+	if (bWasSuccessful && ConnectInfo.IsEmpty())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("%s: No connect info for the hosted match, pass -DustLinkPublicAddress=<Host>[:<Port>]."), *GetClass()->GetName());
+		ServerControl->CompleteMatch(false, FString());
+		return;
+	}
+
+	if (!bWasSuccessful || !World || MatchMap.IsEmpty() || World->URL.Map == MatchMap)
+	{
+		ServerControl->CompleteMatch(bWasSuccessful, ConnectInfo);
+		return;
+	}
+
+	// Players sent to the idle map would be dropped by the travel, so the agent only hears back once the match map loaded
+	PendingMatchConnectInfo = ConnectInfo;
+	Metrics->BeginPhase(EDustLinkLatencyPhase::Travel);
+
+	if (!World->ServerTravel(MatchMap))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("%s: Failed to travel to match map %s."), *GetClass()->GetName(), *MatchMap);
+
+		PendingMatchConnectInfo.Reset();
+		ServerControl->CompleteMatch(false, FString());
+	}
+}
+
+/**
+ * @brief Discovers the sessions of the local player's friends without a global search.
+ *
+ * Only friends whose presence reports a joinable session are queried, directly and in parallel with
+ * bounded concurrency. Answers are cached briefly. The result is delivered through
+ * `DustLinkOnFindFriendSessionsComplete`.
+ *
+ * @param MaxConcurrentQueries The maximum number of friend session queries in flight.
+ * @param CacheLifetime How long a friend's session stays cached, in seconds.
+ */
+void UDustLinkSubsystem::FindFriendSessions(const int32 MaxConcurrentQueries, const float CacheLifetime)
+{
+	if (!FriendSessionFinder->HasProvider())
+	{
+		if (IOnlineSubsystem* Subsystem = Online::GetSubsystem(GetWorld()))
+		{
+			FriendSessionFinder->SetProvider(MakeShared<FDustLinkOnlinePresenceProvider>(Subsystem));
+		}
+	}
+
+	const ULocalPlayer* LocalPlayer = GetWorld() ? GetWorld()->GetFirstLocalPlayerFromController() : nullptr;
+	TWeakObjectPtr<UDustLinkSubsystem> WeakThis(this);
+
+	FriendSessionFinder->Find(LocalPlayer ? LocalPlayer->GetControllerId() : 0, MaxConcurrentQueries, CacheLifetime, FDustLinkOnFriendSessionsFound::CreateLambda(
+		[WeakThis](const TArray<FOnlineSessionSearchResult>& SessionResults, const bool bWasSuccessful)
+	{
+		if (UDustLinkSubsystem* Subsystem = WeakThis.Get()) Subsystem->DustLinkOnFindFriendSessionsComplete.Broadcast(SessionResults, bWasSuccessful);
+	}));
+}
+
+/**
+ * @brief Callback for when the local user accepted a platform session invite.
+ *
+ * This method is triggered by the `FOnSessionUserInviteAcceptedDelegate`. It joins straight from the
+ * invite's search result, leaving the current session first if needed.
+ * Leaving for the invite does not broadcast the destroy delegates, so the menu does not travel away.
+ *
+ * @param bWasSuccessful Whether the invite could be accepted.
+ * @param ControllerId The controller of the local user who accepted the invite.
+ * @param UserId The local user who accepted the invite.
+ * @param InviteResult The session the user was invited to.
+ */
+void UDustLinkSubsystem::OnSessionUserInviteAccepted(const bool bWasSuccessful, const int32 ControllerId, FUniqueNetIdPtr UserId, const FOnlineSessionSearchResult& InviteResult)
+{
+	if (!bWasSuccessful || !InviteResult.IsValid())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("%s: Accepted invite is not valid."), *GetClass()->GetName());
+		DustLinkOnJoinSessionComplete.Broadcast(EOnJoinSessionCompleteResult::SessionDoesNotExist);
+		return;
+	}
+
+	Metrics->BeginPhase(EDustLinkLatencyPhase::Join);
+
+	// Leave the current session first, the invite is joined once destruction completes
+	if (OnlineSessionInterface.IsValid() && OnlineSessionInterface->GetNamedSession(NAME_GameSession))
+	{
+		PendingInviteResult = InviteResult;
+		DestroySession();
+		return;
+	}
+
+	FOnlineSessionSearchResult SessionResult = InviteResult;
+	JoinSession(SessionResult);
+}
+
+/**
+ * @brief Registers the hosted session's join code and connect info with the listing provider.
+ *
+ * A code already held by another host is replaced by a freshly generated one, up to `MaxAttempts` times.
+ *
+ * @param Attempt The number of this attempt, starting at 1.
+ */
+void UDustLinkSubsystem::RegisterJoinCode(const int32 Attempt)
+{
+	constexpr int32 MaxAttempts { 3 };
+
+	if (!ListingProvider.IsValid() || JoinCode.IsEmpty()) return;
+
+	FString ConnectInfo;
+
+	if (!OnlineSessionInterface->GetResolvedConnectString(NAME_GameSession, ConnectInfo))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("%s: Failed to resolve connect info for join code."), *GetClass()->GetName());
+		DustLinkOnJoinCodeRegistered.Broadcast(JoinCode, false);
+		return;
+	}
+
+	TWeakObjectPtr<UDustLinkSubsystem> WeakThis(this);
+	const FString RegisteredCode = JoinCode;
+
+	ListingProvider->RegisterJoinCode(JoinCode, ConnectInfo, FString(), FDustLinkOnJoinCodeRegisterComplete::CreateLambda([WeakThis, RegisteredCode, Attempt, MaxAttempts](const bool bWasSuccessful, const bool bIsCodeTaken, const FString& Secret)
+	{
+		UDustLinkSubsystem* Subsystem = WeakThis.Get();
+
+		// The session was destroyed or recreated with another code in the meantime
+		if (!Subsystem || Subsystem->JoinCode != RegisteredCode) return;
+
+		if (bIsCodeTaken && Attempt < MaxAttempts)
+		{
+			Subsystem->JoinCode = DustLinkJoinCode::Generate();
+
+			if (Subsystem->LastSessionSettings.IsValid()) Subsystem->LastSessionSettings->Set(FName("JoinCode"), Subsystem->JoinCode, EOnlineDataAdvertisementType::DontAdvertise);
+
+			Subsystem->RegisterJoinCode(Attempt + 1);
+			return;
+		}
+
+		if (bWasSuccessful) Subsystem->JoinCodeSecret = Secret;
+
+		Subsystem->DustLinkOnJoinCodeRegistered.Broadcast(RegisteredCode, bWasSuccessful);
+	}));
+}
+
+/**
+ * @brief Removes the hosted session's join code from the listing provider.
+ */
+void UDustLinkSubsystem::UnregisterJoinCode()
+{
+	// Without a secret the code was never registered to this host
+	if (ListingProvider.IsValid() && !JoinCode.IsEmpty() && !JoinCodeSecret.IsEmpty()) ListingProvider->UnregisterJoinCode(JoinCode, JoinCodeSecret);
+
+	JoinCode.Reset();
+	JoinCodeSecret.Reset();
+}
+
+/**
+ * @brief Callback for when session creation is complete.
+ *
+ * This method is triggered by the `FOnCreateSessionCompleteDelegate` when the session creation process finishes.
+ * 
+ * @param SessionName The name of the session that was created.
+ * @param bWasSuccessful Whether the session creation was successful.
+ */
+void UDustLinkSubsystem::OnCreateSessionComplete(FName SessionName, const bool bWasSuccessful)
+{
+	if (!OnlineSessionInterface)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("%s: Session Interface is not defined."), *GetClass()->GetName());
+		return;
+	}
+	
+	OnlineSessionInterface->ClearOnCreateSessionCompleteDelegate_Handle(CreateSessionCompleteDelegateHandle);
+	BroadcastSessionEvent(DustLinkOnCreateSessionCompleteNative, DustLinkOnCreateSessionComplete, bWasSuccessful);
+
+	if (!bWasSuccessful) return;
+
+	RegisterJoinCode();
+	StartLoadMonitor();
+}
+
+/**
+ * @brief Callback for when session search is complete.
+ *
+ * This method is triggered by the `FOnFindSessionsCompleteDelegate` when the session search process finishes.
+ * 
+ * @param bWasSuccessful Whether the session search was successful.
+ */
+void UDustLinkSubsystem::OnFindSessionComplete(bool bWasSuccessful)
+{
+	const int32 NumResults = LastSessionSearch.IsValid() ? LastSessionSearch->SearchResults.Num() : 0;
+
+	// A lost answer fails the search like a backend timeout would, the player can search again
+	DelayThroughNetworkProfile(FDustLinkNetworkProfile::SessionPayloadBytes * NumResults, true, [this, bWasSuccessful](const bool bArrived)
+	{
+		if (!bArrived && LastSessionSearch.IsValid()) LastSessionSearch->SearchResults.Reset();
+
+		CompleteFindSessions(bWasSuccessful && bArrived);
+	});
+}
+
+/**
+ * @brief Processes the results of a session search once they crossed the emulated network.
+ *
+ * @param bWasSuccessful Whether the session search was successful.
+ */
+void UDustLinkSubsystem::CompleteFindSessions(bool bWasSuccessful)
+{
+	if (!OnlineSessionInterface)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("%s: Session Interface is not defined."), *GetClass()->GetName());
+		return;
+	}
+	
+	float Churn = 0.f;
+
+	if (bWasSuccessful)
+	{
+		LastSessionSearch->SearchResults.RemoveAll([this](const FOnlineSessionSearchResult& Result)
+		{
+			FDustLinkContentManifest Manifest;
+			FString Reason;
+
+			if (!FDustLinkContentManifest::FromSessionSettings(Result.Session.SessionSettings, Manifest) || Manifest.IsSatisfiedLocally(Reason)) return false;
+
+			UE_LOG(LogTemp, Verbose, TEXT("%s: Skipping session %s, %s"), *GetClass()->GetName(), *Result.GetSessionIdStr(), *Reason);
+			return true;
+		});
+
+		const int32 PreviousNum = SessionResultStore.Num();
+		const FDustLinkSessionDiff Diff = UpdateSessionResultStore(LastSessionSearch->SearchResults);
+
+		// Rows whose ping or player count moved are not churn, only sessions coming and going are
+		const int32 NumChurned = Diff.Added.Num() + Diff.Removed.Num();
+		Churn = static_cast<float>(NumChurned) / FMath::Max(1, FMath::Max(PreviousNum, SessionResultStore.Num()));
+	}
+
+	if (LastSessionSearch->SearchResults.Num() <= 0) bWasSuccessful = false;
+
+	OnlineSessionInterface->ClearOnFindSessionsCompleteDelegate_Handle(FindSessionsCompleteDelegateHandle);
+	BroadcastSearchComplete(LastSessionSearch->SearchResults, bWasSuccessful);
+
+	if (bAutoRefreshEnabled) ScheduleAutoRefresh(Churn);
+}
+
+/**
+ * @brief Callback for when joining a session is complete.
+ *
+ * This method is triggered by the `FOnJoinSessionCompleteDelegate` when joining a session finishes.
+ * 
+ * @param SessionName The name of the session that was joined.
+ * @param Result The result of the join operation, indicating success or the type of failure.
+ */
+void UDustLinkSubsystem::OnJoinSessionComplete(FName SessionName, EOnJoinSessionCompleteResult::Type Result)
+{
+	// The backend registered the session already, so the answer is only delayed and never lost
+	DelayThroughNetworkProfile(0, false, [this, SessionName, Result](bool)
+	{
+		CompleteJoinSession(SessionName, Result);
+	});
+}
+
+/**
+ * @brief Processes the outcome of a join once it crossed the emulated network.
+ *
+ * @param SessionName The name of the session that was joined.
+ * @param Result The result of the join operation, indicating success or the type of failure.
+ */
+void UDustLinkSubsystem::CompleteJoinSession(FName SessionName, EOnJoinSessionCompleteResult::Type Result)
+{
+	if (!OnlineSessionInterface)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("%s: Session Interface is not defined."), *GetClass()->GetName());
+		return;
+	}
+
+	OnlineSessionInterface->ClearOnJoinSessionCompleteDelegate_Handle(JoinSessionCompleteDelegateHandle);
+
+	// The player leaves the menu for the joined session, a collection now would land on the travel
+	if (Result == EOnJoinSessionCompleteResult::Success) SetIdle(false);
+
+	DustLinkOnJoinSessionComplete.Broadcast(Result);
+}
+
+/**
+ * @brief Callback for when session destruction is complete.
+ *
+ * This method is triggered by the `FOnDestroySessionCompleteDelegate` when the session destruction process finishes.
+ * 
+ * @param SessionName The name of the session that was destroyed.
+ * @param bWasSuccessful Whether the session was successfully destroyed.
+ */
+void UDustLinkSubsystem::OnDestroySessionComplete(FName SessionName, const bool bWasSuccessful)
+{
+	if (!OnlineSessionInterface)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("%s: Session Interface is not defined."), *GetClass()->GetName());
+		return;
+	}
+
+	OnlineSessionInterface->ClearOnDestroySessionCompleteDelegate_Handle(DestroySessionCompleteDelegateHandle);
+
+	// Leaving for an accepted invite is internal, a subscriber travelling away on destroy would race the invite's join
+	if (PendingInviteResult.IsSet())
+	{
+		Metrics->EndOperation(EDustLinkSessionOperation::Destroy, bWasSuccessful);
+	}
+	else
+	{
+		BroadcastSessionEvent(DustLinkOnDestroySessionCompleteNative, DustLinkOnDestroySessionComplete, bWasSuccessful);
+	}
+
+	if (bWasSuccessful) StopLoadMonitor();
+
+	if (bIsReleaseAwaitingDestroy)
+	{
+		if (!bWasSuccessful) UE_LOG(LogTemp, Warning, TEXT("%s: Failed to destroy the released match's session."), *GetClass()->GetName());
+
+		bIsReleaseAwaitingDestroy = false;
+		CompleteReleaseIfDone();
+	}
+
+	if (bWasSuccessful && bCreateSessionOnDestroy)
+	{
+		bCreateSessionOnDestroy = false;
+		CreateSession(LastNumPublicConnections, LastMatchType);
+	}
+
+	if (PendingInviteResult.IsSet())
+	{
+		FOnlineSessionSearchResult SessionResult = PendingInviteResult.GetValue();
+		PendingInviteResult.Reset();
+
+		if (bWasSuccessful) JoinSession(SessionResult);
+		else DustLinkOnJoinSessionComplete.Broadcast(EOnJoinSessionCompleteResult::UnknownError);
+	}
+}
+
+/**
+ * @brief Callback for when session start is complete.
+ *
+ * This method is triggered by the `FOnStartSessionCompleteDelegate` when the session start process finishes.
+ * 
+ * @param SessionName The name of the session that was started.
+ * @param bWasSuccessful Whether the session was successfully started.
+ */
+void UDustLinkSubsystem::OnStartSessionComplete(FName SessionName, bool bWasSuccessful)
+{
+	if (!OnlineSessionInterface)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("%s: Session Interface is not defined."), *GetClass()->GetName());
+		return;
+	}
+
+	OnlineSessionInterface->ClearOnStartSessionCompleteDelegate_Handle(StartSessionCompleteDelegateHandle);
+
+	// Idle collection stops once the match is running
+	if (bWasSuccessful) SetIdle(false);
+
+	BroadcastSessionEvent(DustLinkOnStartSessionCompleteNative, DustLinkOnStartSessionComplete, bWasSuccessful);
+}
+
+/**
+ * @brief Callback for when session end is complete.
+ *
+ * This method is triggered by the `FOnEndSessionCompleteDelegate` when the session end process finishes.
+ * 
+ * @param SessionName The name of the session that was ended.
+ * @param bWasSuccessful Whether the session was successfully ended.
+ */
+void UDustLinkSubsystem::OnEndSessionComplete(FName SessionName, bool bWasSuccessful)
+{
+	if (OnlineSessionInterface) OnlineSessionInterface->ClearOnEndSessionCompleteDelegate_Handle(EndSessionCompleteDelegateHandle);
+
+	BroadcastSessionEvent(DustLinkOnEndSessionCompleteNative, DustLinkOnEndSessionComplete, bWasSuccessful);
+
+	if (PendingLobbyPath.IsEmpty()) return;
+
+	if (!bWasSuccessful)
+	{
+		PendingLobbyPath.Reset();
+		return;
+	}
+
+	UpdateSession();
+}
+
+/**
+ * @brief Callback for when session update is complete.
+ *
+ * This method is triggered by the `FOnUpdateSessionCompleteDelegate` when the session update process finishes.
+ * 
+ * @param SessionName The name of the session that was updated.
+ * @param bWasSuccessful Whether the session settings were successfully updated.
+ */
+void UDustLinkSubsystem::OnUpdateSessionComplete(FName SessionName, bool bWasSuccessful)
+{
+	if (OnlineSessionInterface) OnlineSessionInterface->ClearOnUpdateSessionCompleteDelegate_Handle(UpdateSessionCompleteDelegateHandle);
+
+	BroadcastSessionEvent(DustLinkOnUpdateSessionCompleteNative, DustLinkOnUpdateSessionComplete, bWasSuccessful);
+
+	if (bCreateSessionOnUpdate)
+	{
+		bCreateSessionOnUpdate = false;
+		BroadcastSessionEvent(DustLinkOnCreateSessionCompleteNative, DustLinkOnCreateSessionComplete, bWasSuccessful);
+
+		// The reused session is a new match, its load is measured from scratch like a created one
+		if (bWasSuccessful) StartLoadMonitor();
+	}
+
+	if (PendingLobbyPath.IsEmpty()) return;
+
+	const FString LobbyPath = PendingLobbyPath;
+	PendingLobbyPath.Reset();
+
+	// The lobby is reached even if re-opening failed, the session itself is still intact
+	if (UWorld* World = GetWorld())
+	{
+		Metrics->BeginPhase(EDustLinkLatencyPhase::Travel);
+		World->ServerTravel(LobbyPath);
+	}
+}
+
+/**
+ * @brief Replaces the session result store with the results of the most recent search.
+ *
+ * Computes the difference against the previous store and broadcasts it through `DustLinkOnSessionListChanged`.
+ *
+ * @param SearchResults The results of the most recent successful search.
+ * @return The difference between the previous and the new result store.
+ */
+FDustLinkSessionDiff UDustLinkSubsystem::UpdateSessionResultStore(const TArray<FOnlineSessionSearchResult>& SearchResults)
+{
+	FDustLinkSessionResultStore NewResultStore;
+	NewResultStore.Reserve(SearchResults.Num());
+	SessionResultOrder.Reset(SearchResults.Num());
+
+	for (const FOnlineSessionSearchResult& Result : SearchResults)
+	{
+		FString SessionId = FDustLinkSessionDiff::GetSessionKey(Result);
+
+		if (SessionId.IsEmpty() || NewResultStore.Contains(SessionId)) continue;
+
+		NewResultStore.Add(SessionId, Result);
+		SessionResultOrder.Add(MoveTemp(SessionId));
+	}
+
+	const FDustLinkSessionDiff Diff = FDustLinkSessionDiff::Compute(SessionResultStore, NewResultStore);
+	SessionResultStore = MoveTemp(NewResultStore);
+	PingScheduler.Forget(Diff.Removed);
+
+	for (const FString& SessionId : Diff.Removed) ProbedPings.Remove(SessionId);
+
+	if (!Diff.IsEmpty()) DustLinkOnSessionListChanged.Broadcast(Diff);
+
+	return Diff;
 }
\ No newline at end of file
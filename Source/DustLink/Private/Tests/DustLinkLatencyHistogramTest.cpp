@@ -0,0 +1,139 @@
+// Copyright Dustbyte Software. All Rights Reserved.
+
+#include "DustLink/Public/Online/DustLinkLatencyHistogram.h"
+
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace DustLinkLatencyHistogramTest
+{
+	/** Returns a percentile of the samples with the same nearest-rank definition the histogram uses. */
+	double GetExactPercentile(const TArray<double>& SortedSamples, const double Percentile)
+	{
+		const int32 Rank = FMath::Max(1, FMath::CeilToInt(Percentile / 100.0 * SortedSamples.Num()));
+
+		return SortedSamples[FMath::Min(Rank, SortedSamples.Num()) - 1];
+	}
+
+	/** Checks the usual percentiles of the histogram against the exact ones, within one percent. */
+	void TestPercentiles(FAutomationTestBase& Test, const TCHAR* Distribution, const FDustLinkLatencyHistogram& Histogram, TArray<double> Samples)
+	{
+		Samples.Sort();
+
+		for (const double Percentile : { 1.0, 10.0, 50.0, 90.0, 99.0, 99.9, 100.0 })
+		{
+			const double Expected = GetExactPercentile(Samples, Percentile);
+
+			Test.TestNearlyEqual(FString::Printf(TEXT("%s p%g is within 1%%"), Distribution, Percentile), Histogram.GetPercentile(Percentile), Expected, Expected * 0.01);
+		}
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDustLinkLatencyHistogramTest, "DustLink.Online.LatencyHistogram",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FDustLinkLatencyHistogramTest::RunTest(const FString& Parameters)
+{
+	using namespace DustLinkLatencyHistogramTest;
+
+	{
+		FDustLinkLatencyHistogram Histogram;
+
+		TestEqual(TEXT("An empty histogram has no count"), Histogram.GetCount(), uint64(0));
+		TestEqual(TEXT("An empty histogram reports zero"), Histogram.GetPercentile(50.0), 0.0);
+		TestEqual(TEXT("An empty histogram has no mean"), Histogram.GetMeanMs(), 0.0);
+	}
+
+	{
+		FDustLinkLatencyHistogram Histogram;
+		TArray<double> Samples;
+
+		for (int32 Value = 1; Value <= 10000; ++Value)
+		{
+			Histogram.Record(Value);
+			Samples.Add(Value);
+		}
+
+		TestEqual(TEXT("Every sample is counted"), Histogram.GetCount(), uint64(10000));
+		TestNearlyEqual(TEXT("The mean is exact"), Histogram.GetMeanMs(), 5000.5, 0.001);
+		TestNearlyEqual(TEXT("The max is exact"), Histogram.GetMaxMs(), 10000.0, 0.001);
+		TestPercentiles(*this, TEXT("Uniform"), Histogram, Samples);
+	}
+
+	{
+		FDustLinkLatencyHistogram Histogram;
+		TArray<double> Samples;
+		FRandomStream Random(4711);
+
+		// Long-tailed like real session latencies, offset so microsecond truncation stays far below one percent
+		for (int32 Index = 0; Index < 50000; ++Index)
+		{
+			const double Value = 1.0 - 50.0 * FMath::Loge(1.0 - Random.GetFraction());
+
+			Histogram.Record(Value);
+			Samples.Add(Value);
+		}
+
+		TestPercentiles(*this, TEXT("Exponential"), Histogram, Samples);
+	}
+
+	{
+		FDustLinkLatencyHistogram Histogram;
+
+		for (int32 Index = 0; Index < 99; ++Index) Histogram.Record(10.0);
+
+		Histogram.Record(5000.0);
+
+		TestNearlyEqual(TEXT("A single outlier does not move p99"), Histogram.GetPercentile(99.0), 10.0, 0.1);
+		TestNearlyEqual(TEXT("A single outlier is p100"), Histogram.GetPercentile(100.0), 5000.0, 50.0);
+	}
+
+	{
+		// Below SubBucketCount microseconds every microsecond has its own bucket
+		FDustLinkLatencyHistogram Histogram;
+		Histogram.Record(0.127);
+		Histogram.Record(1.0);
+
+		TestEqual(TEXT("The last one microsecond bucket is exact"), Histogram.GetPercentile(50.0), 0.127);
+	}
+
+	{
+		// 255 µs falls into [254, 256) and 256 µs starts the first four microsecond wide bucket [256, 260)
+		FDustLinkLatencyHistogram Below;
+		Below.Record(0.255);
+		Below.Record(1.0);
+
+		FDustLinkLatencyHistogram Above;
+		Above.Record(0.256);
+		Above.Record(1.0);
+
+		TestEqual(TEXT("The last bucket below a power of two reports its middle"), Below.GetPercentile(50.0), 0.255);
+		TestEqual(TEXT("The first bucket of a power of two reports its middle"), Above.GetPercentile(50.0), 0.258);
+	}
+
+	{
+		FDustLinkLatencyHistogram Histogram;
+		Histogram.Record(-5.0);
+
+		TestEqual(TEXT("Negative latencies are recorded as zero"), Histogram.GetPercentile(100.0), 0.0);
+
+		Histogram.Record(1.0e9);
+
+		const double MaxTrackableMs = ((uint64(1) << FDustLinkLatencyHistogram::MaxValueBits) - 1) / 1000.0;
+
+		TestEqual(TEXT("Latencies beyond the range are clamped"), Histogram.GetMaxMs(), MaxTrackableMs);
+		TestNearlyEqual(TEXT("The last bucket is within 1% of the range"), Histogram.GetPercentile(100.0), MaxTrackableMs, MaxTrackableMs * 0.01);
+
+		Histogram.Reset();
+
+		TestEqual(TEXT("A reset forgets the count"), Histogram.GetCount(), uint64(0));
+		TestEqual(TEXT("A reset forgets the max"), Histogram.GetMaxMs(), 0.0);
+		TestEqual(TEXT("A reset forgets the buckets"), Histogram.GetPercentile(100.0), 0.0);
+	}
+
+	return true;
+}
+
+#endif
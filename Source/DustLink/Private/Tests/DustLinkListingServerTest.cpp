@@ -0,0 +1,76 @@
+// Copyright Dustbyte Software. All Rights Reserved.
+
+#include "DustLink/Public/Online/DustLinkListingServer.h"
+
+#include "HttpServerRequest.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace DustLinkListingServerTest
+{
+	/** Builds a request to the join code route as the HTTP router would hand it over. */
+	FHttpServerRequest MakeRequest(const EHttpServerRequestVerbs Verb, const FString& Code, const FString& ConnectInfo = FString(), const FString& Secret = FString())
+	{
+		FHttpServerRequest Request;
+		Request.Verb = Verb;
+		Request.QueryParams.Add(TEXT("code"), Code);
+
+		if (!Secret.IsEmpty()) Request.QueryParams.Add(TEXT("secret"), Secret);
+
+		const FTCHARToUTF8 Body(*ConnectInfo);
+		Request.Body.Append(reinterpret_cast<const uint8*>(Body.Get()), Body.Length());
+
+		return Request;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDustLinkListingServerTest, "DustLink.Online.ListingServer",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FDustLinkListingServerTest::RunTest(const FString& Parameters)
+{
+	using namespace DustLinkListingServerTest;
+
+	FDustLinkListingServer Server;
+
+	TestEqual(TEXT("Unknown codes are not found"), Server.HandleRequest(MakeRequest(EHttpServerRequestVerbs::VERB_GET, TEXT("ABCDEF"))).Key, 404);
+	TestEqual(TEXT("Requests without a code are refused"), Server.HandleRequest(MakeRequest(EHttpServerRequestVerbs::VERB_GET, FString())).Key, 400);
+	TestEqual(TEXT("Registrations without connect info are refused"), Server.HandleRequest(MakeRequest(EHttpServerRequestVerbs::VERB_PUT, TEXT("ABCDEF"))).Key, 400);
+
+	const TPair<int32, FString> Registration = Server.HandleRequest(MakeRequest(EHttpServerRequestVerbs::VERB_PUT, TEXT("ABCDEF"), TEXT("10.0.0.1:7777")));
+	const FString Secret = Registration.Value;
+
+	TestEqual(TEXT("A free code is registered"), Registration.Key, 200);
+	TestFalse(TEXT("A registration answers with its secret"), Secret.IsEmpty());
+
+	const TPair<int32, FString> Renewal = Server.HandleRequest(MakeRequest(EHttpServerRequestVerbs::VERB_PUT, TEXT("ABCDEF"), TEXT("10.0.0.1:7777"), Secret));
+	TestEqual(TEXT("The same host registers again with its secret"), Renewal.Key, 200);
+	TestEqual(TEXT("A renewal keeps the secret"), Renewal.Value, Secret);
+
+	TestEqual(TEXT("Another host cannot take the code"), Server.HandleRequest(MakeRequest(EHttpServerRequestVerbs::VERB_PUT, TEXT("ABCDEF"), TEXT("10.0.0.2:7777"))).Key, 409);
+	TestEqual(TEXT("Known connect info does not take the code"), Server.HandleRequest(MakeRequest(EHttpServerRequestVerbs::VERB_PUT, TEXT("ABCDEF"), TEXT("10.0.0.1:7777"))).Key, 409);
+	TestEqual(TEXT("A wrong secret does not take the code"), Server.HandleRequest(MakeRequest(EHttpServerRequestVerbs::VERB_PUT, TEXT("ABCDEF"), TEXT("10.0.0.2:7777"), TEXT("guess"))).Key, 409);
+
+	const TPair<int32, FString> Lookup = Server.HandleRequest(MakeRequest(EHttpServerRequestVerbs::VERB_GET, TEXT("abc-def")));
+	TestEqual(TEXT("Codes are looked up normalized"), Lookup.Key, 200);
+	TestEqual(TEXT("The first host keeps the code"), Lookup.Value, FString(TEXT("10.0.0.1:7777")));
+	TestEqual(TEXT("One code is registered"), Server.GetNumJoinCodes(), 1);
+
+	TestEqual(TEXT("A code is not unregistered without its secret"), Server.HandleRequest(MakeRequest(EHttpServerRequestVerbs::VERB_DELETE, TEXT("ABCDEF"))).Key, 403);
+	TestEqual(TEXT("A code is not unregistered with its public connect info"), Server.HandleRequest(MakeRequest(EHttpServerRequestVerbs::VERB_DELETE, TEXT("ABCDEF"), TEXT("10.0.0.1:7777"))).Key, 403);
+	TestEqual(TEXT("A code is not unregistered with a wrong secret"), Server.HandleRequest(MakeRequest(EHttpServerRequestVerbs::VERB_DELETE, TEXT("ABCDEF"), FString(), TEXT("guess"))).Key, 403);
+	TestEqual(TEXT("A refused removal keeps the code"), Server.HandleRequest(MakeRequest(EHttpServerRequestVerbs::VERB_GET, TEXT("ABCDEF"))).Key, 200);
+
+	TestEqual(TEXT("A code is unregistered by its host"), Server.HandleRequest(MakeRequest(EHttpServerRequestVerbs::VERB_DELETE, TEXT("ABCDEF"), FString(), Secret)).Key, 200);
+	TestEqual(TEXT("Unregistered codes are not found"), Server.HandleRequest(MakeRequest(EHttpServerRequestVerbs::VERB_GET, TEXT("ABCDEF"))).Key, 404);
+	TestEqual(TEXT("Removing an unknown code succeeds"), Server.HandleRequest(MakeRequest(EHttpServerRequestVerbs::VERB_DELETE, TEXT("ABCDEF"), FString(), Secret)).Key, 200);
+
+	const TPair<int32, FString> Takeover = Server.HandleRequest(MakeRequest(EHttpServerRequestVerbs::VERB_PUT, TEXT("ABCDEF"), TEXT("10.0.0.2:7777")));
+	TestEqual(TEXT("A released code can be taken"), Takeover.Key, 200);
+	TestNotEqual(TEXT("A new registration gets a new secret"), Takeover.Value, Secret);
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,212 @@
+// Copyright Dustbyte Software. All Rights Reserved.
+
+#include "DustLink/Public/Online/DustLinkNetworkProfile.h"
+
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Misc/AutomationTest.h"
+#include "DustLink/Public/Online/DustLinkSubsystem.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace DustLinkNetworkBenchmarkTest
+{
+	/** Number of searches run under every profile. */
+	constexpr int32 NumSearches { 10 };
+
+	/** Time a single operation may take before the sweep gives up on it, in seconds. */
+	constexpr double OperationTimeout { 30.0 };
+
+	/** Progress of the sweep, shared by its latent commands. */
+	struct FSweep
+	{
+		TWeakObjectPtr<UDustLinkSubsystem> Subsystem;
+
+		/** Profile emulated before the sweep, restored once it ends. */
+		FString InitialProfile;
+
+		/** Profile the current command searches under, empty before it started. */
+		FString CurrentProfile;
+
+		/** Number of searches completed under the current profile. */
+		int32 NumCompleted { 0 };
+
+		/** Whether an operation is waiting for its completion. */
+		bool bIsWaiting { false };
+
+		/** Time the waiting operation was issued. */
+		double WaitStartTime { 0.0 };
+
+		/** Subscription to the completion the sweep waits for. */
+		FDelegateHandle Handle;
+	};
+
+	/** Returns the DustLink subsystem of the first game or PIE world that began play, the sweep needs a running game instance. */
+	UDustLinkSubsystem* FindSubsystem()
+	{
+		if (!GEngine) return nullptr;
+
+		for (const FWorldContext& Context : GEngine->GetWorldContexts())
+		{
+			const UWorld* World = Context.World();
+
+			if (!World || !World->HasBegunPlay() || (Context.WorldType != EWorldType::Game && Context.WorldType != EWorldType::PIE)) continue;
+
+			if (const UGameInstance* GameInstance = World->GetGameInstance()) return GameInstance->GetSubsystem<UDustLinkSubsystem>();
+		}
+
+		return nullptr;
+	}
+}
+
+DEFINE_LATENT_AUTOMATION_COMMAND_TWO_PARAMETER(FDustLinkHostBenchmarkSession, TSharedRef<DustLinkNetworkBenchmarkTest::FSweep>, Sweep, FAutomationTestBase*, Test);
+
+bool FDustLinkHostBenchmarkSession::Update()
+{
+	using namespace DustLinkNetworkBenchmarkTest;
+
+	UDustLinkSubsystem* Subsystem = Sweep->Subsystem.Get();
+
+	if (!Subsystem) return true;
+
+	if (!Sweep->bIsWaiting)
+	{
+		// The null backend finds the session hosted by the same process, so every search has a result
+		Sweep->bIsWaiting = true;
+		Sweep->WaitStartTime = FPlatformTime::Seconds();
+		Sweep->Handle = Subsystem->DustLinkOnCreateSessionCompleteNative.AddLambda([Sweep = Sweep, Test = Test](const bool bWasSuccessful)
+		{
+			Test->TestTrue(TEXT("The benchmark session is hosted"), bWasSuccessful);
+			Sweep->bIsWaiting = false;
+		});
+
+		Subsystem->CreateSession(4, TEXT("DustLinkBenchmark"));
+		return false;
+	}
+
+	if (FPlatformTime::Seconds() - Sweep->WaitStartTime > OperationTimeout)
+	{
+		Test->AddError(TEXT("Hosting the benchmark session timed out."));
+		Sweep->bIsWaiting = false;
+	}
+
+	if (Sweep->bIsWaiting) return false;
+
+	Subsystem->DustLinkOnCreateSessionCompleteNative.Remove(Sweep->Handle);
+
+	return true;
+}
+
+DEFINE_LATENT_AUTOMATION_COMMAND_THREE_PARAMETER(FDustLinkSearchUnderProfile, TSharedRef<DustLinkNetworkBenchmarkTest::FSweep>, Sweep, FString, ProfileName, FAutomationTestBase*, Test);
+
+bool FDustLinkSearchUnderProfile::Update()
+{
+	using namespace DustLinkNetworkBenchmarkTest;
+
+	UDustLinkSubsystem* Subsystem = Sweep->Subsystem.Get();
+
+	if (!Subsystem) return true;
+
+	if (Sweep->CurrentProfile != ProfileName)
+	{
+		Test->TestTrue(FString::Printf(TEXT("Profile %s is emulated"), *ProfileName), Subsystem->SetNetworkProfile(ProfileName));
+
+		Sweep->CurrentProfile = ProfileName;
+		Sweep->NumCompleted = 0;
+		Sweep->Handle = Subsystem->DustLinkOnFindSessionsComplete.AddLambda([Sweep = Sweep](const TArray<FOnlineSessionSearchResult>&, const bool)
+		{
+			// Lost answers fail the search and are left out of the report, they still count towards the runs
+			++Sweep->NumCompleted;
+			Sweep->bIsWaiting = false;
+		});
+	}
+
+	if (Sweep->bIsWaiting)
+	{
+		if (FPlatformTime::Seconds() - Sweep->WaitStartTime <= OperationTimeout) return false;
+
+		Test->AddError(FString::Printf(TEXT("A search under profile %s timed out."), *ProfileName));
+		Sweep->bIsWaiting = false;
+		Sweep->NumCompleted = NumSearches;
+	}
+
+	if (Sweep->NumCompleted < NumSearches)
+	{
+		// Issued from the command rather than the completion, so a search never starts inside the broadcast of the last one
+		Sweep->bIsWaiting = true;
+		Sweep->WaitStartTime = FPlatformTime::Seconds();
+		Subsystem->FindSessions(10);
+		return false;
+	}
+
+	Subsystem->DustLinkOnFindSessionsComplete.Remove(Sweep->Handle);
+
+	return true;
+}
+
+DEFINE_LATENT_AUTOMATION_COMMAND_TWO_PARAMETER(FDustLinkReportBenchmark, TSharedRef<DustLinkNetworkBenchmarkTest::FSweep>, Sweep, FAutomationTestBase*, Test);
+
+bool FDustLinkReportBenchmark::Update()
+{
+	UDustLinkSubsystem* Subsystem = Sweep->Subsystem.Get();
+
+	if (!Subsystem) return true;
+
+	const FString Report = Subsystem->GetNetworkProfileReport();
+
+	TArray<FString> Lines;
+	Report.ParseIntoArrayLines(Lines);
+
+	for (const FString& Line : Lines) Test->AddInfo(Line);
+
+	for (const FDustLinkNetworkProfile& Profile : FDustLinkNetworkProfile::GetBuiltInProfiles())
+	{
+		Test->TestTrue(FString::Printf(TEXT("Profile %s is in the report"), *Profile.Name), Report.Contains(Profile.Name));
+	}
+
+	Subsystem->SetNetworkProfile(Sweep->InitialProfile);
+	Subsystem->DestroySession();
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDustLinkNetworkBenchmarkTest, "DustLink.Online.NetworkBenchmark",
+	EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FDustLinkNetworkBenchmarkTest::RunTest(const FString& Parameters)
+{
+	using namespace DustLinkNetworkBenchmarkTest;
+
+	UDustLinkSubsystem* Subsystem = FindSubsystem();
+
+	if (!Subsystem)
+	{
+		AddError(TEXT("No game world with a DustLink subsystem, run the test in a -game session."));
+		return false;
+	}
+
+	// Background searches would complete in the middle of the sweep's own searches
+	Subsystem->StopAutoRefresh();
+
+	const TSharedRef<FSweep> Sweep = MakeShared<FSweep>();
+	Sweep->Subsystem = Subsystem;
+	Sweep->InitialProfile = Subsystem->GetNetworkProfile().Name;
+
+	// A reset keeps a run for the current profile, which would otherwise become the baseline
+	Subsystem->SetNetworkProfile(FDustLinkNetworkProfile::GetBuiltInProfiles()[0].Name);
+	Subsystem->ResetNetworkProfileReport();
+
+	ADD_LATENT_AUTOMATION_COMMAND(FDustLinkHostBenchmarkSession(Sweep, this));
+
+	// Built-in profiles are ordered from ideal to poor links, so the first one is the baseline of the report
+	for (const FDustLinkNetworkProfile& Profile : FDustLinkNetworkProfile::GetBuiltInProfiles())
+	{
+		ADD_LATENT_AUTOMATION_COMMAND(FDustLinkSearchUnderProfile(Sweep, Profile.Name, this));
+	}
+
+	ADD_LATENT_AUTOMATION_COMMAND(FDustLinkReportBenchmark(Sweep, this));
+
+	return true;
+}
+
+#endif
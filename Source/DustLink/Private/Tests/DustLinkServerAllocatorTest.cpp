@@ -0,0 +1,175 @@
+// Copyright Dustbyte Software. All Rights Reserved.
+
+#include "DustLink/Public/Fleet/DustLinkServerAllocator.h"
+
+#include "Misc/AutomationTest.h"
+#include "DustLink/Public/Fleet/DustLinkServerPool.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace DustLinkServerAllocatorTest
+{
+	/** Pool that boots no processes, it hands matches to a number of pretend idle servers and completes them on request. */
+	class FFakePool : public FDustLinkServerPool
+	{
+	public:
+		FFakePool(const FString& Region, const int32 InNumIdle):
+			NumIdle(InNumIdle)
+		{
+			FDustLinkServerPoolSettings PoolSettings;
+			PoolSettings.Region = Region;
+			PoolSettings.WarmServers = 0;
+			Start(PoolSettings);
+		}
+
+		virtual bool Allocate(const FDustLinkMatchConfig& Config, const FDustLinkOnServerAllocated& OnComplete) override
+		{
+			if (NumIdle <= 0) return false;
+
+			--NumIdle;
+			Pushed.Add(Config);
+			PushedCallbacks.Add(OnComplete);
+
+			return true;
+		}
+
+		virtual bool Release(const int32 ServerSlot) override
+		{
+			return Pushed.IsValidIndex(ServerSlot);
+		}
+
+		/** Answers the match pushed to a slot as the server would once its session exists or failed. */
+		void Complete(const int32 ServerSlot, const bool bWasSuccessful)
+		{
+			PushedCallbacks[ServerSlot].ExecuteIfBound(ServerSlot, bWasSuccessful ? FString::Printf(TEXT("10.0.0.1:%d"), 7777 + ServerSlot) : FString(), bWasSuccessful);
+		}
+
+		/** Number of servers that still take a match. */
+		int32 NumIdle { 0 };
+
+		/** Matches pushed so far, indexed by the slot they were placed in. */
+		TArray<FDustLinkMatchConfig> Pushed;
+
+		/** Completions of the pushed matches. */
+		TArray<FDustLinkOnServerAllocated> PushedCallbacks;
+	};
+
+	/** Builds a match for a region with the given players. */
+	FDustLinkMatchConfig MakeMatch(const FString& Region, const TArray<FString>& Players)
+	{
+		FDustLinkMatchConfig Match;
+		Match.MatchType = TEXT("FFA");
+		Match.Region = Region;
+		Match.ExpectedPlayers = Players;
+
+		return Match;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDustLinkServerAllocatorTest, "DustLink.Fleet.ServerAllocator",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FDustLinkServerAllocatorTest::RunTest(const FString& Parameters)
+{
+	using namespace DustLinkServerAllocatorTest;
+
+	FDustLinkAllocatorSettings Settings;
+	Settings.QueueTimeout = 5.f;
+
+	const TSharedRef<FDustLinkServerAllocator> Allocator = MakeShared<FDustLinkServerAllocator>(Settings);
+	const TSharedRef<FFakePool> Europe = MakeShared<FFakePool>(TEXT("eu"), 1);
+	const TSharedRef<FFakePool> America = MakeShared<FFakePool>(TEXT("us"), 0);
+
+	Allocator->AddPool(Europe);
+	Allocator->AddPool(America);
+
+	TMap<FString, FDustLinkAllocation> Results;
+
+	auto Allocate = [&Allocator, &Results](const FString& Name, const FDustLinkMatchConfig& Match)
+	{
+		Allocator->Allocate(Match, FDustLinkOnAllocationComplete::CreateLambda([&Results, Name](const FDustLinkAllocation& Allocation)
+		{
+			Results.Add(Name, Allocation);
+		}));
+	};
+
+	Allocate(TEXT("Unknown"), MakeMatch(TEXT("mars"), { TEXT("P0") }));
+
+	TestTrue(TEXT("A match for an unknown region fails right away"), Results.Contains(TEXT("Unknown")) && !Results[TEXT("Unknown")].bWasSuccessful);
+	TestEqual(TEXT("The failure names the requested region"), Results.FindRef(TEXT("Unknown")).Region, FString(TEXT("mars")));
+	TestEqual(TEXT("A match for an unknown region is not queued"), Allocator->GetQueueDepth(), 0);
+
+	FDustLinkMatchConfig Placed = MakeMatch(TEXT("eu"), { TEXT("P1"), TEXT("P2") });
+	Placed.PlayerTokens.Add(TEXT("P2"), TEXT("Given"));
+	Allocate(TEXT("Placed"), Placed);
+
+	TestEqual(TEXT("A match with an idle server in its region is pushed to it"), Europe->Pushed.Num(), 1);
+	TestEqual(TEXT("The pushed match is in flight"), Allocator->GetNumInFlight(), 1);
+
+	if (Europe->Pushed.Num() == 1)
+	{
+		const FString IssuedToken = Europe->Pushed[0].PlayerTokens.FindRef(TEXT("P1"));
+
+		TestFalse(TEXT("Every expected player is issued a token"), IssuedToken.IsEmpty());
+		TestEqual(TEXT("A token handed in with the match is kept"), Europe->Pushed[0].PlayerTokens.FindRef(TEXT("P2")), FString(TEXT("Given")));
+
+		Europe->Complete(0, true);
+
+		const FDustLinkAllocation Allocation = Results.FindRef(TEXT("Placed"));
+
+		TestTrue(TEXT("A created session completes the allocation"), Allocation.bWasSuccessful);
+		TestEqual(TEXT("The allocation names the pool's region"), Allocation.Region, FString(TEXT("eu")));
+		TestEqual(TEXT("The allocation names the server's slot"), Allocation.ServerSlot, 0);
+		TestEqual(TEXT("Every player is handed a connect URL carrying its token"),
+			Allocation.PlayerConnectInfo.FindRef(TEXT("P1")), FString::Printf(TEXT("10.0.0.1:7777?DustLinkPlayer=P1?DustLinkToken=%s"), *IssuedToken));
+		TestEqual(TEXT("Nothing is in flight once the server answered"), Allocator->GetNumInFlight(), 0);
+		TestTrue(TEXT("The allocated server is released in its region"), Allocator->Release(TEXT("eu"), 0));
+	}
+
+	TestFalse(TEXT("Nothing is released in an unknown region"), Allocator->Release(TEXT("mars"), 0));
+
+	Allocate(TEXT("Waiting"), MakeMatch(TEXT("us"), { TEXT("P3") }));
+
+	TestEqual(TEXT("A match without an idle server is queued"), Allocator->GetQueueDepth(), 1);
+
+	Europe->NumIdle = 1;
+	Allocate(TEXT("Behind"), MakeMatch(TEXT("eu"), { TEXT("P4") }));
+
+	TestEqual(TEXT("A newer match does not overtake the queue"), Allocator->GetQueueDepth(), 2);
+	TestEqual(TEXT("A queued match is not pushed before the queue is served"), Europe->Pushed.Num(), 1);
+
+	const double Now = FPlatformTime::Seconds();
+	Allocator->Tick(Now);
+
+	TestEqual(TEXT("A queued match is pushed once a server of its region is idle"), Europe->Pushed.Num(), 2);
+	TestEqual(TEXT("A match whose region has no idle server keeps waiting"), Allocator->GetQueueDepth(), 1);
+	TestFalse(TEXT("A waiting match is not reported"), Results.Contains(TEXT("Waiting")));
+
+	if (Europe->Pushed.Num() == 2)
+	{
+		TestNotEqual(TEXT("Tokens differ between matches"), Europe->Pushed[1].PlayerTokens.FindRef(TEXT("P4")), Europe->Pushed[0].PlayerTokens.FindRef(TEXT("P1")));
+
+		Europe->Complete(1, false);
+
+		TestTrue(TEXT("A server that failed to create the session fails the allocation"), Results.Contains(TEXT("Behind")) && !Results[TEXT("Behind")].bWasSuccessful);
+		TestTrue(TEXT("A failed allocation hands out no connect URLs"), Results.FindRef(TEXT("Behind")).PlayerConnectInfo.IsEmpty());
+	}
+
+	Allocator->Tick(Now + Settings.QueueTimeout + 1.0);
+
+	TestEqual(TEXT("A match that waited too long leaves the queue"), Allocator->GetQueueDepth(), 0);
+	TestTrue(TEXT("A match that waited too long fails"), Results.Contains(TEXT("Waiting")) && !Results[TEXT("Waiting")].bWasSuccessful);
+	TestEqual(TEXT("The timed out match names its region"), Results.FindRef(TEXT("Waiting")).Region, FString(TEXT("us")));
+
+	TestEqual(TEXT("One allocation succeeded"), Allocator->GetNumSucceeded(), 1);
+	TestEqual(TEXT("Three allocations failed"), Allocator->GetNumFailed(), 3);
+
+	Allocator->ResetStats();
+
+	TestEqual(TEXT("Resetting forgets the counts"), Allocator->GetNumSucceeded() + Allocator->GetNumFailed(), 0);
+	TestEqual(TEXT("Resetting forgets the latencies"), Allocator->GetLatencyPercentile(95.f), 0.0);
+
+	return true;
+}
+
+#endif
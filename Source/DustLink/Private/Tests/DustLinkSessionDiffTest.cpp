@@ -0,0 +1,93 @@
+// Copyright Dustbyte Software. All Rights Reserved.
+
+#include "DustLink/Public/Online/DustLinkSessionDiff.h"
+
+#include "Misc/AutomationTest.h"
+#include "DustLink/Public/Online/DustLinkPresenceProvider.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace DustLinkSessionDiffTest
+{
+	/** Builds a result store from mock sessions, keyed the way the subsystem keys its search results. */
+	FDustLinkSessionResultStore MakeStore(const TArray<FOnlineSessionSearchResult>& Results)
+	{
+		FDustLinkSessionResultStore Store;
+
+		for (const FOnlineSessionSearchResult& Result : Results) Store.Add(FDustLinkSessionDiff::GetSessionKey(Result), Result);
+
+		return Store;
+	}
+
+	/** Returns the fields reported as changed for a session, or `None` if the session is not among the changes. */
+	EDustLinkSessionChange FindChange(const FDustLinkSessionDiff& Diff, const FString& SessionId)
+	{
+		const FDustLinkSessionChange* Change = Diff.Changed.FindByPredicate([&SessionId](const FDustLinkSessionChange& Candidate)
+		{
+			return Candidate.SessionId.Equals(SessionId, ESearchCase::CaseSensitive);
+		});
+
+		return Change ? Change->Fields : EDustLinkSessionChange::None;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDustLinkSessionDiffTest, "DustLink.Online.SessionDiff",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FDustLinkSessionDiffTest::RunTest(const FString& Parameters)
+{
+	using namespace DustLinkSessionDiffTest;
+
+	const FOnlineSessionSearchResult Stable = FDustLinkMockPresenceProvider::MakeSessionResult(TEXT("Stable"), TEXT("FFA"), 2, 4, 30);
+	const FOnlineSessionSearchResult Leaving = FDustLinkMockPresenceProvider::MakeSessionResult(TEXT("Leaving"), TEXT("FFA"), 2, 4, 30);
+	const FOnlineSessionSearchResult Filling = FDustLinkMockPresenceProvider::MakeSessionResult(TEXT("Filling"), TEXT("FFA"), 3, 4, 30);
+	const FOnlineSessionSearchResult Filled = FDustLinkMockPresenceProvider::MakeSessionResult(TEXT("Filling"), TEXT("FFA"), 1, 4, 45);
+	const FOnlineSessionSearchResult Switching = FDustLinkMockPresenceProvider::MakeSessionResult(TEXT("Switching"), TEXT("FFA"), 2, 4, 30);
+	const FOnlineSessionSearchResult Switched = FDustLinkMockPresenceProvider::MakeSessionResult(TEXT("Switching"), TEXT("TDM"), 2, 4, 30);
+	const FOnlineSessionSearchResult Joining = FDustLinkMockPresenceProvider::MakeSessionResult(TEXT("Joining"), TEXT("FFA"), 2, 4, 30);
+
+	const FString StableId = FDustLinkSessionDiff::GetSessionKey(Stable);
+
+	TestFalse(TEXT("Results with session info are keyed"), StableId.IsEmpty());
+	TestTrue(TEXT("Results without session info are not keyed"), FDustLinkSessionDiff::GetSessionKey(FOnlineSessionSearchResult()).IsEmpty());
+
+	{
+		const FDustLinkSessionDiff Diff = FDustLinkSessionDiff::Compute(MakeStore({ Stable, Leaving }), MakeStore({ Stable, Leaving }));
+
+		TestTrue(TEXT("Identical searches produce an empty diff"), Diff.IsEmpty());
+	}
+
+	{
+		const FDustLinkSessionDiff Diff = FDustLinkSessionDiff::Compute(MakeStore({ Stable, Leaving, Filling, Switching }), MakeStore({ Stable, Filled, Switched, Joining }));
+
+		TestEqual(TEXT("One session is added"), Diff.Added.Num(), 1);
+		TestTrue(TEXT("The new session is added"), Diff.Added.Contains(FDustLinkSessionDiff::GetSessionKey(Joining)));
+		TestEqual(TEXT("One session is removed"), Diff.Removed.Num(), 1);
+		TestTrue(TEXT("The missing session is removed"), Diff.Removed.Contains(FDustLinkSessionDiff::GetSessionKey(Leaving)));
+		TestEqual(TEXT("Two sessions are changed"), Diff.Changed.Num(), 2);
+		TestTrue(TEXT("An unchanged session is not reported"), FindChange(Diff, StableId) == EDustLinkSessionChange::None);
+		TestTrue(TEXT("Slots and ping changes are reported"), FindChange(Diff, FDustLinkSessionDiff::GetSessionKey(Filling)) == (EDustLinkSessionChange::OpenConnections | EDustLinkSessionChange::Ping));
+		TestTrue(TEXT("Setting changes are reported"), FindChange(Diff, FDustLinkSessionDiff::GetSessionKey(Switching)) == EDustLinkSessionChange::Settings);
+		TestEqual(TEXT("Num counts every kind of change"), Diff.Num(), 4);
+	}
+
+	{
+		// Backends may hand out identifiers differing only in case, they are distinct sessions
+		const FOnlineSessionSearchResult Lower = FDustLinkMockPresenceProvider::MakeSessionResult(TEXT("host"), TEXT("FFA"), 2, 4, 30);
+		const FOnlineSessionSearchResult Upper = FDustLinkMockPresenceProvider::MakeSessionResult(TEXT("HOST"), TEXT("FFA"), 2, 4, 30);
+
+		const FDustLinkSessionResultStore Both = MakeStore({ Lower, Upper });
+
+		TestEqual(TEXT("Identifiers differing in case are kept apart"), Both.Num(), 2);
+
+		const FDustLinkSessionDiff Diff = FDustLinkSessionDiff::Compute(MakeStore({ Lower }), Both);
+
+		TestEqual(TEXT("A session differing in case is added"), Diff.Added.Num(), 1);
+		TestTrue(TEXT("The upper case session is the added one"), Diff.Added.Num() == 1 && Diff.Added[0].Equals(FDustLinkSessionDiff::GetSessionKey(Upper), ESearchCase::CaseSensitive));
+		TestTrue(TEXT("Nothing else changes"), Diff.Removed.IsEmpty() && Diff.Changed.IsEmpty());
+	}
+
+	return true;
+}
+
+#endif
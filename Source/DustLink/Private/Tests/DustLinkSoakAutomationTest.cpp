@@ -0,0 +1,93 @@
+// Copyright Dustbyte Software. All Rights Reserved.
+
+#include "DustLink/Public/Online/DustLinkSoakTest.h"
+
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Misc/AutomationTest.h"
+#include "DustLink/Public/Online/DustLinkSubsystem.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace DustLinkSoakAutomationTest
+{
+	/** Outcome of a soak run, filled in once it completes. */
+	struct FOutcome
+	{
+		bool bIsComplete { false };
+		bool bPassed { false };
+		FString Report;
+	};
+
+	/** Returns the DustLink subsystem of the first game or PIE world that began play, the soak needs a running game instance. */
+	UDustLinkSubsystem* FindSubsystem()
+	{
+		if (!GEngine) return nullptr;
+
+		for (const FWorldContext& Context : GEngine->GetWorldContexts())
+		{
+			const UWorld* World = Context.World();
+
+			if (!World || !World->HasBegunPlay() || (Context.WorldType != EWorldType::Game && Context.WorldType != EWorldType::PIE)) continue;
+
+			if (const UGameInstance* GameInstance = World->GetGameInstance()) return GameInstance->GetSubsystem<UDustLinkSubsystem>();
+		}
+
+		return nullptr;
+	}
+}
+
+DEFINE_LATENT_AUTOMATION_COMMAND_TWO_PARAMETER(FDustLinkWaitForSoak, TSharedRef<DustLinkSoakAutomationTest::FOutcome>, Outcome, FAutomationTestBase*, Test);
+
+bool FDustLinkWaitForSoak::Update()
+{
+	// The run aborts itself once a step stalls, so it always completes
+	if (!Outcome->bIsComplete) return false;
+
+	Test->TestTrue(FString::Printf(TEXT("The soak run passed. %s"), *Outcome->Report), Outcome->bPassed);
+
+	return true;
+}
+
+// Only a game client has a world that began play, editor and commandlet runs would fail for the lack of one
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDustLinkSoakAutomationTest, "DustLink.Online.Soak",
+	EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FDustLinkSoakAutomationTest::RunTest(const FString& Parameters)
+{
+	using namespace DustLinkSoakAutomationTest;
+
+	UDustLinkSubsystem* Subsystem = FindSubsystem();
+
+	if (!Subsystem)
+	{
+		AddError(TEXT("No game world with a DustLink subsystem, run the test in a -game session."));
+		return false;
+	}
+
+	// Short enough for a test pass, it proves the harness and catches leaks that grow every cycle
+	FDustLinkSoakSettings Settings;
+	Settings.NumCycles = 40;
+	Settings.WarmupCycles = 4;
+	Settings.SampleInterval = 12;
+	Settings.MaxLatencyDrift = 4.0;
+
+	const TSharedPtr<FDustLinkSoakTest> Soak = Subsystem->StartSoakTest(Settings);
+
+	if (!TestTrue(TEXT("No other soak run is in progress"), Soak.IsValid())) return false;
+
+	const TSharedRef<FOutcome> Outcome = MakeShared<FOutcome>();
+
+	Soak->OnComplete.AddLambda([Outcome](const bool bPassed, const FString& Report)
+	{
+		Outcome->bIsComplete = true;
+		Outcome->bPassed = bPassed;
+		Outcome->Report = Report;
+	});
+
+	ADD_LATENT_AUTOMATION_COMMAND(FDustLinkWaitForSoak(Outcome, this));
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,117 @@
+// Copyright Dustbyte Software. All Rights Reserved.
+
+#include "DustLink/Public/Travel/DustLinkTravelMemoryScheduler.h"
+
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "Misc/CoreDelegates.h"
+#include "UObject/UObjectGlobals.h"
+
+
+/**
+ * @brief Constructs the scheduler and hooks the engine's map load notifications.
+ *
+ * @param InGameInstance The game instance whose map loads are handled.
+ * @param InSettings The tuning parameters to use.
+ */
+FDustLinkTravelMemoryScheduler::FDustLinkTravelMemoryScheduler(const UGameInstance* InGameInstance, const FDustLinkTravelMemorySettings& InSettings):
+	GameInstance(InGameInstance),
+	Settings(InSettings)
+{
+	PreLoadMapHandle = FCoreUObjectDelegates::PreLoadMapWithContext.AddRaw(this, &FDustLinkTravelMemoryScheduler::HandlePreLoadMap);
+	PostLoadMapHandle = FCoreUObjectDelegates::PostLoadMapWithWorld.AddRaw(this, &FDustLinkTravelMemoryScheduler::HandlePostLoadMap);
+
+	if (Settings.IdleCollectionInterval > 0.f)
+	{
+		IdleTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+			FTickerDelegate::CreateRaw(this, &FDustLinkTravelMemoryScheduler::TickIdleCollection), Settings.IdleCollectionInterval);
+	}
+}
+
+FDustLinkTravelMemoryScheduler::~FDustLinkTravelMemoryScheduler()
+{
+	FCoreUObjectDelegates::PreLoadMapWithContext.Remove(PreLoadMapHandle);
+	FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(PostLoadMapHandle);
+
+	FTSTicker::GetCoreTicker().RemoveTicker(IdleTickerHandle);
+	FTSTicker::GetCoreTicker().RemoveTicker(ArrivalQuietTickerHandle);
+}
+
+/**
+ * @brief Callback for when a map is about to be loaded.
+ *
+ * @param WorldContext The context of the world the map is loaded into.
+ * @param MapName The name of the map being loaded.
+ */
+void FDustLinkTravelMemoryScheduler::HandlePreLoadMap(const FWorldContext& WorldContext, const FString& MapName)
+{
+	if (WorldContext.OwningGameInstance != GameInstance.Get()) return;
+
+	// A match map never declares idling, only a menu or lobby on the new map does
+	bIsIdle = false;
+
+	// Let menus drop their references so the purge performed by the map load frees them
+	OnPreTravel.Broadcast(MapName);
+	FCoreDelegates::GetMemoryTrimDelegate().Broadcast();
+
+	FTSTicker::GetCoreTicker().RemoveTicker(ArrivalQuietTickerHandle);
+	ArrivalQuietTickerHandle.Reset();
+}
+
+/**
+ * @brief Callback for when a map finished loading.
+ *
+ * @param World The world of the loaded map.
+ */
+void FDustLinkTravelMemoryScheduler::HandlePostLoadMap(UWorld* World)
+{
+	if (!World || World->GetGameInstance() != GameInstance.Get()) return;
+
+	OnPostTravel.Broadcast(World);
+
+	if (Settings.ArrivalQuietPeriod <= 0.f) return;
+
+	ArrivalQuietTimeLeft = Settings.ArrivalQuietPeriod;
+
+	if (!ArrivalQuietTickerHandle.IsValid())
+	{
+		ArrivalQuietTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+			FTickerDelegate::CreateRaw(this, &FDustLinkTravelMemoryScheduler::TickArrivalQuietPeriod));
+	}
+}
+
+/**
+ * @brief Ticker callback that collects garbage while idle.
+ *
+ * @param DeltaTime Time since the last call, in seconds.
+ * @return Always `true` to keep ticking.
+ */
+bool FDustLinkTravelMemoryScheduler::TickIdleCollection(float DeltaTime)
+{
+	if (bIsIdle && !IsInArrivalQuietPeriod() && GEngine) GEngine->ForceGarbageCollection(true);
+
+	return true;
+}
+
+/**
+ * @brief Ticker callback that defers garbage collection during the arrival quiet period.
+ *
+ * @param DeltaTime Time since the last call, in seconds.
+ * @return `true` until the quiet period is over.
+ */
+bool FDustLinkTravelMemoryScheduler::TickArrivalQuietPeriod(float DeltaTime)
+{
+	ArrivalQuietTimeLeft -= DeltaTime;
+
+	if (ArrivalQuietTimeLeft <= 0.f)
+	{
+		ArrivalQuietTickerHandle.Reset();
+		return false;
+	}
+
+	// Pushes the next scheduled collection past the upcoming frame
+	if (GEngine) GEngine->DelayGarbageCollection();
+
+	return true;
+}
@@ -0,0 +1,44 @@
+// Copyright Dustbyte Software. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+
+#include "DustLinkFleetCommandlet.generated.h"
+
+
+/**
+ * @class UDustLinkFleetCommandlet
+ * @brief Fleet agent that keeps warm dedicated servers on this machine and hands them matches.
+ *
+ * Runs a `FDustLinkServerPool` behind a `FDustLinkServerAllocator` and serves `POST /allocate` on
+ * localhost, whose body is a `FDustLinkMatchConfig` as JSON and whose response is a
+ * `FDustLinkAllocation` as JSON holding the connect info of every expected player.
+ * `POST /release?Region=&ServerSlot=` returns a server to the pool and `GET /pool` reports the
+ * number of servers per state and the number of queued matches.
+ *
+ * With `-Benchmark=N` the agent waits for its warm servers, allocates and releases N matches with
+ * `-Concurrency` of them in flight, logs throughput and latency percentiles and exits.
+ *
+ * Usage:
+ * `UnrealEditor-Cmd <Project> -run=DustLinkFleet -ServerMap=/Game/Maps/Entry -Region=local -WarmServers=2
+ *  -MaxServers=16 -BaseGamePort=7777 -BaseControlPort=8700 -AgentPort=8600 -QueueTimeout=10 -ServerArgs="..."
+ *  [-Benchmark=100 -Concurrency=2]`
+ */
+UCLASS()
+class DUSTLINK_API UDustLinkFleetCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UDustLinkFleetCommandlet();
+
+	/**
+	 * @brief Runs the fleet agent until the process is asked to exit.
+	 *
+	 * @param Params The command line of the commandlet.
+	 * @return The exit code of the process.
+	 */
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,45 @@
+// Copyright Dustbyte Software. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+
+/**
+ * @struct FDustLinkMatchConfig
+ * @brief Match a warm dedicated server is asked to host, exchanged as JSON over the local control channel.
+ */
+struct DUSTLINK_API FDustLinkMatchConfig
+{
+	/** Session type advertised in the `MatchType` setting. */
+	FString MatchType;
+
+	/** Number of player slots of the session. */
+	int32 NumPublicConnections { 4 };
+
+	/** Map the server travels to once its session exists, empty to stay on the current map. */
+	FString MatchMap;
+
+	/** Region the match should be hosted in, empty for any region. */
+	FString Region;
+
+	/** Identifiers of the players assigned to the match, the server only admits these when set. */
+	TArray<FString> ExpectedPlayers;
+
+	/** Secret admission token of every expected player, keyed by player identifier and issued by the allocator. */
+	TMap<FString, FString> PlayerTokens;
+
+	/**
+	 * @brief Encodes the config as a JSON object.
+	 */
+	FString ToJson() const;
+
+	/**
+	 * @brief Decodes a config produced by `ToJson`.
+	 *
+	 * @param Json The JSON object.
+	 * @param OutConfig The decoded config.
+	 * @return `true` if the JSON is a valid config.
+	 */
+	static bool FromJson(const FString& Json, FDustLinkMatchConfig& OutConfig);
+};
@@ -0,0 +1,194 @@
+// Copyright Dustbyte Software. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "DustLinkMatchConfig.h"
+
+class FDustLinkServerPool;
+
+
+/**
+ * @struct FDustLinkAllocation
+ * @brief Result of placing a match on a warm server.
+ */
+struct DUSTLINK_API FDustLinkAllocation
+{
+	/** Whether a server created the session of the match. */
+	bool bWasSuccessful { false };
+
+	/** Region of the pool the server belongs to. */
+	FString Region;
+
+	/** Slot of the server within its pool, used to release it. */
+	int32 ServerSlot { INDEX_NONE };
+
+	/** Address of the server. */
+	FString ConnectInfo;
+
+	/** Address every expected player travels to, carrying the player's identifier and admission token. */
+	TMap<FString, FString> PlayerConnectInfo;
+
+	/** Time from the allocation request to the session being created, in seconds. */
+	double Latency { 0.0 };
+
+	/**
+	 * @brief Encodes the allocation as a JSON object.
+	 */
+	FString ToJson() const;
+};
+
+/**
+ * Notifies the caller that a match was placed on a server, or could not be placed in time.
+ * @param Allocation The result of the allocation.
+ */
+DECLARE_DELEGATE_OneParam(FDustLinkOnAllocationComplete, const FDustLinkAllocation& Allocation);
+
+/**
+ * @struct FDustLinkAllocatorSettings
+ * @brief Tuning parameters of the server allocator.
+ */
+struct DUSTLINK_API FDustLinkAllocatorSettings
+{
+	/** Time a match waits for an idle server before its allocation fails, in seconds. */
+	float QueueTimeout { 10.f };
+
+	/** Number of recent allocation latencies kept for percentiles. */
+	int32 MaxLatencySamples { 4096 };
+};
+
+/**
+ * @class FDustLinkServerAllocator
+ * @brief Assigns matches to idle warm servers of per-region pools.
+ *
+ * A match names its players, type and region. The allocator picks an idle server of that region,
+ * pushes the match config including the expected player list, waits until the server created its
+ * session and reports one response holding the connect info of every player. Matches that find no
+ * idle server wait in a queue until one frees up or they time out. Throughput and latency of
+ * completed allocations are recorded for benchmarking.
+ */
+class DUSTLINK_API FDustLinkServerAllocator : public TSharedFromThis<FDustLinkServerAllocator>
+{
+public:
+	/**
+	 * @brief Constructs the allocator with the given tuning parameters.
+	 *
+	 * @param InSettings The tuning parameters to use.
+	 */
+	explicit FDustLinkServerAllocator(const FDustLinkAllocatorSettings& InSettings = FDustLinkAllocatorSettings());
+
+	/**
+	 * @brief Registers the pool serving a region.
+	 *
+	 * @param Pool The pool, its `Region` setting names the region.
+	 */
+	void AddPool(const TSharedRef<FDustLinkServerPool>& Pool);
+
+	/**
+	 * @brief Places a match on an idle server of its region, or of any region if none is named.
+	 *
+	 * @param Match The match to place.
+	 * @param OnComplete Called once the server created the session, or the allocation failed.
+	 */
+	void Allocate(const FDustLinkMatchConfig& Match, const FDustLinkOnAllocationComplete& OnComplete);
+
+	/**
+	 * @brief Returns the server of a finished match to its pool.
+	 *
+	 * @param Region The region reported by the allocation.
+	 * @param ServerSlot The slot reported by the allocation.
+	 * @return `false` if the server is not allocated.
+	 */
+	bool Release(const FString& Region, const int32 ServerSlot);
+
+	/**
+	 * @brief Places queued matches on servers that became idle and fails those that waited too long.
+	 *
+	 * @param Now The current time, in seconds.
+	 */
+	void Tick(const double Now);
+
+	/**
+	 * @brief Returns the number of matches waiting for an idle server.
+	 */
+	int32 GetQueueDepth() const { return Queue.Num(); }
+
+	/**
+	 * @brief Returns the number of allocations in flight to a server.
+	 */
+	int32 GetNumInFlight() const { return NumInFlight; }
+
+	/**
+	 * @brief Returns the number of allocations that succeeded.
+	 */
+	int32 GetNumSucceeded() const { return NumSucceeded; }
+
+	/**
+	 * @brief Returns the number of allocations that failed.
+	 */
+	int32 GetNumFailed() const { return NumFailed; }
+
+	/**
+	 * @brief Returns a percentile of recent successful allocation latencies, in seconds.
+	 *
+	 * @param Percentile The percentile in the range [0, 100].
+	 */
+	double GetLatencyPercentile(const float Percentile) const;
+
+	/**
+	 * @brief Forgets the recorded counts and latencies.
+	 */
+	void ResetStats();
+
+private:
+	/**
+	 * @struct FPendingAllocation
+	 * @brief A match waiting for an idle server.
+	 */
+	struct FPendingAllocation
+	{
+		FDustLinkMatchConfig Match;
+		FDustLinkOnAllocationComplete OnComplete;
+		double RequestTime { 0.0 };
+	};
+
+	/**
+	 * @brief Pushes a match to an idle server of its region.
+	 *
+	 * @param Pending The match to place.
+	 * @return `false` if no idle server is available.
+	 */
+	bool TryDispatch(const FPendingAllocation& Pending);
+
+	/**
+	 * @brief Reports a finished allocation and records its outcome.
+	 *
+	 * @param Pending The allocated match.
+	 * @param Allocation The result to report.
+	 */
+	void Finish(const FPendingAllocation& Pending, FDustLinkAllocation& Allocation);
+
+	/** Tuning parameters of the allocator. */
+	FDustLinkAllocatorSettings Settings;
+
+	/** Pools keyed by region. */
+	TMap<FString, TSharedRef<FDustLinkServerPool>> Pools;
+
+	/** Matches waiting for an idle server, oldest first. */
+	TArray<FPendingAllocation> Queue;
+
+	/** Recent successful allocation latencies, in seconds. */
+	TArray<double> Latencies;
+
+	/** Index the next latency is written to once the sample buffer is full. */
+	int32 NextLatencyIndex { 0 };
+
+	/** Number of allocations in flight to a server. */
+	int32 NumInFlight { 0 };
+
+	/** Number of allocations that succeeded. */
+	int32 NumSucceeded { 0 };
+
+	/** Number of allocations that failed. */
+	int32 NumFailed { 0 };
+};
@@ -0,0 +1,125 @@
+// Copyright Dustbyte Software. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HttpRouteHandle.h"
+#include "HttpResultCallback.h"
+#include "DustLinkMatchConfig.h"
+
+class IHttpRouter;
+
+
+/**
+ * Notifies the owner that the fleet agent asked this server to host a match.
+ * @param Config The match to host.
+ */
+DECLARE_DELEGATE_OneParam(FDustLinkOnMatchConfigReceived, const FDustLinkMatchConfig& Config);
+
+/**
+ * Notifies the owner that the fleet agent released this server's match and it should go back to idle.
+ */
+DECLARE_DELEGATE(FDustLinkOnMatchReleased);
+
+/**
+ * @brief Lifecycle of a pooled dedicated server as seen through its control channel.
+ */
+enum class EDustLinkServerState : uint8
+{
+	Idle,
+	Allocating,
+	Allocated,
+	Releasing
+};
+
+/**
+ * @class FDustLinkServerControl
+ * @brief Local control channel of a pooled dedicated server.
+ *
+ * Serves `GET /status`, which the fleet agent polls until the server finished booting, and
+ * `POST /match`, which hands the server a `FDustLinkMatchConfig`. The response to `/match` is held
+ * until the session was created and the match map loaded, and carries the connect info players travel to.
+ * `POST /release` ends the match, its response is held until the session was destroyed and the server
+ * is back on its idle map, so the server never reports `Idle` while it still tears the match down.
+ */
+class DUSTLINK_API FDustLinkServerControl
+{
+public:
+	~FDustLinkServerControl();
+
+	/**
+	 * @brief Starts serving the control routes on the given port.
+	 *
+	 * @param Port The local port to listen on.
+	 * @return Returns `true` if the routes were bound successfully.
+	 */
+	bool Start(const uint32 Port);
+
+	/**
+	 * @brief Stops serving the control routes and fails a pending match request.
+	 */
+	void Stop();
+
+	/**
+	 * @brief Returns `true` while the control channel is listening.
+	 */
+	bool IsRunning() const { return StatusRouteHandle.IsValid(); }
+
+	/**
+	 * @brief Returns the current state of the server.
+	 */
+	EDustLinkServerState GetState() const { return State; }
+
+	/**
+	 * @brief Answers the pending match request once the session was created or failed to be created.
+	 *
+	 * @param bWasSuccessful Whether the session was created.
+	 * @param ConnectInfo The address players travel to.
+	 */
+	void CompleteMatch(const bool bWasSuccessful, const FString& ConnectInfo);
+
+	/**
+	 * @brief Answers the pending release request once the server is ready for the next match.
+	 */
+	void CompleteRelease();
+
+	/**
+	 * @brief Delegate triggered when the fleet agent hands this server a match.
+	 */
+	FDustLinkOnMatchConfigReceived OnMatchConfigReceived;
+
+	/**
+	 * @brief Delegate triggered when the fleet agent releases this server's match.
+	 */
+	FDustLinkOnMatchReleased OnMatchReleased;
+
+private:
+	/**
+	 * @brief Handles a match request.
+	 *
+	 * @param Body The body of the request.
+	 * @param OnComplete Sends the response.
+	 */
+	void HandleMatchRequest(const FString& Body, const FHttpResultCallback& OnComplete);
+
+	/** Router bound to the listening port. */
+	TSharedPtr<IHttpRouter> Router;
+
+	/** Handle of the status route. */
+	FHttpRouteHandle StatusRouteHandle;
+
+	/** Handle of the match route. */
+	FHttpRouteHandle MatchRouteHandle;
+
+	/** Handle of the release route. */
+	FHttpRouteHandle ReleaseRouteHandle;
+
+	/** Sends the response to the match request that is in flight. */
+	FHttpResultCallback PendingMatchResponse;
+
+	/** Sends the response to the release request that is in flight. */
+	FHttpResultCallback PendingReleaseResponse;
+
+	/** Current state of the server. */
+	EDustLinkServerState State { EDustLinkServerState::Idle };
+};
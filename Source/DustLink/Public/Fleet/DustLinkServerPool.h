@@ -0,0 +1,205 @@
+// Copyright Dustbyte Software. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/PlatformProcess.h"
+#include "DustLinkMatchConfig.h"
+
+
+/**
+ * Notifies the caller that a match was placed on a pooled server, or could not be placed.
+ * @param ServerSlot The slot of the server the match was pushed to, used to release it later.
+ * @param ConnectInfo The address players travel to, empty on failure.
+ * @param bWasSuccessful Whether a server created the session of the match.
+ */
+DECLARE_DELEGATE_ThreeParams(FDustLinkOnServerAllocated, const int32 ServerSlot, const FString& ConnectInfo, const bool bWasSuccessful);
+
+/**
+ * @struct FDustLinkServerPoolSettings
+ * @brief Tuning parameters of the local pool of warm dedicated servers.
+ */
+struct DUSTLINK_API FDustLinkServerPoolSettings
+{
+	/** Number of booted, idle servers the pool keeps ready. */
+	int32 WarmServers { 2 };
+
+	/** Maximum number of server processes, warm and allocated, running at once. */
+	int32 MaxServers { 16 };
+
+	/** Game port of the first server slot, every further slot uses the next port. */
+	int32 BaseGamePort { 7777 };
+
+	/** Control port of the first server slot, every further slot uses the next port. */
+	int32 BaseControlPort { 8700 };
+
+	/** Map the servers boot into and idle on. */
+	FString ServerMap;
+
+	/** Region the servers of this pool are hosted in. */
+	FString Region { TEXT("local") };
+
+	/** Additional command line arguments passed to every server. */
+	FString ExtraArgs;
+
+	/** Interval between two readiness probes of a booting server, in seconds. */
+	float ReadyPollInterval { 0.5f };
+
+	/** Time after which a server that did not report ready is killed and replaced, in seconds. */
+	float BootTimeout { 120.f };
+
+	/** Time a server may take to create the session of a pushed match before it is killed and replaced, in seconds. */
+	float AllocateTimeout { 60.f };
+};
+
+/**
+ * @brief Lifecycle of a server process owned by the pool.
+ */
+enum class EDustLinkPooledServerState : uint8
+{
+	Booting,
+	Idle,
+	Allocating,
+	Allocated
+};
+
+/**
+ * @struct FDustLinkPooledServer
+ * @brief A dedicated server process owned by the pool.
+ */
+struct DUSTLINK_API FDustLinkPooledServer
+{
+	/** Handle of the server process. */
+	FProcHandle Process;
+
+	/** Slot of the server, which determines its ports. */
+	int32 Slot { INDEX_NONE };
+
+	/** Port clients connect to. */
+	int32 GamePort { 0 };
+
+	/** Port of the server's control channel. */
+	int32 ControlPort { 0 };
+
+	/** Current state of the server. */
+	EDustLinkPooledServerState State { EDustLinkPooledServerState::Booting };
+
+	/** Time the server entered its current state, in seconds. */
+	double StateTime { 0.0 };
+
+	/** Time of the last readiness probe, in seconds. */
+	double LastProbeTime { 0.0 };
+
+	/** Whether a readiness probe is in flight. */
+	bool bIsProbing { false };
+};
+
+/**
+ * @class FDustLinkServerPool
+ * @brief Keeps a pool of pre-booted `-server -nullrhi` processes idling on localhost.
+ *
+ * Booting servers are probed through their control channel until they report `Idle`. Allocating a
+ * match pushes its `FDustLinkMatchConfig` to an idle server, which creates its session right away, so
+ * the cost of a match start is a single request instead of a full boot. Servers that exited, did not
+ * boot within `BootTimeout` or did not host a pushed match within `AllocateTimeout` are reaped and the
+ * pool boots replacements to keep the configured number of servers warm.
+ */
+class DUSTLINK_API FDustLinkServerPool : public TSharedFromThis<FDustLinkServerPool>
+{
+public:
+	virtual ~FDustLinkServerPool();
+
+	/**
+	 * @brief Starts filling the pool.
+	 *
+	 * @param InSettings The tuning parameters to use.
+	 */
+	void Start(const FDustLinkServerPoolSettings& InSettings);
+
+	/**
+	 * @brief Terminates every server process owned by the pool.
+	 */
+	void Stop();
+
+	/**
+	 * @brief Reaps exited servers, probes booting ones and boots replacements.
+	 *
+	 * @param Now The current time, in seconds.
+	 */
+	void Tick(const double Now);
+
+	/**
+	 * @brief Places a match on an idle server.
+	 *
+	 * @param Config The match to host.
+	 * @param OnComplete Called with the connect info once the server created the session.
+	 * @return `false` if no server is idle, `OnComplete` is not called in that case.
+	 */
+	virtual bool Allocate(const FDustLinkMatchConfig& Config, const FDustLinkOnServerAllocated& OnComplete);
+
+	/**
+	 * @brief Ends the match of an allocated server and returns the server to the pool.
+	 *
+	 * @param ServerSlot The slot reported when the server was allocated.
+	 * @return `false` if no allocated server occupies the slot.
+	 */
+	virtual bool Release(const int32 ServerSlot);
+
+	/**
+	 * @brief Returns the number of servers in the given state.
+	 *
+	 * @param State The state to count.
+	 */
+	int32 GetNumServers(const EDustLinkPooledServerState State) const;
+
+	/**
+	 * @brief Returns the number of server processes owned by the pool.
+	 */
+	int32 GetNumServers() const { return Servers.Num(); }
+
+	/**
+	 * @brief Returns the tuning parameters of the pool.
+	 */
+	const FDustLinkServerPoolSettings& GetSettings() const { return Settings; }
+
+private:
+	/**
+	 * @brief Boots a server process in the lowest free slot.
+	 *
+	 * @param Now The current time, in seconds.
+	 * @return `true` if the process was started.
+	 */
+	bool BootServer(const double Now);
+
+	/**
+	 * @brief Asks a booting server whether it is ready to host a match.
+	 *
+	 * @param Server The server to probe.
+	 * @param Now The current time, in seconds.
+	 */
+	void ProbeServer(FDustLinkPooledServer& Server, const double Now);
+
+	/**
+	 * @brief Returns the server in a slot, or `nullptr` if the slot is free.
+	 *
+	 * @param Slot The slot of the server.
+	 */
+	FDustLinkPooledServer* FindServer(const int32 Slot);
+
+	/**
+	 * @brief Builds the URL of a route on a server's control channel.
+	 *
+	 * @param Server The server to address.
+	 * @param Route The route, e.g. "/status".
+	 */
+	static FString MakeControlUrl(const FDustLinkPooledServer& Server, const TCHAR* Route);
+
+	/** Tuning parameters of the pool. */
+	FDustLinkServerPoolSettings Settings;
+
+	/** Server processes owned by the pool. */
+	TArray<FDustLinkPooledServer> Servers;
+
+	/** Whether the pool boots servers. */
+	bool bIsRunning { false };
+};
@@ -0,0 +1,67 @@
+// Copyright Dustbyte Software. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/StrongObjectPtr.h"
+
+
+/**
+ * @class FDustLinkContentWarmup
+ * @brief Gets the match ready while players wait in the lobby countdown.
+ *
+ * Runs a garbage collection pass while nothing else is happening, preloads the packages of the
+ * match map asynchronously and keeps them resident until the match map loaded, and switches the shader
+ * pipeline cache to fast batching so its precompilation finishes before the match starts.
+ *
+ * The batching switch only speeds up whatever the bundled pipeline cache still has to compile, it does
+ * not select the pipeline states of the match map, so states missing from the cache still hitch there.
+ */
+class DUSTLINK_API FDustLinkContentWarmup : public TSharedFromThis<FDustLinkContentWarmup>
+{
+public:
+	~FDustLinkContentWarmup();
+
+	/**
+	 * @brief Starts warming up for the given map.
+	 *
+	 * @param MapPath The path to the match level, optionally followed by URL options.
+	 */
+	void Begin(const FString& MapPath);
+
+	/**
+	 * @brief Stops warming up and releases the preloaded map, e.g. when the countdown was cancelled.
+	 */
+	void Cancel();
+
+	/**
+	 * @brief Returns `true` once the map packages finished loading.
+	 */
+	bool IsMapLoaded() const { return LoadedMapPackage.IsValid(); }
+
+	/**
+	 * @brief Returns `true` while the map packages are being loaded.
+	 */
+	bool IsLoading() const { return bIsLoading; }
+
+private:
+	/**
+	 * @brief Restores the shader pipeline cache batching mode used outside of warmup.
+	 */
+	void RestoreShaderPipelineCache();
+
+	/** Package name of the map being warmed up. */
+	FString MapPackageName;
+
+	/** Preloaded map package, kept resident until travel. */
+	TStrongObjectPtr<UPackage> LoadedMapPackage;
+
+	/** Identifier of the current warmup, used to ignore load results after cancellation. */
+	uint32 Generation { 0 };
+
+	/** Whether the map packages are being loaded. */
+	bool bIsLoading { false };
+
+	/** Whether the shader pipeline cache was switched to fast batching. */
+	bool bIsShaderCacheBoosted { false };
+};
@@ -0,0 +1,152 @@
+// Copyright Dustbyte Software. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/GameModeBase.h"
+#include "DustLink/Public/Online/DustLinkSubscription.h"
+
+#include "DustLinkLobbyGameMode.generated.h"
+
+class ADustLinkLobbyRoster;
+
+
+/**
+ * @class ADustLinkLobbyGameMode
+ * @brief Game mode of a DustLink lobby.
+ *
+ * Assigns every joining player a roster slot, tracks ready flags and frees slots on logout.
+ * The number of slots follows the `NumPublicConnections` of the current session. Seamless travel
+ * is enabled so the party stays connected when moving between the lobby and matches.
+ *
+ * The match starts on its own: a countdown begins when the lobby is full or a quorum of players is
+ * ready, and when it completes the session is started and everyone travels to the match map.
+ */
+UCLASS()
+class DUSTLINK_API ADustLinkLobbyGameMode : public AGameModeBase
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * @brief Default constructor for the lobby game mode.
+	 *
+	 * Selects the DustLink lobby game state and player controller and enables seamless travel.
+	 */
+	ADustLinkLobbyGameMode();
+
+	/**
+	 * @brief Sets the ready flag of a player.
+	 *
+	 * @param PlayerController The controller of the player.
+	 * @param bIsReady Whether the player is ready for the match to start.
+	 */
+	virtual void SetPlayerReady(const APlayerController* PlayerController, const bool bIsReady);
+
+	virtual void PostLogin(APlayerController* NewPlayer) override;
+	virtual void Logout(AController* Exiting) override;
+	virtual void HandleSeamlessTravelPlayer(AController*& Controller) override;
+
+protected:
+	/**
+	 * @brief Sizes the roster from the current session once play begins.
+	 */
+	virtual void BeginPlay() override;
+
+	/**
+	 * @brief Returns the lobby roster of the current game state.
+	 */
+	ADustLinkLobbyRoster* GetRoster() const;
+
+	/**
+	 * @brief Adds a player to the lobby roster.
+	 *
+	 * @param Controller The controller of the player.
+	 */
+	virtual void AddPlayerToRoster(const AController* Controller);
+
+	/**
+	 * @brief Returns the number of slots of the current session.
+	 *
+	 * Reads `NumPublicConnections` from the session settings, falling back to `DefaultMaxPlayers`.
+	 */
+	int32 GetSessionMaxPlayers() const;
+
+	/**
+	 * @brief Starts or cancels the countdown based on the lobby fill and ready quorum.
+	 */
+	virtual void EvaluateAutoStart();
+
+	/**
+	 * @brief Timer callback that starts the session once the countdown completed.
+	 */
+	virtual void OnCountdownComplete();
+
+	/**
+	 * @brief Callback for handling the completion of starting the session.
+	 *
+	 * Travels to the match map on success, otherwise re-evaluates the countdown.
+	 *
+	 * @param bWasSuccessful Indicates whether the session start was successful.
+	 */
+	void OnStartSession(const bool bWasSuccessful);
+
+	/**
+	 * @brief Travels every player to the match map.
+	 */
+	virtual void TravelToMatch();
+
+	/**
+	 * @brief Path to the match level players travel to once the countdown completes.
+	 *
+	 * Overridden by the `MatchMap` session setting when the host advertised one.
+	 */
+	UPROPERTY(EditDefaultsOnly, Category = "DustLink")
+	FString MatchMapPath { TEXT("/Game/ThirdPerson/Maps/ThirdPerson") };
+
+	/**
+	 * @brief Minimum number of players before a ready quorum can start the countdown.
+	 */
+	UPROPERTY(EditDefaultsOnly, Category = "DustLink", meta = (ClampMin = 1))
+	int32 MinPlayersToStart { 2 };
+
+	/**
+	 * @brief Fraction of players that must be ready to start the countdown.
+	 */
+	UPROPERTY(EditDefaultsOnly, Category = "DustLink", meta = (ClampMin = 0, ClampMax = 1))
+	float ReadyQuorum { 1.f };
+
+	/**
+	 * @brief Countdown length once the ready quorum is reached, in seconds.
+	 */
+	UPROPERTY(EditDefaultsOnly, Category = "DustLink", meta = (ClampMin = 0))
+	float ReadyCountdownDuration { 10.f };
+
+	/**
+	 * @brief Countdown length once every slot is taken, in seconds.
+	 */
+	UPROPERTY(EditDefaultsOnly, Category = "DustLink", meta = (ClampMin = 0))
+	float FullLobbyCountdownDuration { 5.f };
+
+	/**
+	 * @brief Number of slots used when no session is available, e.g. when playing in the editor.
+	 */
+	UPROPERTY(EditDefaultsOnly, Category = "DustLink")
+	int32 DefaultMaxPlayers { 4 };
+
+private:
+	/**
+	 * @brief Handle of the timer that completes the countdown.
+	 */
+	FTimerHandle CountdownTimerHandle;
+
+	/**
+	 * @brief Subscription to the session start result, held while the match is starting.
+	 */
+	FDustLinkSubscription StartSessionSubscription;
+
+	/**
+	 * @brief Flag indicating whether the match start is in progress and the roster no longer affects it.
+	 */
+	bool bIsStartingMatch { false };
+};
@@ -0,0 +1,121 @@
+// Copyright Dustbyte Software. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/GameStateBase.h"
+
+#include "DustLinkLobbyGameState.generated.h"
+
+class ADustLinkLobbyRoster;
+
+
+/**
+ * Notifies subscribers that the lobby countdown started or was cancelled, on the server and on every client.
+ * @param bIsCountingDown Whether a countdown is running.
+ */
+DECLARE_MULTICAST_DELEGATE_OneParam(FDustLinkOnLobbyCountdownChanged, const bool bIsCountingDown);
+
+/**
+ * @class ADustLinkLobbyGameState
+ * @brief Game state of a DustLink lobby.
+ *
+ * Owns the replicated lobby roster and the match start countdown. The roster lives in its own dormant
+ * actor so that the game state keeps replicating the server time, which the countdown is synced to,
+ * while the roster only replicates when it changes.
+ *
+ * While the countdown runs, every machine warms up for the match map read from the session settings,
+ * through its DustLink subsystem so the preloaded content survives travel.
+ */
+UCLASS()
+class DUSTLINK_API ADustLinkLobbyGameState : public AGameStateBase
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * @brief Marks the player idle and spawns the lobby roster on the server.
+	 */
+	virtual void PostInitializeComponents() override;
+
+	/**
+	 * @brief Sets the match map travelled to after the countdown, on the server.
+	 *
+	 * Clients prefer the `MatchMap` session setting and fall back to this replicated value.
+	 *
+	 * @param InMatchMapPath The path to the match level.
+	 */
+	void SetMatchMapPath(const FString& InMatchMapPath);
+
+	/**
+	 * @brief Returns the match map travelled to after the countdown.
+	 */
+	FString GetMatchMapPath() const;
+
+	/**
+	 * @brief Returns the lobby roster, `nullptr` on clients until it has replicated.
+	 */
+	UFUNCTION(BlueprintPure)
+	ADustLinkLobbyRoster* GetRoster() const { return Roster; }
+
+	/**
+	 * @brief Starts or cancels the lobby countdown on the server.
+	 *
+	 * @param Duration The countdown length in seconds, or a negative value to cancel it.
+	 */
+	void SetCountdown(const float Duration);
+
+	/**
+	 * @brief Returns `true` while the lobby countdown is running.
+	 */
+	UFUNCTION(BlueprintPure)
+	bool IsCountingDown() const { return CountdownEndTime >= 0.f; }
+
+	/**
+	 * @brief Returns the seconds left until the match starts, synced to server time.
+	 *
+	 * @return The remaining seconds, or a negative value if no countdown is running.
+	 */
+	UFUNCTION(BlueprintPure)
+	float GetCountdownRemaining() const;
+
+	/**
+	 * @brief Delegate triggered when the lobby countdown started or was cancelled.
+	 */
+	FDustLinkOnLobbyCountdownChanged OnCountdownChanged;
+
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+protected:
+	/**
+	 * @brief Called on clients when the countdown end time was replicated.
+	 */
+	UFUNCTION()
+	void OnRep_CountdownEndTime();
+
+	/**
+	 * @brief Starts warming up for the match when the countdown starts and stops when it is cancelled.
+	 *
+	 * @param bIsCountingDown Whether a countdown is running.
+	 */
+	void UpdateContentWarmup(const bool bIsCountingDown);
+
+private:
+	/**
+	 * @brief Replicated roster of the players in the lobby.
+	 */
+	UPROPERTY(Replicated)
+	TObjectPtr<ADustLinkLobbyRoster> Roster { nullptr };
+
+	/**
+	 * @brief Server world time at which the countdown ends, negative if no countdown is running.
+	 */
+	UPROPERTY(ReplicatedUsing = OnRep_CountdownEndTime)
+	float CountdownEndTime { -1.f };
+
+	/**
+	 * @brief Match map set by the server, used when the session settings carry none.
+	 */
+	UPROPERTY(Replicated)
+	FString MatchMapPath { TEXT("") };
+};
@@ -0,0 +1,30 @@
+// Copyright Dustbyte Software. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/PlayerController.h"
+
+#include "DustLinkLobbyPlayerController.generated.h"
+
+
+/**
+ * @class ADustLinkLobbyPlayerController
+ * @brief Player controller used in DustLink lobbies.
+ *
+ * Forwards the local player's lobby actions, such as toggling the ready flag, to the server.
+ */
+UCLASS()
+class DUSTLINK_API ADustLinkLobbyPlayerController : public APlayerController
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * @brief Asks the server to set the ready flag of this player.
+	 *
+	 * @param bIsReady Whether the player is ready for the match to start.
+	 */
+	UFUNCTION(BlueprintCallable, Server, Reliable)
+	void ServerSetReady(const bool bIsReady);
+};
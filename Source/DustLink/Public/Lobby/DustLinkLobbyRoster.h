@@ -0,0 +1,200 @@
+// Copyright Dustbyte Software. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Info.h"
+#include "Net/Serialization/FastArraySerializer.h"
+
+#include "DustLinkLobbyRoster.generated.h"
+
+class ADustLinkLobbyRoster;
+class APlayerState;
+
+
+/**
+ * Notifies subscribers that the lobby roster changed, on the server and on every client.
+ */
+DECLARE_MULTICAST_DELEGATE(FDustLinkOnLobbyRosterChanged);
+
+
+/**
+ * @struct FDustLinkLobbyPlayer
+ * @brief A single roster entry describing a player in the lobby.
+ *
+ * Entries are replicated individually through fast array serialization, so changing one
+ * player's ready flag only sends that entry.
+ */
+USTRUCT(BlueprintType)
+struct DUSTLINK_API FDustLinkLobbyPlayer : public FFastArraySerializerItem
+{
+	GENERATED_BODY()
+
+	/** Player state of the player, carrying the player's name and unique ID. */
+	UPROPERTY(BlueprintReadOnly)
+	TObjectPtr<APlayerState> PlayerState { nullptr };
+
+	/** Slot the player occupies in the lobby, from 0 to the number of public connections. */
+	UPROPERTY(BlueprintReadOnly)
+	int32 SlotIndex { INDEX_NONE };
+
+	/** Whether the player is ready for the match to start. */
+	UPROPERTY(BlueprintReadOnly)
+	bool bIsReady { false };
+
+	/**
+	 * @brief Called on clients after the entry was added by replication.
+	 */
+	void PostReplicatedAdd(const struct FDustLinkLobbyRosterArray& InArraySerializer);
+
+	/**
+	 * @brief Called on clients after the entry was changed by replication.
+	 */
+	void PostReplicatedChange(const struct FDustLinkLobbyRosterArray& InArraySerializer);
+
+	/**
+	 * @brief Called on clients before the entry is removed by replication.
+	 */
+	void PreReplicatedRemove(const struct FDustLinkLobbyRosterArray& InArraySerializer);
+};
+
+/**
+ * @struct FDustLinkLobbyRosterArray
+ * @brief Fast array of lobby roster entries, replicated as deltas.
+ */
+USTRUCT()
+struct DUSTLINK_API FDustLinkLobbyRosterArray : public FFastArraySerializer
+{
+	GENERATED_BODY()
+
+	/** Roster entries, in join order. */
+	UPROPERTY()
+	TArray<FDustLinkLobbyPlayer> Players;
+
+	/** Actor owning the array, notified about replicated changes. */
+	UPROPERTY(NotReplicated)
+	TObjectPtr<ADustLinkLobbyRoster> Owner { nullptr };
+
+	/**
+	 * @brief Serializes the array as deltas against the state last acknowledged by each connection.
+	 */
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParams)
+	{
+		return FFastArraySerializer::FastArrayDeltaSerialize<FDustLinkLobbyPlayer, FDustLinkLobbyRosterArray>(Players, DeltaParams, *this);
+	}
+};
+
+template <>
+struct TStructOpsTypeTraits<FDustLinkLobbyRosterArray> : TStructOpsTypeTraitsBase2<FDustLinkLobbyRosterArray>
+{
+	enum
+	{
+		WithNetDeltaSerializer = true,
+	};
+};
+
+
+/**
+ * @class ADustLinkLobbyRoster
+ * @brief Replicated roster of the players in a DustLink lobby.
+ *
+ * The roster is dormant and only woken up for a single replication pass when it changes, so the
+ * server spends no time considering it for replication while the lobby is idle. Together with delta
+ * replication of individual entries this keeps lobby bandwidth and server CPU flat as lobbies grow.
+ * All mutators are server-only.
+ */
+UCLASS()
+class DUSTLINK_API ADustLinkLobbyRoster : public AInfo
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * @brief Default constructor for the lobby roster.
+	 *
+	 * Enables replication to every connection and makes the actor dormant until its first change.
+	 */
+	ADustLinkLobbyRoster();
+
+	/**
+	 * @brief Adds a player to the lowest free slot.
+	 *
+	 * @param PlayerState The player state of the joining player.
+	 * @return The assigned slot, or `INDEX_NONE` if every slot is taken.
+	 */
+	int32 AddPlayer(APlayerState* PlayerState);
+
+	/**
+	 * @brief Removes a player from the roster, freeing the player's slot.
+	 *
+	 * @param PlayerState The player state of the leaving player.
+	 */
+	void RemovePlayer(const APlayerState* PlayerState);
+
+	/**
+	 * @brief Sets the ready flag of a player.
+	 *
+	 * @param PlayerState The player state of the player.
+	 * @param bIsReady Whether the player is ready.
+	 */
+	void SetPlayerReady(const APlayerState* PlayerState, const bool bIsReady);
+
+	/**
+	 * @brief Sets the number of slots in the lobby.
+	 *
+	 * @param InMaxPlayers The number of slots.
+	 */
+	void SetMaxPlayers(const int32 InMaxPlayers);
+
+	/**
+	 * @brief Returns the roster entries, in join order.
+	 */
+	const TArray<FDustLinkLobbyPlayer>& GetPlayers() const { return Roster.Players; }
+
+	/**
+	 * @brief Returns the roster entry of a player, or `nullptr` if the player is not in the lobby.
+	 */
+	const FDustLinkLobbyPlayer* FindPlayer(const APlayerState* PlayerState) const;
+
+	/**
+	 * @brief Returns the number of slots in the lobby.
+	 */
+	int32 GetMaxPlayers() const { return MaxPlayers; }
+
+	/**
+	 * @brief Returns the number of players that are ready.
+	 */
+	int32 GetNumReadyPlayers() const;
+
+	/**
+	 * @brief Notifies the roster about a change, waking it up for replication on the server.
+	 */
+	void NotifyRosterChanged();
+
+	/**
+	 * @brief Delegate triggered when the roster changed, on the server and on every client.
+	 */
+	FDustLinkOnLobbyRosterChanged OnRosterChanged;
+
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+protected:
+	/**
+	 * @brief Called on clients when the number of slots was replicated.
+	 */
+	UFUNCTION()
+	void OnRep_MaxPlayers();
+
+private:
+	/**
+	 * @brief Replicated roster entries.
+	 */
+	UPROPERTY(Replicated)
+	FDustLinkLobbyRosterArray Roster;
+
+	/**
+	 * @brief Number of slots in the lobby.
+	 */
+	UPROPERTY(ReplicatedUsing = OnRep_MaxPlayers)
+	int32 MaxPlayers { 0 };
+};
@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "Blueprint/UserWidget.h"
 #include "Interfaces/OnlineSessionInterface.h"
+#include "DustLink/Public/Online/DustLinkSubscription.h"
 
 #include "DustLinkMenu.generated.h"
 
@@ -27,10 +28,10 @@ public:
 	/**
 	 * @brief Sets up the menu and its components.
 	 *
-	 * This function initializes the menu widget, binds necessary events, and prepares it for display.
+	 * This function shows the menu widget, lets its callbacks react to session events, and prepares it for input.
 	 * It also configures the default session settings, such as the number of public connections,
 	 * the type of match, and the path to the lobby level. This method should be called before adding
-	 * the widget to the viewport.
+	 * the widget to the viewport. Prefer `UDustLinkMenuManager::OpenMenu`, which loads and pools the widget.
 	 *
 	 * @param NumberOfPublicConnections The default number of player slots available in the session (default is 4).
 	 * @param TypeOfMatch A string identifier for the session type (e.g., "Deathmatch", "Coop"). Default is "Error404".
@@ -47,6 +48,40 @@ public:
 	 */
 	UFUNCTION(BlueprintCallable)
 	void MenuTearDown();
+
+	/**
+	 * @brief Joins a private lobby by its short join code.
+	 *
+	 * The code is resolved straight to connect info through the DustLink subsystem's listing provider,
+	 * so no session search is performed. Intended to be bound to a join code text box.
+	 *
+	 * @param JoinCode The code shared by the host.
+	 */
+	UFUNCTION(BlueprintCallable)
+	void JoinByCode(const FString& JoinCode);
+
+	/**
+	 * @brief Connects directly to a host address entered by the player.
+	 *
+	 * The address is resolved through the DustLink subsystem without performing a session search.
+	 * Intended to be bound to a direct connect text box.
+	 *
+	 * @param Address A host name or IP address, optionally followed by ":<Port>".
+	 */
+	UFUNCTION(BlueprintCallable)
+	void ConnectToAddress(const FString& Address);
+
+	/**
+	 * @brief Replaces the travel the menu starts after hosting, joining or leaving, e.g. so a soak run stays in its map.
+	 *
+	 * @param InTravelOverride Receives the URL instead of the menu travelling, an empty function restores travel.
+	 */
+	void SetTravelOverride(TFunction<void(const FString& URL)>&& InTravelOverride) { TravelOverride = MoveTemp(InTravelOverride); }
+
+	/**
+	 * @brief Returns `true` between `MenuSetup` and `MenuTearDown`, while the menu reacts to session events.
+	 */
+	bool IsOpen() const { return bIsOpen; }
 	
 protected:
 
@@ -61,6 +96,11 @@ protected:
 	 */
 	virtual bool Initialize() override;
 
+	/**
+	 * @brief Subscribes the menu callbacks to the DustLink subsystem's delegates, once for the lifetime of the widget.
+	 */
+	void BindSubsystem();
+
 	/**
 	 * @brief Called when the widget is about to be destroyed.
 	 *
@@ -78,7 +118,6 @@ protected:
 	 *
 	 * @param bWasSuccessful Indicates whether the session creation was successful.
 	 */
-	UFUNCTION()
 	void OnCreateSession(const bool bWasSuccessful);
 
 	/**
@@ -89,7 +128,6 @@ protected:
 	 *
 	 * @param bWasSuccessful Indicates whether the session destruction was successful.
 	 */
-	UFUNCTION()
 	void OnDestroySession(const bool bWasSuccessful);
 
 	/**
@@ -100,7 +138,6 @@ protected:
 	 *
 	 * @param bWasSuccessful Indicates whether the session start was successful.
 	 */
-	UFUNCTION()
 	void OnStartSession(const bool bWasSuccessful);
 
 	/**
@@ -123,6 +160,34 @@ protected:
 	 * @param Result The result of the join operation, represented as `EOnJoinSessionCompleteResult::Type`.
 	 */
 	void OnJoinSession(const EOnJoinSessionCompleteResult::Type Result);
+
+	/**
+	 * @brief Callback for handling the completion of resolving a join code or a direct address.
+	 *
+	 * This method is triggered after connect info was resolved. On success it travels straight
+	 * to the provided address, otherwise it re-enables the join button.
+	 *
+	 * @param ConnectInfo The address of the session, empty if it could not be resolved.
+	 * @param bWasSuccessful Indicates whether the connect info was resolved.
+	 */
+	void OnConnectInfoResolved(const FString& ConnectInfo, const bool bWasSuccessful);
+
+	/**
+	 * @brief Callback for when a map is about to be loaded.
+	 *
+	 * Tears the menu down so it is released by the purge of the map load instead of surviving into the match.
+	 *
+	 * @param MapName The name of the map being loaded.
+	 */
+	void OnPreTravel(const FString& MapName);
+
+	/**
+	 * @brief Travels to a URL as listen server or as client, unless travel is overridden.
+	 *
+	 * @param URL The map or address to travel to.
+	 * @param bIsServerTravel Whether the world travels with its clients rather than the local player alone.
+	 */
+	void Travel(const FString& URL, const bool bIsServerTravel);
 	
 private:
 
@@ -186,6 +251,21 @@ private:
 	 */
 	UPROPERTY()
 	class UDustLinkSubsystem* DustLinkSubsystem;
+
+	/**
+	 * @brief Subscriptions of the menu callbacks to the DustLink subsystem's delegates, released with the widget.
+	 */
+	TArray<FDustLinkSubscription> SubsystemSubscriptions;
+
+	/**
+	 * @brief Whether the menu is set up, the callbacks ignore session events while it is closed.
+	 */
+	bool bIsOpen { false };
+
+	/**
+	 * @brief Replacement of the menu's travel, travel is not overridden if empty.
+	 */
+	TFunction<void(const FString& URL)> TravelOverride;
 	
 	/**
 	 * @brief Callback function for the Host button.
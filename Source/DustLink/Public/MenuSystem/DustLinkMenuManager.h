@@ -0,0 +1,129 @@
+// Copyright Dustbyte Software. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+
+#include "DustLinkMenuManager.generated.h"
+
+class UDustLinkMenu;
+struct FStreamableHandle;
+
+
+/**
+ * @class UDustLinkMenuManager
+ * @brief Loads, pools and opens the DustLink menu widget.
+ *
+ * The menu widget class is a soft reference that is loaded asynchronously when the game instance
+ * starts, so opening the menu never hitches on a synchronous load. A single menu instance is kept
+ * and reused every time the menu is opened in the same map; it is released right before travel so
+ * the map load frees it. The class is configurable in `DefaultGame.ini`:
+ *
+ * `[/Script/DustLink.DustLinkMenuManager]`
+ * `MenuClass=/Game/UI/WBP_MyMenu.WBP_MyMenu_C`
+ */
+UCLASS(Config = Game)
+class DUSTLINK_API UDustLinkMenuManager : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UDustLinkMenuManager();
+
+	/**
+	 * @brief Starts loading the menu widget class on clients.
+	 *
+	 * @param Collection The subsystem collection the subsystem is initialized in.
+	 */
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	/**
+	 * @brief Cancels the pending load and releases the pooled menu.
+	 */
+	virtual void Deinitialize() override;
+
+	/**
+	 * @brief Opens the menu, reusing the pooled instance when there is one.
+	 *
+	 * If the menu class is still loading, the menu opens as soon as the load completes.
+	 *
+	 * @param NumberOfPublicConnections The default number of player slots available in the session.
+	 * @param TypeOfMatch A string identifier for the session type.
+	 * @param LobbyPath The path to the lobby level where players gather before starting the session.
+	 */
+	UFUNCTION(BlueprintCallable)
+	void OpenMenu(const int32 NumberOfPublicConnections = 4, FString TypeOfMatch = FString("Error404"), FString LobbyPath = FString("/Game/ThirdPerson/Maps/Lobby"));
+
+	/**
+	 * @brief Hides the menu while keeping its instance pooled for the next `OpenMenu`.
+	 */
+	UFUNCTION(BlueprintCallable)
+	void CloseMenu();
+
+	/**
+	 * @brief Returns `true` once the menu widget class is loaded.
+	 */
+	UFUNCTION(BlueprintPure)
+	bool IsMenuClassLoaded() const { return MenuClass.Get() != nullptr; }
+
+	/**
+	 * @brief Returns the menu widget class, or `nullptr` while it is loading.
+	 */
+	UClass* GetMenuClass() const { return MenuClass.Get(); }
+
+protected:
+	/**
+	 * @brief Callback for when the menu widget class finished loading.
+	 */
+	void OnMenuClassLoaded();
+
+	/**
+	 * @brief Callback for when a map is about to be loaded, releases the pooled menu.
+	 *
+	 * @param MapName The name of the map being loaded.
+	 */
+	void OnPreTravel(const FString& MapName);
+
+	/**
+	 * @brief Returns the pooled menu, creating it on first use.
+	 *
+	 * @return The menu instance, or `nullptr` if the class is not loaded.
+	 */
+	UDustLinkMenu* GetOrCreateMenu();
+
+private:
+	/**
+	 * @brief Widget class of the menu, loaded asynchronously at startup.
+	 */
+	UPROPERTY(Config)
+	TSoftClassPtr<UDustLinkMenu> MenuClass;
+
+	/**
+	 * @brief Menu instance reused by every `OpenMenu` call in the current map.
+	 */
+	UPROPERTY()
+	TObjectPtr<UDustLinkMenu> PooledMenu;
+
+	/**
+	 * @brief Handle of the in-flight or completed load of the menu class.
+	 */
+	TSharedPtr<FStreamableHandle> MenuClassHandle;
+
+	/**
+	 * @brief Handle of the pre-travel binding on the DustLink subsystem.
+	 */
+	FDelegateHandle PreTravelHandle;
+
+	/**
+	 * @brief Whether `OpenMenu` was called before the menu class finished loading.
+	 */
+	bool bIsOpenPending { false };
+
+	/**
+	 * @brief Arguments of the pending `OpenMenu` call.
+	 */
+	int32 PendingNumPublicConnections { 4 };
+	FString PendingMatchType { TEXT("") };
+	FString PendingLobbyPath { TEXT("") };
+};
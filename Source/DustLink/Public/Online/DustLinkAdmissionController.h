@@ -0,0 +1,76 @@
+// Copyright Dustbyte Software. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+
+/**
+ * @struct FDustLinkAdmissionSettings
+ * @brief Tuning parameters for closing a struggling host to new players.
+ */
+struct DUSTLINK_API FDustLinkAdmissionSettings
+{
+	/** Fraction of the tick budget above which the host stops admitting players. */
+	float CloseThreshold { 1.f };
+
+	/** Fraction of the tick budget below which a closed host admits players again. */
+	float ReopenThreshold { 0.8f };
+
+	/** Shortest time a host stays closed, so it does not flap around the threshold, in seconds. */
+	float MinClosedTime { 10.f };
+};
+
+/**
+ * @class FDustLinkAdmissionController
+ * @brief Decides whether a host accepts new players based on its smoothed tick time.
+ *
+ * A host that exceeds its tick budget is closed: it stops advertising its session and rejects new
+ * connections even though it has free slots. It reopens once the tick time dropped well below the
+ * budget and it stayed closed for a minimum time, so a join storm cannot push it back over right away.
+ */
+class DUSTLINK_API FDustLinkAdmissionController
+{
+public:
+	/**
+	 * @brief Constructs the controller with the given tuning parameters.
+	 *
+	 * @param InSettings The tuning parameters to use.
+	 */
+	explicit FDustLinkAdmissionController(const FDustLinkAdmissionSettings& InSettings = FDustLinkAdmissionSettings());
+
+	/**
+	 * @brief Reopens the host and forgets when it was closed.
+	 */
+	void Reset();
+
+	/**
+	 * @brief Re-evaluates the admission state from the latest tick time.
+	 *
+	 * @param TickTimeMs The smoothed game thread work per frame, in milliseconds.
+	 * @param TickBudgetMs The work per frame the host can afford, in milliseconds.
+	 * @param Now The current time, in seconds.
+	 * @return `true` if the host was opened or closed by this update.
+	 */
+	bool Update(const float TickTimeMs, const float TickBudgetMs, const double Now);
+
+	/**
+	 * @brief Returns `true` while the host accepts new players.
+	 */
+	bool IsAdmitting() const { return bIsAdmitting; }
+
+	/**
+	 * @brief Returns the tuning parameters of the controller.
+	 */
+	const FDustLinkAdmissionSettings& GetSettings() const { return Settings; }
+
+private:
+	/** Tuning parameters of the controller. */
+	FDustLinkAdmissionSettings Settings;
+
+	/** Whether the host accepts new players. */
+	bool bIsAdmitting { true };
+
+	/** Time the host was last closed, in seconds. */
+	double ClosedTime { 0.0 };
+};
@@ -0,0 +1,229 @@
+// Copyright Dustbyte Software. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AnalyticsEventAttribute.h"
+#include "Async/Future.h"
+#include "Interfaces/IAnalyticsProvider.h"
+
+class FJsonObject;
+
+
+/**
+ * @brief Stages of the funnel from opening the menu to arriving in a match.
+ */
+enum class EDustLinkFunnelEvent : uint8
+{
+	MenuOpened,
+	SearchStarted,
+	SearchCompleted,
+	JoinAttempted,
+	JoinCompleted,
+	TravelStarted,
+	Arrived,
+	Num
+};
+
+/**
+ * @struct FDustLinkAnalyticsSettings
+ * @brief Tuning parameters of the funnel event export.
+ */
+struct DUSTLINK_API FDustLinkAnalyticsSettings
+{
+	/** Interval between two exports of the buffered events to the provider, in seconds. */
+	float FlushInterval { 60.f };
+
+	/** Size of the raw event block that is compressed on the thread pool once full, in bytes. */
+	int32 BlockSize { 16 * 1024 };
+};
+
+/**
+ * @class FDustLinkAnalytics
+ * @brief Buffers session funnel events in compressed memory blocks and exports them in batches.
+ *
+ * Recording an event appends a fixed-size binary record to a preallocated block, so the game thread
+ * neither formats strings nor allocates. Full blocks are compressed in memory on the thread pool. On
+ * `Flush`, called on a timer and at shutdown, all buffered events are decoded and handed to the
+ * `IAnalyticsProvider` as `DustLink.Funnel.<Stage>` events. Every event carries the funnel attempt it
+ * belongs to, which starts when the menu opens, so conversion and latency can be measured per stage.
+ */
+class DUSTLINK_API FDustLinkAnalytics
+{
+public:
+	/**
+	 * @brief Constructs the exporter for the given provider.
+	 *
+	 * @param InProvider The provider events are exported to.
+	 * @param InSettings The tuning parameters to use.
+	 */
+	explicit FDustLinkAnalytics(const TSharedRef<IAnalyticsProvider>& InProvider, const FDustLinkAnalyticsSettings& InSettings = FDustLinkAnalyticsSettings());
+
+	/**
+	 * @brief Buffers one funnel event.
+	 *
+	 * @param Event The funnel stage that was reached.
+	 * @param bWasSuccessful Whether the stage succeeded, meaningful for completions.
+	 * @param Value A stage specific count, e.g. the number of candidates a search returned.
+	 * @param LatencyMs Time the stage took, in milliseconds, negative if not applicable.
+	 */
+	void RecordEvent(const EDustLinkFunnelEvent Event, const bool bWasSuccessful = true, const int32 Value = 0, const double LatencyMs = -1.0);
+
+	/**
+	 * @brief Exports all buffered events to the provider and asks it to flush.
+	 */
+	void Flush();
+
+	/**
+	 * @brief Returns the settings of the exporter.
+	 */
+	const FDustLinkAnalyticsSettings& GetSettings() const { return Settings; }
+
+	/**
+	 * @brief Returns the number of events waiting to be exported.
+	 */
+	int32 GetNumBufferedEvents() const { return NumBufferedEvents; }
+
+	/**
+	 * @brief Returns the name of a funnel stage, as used in event names.
+	 */
+	static const TCHAR* GetEventName(const EDustLinkFunnelEvent Event);
+
+private:
+	/**
+	 * @struct FRecord
+	 * @brief Binary layout of one buffered event.
+	 */
+	struct FRecord
+	{
+		float Time;
+		uint32 AttemptId;
+		int32 Value;
+		float LatencyMs;
+		uint8 Event;
+		uint8 bWasSuccessful;
+	};
+
+	/**
+	 * @struct FCompressedBlock
+	 * @brief A full block of records, compressed in memory.
+	 */
+	struct FCompressedBlock
+	{
+		TArray<uint8> Data;
+		int32 UncompressedSize { 0 };
+		bool bIsCompressed { true };
+	};
+
+	/**
+	 * @brief Hands the current block to the thread pool for compression and starts a new one.
+	 */
+	void CompressBlock();
+
+	/**
+	 * @brief Compresses a block of records, falling back to the raw records if they do not compress.
+	 *
+	 * @param Block The raw records.
+	 */
+	static FCompressedBlock CompressRecords(const TArray<uint8>& Block);
+
+	/**
+	 * @brief Hands the records of a raw block to the provider.
+	 *
+	 * @param Block The raw records.
+	 * @param Size The number of bytes of `Block` holding records.
+	 */
+	void ExportBlock(const uint8* Block, const int32 Size) const;
+
+	/** Provider events are exported to. */
+	TSharedRef<IAnalyticsProvider> Provider;
+
+	/** Tuning parameters of the exporter. */
+	FDustLinkAnalyticsSettings Settings;
+
+	/** Records that were not compressed yet. */
+	TArray<uint8> CurrentBlock;
+
+	/** Full blocks waiting to be exported, in recording order, possibly still being compressed. */
+	TArray<TFuture<FCompressedBlock>> CompressedBlocks;
+
+	/** Time the exporter was created, event times are relative to it. */
+	double StartTime { 0.0 };
+
+	/** Funnel attempt the next events belong to. */
+	uint32 AttemptId { 0 };
+
+	/** Number of events waiting to be exported. */
+	int32 NumBufferedEvents { 0 };
+};
+
+/**
+ * @class FDustLinkFileAnalyticsProvider
+ * @brief Analytics provider that appends events as JSON lines to a local file.
+ *
+ * Meant for development and playtests without an analytics backend. Events are kept in memory and
+ * appended to `Saved/DustLink/Analytics/<SessionId>.jsonl` when flushed. Unless set, the session
+ * identifier is the start time to the millisecond followed by a GUID, so concurrent processes never
+ * share a file.
+ */
+class DUSTLINK_API FDustLinkFileAnalyticsProvider : public IAnalyticsProvider
+{
+public:
+	/**
+	 * @brief Constructs the provider writing to the given directory.
+	 *
+	 * @param InDirectory Directory event files are written to, the default location if empty.
+	 */
+	explicit FDustLinkFileAnalyticsProvider(const FString& InDirectory = FString());
+
+	virtual ~FDustLinkFileAnalyticsProvider() override;
+
+	virtual bool StartSession(const TArray<FAnalyticsEventAttribute>& Attributes) override;
+	virtual void EndSession() override;
+	virtual void FlushEvents() override;
+
+	virtual void SetUserID(const FString& InUserID) override { UserId = InUserID; }
+	virtual FString GetUserID() const override { return UserId; }
+
+	virtual FString GetSessionID() const override { return SessionId; }
+	virtual bool SetSessionID(const FString& InSessionID) override;
+
+	virtual void RecordEvent(const FString& EventName, const TArray<FAnalyticsEventAttribute>& Attributes) override;
+
+	virtual void SetDefaultEventAttributes(TArray<FAnalyticsEventAttribute>&& Attributes) override { DefaultAttributes = MoveTemp(Attributes); }
+	virtual TArray<FAnalyticsEventAttribute> GetDefaultEventAttributesSafe() const override { return DefaultAttributes; }
+	virtual int32 GetDefaultEventAttributeCount() const override { return DefaultAttributes.Num(); }
+	virtual FAnalyticsEventAttribute GetDefaultEventAttribute(int AttributeIndex) const override { return DefaultAttributes[AttributeIndex]; }
+
+	/**
+	 * @brief Returns the file events of the current session are written to.
+	 */
+	FString GetFilePath() const;
+
+private:
+	/**
+	 * @brief Adds attributes as fields of an event object, JSON fragments as their parsed value.
+	 *
+	 * @param Object The event object to add the fields to.
+	 * @param Attributes The attributes to add.
+	 */
+	static void SetAttributes(FJsonObject& Object, const TArray<FAnalyticsEventAttribute>& Attributes);
+
+	/** Directory event files are written to. */
+	FString Directory;
+
+	/** Identifier of the current session, also the name of its file. */
+	FString SessionId;
+
+	/** Identifier of the user events are recorded for. */
+	FString UserId;
+
+	/** Attributes added to every event. */
+	TArray<FAnalyticsEventAttribute> DefaultAttributes;
+
+	/** Encoded events that were not written yet. */
+	FString PendingLines;
+
+	/** Whether a session was started and not yet ended. */
+	bool bSessionInProgress { false };
+};
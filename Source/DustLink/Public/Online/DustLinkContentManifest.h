@@ -0,0 +1,82 @@
+// Copyright Dustbyte Software. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OnlineSessionSettings.h"
+
+
+/**
+ * @struct FDustLinkContentManifest
+ * @brief Compact description of the content a client needs to play in a session.
+ *
+ * Hosts advertise the manifest in the `ContentManifest` session setting. Clients drop sessions whose
+ * manifest they cannot satisfy from search results and request missing chunks before travelling, so
+ * joins neither fail on missing content nor stream it in after arrival.
+ */
+struct DUSTLINK_API FDustLinkContentManifest
+{
+	/** Package path of the map played in the session, empty if unknown. */
+	FString MapPath;
+
+	/** Content chunks the map is cooked into, without the always-installed base chunk. */
+	TArray<int32> ChunkIds;
+
+	/** Versions of the enabled project plugins that carry content, keyed by plugin name. */
+	TMap<FString, FString> PluginVersions;
+
+	/**
+	 * @brief Builds the manifest of the local installation for a map.
+	 *
+	 * @param InMapPath The package path of the map, may be empty.
+	 * @return The manifest describing the map's chunks and the local content plugins.
+	 */
+	static FDustLinkContentManifest Build(const FString& InMapPath);
+
+	/**
+	 * @brief Reads the manifest advertised in session settings.
+	 *
+	 * @param SessionSettings The settings of the session.
+	 * @param OutManifest The parsed manifest.
+	 * @return `true` if the session advertises a manifest.
+	 */
+	static bool FromSessionSettings(const FOnlineSessionSettings& SessionSettings, FDustLinkContentManifest& OutManifest);
+
+	/**
+	 * @brief Writes the manifest into session settings.
+	 *
+	 * @param SessionSettings The settings to advertise the manifest in.
+	 */
+	void ToSessionSettings(FOnlineSessionSettings& SessionSettings) const;
+
+	/**
+	 * @brief Encodes the manifest as `<Map>|<Chunk>,<Chunk>|<Plugin>=<Version>,<Plugin>=<Version>`.
+	 */
+	FString ToString() const;
+
+	/**
+	 * @brief Decodes a manifest produced by `ToString`.
+	 *
+	 * @param Encoded The encoded manifest.
+	 * @param OutManifest The decoded manifest.
+	 * @return `true` if the string is a well-formed manifest.
+	 */
+	static bool FromString(const FString& Encoded, FDustLinkContentManifest& OutManifest);
+
+	/**
+	 * @brief Checks whether the local installation can satisfy the manifest.
+	 *
+	 * Chunks that are known but not yet installed count as satisfiable, since they can be requested before travel.
+	 *
+	 * @param OutReason Describes the first unsatisfied requirement.
+	 * @return `true` if every plugin version matches and every chunk and the map are installed or installable.
+	 */
+	bool IsSatisfiedLocally(FString& OutReason) const;
+
+	/**
+	 * @brief Asks the platform chunk installer to fetch every chunk of the manifest that is not installed yet.
+	 *
+	 * @return The number of chunks that were requested.
+	 */
+	int32 RequestContent() const;
+};
@@ -0,0 +1,139 @@
+// Copyright Dustbyte Software. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "DustLinkPresenceProvider.h"
+
+
+/**
+ * Notifies the caller about the sessions of all joinable friends.
+ * @param SessionResults The sessions hosted or joined by friends.
+ * @param bWasSuccessful Indicates whether the friends list could be read.
+ */
+DECLARE_DELEGATE_TwoParams(FDustLinkOnFriendSessionsFound, const TArray<FOnlineSessionSearchResult>& SessionResults, const bool bWasSuccessful);
+
+
+/**
+ * @class FDustLinkFriendSessionFinder
+ * @brief Discovers the sessions of friends without a global session search.
+ *
+ * Friends are filtered by presence first, so only friends in a joinable session are queried.
+ * Their sessions are then queried directly in parallel with bounded concurrency, and each answer
+ * is cached for a short time so reopening the friends tab does not query the backend again.
+ */
+class DUSTLINK_API FDustLinkFriendSessionFinder : public TSharedFromThis<FDustLinkFriendSessionFinder>
+{
+public:
+	/**
+	 * @brief Replaces the source of friends and their sessions, dropping all cached answers.
+	 *
+	 * @param InProvider The provider to query.
+	 */
+	void SetProvider(const TSharedPtr<IDustLinkPresenceProvider>& InProvider);
+
+	/**
+	 * @brief Returns `true` if a provider has been set.
+	 */
+	bool HasProvider() const { return Provider.IsValid(); }
+
+	/**
+	 * @brief Discovers the sessions of all joinable friends.
+	 *
+	 * A discovery already in progress is abandoned and its callback is never invoked.
+	 *
+	 * @param LocalUserNum The local user whose friends are queried.
+	 * @param MaxConcurrentQueries The maximum number of friend session queries in flight.
+	 * @param CacheLifetime How long a friend's session stays cached, in seconds.
+	 * @param OnComplete Called with the sessions once every joinable friend was answered.
+	 */
+	void Find(const int32 LocalUserNum, const int32 MaxConcurrentQueries, const float CacheLifetime, const FDustLinkOnFriendSessionsFound& OnComplete);
+
+	/**
+	 * @brief Drops all cached friend sessions.
+	 */
+	void InvalidateCache() { Cache.Reset(); }
+
+	/**
+	 * @brief Returns the number of friends of the current discovery still waiting to be queried.
+	 */
+	int32 GetNumQueuedQueries() const { return QueuedFriends.Num(); }
+
+	/**
+	 * @brief Returns the number of friend session queries in flight.
+	 */
+	int32 GetNumQueriesInFlight() const { return NumQueriesInFlight; }
+
+private:
+	/**
+	 * @brief Callback for when the provider read the joinable friends.
+	 *
+	 * @param Generation The discovery the answer belongs to.
+	 * @param Friends The friends in a joinable session.
+	 * @param bWasSuccessful Whether the friends list could be read.
+	 */
+	void OnFriendsRead(const uint32 Generation, const TArray<FDustLinkFriend>& Friends, const bool bWasSuccessful);
+
+	/**
+	 * @brief Callback for when the provider answered a friend session query.
+	 *
+	 * @param Generation The discovery the answer belongs to.
+	 * @param FriendId The friend whose session was queried.
+	 * @param SessionResults The sessions found for the friend.
+	 * @param bWasSuccessful Whether the query succeeded.
+	 */
+	void OnFriendSessionFound(const uint32 Generation, const FString FriendId, const TArray<FOnlineSessionSearchResult>& SessionResults, const bool bWasSuccessful);
+
+	/**
+	 * @brief Issues queued friend session queries until the concurrency limit is reached.
+	 */
+	void IssueQueries();
+
+	/**
+	 * @brief Gathers the sessions of all friends of the current discovery and invokes its callback.
+	 */
+	void Finish();
+
+	/**
+	 * @struct FCacheEntry
+	 * @brief A cached friend session answer.
+	 */
+	struct FCacheEntry
+	{
+		/** Sessions found for the friend. */
+		TArray<FOnlineSessionSearchResult> SessionResults;
+
+		/** Time the answer was received, in seconds. */
+		double Time { 0.0 };
+	};
+
+	/** Source of friends and their sessions. */
+	TSharedPtr<IDustLinkPresenceProvider> Provider;
+
+	/** Cached friend session answers, keyed by friend identifier. */
+	TMap<FString, FCacheEntry> Cache;
+
+	/** Friends of the current discovery still waiting to be queried. */
+	TArray<FDustLinkFriend> QueuedFriends;
+
+	/** Friends of the current discovery, whose sessions make up the result. */
+	TArray<FString> DiscoveredFriendIds;
+
+	/** Callback of the current discovery. */
+	FDustLinkOnFriendSessionsFound PendingOnComplete;
+
+	/** Identifier of the current discovery, used to ignore answers of abandoned ones. */
+	uint32 CurrentGeneration { 0 };
+
+	/** Local user of the current discovery. */
+	int32 CurrentLocalUserNum { 0 };
+
+	/** Concurrency limit of the current discovery. */
+	int32 CurrentMaxConcurrentQueries { 1 };
+
+	/** Cache lifetime of the current discovery, in seconds. */
+	float CurrentCacheLifetime { 0.f };
+
+	/** Number of friend session queries in flight. */
+	int32 NumQueriesInFlight { 0 };
+};
@@ -0,0 +1,112 @@
+// Copyright Dustbyte Software. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+
+
+/**
+ * @class FDustLinkLatencyHistogram
+ * @brief Fixed-memory, log-bucketed latency histogram in the style of HdrHistogram.
+ *
+ * Latencies are tracked in microseconds from 1 µs up to roughly 4.7 hours. Every power of two is
+ * split into 64 linear sub-buckets, so a percentile is reported within 1/128 of the true value no
+ * matter how many samples were recorded. Recording touches only relaxed atomics and never allocates,
+ * so the game thread can record while another thread reads.
+ */
+class DUSTLINK_API FDustLinkLatencyHistogram
+{
+public:
+	/** Number of linear sub-buckets per power of two, as a power of two. */
+	static constexpr int32 SubBucketBits = 7;
+
+	/** Number of sub-buckets below the first power of two that is split, each one microsecond wide. */
+	static constexpr int32 SubBucketCount = 1 << SubBucketBits;
+
+	/** Number of sub-buckets per split power of two. */
+	static constexpr int32 SubBucketHalfCount = SubBucketCount / 2;
+
+	/** Bits of the largest trackable latency in microseconds, larger latencies are clamped. */
+	static constexpr int32 MaxValueBits = 34;
+
+	/** Total number of buckets. */
+	static constexpr int32 NumBuckets = SubBucketCount + (MaxValueBits - SubBucketBits) * SubBucketHalfCount;
+
+	/**
+	 * @brief Records one latency.
+	 *
+	 * @param LatencyMs The latency, in milliseconds.
+	 */
+	void Record(const double LatencyMs);
+
+	/**
+	 * @brief Returns the latency below which the given share of recorded latencies fall, in milliseconds.
+	 *
+	 * @param Percentile The percentile in the range [0, 100].
+	 * @return The latency, or zero if nothing was recorded.
+	 */
+	double GetPercentile(const double Percentile) const;
+
+	/**
+	 * @brief Returns the number of recorded latencies.
+	 */
+	uint64 GetCount() const { return Count.load(std::memory_order_relaxed); }
+
+	/**
+	 * @brief Returns the sum of all recorded latencies, in milliseconds.
+	 */
+	double GetSumMs() const { return SumMicroseconds.load(std::memory_order_relaxed) / 1000.0; }
+
+	/**
+	 * @brief Returns the mean of all recorded latencies, in milliseconds.
+	 */
+	double GetMeanMs() const;
+
+	/**
+	 * @brief Returns the largest recorded latency, in milliseconds.
+	 */
+	double GetMaxMs() const { return MaxMicroseconds.load(std::memory_order_relaxed) / 1000.0; }
+
+	/**
+	 * @brief Forgets all recorded latencies.
+	 *
+	 * Latencies recorded concurrently with a reset may be partially kept.
+	 */
+	void Reset();
+
+	/**
+	 * @brief Formats the count and the usual percentiles on one line, e.g. for console output.
+	 */
+	FString ToSummaryString() const;
+
+private:
+	/**
+	 * @brief Returns the bucket a latency falls into.
+	 *
+	 * @param Microseconds The latency, already clamped to the trackable range.
+	 */
+	static int32 GetBucketIndex(const uint64 Microseconds);
+
+	/**
+	 * @brief Returns the smallest latency of a bucket, in microseconds.
+	 */
+	static uint64 GetBucketLowerBound(const int32 Index);
+
+	/**
+	 * @brief Returns the width of a bucket, in microseconds.
+	 */
+	static uint64 GetBucketWidth(const int32 Index);
+
+	/** Number of latencies per bucket. */
+	std::atomic<uint32> Buckets[NumBuckets] {};
+
+	/** Number of recorded latencies. */
+	std::atomic<uint64> Count { 0 };
+
+	/** Sum of all recorded latencies, in microseconds. */
+	std::atomic<uint64> SumMicroseconds { 0 };
+
+	/** Largest recorded latency, in microseconds. */
+	std::atomic<uint64> MaxMicroseconds { 0 };
+};
@@ -0,0 +1,123 @@
+// Copyright Dustbyte Software. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+
+/**
+ * Notifies the caller whether a join code registration was accepted.
+ * @param bWasSuccessful Indicates whether the code is now registered to the caller.
+ * @param bIsCodeTaken Indicates whether the registration failed because another host holds the code.
+ * @param Secret The secret of the registration, required to renew or remove the code.
+ */
+DECLARE_DELEGATE_ThreeParams(FDustLinkOnJoinCodeRegisterComplete, const bool bWasSuccessful, const bool bIsCodeTaken, const FString& Secret);
+
+/**
+ * Notifies the caller about the connect info registered for a join code.
+ * @param ConnectInfo The address to travel to, empty if the code is unknown.
+ * @param bWasSuccessful Indicates whether the code was resolved.
+ */
+DECLARE_DELEGATE_TwoParams(FDustLinkOnJoinCodeResolved, const FString& ConnectInfo, const bool bWasSuccessful);
+
+
+/**
+ * @class IDustLinkListingProvider
+ * @brief Interface of the master server that maps short join codes to connect info.
+ *
+ * Hosts register a join code when their session is created and clients resolve it straight to
+ * connect info, so joining a private lobby skips the session search entirely.
+ */
+class DUSTLINK_API IDustLinkListingProvider
+{
+public:
+	virtual ~IDustLinkListingProvider() = default;
+
+	/**
+	 * @brief Registers the connect info of a hosted session under a join code.
+	 *
+	 * @param JoinCode The normalized join code.
+	 * @param ConnectInfo The address clients travel to.
+	 * @param Secret The secret of a previous registration of the code when renewing it, empty for a new code.
+	 * @param OnComplete Called once the provider accepted or rejected the registration.
+	 */
+	virtual void RegisterJoinCode(const FString& JoinCode, const FString& ConnectInfo, const FString& Secret, const FDustLinkOnJoinCodeRegisterComplete& OnComplete) = 0;
+
+	/**
+	 * @brief Removes a join code, e.g. when its session is destroyed.
+	 *
+	 * @param JoinCode The normalized join code.
+	 * @param Secret The secret returned by the registration of the code.
+	 */
+	virtual void UnregisterJoinCode(const FString& JoinCode, const FString& Secret) = 0;
+
+	/**
+	 * @brief Resolves a join code to the connect info of its session.
+	 *
+	 * @param JoinCode The normalized join code.
+	 * @param OnComplete Called with the connect info once the provider answered.
+	 */
+	virtual void ResolveJoinCode(const FString& JoinCode, const FDustLinkOnJoinCodeResolved& OnComplete) = 0;
+};
+
+/**
+ * @class FDustLinkHttpListingProvider
+ * @brief Listing provider that talks to a master server over HTTP.
+ *
+ * Codes are stored with `PUT <Url>/codes?code=<JoinCode>`, removed with `DELETE` and resolved with
+ * `GET`. A registration answers with a secret, renewing or removing the code passes it back as
+ * `&secret=<Secret>`. Connect info is public to every client, so it cannot prove ownership itself.
+ * `FDustLinkListingServer` implements the same protocol as a local stand-in.
+ */
+class DUSTLINK_API FDustLinkHttpListingProvider : public IDustLinkListingProvider
+{
+public:
+	/**
+	 * @brief Constructs a provider for the master server at the given base URL.
+	 *
+	 * @param InBaseUrl The base URL of the master server, e.g. "http://127.0.0.1:8810".
+	 */
+	explicit FDustLinkHttpListingProvider(const FString& InBaseUrl);
+
+	virtual void RegisterJoinCode(const FString& JoinCode, const FString& ConnectInfo, const FString& Secret, const FDustLinkOnJoinCodeRegisterComplete& OnComplete) override;
+	virtual void UnregisterJoinCode(const FString& JoinCode, const FString& Secret) override;
+	virtual void ResolveJoinCode(const FString& JoinCode, const FDustLinkOnJoinCodeResolved& OnComplete) override;
+
+private:
+	/**
+	 * @brief Builds the URL of a join code entry.
+	 *
+	 * @param JoinCode The normalized join code.
+	 * @param Secret The secret of the registration, omitted if empty.
+	 * @return The URL addressing the entry on the master server.
+	 */
+	FString MakeCodeUrl(const FString& JoinCode, const FString& Secret = FString()) const;
+
+	/** Base URL of the master server. */
+	FString BaseUrl;
+};
+
+/**
+ * @brief Helpers for generating and normalizing short join codes.
+ */
+namespace DustLinkJoinCode
+{
+	/** Default number of characters of a generated join code. */
+	constexpr int32 DefaultLength = 6;
+
+	/**
+	 * @brief Generates a random join code from an alphabet without easily confused characters.
+	 *
+	 * @param Length The number of characters of the code.
+	 * @return The generated code.
+	 */
+	DUSTLINK_API FString Generate(const int32 Length = DefaultLength);
+
+	/**
+	 * @brief Normalizes a code entered by a player, dropping whitespace and dashes and upper-casing it.
+	 *
+	 * @param JoinCode The code as entered by the player.
+	 * @return The normalized code.
+	 */
+	DUSTLINK_API FString Normalize(const FString& JoinCode);
+}
@@ -0,0 +1,79 @@
+// Copyright Dustbyte Software. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HttpRouteHandle.h"
+
+class IHttpRouter;
+struct FHttpServerRequest;
+
+
+/**
+ * @class FDustLinkListingServer
+ * @brief Local stand-in for the master server that maps join codes to connect info.
+ *
+ * Serves the protocol used by `FDustLinkHttpListingProvider` on localhost, keeping all codes in a
+ * hash map so registration and lookup are O(1). Intended for local testing of join-by-code flows
+ * without a deployed master server.
+ */
+class DUSTLINK_API FDustLinkListingServer
+{
+public:
+	~FDustLinkListingServer();
+
+	/**
+	 * @brief Starts serving join codes on the given port.
+	 *
+	 * @param Port The local port to listen on.
+	 * @return Returns `true` if the route was bound successfully.
+	 */
+	bool Start(const uint32 Port);
+
+	/**
+	 * @brief Stops serving join codes and forgets all registered codes.
+	 */
+	void Stop();
+
+	/**
+	 * @brief Returns `true` while the server is listening.
+	 */
+	bool IsRunning() const { return RouteHandle.IsValid(); }
+
+	/**
+	 * @brief Returns the number of currently registered join codes.
+	 */
+	int32 GetNumJoinCodes() const { return JoinCodes.Num(); }
+
+	/**
+	 * @brief Handles a request to the join code route.
+	 *
+	 * A new code is registered with a fresh secret, answered as body. Renewing or removing a code
+	 * requires its secret, a taken code is refused with 409 and a removal without the secret with 403.
+	 * Public so the protocol can be exercised without a socket.
+	 *
+	 * @param Request The incoming request.
+	 * @return The response status and body to send back.
+	 */
+	TPair<int32, FString> HandleRequest(const FHttpServerRequest& Request);
+
+private:
+	/** Router bound to the listening port. */
+	TSharedPtr<IHttpRouter> Router;
+
+	/** Handle of the join code route. */
+	FHttpRouteHandle RouteHandle;
+
+	/**
+	 * @struct FRegistration
+	 * @brief Connect info registered under a join code and the secret proving the registering host.
+	 */
+	struct FRegistration
+	{
+		FString ConnectInfo;
+		FString Secret;
+	};
+
+	/** Registrations, keyed by join code. */
+	TMap<FString, FRegistration> JoinCodes;
+};
@@ -0,0 +1,165 @@
+// Copyright Dustbyte Software. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OnlineSessionSettings.h"
+
+
+/**
+ * @struct FDustLinkLoadSettings
+ * @brief Tuning parameters for measuring, advertising and ranking host load.
+ */
+struct DUSTLINK_API FDustLinkLoadSettings
+{
+	/** Interval between two load samples on the host, in seconds. */
+	float SampleInterval { 1.f };
+
+	/** Game thread work per frame the host can afford while holding its tick rate, in milliseconds. */
+	float TickBudgetMs { 33.3f };
+
+	/** Weight of the most recent sample in the exponential moving averages. */
+	float SmoothingAlpha { 0.2f };
+
+	/** Shortest interval between two advertisements of the load, in seconds. */
+	float MinAdvertiseInterval { 15.f };
+
+	/** Change of the load, in percent, required before it is advertised again. */
+	int32 AdvertiseThreshold { 10 };
+
+	/** Load, in percent, above which clients consider a host overloaded. */
+	int32 OverloadedLoad { 85 };
+
+	/** Ranking penalty per percent of advertised load, in milliseconds of ping. */
+	float LoadPenaltyMs { 0.5f };
+
+	/** Additional ranking penalty of overloaded hosts, in milliseconds of ping. */
+	float OverloadPenaltyMs { 250.f };
+};
+
+/**
+ * @class FDustLinkLoadMonitor
+ * @brief Smooths the host's tick time, CPU usage and bandwidth usage into a single load figure.
+ *
+ * The load is the most constrained of the three resources in percent of its budget, so a host that
+ * is bandwidth bound is reported as loaded even if its tick time is fine. It is advertised in the
+ * `HostLoad` session setting, but only when it moved noticeably and not more often than allowed,
+ * so the backend sees a handful of coalesced updates instead of one per sample.
+ */
+class DUSTLINK_API FDustLinkLoadMonitor
+{
+public:
+	/**
+	 * @brief Constructs the monitor with the given tuning parameters.
+	 *
+	 * @param InSettings The tuning parameters to use.
+	 */
+	explicit FDustLinkLoadMonitor(const FDustLinkLoadSettings& InSettings = FDustLinkLoadSettings());
+
+	/**
+	 * @brief Forgets all samples and the last advertisement.
+	 */
+	void Reset();
+
+	/**
+	 * @brief Accumulates the work of one frame towards the next sample.
+	 *
+	 * @param TickTimeMs Game thread work of the frame, without idle time, in milliseconds.
+	 * @param CpuUsage Fraction of the machine's CPU used by the process, in the range [0, 1].
+	 */
+	void AddFrame(const float TickTimeMs, const float CpuUsage);
+
+	/**
+	 * @brief Feeds the average of the frames accumulated since the last sample into the moving averages.
+	 *
+	 * Does nothing if no frame was accumulated.
+	 *
+	 * @param BandwidthUsage Fraction of the outgoing bandwidth budget in use, in the range [0, 1].
+	 */
+	void AddSampleFromFrames(const float BandwidthUsage);
+
+	/**
+	 * @brief Feeds a sample into the moving averages.
+	 *
+	 * @param TickTimeMs Game thread work of the last frame, without idle time, in milliseconds.
+	 * @param CpuUsage Fraction of the machine's CPU used by the process, in the range [0, 1].
+	 * @param BandwidthUsage Fraction of the outgoing bandwidth budget in use, in the range [0, 1].
+	 */
+	void AddSample(const float TickTimeMs, const float CpuUsage, const float BandwidthUsage);
+
+	/**
+	 * @brief Returns the smoothed load in percent, where 100 means one of the resources is at its budget.
+	 */
+	int32 GetLoad() const;
+
+	/**
+	 * @brief Returns the smoothed game thread work per frame, in milliseconds.
+	 */
+	float GetSmoothedTickTimeMs() const { return SmoothedTickTimeMs; }
+
+	/**
+	 * @brief Returns `true` if the load changed enough since the last advertisement and the rate limit allows another one.
+	 *
+	 * @param Now The current time, in seconds.
+	 */
+	bool ShouldAdvertise(const double Now) const;
+
+	/**
+	 * @brief Records that the current load was advertised.
+	 *
+	 * @param Now The current time, in seconds.
+	 */
+	void MarkAdvertised(const double Now);
+
+	/**
+	 * @brief Returns the tuning parameters of the monitor.
+	 */
+	const FDustLinkLoadSettings& GetSettings() const { return Settings; }
+
+	/**
+	 * @brief Reads the load a host advertised in its session settings.
+	 *
+	 * @param SessionSettings The settings of the session.
+	 * @return The advertised load in percent, or `INDEX_NONE` if the host does not advertise it.
+	 */
+	static int32 GetAdvertisedLoad(const FOnlineSessionSettings& SessionSettings);
+
+	/**
+	 * @brief Orders search results by preference, lowest ping first with lightly loaded hosts ahead of overloaded ones.
+	 *
+	 * @param SessionResults The search results to sort in place.
+	 * @param InSettings The penalties to apply.
+	 */
+	static void RankSessions(TArray<FOnlineSessionSearchResult>& SessionResults, const FDustLinkLoadSettings& InSettings = FDustLinkLoadSettings());
+
+private:
+	/** Tuning parameters of the monitor. */
+	FDustLinkLoadSettings Settings;
+
+	/** Exponentially smoothed game thread work per frame, in milliseconds. */
+	float SmoothedTickTimeMs { 0.f };
+
+	/** Exponentially smoothed fraction of CPU in use. */
+	float SmoothedCpuUsage { 0.f };
+
+	/** Exponentially smoothed fraction of the bandwidth budget in use. */
+	float SmoothedBandwidthUsage { 0.f };
+
+	/** Game thread work of the frames accumulated since the last sample, in milliseconds. */
+	double FrameTickTimeMsSum { 0.0 };
+
+	/** CPU usage of the frames accumulated since the last sample. */
+	double FrameCpuUsageSum { 0.0 };
+
+	/** Number of frames accumulated since the last sample. */
+	int32 NumFrames { 0 };
+
+	/** Whether at least one sample was added since the last reset. */
+	bool bHasSamples { false };
+
+	/** Load reported by the last advertisement, `INDEX_NONE` if none was made. */
+	int32 LastAdvertisedLoad { INDEX_NONE };
+
+	/** Time of the last advertisement, in seconds. */
+	double LastAdvertiseTime { 0.0 };
+};
@@ -0,0 +1,286 @@
+// Copyright Dustbyte Software. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "DustLinkLatencyHistogram.h"
+#include <atomic>
+
+class FJsonObject;
+
+/**
+ * @brief Session operations whose outcomes and latencies are recorded.
+ */
+enum class EDustLinkSessionOperation : uint8
+{
+	Create,
+	Find,
+	Join,
+	Destroy,
+	Start,
+	End,
+	Update,
+	Num
+};
+
+/**
+ * @brief Player-facing phases of getting into a match, each of which may span several operations.
+ *
+ * Search runs from a player's search request to its results, join from picking a session, code, address
+ * or invite to having connect info, travel from deciding to travel to the map load starting and load
+ * covers the map load itself.
+ */
+enum class EDustLinkLatencyPhase : uint8
+{
+	Search,
+	Join,
+	Travel,
+	Load,
+	Num
+};
+
+/**
+ * @brief Point-in-time values sampled from the subsystem whenever metrics are requested.
+ */
+enum class EDustLinkGauge : uint8
+{
+	Players,
+	HostLoad,
+	Admitting,
+	PingProbesInFlight,
+	FriendQueriesQueued,
+	FriendQueriesInFlight,
+	Num
+};
+
+/**
+ * @brief Kinds of telemetry events emitted while recording metrics.
+ */
+enum class EDustLinkTelemetryEventType : uint8
+{
+	OperationBegin,
+	OperationEnd,
+	PhaseBegin,
+	PhaseEnd
+};
+
+/**
+ * @struct FDustLinkTelemetryEvent
+ * @brief A single start or completion of a session operation or phase.
+ *
+ * Plain data without allocations, so events can be kept in fixed-size ring buffers.
+ */
+struct DUSTLINK_API FDustLinkTelemetryEvent
+{
+	/** Time the event happened, in seconds. */
+	double Time { 0.0 };
+
+	/** Kind of the event. */
+	EDustLinkTelemetryEventType Type { EDustLinkTelemetryEventType::OperationBegin };
+
+	/** The `EDustLinkSessionOperation` or `EDustLinkLatencyPhase` the event belongs to, depending on its type. */
+	uint8 Target { 0 };
+
+	/** Whether the operation or phase succeeded, only meaningful for completions. */
+	bool bWasSuccessful { false };
+
+	/** Duration of the operation or phase in milliseconds, negative if its start is unknown or it just began. */
+	double LatencyMs { -1.0 };
+
+	/**
+	 * @brief Formats the event on one line.
+	 */
+	FString ToString() const;
+};
+
+/**
+ * Notifies subscribers about every start and completion recorded by `FDustLinkMetrics`.
+ * @param Event The recorded event.
+ */
+DECLARE_MULTICAST_DELEGATE_OneParam(FDustLinkOnTelemetryEvent, const FDustLinkTelemetryEvent& Event);
+
+/**
+ * @class FDustLinkMetrics
+ * @brief Counters, latency histograms and gauges describing the session activity of this process.
+ *
+ * Recording only touches relaxed atomics, so the game thread never blocks on a reader and a scrape
+ * from any thread sees consistent individual values. Operation and phase start times are only written
+ * and read on the game thread, which issues and completes all session operations.
+ */
+class DUSTLINK_API FDustLinkMetrics
+{
+public:
+	/**
+	 * @brief Counts a session operation as started and remembers when it started.
+	 *
+	 * @param Operation The operation that was issued.
+	 */
+	void BeginOperation(const EDustLinkSessionOperation Operation);
+
+	/**
+	 * @brief Counts a session operation as finished and records its latency if its start is known.
+	 *
+	 * @param Operation The operation that completed.
+	 * @param bWasSuccessful Whether the operation succeeded.
+	 */
+	void EndOperation(const EDustLinkSessionOperation Operation, const bool bWasSuccessful);
+
+	/**
+	 * @brief Remembers when a phase started, restarting it if it was already running.
+	 *
+	 * @param Phase The phase that started.
+	 */
+	void BeginPhase(const EDustLinkLatencyPhase Phase);
+
+	/**
+	 * @brief Records the duration of a phase if it is running.
+	 *
+	 * @param Phase The phase that ended.
+	 * @param bWasSuccessful Whether the phase reached its goal, only successful phases are recorded.
+	 */
+	void EndPhase(const EDustLinkLatencyPhase Phase, const bool bWasSuccessful);
+
+	/**
+	 * @brief Returns `true` while a phase is running.
+	 */
+	bool IsPhaseRunning(const EDustLinkLatencyPhase Phase) const { return PhaseStartTimes[static_cast<uint8>(Phase)] > 0.0; }
+
+	/**
+	 * @brief Forgets all recorded latencies, keeping the counters.
+	 */
+	void ResetLatencies();
+
+	/**
+	 * @brief Stops or resumes recording operations and phases, e.g. while a soak run floods the session lifecycle.
+	 *
+	 * No counters, latencies or telemetry events are recorded while suspended. Running operations and phases
+	 * are forgotten on suspension, so none of them straddles the pause.
+	 *
+	 * @param bInSuspended Whether recording stops.
+	 */
+	void SetSuspended(const bool bInSuspended);
+
+	/**
+	 * @brief Returns `true` while recording is suspended.
+	 */
+	bool IsSuspended() const { return bIsSuspended; }
+
+	/**
+	 * @brief Replaces the value of a gauge.
+	 *
+	 * @param Gauge The gauge to set.
+	 * @param Value The new value.
+	 */
+	void SetGauge(const EDustLinkGauge Gauge, const int64 Value) { Gauges[static_cast<uint8>(Gauge)].store(Value, std::memory_order_relaxed); }
+
+	/**
+	 * @brief Returns the value of a gauge.
+	 */
+	int64 GetGauge(const EDustLinkGauge Gauge) const { return Gauges[static_cast<uint8>(Gauge)].load(std::memory_order_relaxed); }
+
+	/**
+	 * @brief Returns the number of issued operations of a kind.
+	 */
+	uint64 GetNumStarted(const EDustLinkSessionOperation Operation) const { return Operations[static_cast<uint8>(Operation)].Started.load(std::memory_order_relaxed); }
+
+	/**
+	 * @brief Returns the number of succeeded operations of a kind.
+	 */
+	uint64 GetNumSucceeded(const EDustLinkSessionOperation Operation) const { return Operations[static_cast<uint8>(Operation)].Succeeded.load(std::memory_order_relaxed); }
+
+	/**
+	 * @brief Returns the number of failed operations of a kind.
+	 */
+	uint64 GetNumFailed(const EDustLinkSessionOperation Operation) const { return Operations[static_cast<uint8>(Operation)].Failed.load(std::memory_order_relaxed); }
+
+	/**
+	 * @brief Returns the latency histogram of an operation.
+	 */
+	const FDustLinkLatencyHistogram& GetLatency(const EDustLinkSessionOperation Operation) const { return Operations[static_cast<uint8>(Operation)].Latency; }
+
+	/**
+	 * @brief Returns the latency histogram of a phase.
+	 */
+	const FDustLinkLatencyHistogram& GetLatency(const EDustLinkLatencyPhase Phase) const { return Phases[static_cast<uint8>(Phase)]; }
+
+	/**
+	 * @brief Formats the latency percentiles of every operation and phase that recorded something.
+	 */
+	FString ToLatencyReport() const;
+
+	/**
+	 * @brief Encodes all metrics in the Prometheus text exposition format.
+	 */
+	FString ToPrometheus() const;
+
+	/**
+	 * @brief Encodes all metrics as a JSON object.
+	 */
+	FString ToJson() const;
+
+	/**
+	 * @brief Returns all metrics as a JSON object, e.g. to embed them in a larger document.
+	 */
+	TSharedRef<FJsonObject> ToJsonObject() const;
+
+	/**
+	 * @brief Returns the lower case name of an operation, as used in metric labels.
+	 */
+	static const TCHAR* GetOperationName(const EDustLinkSessionOperation Operation);
+
+	/**
+	 * @brief Returns the lower case name of a phase, as used in metric labels.
+	 */
+	static const TCHAR* GetPhaseName(const EDustLinkLatencyPhase Phase);
+
+	/**
+	 * @brief Returns the snake case name of a gauge, as used in metric names.
+	 */
+	static const TCHAR* GetGaugeName(const EDustLinkGauge Gauge);
+
+	/**
+	 * @brief Delegate triggered on the game thread for every start and completion that is recorded.
+	 */
+	FDustLinkOnTelemetryEvent OnTelemetryEvent;
+
+private:
+	/**
+	 * @brief Broadcasts a telemetry event if anyone listens.
+	 *
+	 * @param Type The kind of the event.
+	 * @param Target The operation or phase of the event.
+	 * @param bWasSuccessful Whether the operation or phase succeeded.
+	 * @param LatencyMs The duration of the operation or phase, negative if unknown.
+	 */
+	void EmitEvent(const EDustLinkTelemetryEventType Type, const uint8 Target, const bool bWasSuccessful, const double LatencyMs) const;
+
+	/**
+	 * @struct FOperationMetrics
+	 * @brief Counters and latencies of one kind of session operation.
+	 */
+	struct FOperationMetrics
+	{
+		std::atomic<uint64> Started { 0 };
+		std::atomic<uint64> Succeeded { 0 };
+		std::atomic<uint64> Failed { 0 };
+		FDustLinkLatencyHistogram Latency;
+
+		/** Time the pending operation was issued, zero if none is pending. Game thread only. */
+		double StartTime { 0.0 };
+	};
+
+	/** Metrics per session operation. */
+	FOperationMetrics Operations[static_cast<uint8>(EDustLinkSessionOperation::Num)];
+
+	/** Latencies per phase. */
+	FDustLinkLatencyHistogram Phases[static_cast<uint8>(EDustLinkLatencyPhase::Num)];
+
+	/** Time each running phase started, zero if it is not running. Game thread only. */
+	double PhaseStartTimes[static_cast<uint8>(EDustLinkLatencyPhase::Num)] {};
+
+	/** Current value of every gauge. */
+	std::atomic<int64> Gauges[static_cast<uint8>(EDustLinkGauge::Num)] {};
+
+	/** Whether recording is suspended. Game thread only. */
+	bool bIsSuspended { false };
+};
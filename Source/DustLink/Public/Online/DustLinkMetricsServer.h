@@ -0,0 +1,79 @@
+// Copyright Dustbyte Software. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HttpRouteHandle.h"
+#include "DustLinkMetrics.h"
+
+class IHttpRouter;
+struct FHttpServerRequest;
+
+
+/**
+ * Asks the owner to refresh the gauges right before the metrics are served.
+ */
+DECLARE_DELEGATE(FDustLinkOnMetricsRequested);
+
+/**
+ * @class FDustLinkMetricsServer
+ * @brief Local HTTP endpoint exposing `FDustLinkMetrics` to monitoring agents.
+ *
+ * Serves `GET /metrics` in the Prometheus text format and `GET /metrics/json` as JSON. Requests from
+ * other machines are refused, a collector running next to the dedicated server is expected to scrape it.
+ */
+class DUSTLINK_API FDustLinkMetricsServer
+{
+public:
+	/**
+	 * @brief Constructs the server for the given metrics.
+	 *
+	 * @param InMetrics The metrics to serve.
+	 */
+	explicit FDustLinkMetricsServer(const TSharedRef<const FDustLinkMetrics>& InMetrics);
+
+	~FDustLinkMetricsServer();
+
+	/**
+	 * @brief Starts serving the metrics routes on the given port.
+	 *
+	 * @param Port The local port to listen on.
+	 * @return Returns `true` if the routes were bound successfully.
+	 */
+	bool Start(const uint32 Port);
+
+	/**
+	 * @brief Stops serving the metrics routes.
+	 */
+	void Stop();
+
+	/**
+	 * @brief Returns `true` while the server is listening.
+	 */
+	bool IsRunning() const { return PrometheusRouteHandle.IsValid(); }
+
+	/**
+	 * @brief Delegate triggered right before the metrics are encoded for a request.
+	 */
+	FDustLinkOnMetricsRequested OnMetricsRequested;
+
+private:
+	/**
+	 * @brief Returns `true` if the request was sent from this machine.
+	 *
+	 * @param Request The incoming request.
+	 */
+	static bool IsLocalRequest(const FHttpServerRequest& Request);
+
+	/** Metrics served by the endpoint. */
+	TSharedRef<const FDustLinkMetrics> Metrics;
+
+	/** Router bound to the listening port. */
+	TSharedPtr<IHttpRouter> Router;
+
+	/** Handle of the Prometheus route. */
+	FHttpRouteHandle PrometheusRouteHandle;
+
+	/** Handle of the JSON route. */
+	FHttpRouteHandle JsonRouteHandle;
+};
@@ -0,0 +1,158 @@
+// Copyright Dustbyte Software. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "DustLinkMetrics.h"
+
+class UNetDriver;
+
+
+/**
+ * @struct FDustLinkNetworkProfile
+ * @brief Named set of link conditions emulated on the net driver and on the mock session backend.
+ *
+ * Lag and loss map to the packet simulation of the net driver, which only exists in builds with
+ * `DO_ENABLE_NET_TEST`. A profile without lag and loss leaves the packet simulation the user configured
+ * in place. The bandwidth cap limits the rate of every net connection. The mock backend and the
+ * completions of session searches and joins are delayed by the same lag plus the time the payload
+ * takes at the capped bandwidth, and backend answers are lost with the loss probability.
+ */
+struct DUSTLINK_API FDustLinkNetworkProfile
+{
+	/** Name the profile is selected by. */
+	FString Name { TEXT("Loopback") };
+
+	/** Added one-way latency, in milliseconds. */
+	int32 PktLag { 0 };
+
+	/** Random variance of the added latency, in milliseconds. */
+	int32 PktLagVariance { 0 };
+
+	/** Chance of a packet being dropped, in percent. */
+	int32 PktLoss { 0 };
+
+	/** Bandwidth cap, in bytes per second, zero for uncapped. */
+	int32 MaxBandwidth { 0 };
+
+	/** Approximate wire size of a backend answer without its entries, in bytes. */
+	static constexpr int32 EnvelopePayloadBytes { 256 };
+
+	/** Approximate wire size of one session entry with its settings, in bytes. */
+	static constexpr int32 SessionPayloadBytes { 1024 };
+
+	/**
+	 * @brief Returns `true` if the profile adds lag or loss to the packet simulation.
+	 */
+	bool HasPacketSimulation() const { return PktLag > 0 || PktLagVariance > 0 || PktLoss > 0; }
+
+	/**
+	 * @brief Returns `true` if the profile changes the link in any way.
+	 */
+	bool HasConditions() const { return HasPacketSimulation() || MaxBandwidth > 0; }
+
+	/**
+	 * @brief Applies lag, loss and bandwidth cap to a net driver and its open connections.
+	 *
+	 * @param NetDriver The net driver to configure.
+	 * @param UserConditions The lag and loss the net driver was created with, restored by profiles without lag and loss.
+	 */
+	void ApplyToNetDriver(UNetDriver* NetDriver, const FDustLinkNetworkProfile& UserConditions) const;
+
+	/**
+	 * @brief Returns the lag and loss a net driver currently simulates, none in builds without `DO_ENABLE_NET_TEST`.
+	 *
+	 * @param NetDriver The net driver to read.
+	 */
+	static FDustLinkNetworkProfile FromNetDriver(const UNetDriver* NetDriver);
+
+	/**
+	 * @brief Draws the delay of one backend answer, in seconds.
+	 *
+	 * @param PayloadBytes Approximate size of the answer, used with the bandwidth cap.
+	 */
+	float SampleBackendDelay(const int32 PayloadBytes) const;
+
+	/**
+	 * @brief Draws whether one backend answer is lost.
+	 */
+	bool SampleBackendLoss() const;
+
+	/**
+	 * @brief Formats the conditions of the profile on one line.
+	 */
+	FString ToString() const;
+
+	/**
+	 * @brief Returns the built-in profiles, from ideal to poor links.
+	 */
+	static const TArray<FDustLinkNetworkProfile>& GetBuiltInProfiles();
+
+	/**
+	 * @brief Finds a built-in profile by name, ignoring case.
+	 *
+	 * @param InName The name of the profile.
+	 * @return The profile, or `nullptr` if no profile has this name.
+	 */
+	static const FDustLinkNetworkProfile* Find(const FString& InName);
+};
+
+/**
+ * @class FDustLinkNetworkBenchmark
+ * @brief Collects phase latencies per network profile and reports how each phase degrades.
+ *
+ * Latencies are recorded into histograms of the benchmark's own, so switching profiles never clears
+ * the phase histograms of `FDustLinkMetrics`. The first profile with samples is the baseline every
+ * other profile is compared against.
+ */
+class DUSTLINK_API FDustLinkNetworkBenchmark
+{
+public:
+	/**
+	 * @brief Records later phase latencies under a profile, replacing an earlier run of it.
+	 *
+	 * @param ProfileName The profile that is emulated from now on.
+	 */
+	void SetProfile(const FString& ProfileName);
+
+	/**
+	 * @brief Records the latency of a finished phase under the current profile.
+	 *
+	 * @param Phase The phase that ended.
+	 * @param bWasSuccessful Whether the phase reached its goal, only successful phases are recorded.
+	 * @param LatencyMs The duration of the phase, in milliseconds.
+	 */
+	void RecordPhase(const EDustLinkLatencyPhase Phase, const bool bWasSuccessful, const double LatencyMs);
+
+	/**
+	 * @brief Forgets all runs, including the samples of the current profile.
+	 */
+	void Reset();
+
+	/**
+	 * @brief Formats the p50 and p95 of every phase per profile and their ratio to the baseline.
+	 */
+	FString ToReport() const;
+
+private:
+	/**
+	 * @struct FRun
+	 * @brief Phase latencies recorded under one profile.
+	 */
+	struct FRun
+	{
+		FString ProfileName;
+		FDustLinkLatencyHistogram Phases[static_cast<uint8>(EDustLinkLatencyPhase::Num)];
+
+		/**
+		 * @brief Returns `true` if any phase recorded a latency.
+		 */
+		bool HasSamples() const;
+	};
+
+	/** Recorded runs, in the order their profiles were first selected. Histograms are not movable, so runs are boxed. */
+	TArray<TUniquePtr<FRun>> Runs;
+
+	/** Run latencies are currently recorded into, `nullptr` before a profile is selected. */
+	FRun* CurrentRun { nullptr };
+};
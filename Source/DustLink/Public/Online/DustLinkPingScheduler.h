@@ -0,0 +1,128 @@
+// Copyright Dustbyte Software. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "DustLinkSessionDiff.h"
+
+
+/**
+ * @struct FDustLinkPingSettings
+ * @brief Tuning parameters for re-probing the ping of visible server browser rows.
+ */
+struct DUSTLINK_API FDustLinkPingSettings
+{
+	/** Number of rows after the last visible row that are probed ahead of scrolling. */
+	int32 Lookahead { 4 };
+
+	/** Maximum number of probes in flight at the same time. */
+	int32 MaxConcurrentProbes { 4 };
+
+	/** Minimum time between two probes of the same session, in seconds. */
+	float ReprobeInterval { 5.f };
+
+	/** Interval of the rolling schedule that starts new probes, in seconds. */
+	float TickInterval { 0.25f };
+
+	/** Time after which an unanswered probe is considered lost, in seconds. */
+	float ProbeTimeout { 1.5f };
+};
+
+/**
+ * @class FDustLinkPingScheduler
+ * @brief Decides which sessions to re-probe on a rolling schedule.
+ *
+ * Only the rows reported as visible by the server browser, plus a small lookahead, are probed.
+ * Visible rows are served before lookahead rows, each session is probed at most once per
+ * `ReprobeInterval`, and no more than `MaxConcurrentProbes` probes are in flight.
+ */
+class DUSTLINK_API FDustLinkPingScheduler
+{
+public:
+	/**
+	 * @brief Replaces the tuning parameters of the scheduler.
+	 *
+	 * @param InSettings The tuning parameters to use.
+	 */
+	void SetSettings(const FDustLinkPingSettings& InSettings) { Settings = InSettings; }
+
+	/**
+	 * @brief Returns the tuning parameters of the scheduler.
+	 */
+	const FDustLinkPingSettings& GetSettings() const { return Settings; }
+
+	/**
+	 * @brief Updates the set of sessions eligible for probing.
+	 *
+	 * @param VisibleSessionIds The sessions currently displayed by the server browser.
+	 * @param SessionOrder All sessions of the current result store, in display order, used to pick the lookahead.
+	 */
+	void SetVisibleSessions(const TArray<FString>& VisibleSessionIds, const TArray<FString>& SessionOrder);
+
+	/**
+	 * @brief Returns the sessions that should be probed now and marks them as in flight.
+	 *
+	 * @param Now The current time, in seconds.
+	 * @return The sessions to probe, limited by the free concurrency slots.
+	 */
+	TArray<FString> CollectDueProbes(const double Now);
+
+	/**
+	 * @brief Marks a probe as finished, freeing its concurrency slot.
+	 *
+	 * @param SessionId The session whose probe finished.
+	 */
+	void OnProbeComplete(const FString& SessionId);
+
+	/**
+	 * @brief Excludes a session from probing, e.g. because its address cannot be pinged.
+	 *
+	 * @param SessionId The session to exclude.
+	 */
+	void MarkUnpingable(const FString& SessionId) { UnpingableSessions.Add(SessionId); }
+
+	/**
+	 * @brief Forgets the probing state of sessions that left the result store.
+	 *
+	 * @param SessionIds The sessions to forget.
+	 */
+	void Forget(const TArray<FString>& SessionIds);
+
+	/**
+	 * @brief Stops probing and forgets all probing state.
+	 */
+	void Reset();
+
+	/**
+	 * @brief Returns `true` if there is at least one session eligible for probing.
+	 */
+	bool HasCandidates() const { return Candidates.Num() > 0; }
+
+	/**
+	 * @brief Returns the number of probes currently in flight.
+	 */
+	int32 GetNumInFlight() const { return InFlightProbes.Num(); }
+
+private:
+	/**
+	 * @brief Appends a session to the candidates unless it is already one, comparing identifiers case-sensitively.
+	 *
+	 * @param SessionId The session to probe.
+	 */
+	void AddCandidate(const FString& SessionId);
+
+	/** Tuning parameters of the scheduler. */
+	FDustLinkPingSettings Settings;
+
+	/** Visible sessions followed by the lookahead sessions, in probing priority order. */
+	TArray<FString> Candidates;
+
+	/** Time each session was last probed, in seconds. */
+	TDustLinkSessionIdMap<double> LastProbeTimes;
+
+	/** Sessions with a probe currently in flight. */
+	FDustLinkSessionIdSet InFlightProbes;
+
+	/** Sessions whose address cannot be probed. */
+	FDustLinkSessionIdSet UnpingableSessions;
+};
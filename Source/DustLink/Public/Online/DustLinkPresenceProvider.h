@@ -0,0 +1,236 @@
+// Copyright Dustbyte Software. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OnlineSessionSettings.h"
+#include "Containers/Ticker.h"
+#include "Interfaces/OnlineSessionInterface.h"
+#include "DustLinkNetworkProfile.h"
+
+
+/**
+ * @struct FDustLinkFriend
+ * @brief A friend of the local player who may be hosting or playing in a joinable session.
+ */
+struct DUSTLINK_API FDustLinkFriend
+{
+	/** Stable identifier of the friend, used as the cache key. */
+	FString FriendId;
+
+	/** Display name of the friend. */
+	FString DisplayName;
+
+	/** Online subsystem identifier of the friend, unset for mock friends. */
+	FUniqueNetIdPtr UserId;
+};
+
+/**
+ * Notifies the caller about the friends that are currently in a joinable session.
+ * @param Friends The friends whose presence reports a joinable session.
+ * @param bWasSuccessful Indicates whether the friends list could be read.
+ */
+DECLARE_DELEGATE_TwoParams(FDustLinkOnFriendsRead, const TArray<FDustLinkFriend>& Friends, const bool bWasSuccessful);
+
+/**
+ * Notifies the caller about the session of a single friend.
+ * @param SessionResults The sessions found for the friend, usually zero or one.
+ * @param bWasSuccessful Indicates whether the query succeeded.
+ */
+DECLARE_DELEGATE_TwoParams(FDustLinkOnFriendSessionFound, const TArray<FOnlineSessionSearchResult>& SessionResults, const bool bWasSuccessful);
+
+
+/**
+ * @class IDustLinkPresenceProvider
+ * @brief Source of friends and their sessions used by friend-session discovery.
+ */
+class DUSTLINK_API IDustLinkPresenceProvider
+{
+public:
+	virtual ~IDustLinkPresenceProvider() = default;
+
+	/**
+	 * @brief Reads the friends list and keeps only friends whose presence reports a joinable session.
+	 *
+	 * @param LocalUserNum The local user whose friends are read.
+	 * @param OnComplete Called with the friends once the list was read.
+	 */
+	virtual void ReadJoinableFriends(const int32 LocalUserNum, const FDustLinkOnFriendsRead& OnComplete) = 0;
+
+	/**
+	 * @brief Queries the session of a single friend directly, without a global search.
+	 *
+	 * @param LocalUserNum The local user issuing the query.
+	 * @param Friend The friend whose session is queried.
+	 * @param OnComplete Called with the friend's session once the query finished.
+	 */
+	virtual void FindFriendSession(const int32 LocalUserNum, const FDustLinkFriend& Friend, const FDustLinkOnFriendSessionFound& OnComplete) = 0;
+};
+
+/**
+ * @class FDustLinkOnlinePresenceProvider
+ * @brief Presence provider backed by the friends, presence and session interfaces of an online subsystem.
+ *
+ * Friend session queries of a local user reach the session interface one at a time, whatever
+ * concurrency the caller allows, because its completions cannot otherwise be told apart.
+ */
+class DUSTLINK_API FDustLinkOnlinePresenceProvider : public IDustLinkPresenceProvider, public TSharedFromThis<FDustLinkOnlinePresenceProvider>
+{
+public:
+	/**
+	 * @brief Constructs a provider for the given online subsystem.
+	 *
+	 * @param InSubsystem The online subsystem to query.
+	 */
+	explicit FDustLinkOnlinePresenceProvider(IOnlineSubsystem* InSubsystem);
+
+	virtual ~FDustLinkOnlinePresenceProvider() override;
+
+	virtual void ReadJoinableFriends(const int32 LocalUserNum, const FDustLinkOnFriendsRead& OnComplete) override;
+	virtual void FindFriendSession(const int32 LocalUserNum, const FDustLinkFriend& Friend, const FDustLinkOnFriendSessionFound& OnComplete) override;
+
+private:
+	/**
+	 * @brief Issues the next queued friend session query of a local user, unless one is in flight.
+	 *
+	 * @param LocalUserNum The local user whose queue is served.
+	 */
+	void IssueNextQuery(const int32 LocalUserNum);
+
+	/**
+	 * @brief Callback for when the session interface finished a friend session query.
+	 *
+	 * The session interface does not report which friend a completion belongs to, and a friend
+	 * who joined someone else's session is not its owner. Each local user therefore has a single
+	 * query in flight, and the completion is keyed by the friend that query was issued for.
+	 *
+	 * @param LocalUserNum The local user who issued the query.
+	 * @param bWasSuccessful Whether the query succeeded.
+	 * @param SessionResults The sessions found.
+	 */
+	void OnFindFriendSessionComplete(int32 LocalUserNum, bool bWasSuccessful, const TArray<FOnlineSessionSearchResult>& SessionResults);
+
+	/**
+	 * @struct FPendingQuery
+	 * @brief A friend session query waiting for its completion.
+	 */
+	struct FPendingQuery
+	{
+		/** Friend whose session is queried. */
+		FDustLinkFriend Friend;
+
+		/** Callback to invoke on completion. */
+		FDustLinkOnFriendSessionFound OnComplete;
+
+		/** Sequence number of the query, telling a synchronous failure apart from a later query. */
+		uint32 Serial { 0 };
+	};
+
+	/** Online subsystem whose interfaces are queried. */
+	IOnlineSubsystem* Subsystem { nullptr };
+
+	/** Queries waiting for the in-flight one to complete, in the order they were issued, keyed by local user. */
+	TMap<int32, TArray<FPendingQuery>> QueuedQueries;
+
+	/** The query in flight at the session interface, keyed by local user. */
+	TMap<int32, FPendingQuery> InFlightQueries;
+
+	/** Sequence number of the most recently issued query. */
+	uint32 LastQuerySerial { 0 };
+
+	/** Handles of the friend session completion delegates, keyed by local user. */
+	TMap<int32, FDelegateHandle> FindFriendSessionCompleteDelegateHandles;
+};
+
+/**
+ * @class FDustLinkMockPresenceProvider
+ * @brief Presence provider serving a configurable set of fake friends for local tests.
+ *
+ * Answers are delivered on the core ticker after a configurable delay to mimic backend latency,
+ * plus the lag and transfer time of the emulated network profile, which may also lose answers.
+ */
+class DUSTLINK_API FDustLinkMockPresenceProvider : public IDustLinkPresenceProvider, public TSharedFromThis<FDustLinkMockPresenceProvider>
+{
+public:
+	/**
+	 * @brief Adds a fake friend.
+	 *
+	 * @param Friend The friend to add.
+	 * @param SessionResult The session the friend is in, unset if the friend is not joinable.
+	 */
+	void AddFriend(const FDustLinkFriend& Friend, const TOptional<FOnlineSessionSearchResult>& SessionResult);
+
+	/**
+	 * @brief Removes a fake friend.
+	 *
+	 * @param FriendId The identifier of the friend to remove.
+	 */
+	void RemoveFriend(const FString& FriendId) { Friends.Remove(FriendId); }
+
+	/**
+	 * @brief Removes all fake friends.
+	 */
+	void Reset() { Friends.Reset(); }
+
+	/**
+	 * @brief Returns the number of fake friends, joinable or not.
+	 */
+	int32 GetNumFriends() const { return Friends.Num(); }
+
+	/**
+	 * @brief Adds the fake friends listed in a JSON file.
+	 *
+	 * The file holds a `Friends` array whose entries have an `Id`, an optional `Name` and an optional
+	 * `Session` object with `MatchType`, `OpenSlots`, `MaxPlayers` and `Ping`. Friends without a session are not joinable.
+	 *
+	 * @param Path The file to read.
+	 * @return `true` if the file was read and parsed.
+	 */
+	bool LoadFromFile(const FString& Path);
+
+	/**
+	 * @brief Builds a search result for a fake session hosted by a fake friend.
+	 *
+	 * @param OwnerName The display name of the host, also used to derive the session identifier.
+	 * @param MatchType The value of the session's `MatchType` setting.
+	 * @param NumOpenSlots The number of free player slots.
+	 * @param MaxPlayers The total number of player slots.
+	 * @param PingInMs The ping reported for the session.
+	 */
+	static FOnlineSessionSearchResult MakeSessionResult(const FString& OwnerName, const FString& MatchType, const int32 NumOpenSlots, const int32 MaxPlayers, const int32 PingInMs);
+
+	/**
+	 * @brief Sets the simulated latency of every answer, in seconds.
+	 *
+	 * @param InLatency The delay before each answer is delivered.
+	 */
+	void SetLatency(const float InLatency) { Latency = InLatency; }
+
+	/**
+	 * @brief Sets the network conditions emulated between the caller and the backend.
+	 *
+	 * @param InProfile The conditions to emulate.
+	 */
+	void SetNetworkProfile(const FDustLinkNetworkProfile& InProfile) { NetworkProfile = InProfile; }
+
+	virtual void ReadJoinableFriends(const int32 LocalUserNum, const FDustLinkOnFriendsRead& OnComplete) override;
+	virtual void FindFriendSession(const int32 LocalUserNum, const FDustLinkFriend& Friend, const FDustLinkOnFriendSessionFound& OnComplete) override;
+
+private:
+	/**
+	 * @brief Delivers an answer after the simulated latency.
+	 *
+	 * @param PayloadBytes Approximate size of the answer on the wire.
+	 * @param Answer The function that invokes the caller's callback, told whether the answer arrived.
+	 */
+	void Deliver(const int32 PayloadBytes, TFunction<void(bool)>&& Answer) const;
+
+	/** Fake friends and their sessions, keyed by friend identifier. */
+	TMap<FString, TPair<FDustLinkFriend, TOptional<FOnlineSessionSearchResult>>> Friends;
+
+	/** Simulated latency of every answer, in seconds. */
+	float Latency { 0.05f };
+
+	/** Network conditions emulated on top of the backend latency. */
+	FDustLinkNetworkProfile NetworkProfile;
+};
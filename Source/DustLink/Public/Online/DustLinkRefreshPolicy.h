@@ -0,0 +1,101 @@
+// Copyright Dustbyte Software. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+
+/**
+ * @struct FDustLinkRefreshPolicySettings
+ * @brief Tuning parameters for the adaptive background refresh of the server list.
+ */
+struct DUSTLINK_API FDustLinkRefreshPolicySettings
+{
+	/** Shortest interval between two refreshes, in seconds. */
+	float MinInterval { 5.f };
+
+	/** Longest interval between two refreshes while the window is focused, in seconds. */
+	float MaxInterval { 120.f };
+
+	/** Interval used for the first refresh after auto-refresh is enabled, in seconds. */
+	float InitialInterval { 15.f };
+
+	/** Multiplier applied to the interval while the window is not focused. */
+	float UnfocusedMultiplier { 4.f };
+
+	/** Longest interval between two refreshes while the window is not focused, in seconds. */
+	float MaxUnfocusedInterval { 300.f };
+
+	/** Smoothed churn above which the list is considered to be turning over and the interval shrinks. */
+	float HighChurn { 0.2f };
+
+	/** Smoothed churn below which the list is considered stable and the interval grows. */
+	float LowChurn { 0.02f };
+
+	/** Factor applied to the interval when the list is stable. */
+	float BackoffFactor { 1.5f };
+
+	/** Factor applied to the interval when the list is turning over. */
+	float SpeedupFactor { 0.5f };
+
+	/** Weight of the most recent churn sample in the exponential moving average. */
+	float SmoothingAlpha { 0.3f };
+};
+
+/**
+ * @class FDustLinkRefreshPolicy
+ * @brief Computes the interval until the next background refresh from the churn seen in recent diffs.
+ *
+ * Churn is the fraction of sessions that were added or removed by a search. The policy
+ * smooths it over recent searches, backs off while the list is stable or the window is unfocused,
+ * and speeds up while sessions are turning over.
+ */
+class DUSTLINK_API FDustLinkRefreshPolicy
+{
+public:
+	/**
+	 * @brief Constructs the policy with the given tuning parameters.
+	 *
+	 * @param InSettings The tuning parameters to use.
+	 */
+	explicit FDustLinkRefreshPolicy(const FDustLinkRefreshPolicySettings& InSettings = FDustLinkRefreshPolicySettings());
+
+	/**
+	 * @brief Restores the initial interval and forgets the churn history.
+	 */
+	void Reset();
+
+	/**
+	 * @brief Feeds the result of a completed search into the policy.
+	 *
+	 * @param Churn Fraction of sessions that appeared or disappeared in the search, in the range [0, 1].
+	 * @param bIsFocused Whether the game window currently has focus.
+	 * @return The interval until the next refresh, in seconds.
+	 */
+	float OnSearchComplete(const float Churn, const bool bIsFocused);
+
+	/**
+	 * @brief Returns the interval the policy would use while the window is focused, in seconds.
+	 */
+	float GetInterval() const { return Interval; }
+
+	/**
+	 * @brief Returns the exponentially smoothed churn of recent searches.
+	 */
+	float GetSmoothedChurn() const { return SmoothedChurn; }
+
+	/**
+	 * @brief Returns the tuning parameters of the policy.
+	 */
+	const FDustLinkRefreshPolicySettings& GetSettings() const { return Settings; }
+
+private:
+	/** Tuning parameters of the policy. */
+	FDustLinkRefreshPolicySettings Settings;
+
+	/** Current focused refresh interval, in seconds. */
+	float Interval { 0.f };
+
+	/** Exponentially smoothed churn of recent searches. */
+	float SmoothedChurn { 0.f };
+};
@@ -0,0 +1,122 @@
+// Copyright Dustbyte Software. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OnlineSessionSettings.h"
+
+
+/**
+ * @brief Bit flags describing which fields of a session changed between two consecutive searches.
+ */
+enum class EDustLinkSessionChange : uint8
+{
+	None = 0,
+	Ping = 1 << 0,
+	OpenConnections = 1 << 1,
+	Owner = 1 << 2,
+	Settings = 1 << 3
+};
+
+ENUM_CLASS_FLAGS(EDustLinkSessionChange);
+
+/**
+ * @struct FDustLinkSessionIdKeyFuncs
+ * @brief Case-sensitive set key functions for session identifiers, which backends may tell apart by case alone.
+ */
+struct FDustLinkSessionIdKeyFuncs : DefaultKeyFuncs<FString>
+{
+	static bool Matches(const FString& A, const FString& B) { return A.Equals(B, ESearchCase::CaseSensitive); }
+	static uint32 GetKeyHash(const FString& Key) { return FCrc::StrCrc32(*Key); }
+};
+
+/**
+ * @struct TDustLinkSessionIdMapKeyFuncs
+ * @brief Case-sensitive map key functions for session identifiers.
+ */
+template <typename ValueType>
+struct TDustLinkSessionIdMapKeyFuncs : TDefaultMapKeyFuncs<FString, ValueType, false>
+{
+	static bool Matches(const FString& A, const FString& B) { return A.Equals(B, ESearchCase::CaseSensitive); }
+	static uint32 GetKeyHash(const FString& Key) { return FCrc::StrCrc32(*Key); }
+};
+
+/** Set of session identifiers, compared case-sensitively. */
+using FDustLinkSessionIdSet = TSet<FString, FDustLinkSessionIdKeyFuncs>;
+
+/** Map keyed by session identifiers, compared case-sensitively. */
+template <typename ValueType>
+using TDustLinkSessionIdMap = TMap<FString, ValueType, FDefaultSetAllocator, TDustLinkSessionIdMapKeyFuncs<ValueType>>;
+
+/** Session result store keyed by session identifier. */
+using FDustLinkSessionResultStore = TDustLinkSessionIdMap<FOnlineSessionSearchResult>;
+
+/**
+ * @struct FDustLinkSessionChange
+ * @brief Describes a single session that is present in both searches but whose fields differ.
+ */
+struct DUSTLINK_API FDustLinkSessionChange
+{
+	/** Identifier of the changed session. */
+	FString SessionId;
+
+	/** Set of fields that differ from the previous search. */
+	EDustLinkSessionChange Fields { EDustLinkSessionChange::None };
+};
+
+/**
+ * @struct FDustLinkSessionDiff
+ * @brief Difference between two consecutive session result stores.
+ *
+ * The diff is keyed by session identifiers, so consumers such as server browser widgets
+ * can patch only the rows that were added, removed or changed instead of rebuilding their lists.
+ */
+struct DUSTLINK_API FDustLinkSessionDiff
+{
+	/** Sessions that appeared in the new search. */
+	TArray<FString> Added;
+
+	/** Sessions that are no longer present in the new search. */
+	TArray<FString> Removed;
+
+	/** Sessions present in both searches whose fields differ. */
+	TArray<FDustLinkSessionChange> Changed;
+
+	/**
+	 * @brief Returns the total number of added, removed and changed sessions.
+	 */
+	int32 Num() const { return Added.Num() + Removed.Num() + Changed.Num(); }
+
+	/**
+	 * @brief Returns `true` if both searches produced identical result stores.
+	 */
+	bool IsEmpty() const { return Num() == 0; }
+
+	/**
+	 * @brief Computes the difference between two session result stores.
+	 *
+	 * @param Previous The result store of the previous search.
+	 * @param Current The result store of the new search.
+	 * @return The added, removed and changed sessions.
+	 */
+	static FDustLinkSessionDiff Compute(const FDustLinkSessionResultStore& Previous, const FDustLinkSessionResultStore& Current);
+
+	/**
+	 * @brief Returns the identifier used to key a search result.
+	 *
+	 * Kept as a string rather than an `FName`, so searches of thousands of sessions do not grow the name table.
+	 *
+	 * @param Result The search result to identify.
+	 * @return The session identifier, or an empty string if the result carries no session info.
+	 */
+	static FString GetSessionKey(const FOnlineSessionSearchResult& Result);
+
+	/**
+	 * @brief Compares the fields of the same session across two searches.
+	 *
+	 * @param Previous The session as seen by the previous search.
+	 * @param Current The session as seen by the new search.
+	 * @return Flags for every field that differs.
+	 */
+	static EDustLinkSessionChange CompareFields(const FOnlineSessionSearchResult& Previous, const FOnlineSessionSearchResult& Current);
+};
@@ -0,0 +1,164 @@
+// Copyright Dustbyte Software. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "DustLinkMetrics.h"
+
+
+/**
+ * @struct FDustLinkSlo
+ * @brief Latency objective of one session operation, e.g. joins finish within 3 s at the 95th percentile.
+ */
+struct DUSTLINK_API FDustLinkSlo
+{
+	/** Operation the objective applies to. */
+	EDustLinkSessionOperation Operation { EDustLinkSessionOperation::Join };
+
+	/** Percentile of recent latencies that has to stay below the threshold, in the range [0, 100]. */
+	float Percentile { 95.f };
+
+	/** Latency the percentile must not exceed, in milliseconds. */
+	float ThresholdMs { 3000.f };
+};
+
+/**
+ * @struct FDustLinkSloSettings
+ * @brief Objectives and capture parameters of the SLO watchdog.
+ */
+struct DUSTLINK_API FDustLinkSloSettings
+{
+	/** Objectives that are watched. */
+	TArray<FDustLinkSlo> Slos {
+		{ EDustLinkSessionOperation::Join, 95.f, 3000.f },
+		{ EDustLinkSessionOperation::Find, 95.f, 5000.f },
+		{ EDustLinkSessionOperation::Create, 95.f, 5000.f }
+	};
+
+	/** Number of recent latencies per operation an objective is evaluated over. */
+	int32 WindowSize { 50 };
+
+	/** Number of recent latencies required before an objective is evaluated. */
+	int32 MinSamples { 10 };
+
+	/** Number of recent telemetry events kept for snapshots. */
+	int32 RingCapacity { 512 };
+
+	/** Shortest interval between two captures, in seconds, so a lasting breach does not flood the disk. */
+	float CaptureCooldown { 300.f };
+
+	/** Whether a breach also writes the tail of the Unreal Insights trace buffer. */
+	bool bCaptureTrace { false };
+
+	/** Directory snapshots are written to, the project's `Saved/DustLink/Slo` directory if empty. */
+	FString OutputDirectory;
+};
+
+/**
+ * Notifies subscribers that an objective was breached and a snapshot was captured.
+ * @param Slo The breached objective.
+ * @param ObservedMs The observed percentile latency, in milliseconds.
+ * @param SnapshotPath The file the telemetry snapshot is written to.
+ */
+DECLARE_MULTICAST_DELEGATE_ThreeParams(FDustLinkOnSloBreached, const FDustLinkSlo& Slo, const double ObservedMs, const FString& SnapshotPath);
+
+/**
+ * @class FDustLinkSloWatchdog
+ * @brief Watches session operation latencies against their objectives and captures diagnostics on a breach.
+ *
+ * Every telemetry event of `FDustLinkMetrics` is kept in a fixed-size ring buffer. When an operation
+ * completes, its objective is evaluated over a sliding window of recent latencies. On a breach the
+ * ring buffer and the current metrics are written to a JSON snapshot on a background thread and,
+ * if enabled, the tail of the Unreal Insights trace buffer is written next to it, so slow joins seen
+ * in production come with the events that led up to them.
+ */
+class DUSTLINK_API FDustLinkSloWatchdog
+{
+public:
+	/**
+	 * @brief Constructs the watchdog and subscribes to the telemetry events of the metrics.
+	 *
+	 * @param InMetrics The metrics to watch.
+	 * @param InSettings The objectives and capture parameters to use.
+	 */
+	explicit FDustLinkSloWatchdog(const TSharedRef<FDustLinkMetrics>& InMetrics, const FDustLinkSloSettings& InSettings = FDustLinkSloSettings());
+
+	~FDustLinkSloWatchdog();
+
+	/**
+	 * @brief Replaces the objectives and capture parameters, forgetting recent latencies and events.
+	 *
+	 * @param InSettings The objectives and capture parameters to use.
+	 */
+	void SetSettings(const FDustLinkSloSettings& InSettings);
+
+	/**
+	 * @brief Returns the objectives and capture parameters.
+	 */
+	const FDustLinkSloSettings& GetSettings() const { return Settings; }
+
+	/**
+	 * @brief Writes a snapshot of the recent telemetry right away, regardless of objectives and cooldown.
+	 *
+	 * @param Reason A short label included in the snapshot and its file name.
+	 * @return The file the snapshot is written to.
+	 */
+	FString CaptureSnapshot(const FString& Reason);
+
+	/**
+	 * @brief Delegate triggered when an objective was breached and a snapshot was captured.
+	 */
+	FDustLinkOnSloBreached OnSloBreached;
+
+private:
+	/**
+	 * @brief Callback for every telemetry event of the watched metrics.
+	 *
+	 * @param Event The recorded event.
+	 */
+	void HandleTelemetryEvent(const FDustLinkTelemetryEvent& Event);
+
+	/**
+	 * @brief Evaluates the objectives of an operation after one of its latencies was added.
+	 *
+	 * @param Operation The operation that completed.
+	 */
+	void EvaluateSlos(const EDustLinkSessionOperation Operation);
+
+	/**
+	 * @brief Returns a percentile of the recent latencies of an operation, in milliseconds.
+	 *
+	 * @param Operation The operation to evaluate.
+	 * @param Percentile The percentile in the range [0, 100].
+	 */
+	double GetWindowPercentile(const EDustLinkSessionOperation Operation, const float Percentile) const;
+
+	/**
+	 * @brief Forgets recent latencies and events and sizes the buffers for the current settings.
+	 */
+	void ResetBuffers();
+
+	/** Metrics whose telemetry events are watched. */
+	TSharedRef<FDustLinkMetrics> Metrics;
+
+	/** Handle of the telemetry event binding. */
+	FDelegateHandle TelemetryEventHandle;
+
+	/** Objectives and capture parameters. */
+	FDustLinkSloSettings Settings;
+
+	/** Recent telemetry events, overwritten oldest first once full. */
+	TArray<FDustLinkTelemetryEvent> Events;
+
+	/** Index the next event is written to once the ring buffer is full. */
+	int32 NextEventIndex { 0 };
+
+	/** Recent latencies per operation, overwritten oldest first once full. */
+	TArray<double> Windows[static_cast<uint8>(EDustLinkSessionOperation::Num)];
+
+	/** Index the next latency of each operation is written to once its window is full. */
+	int32 NextWindowIndices[static_cast<uint8>(EDustLinkSessionOperation::Num)] {};
+
+	/** Time of the last capture, in seconds. */
+	double LastCaptureTime { -TNumericLimits<double>::Max() };
+};
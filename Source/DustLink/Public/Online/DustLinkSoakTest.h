@@ -0,0 +1,284 @@
+// Copyright Dustbyte Software. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OnlineSessionSettings.h"
+#include "Containers/Ticker.h"
+#include "Interfaces/OnlineSessionInterface.h"
+#include "UObject/StrongObjectPtr.h"
+#include "DustLinkLatencyHistogram.h"
+
+class UDustLinkMenu;
+class UDustLinkSubsystem;
+
+
+/**
+ * @struct FDustLinkSoakSettings
+ * @brief Length of a soak run and the growth it tolerates.
+ */
+struct DUSTLINK_API FDustLinkSoakSettings
+{
+	/** Number of session lifecycles to run. */
+	int32 NumCycles { 10000 };
+
+	/** Cycles run before the baseline sample is taken, so caches and pools can fill up. */
+	int32 WarmupCycles { 200 };
+
+	/** Cycles between two samples of memory, objects and bindings. */
+	int32 SampleInterval { 500 };
+
+	/** Heap growth over the baseline that fails the run, in megabytes. */
+	double MaxHeapGrowthMb { 32.0 };
+
+	/** Growth of the live object count over the baseline that fails the run. */
+	int32 MaxObjectGrowth { 256 };
+
+	/** Ratio of a step's p95 latency in the last window to its p95 in the first window that fails the run. */
+	double MaxLatencyDrift { 1.5 };
+
+	/** Steps whose p95 latency in the first window is below this are not checked for drift, in milliseconds. */
+	double MinDriftLatencyMs { 1.0 };
+
+	/** Time a single step may take before the run is aborted as stalled, in seconds. */
+	float StepTimeout { 15.f };
+
+	/** Whether every cycle hosts and searches through the buttons of a fresh menu, if a menu class is loaded. */
+	bool bCycleMenu { true };
+};
+
+/**
+ * @struct FDustLinkSoakSample
+ * @brief Resource usage measured after a garbage collection at one point of a soak run.
+ */
+struct DUSTLINK_API FDustLinkSoakSample
+{
+	/** Cycles completed when the sample was taken. */
+	int32 Cycle { 0 };
+
+	/** Memory handed out by the allocator, in megabytes, or the physical memory used if the allocator does not report it. */
+	double HeapMb { 0.0 };
+
+	/** Number of live objects. */
+	int32 NumObjects { 0 };
+
+	/** Number of active subscriptions to the subsystem's delegates. */
+	int32 NumSubscriptions { 0 };
+
+	/** 95th percentile of the cycle times since the previous sample, in milliseconds. */
+	double CycleP95Ms { 0.0 };
+
+	/** 95th percentile of each step's latency since the previous sample, in milliseconds, in the order of a cycle. */
+	TArray<double> StepP95Ms;
+};
+
+/**
+ * Notifies the caller about the outcome of a soak run.
+ * @param bPassed Indicates whether the run completed without resource growth or latency drift.
+ * @param Report Samples and verdicts of the run, one per line.
+ */
+DECLARE_MULTICAST_DELEGATE_TwoParams(FDustLinkOnSoakComplete, const bool bPassed, const FString& Report);
+
+
+/**
+ * @class FDustLinkSoakTest
+ * @brief Runs thousands of session lifecycles through the subsystem and fails on leaks.
+ *
+ * Every cycle creates, starts and finds a session, destroys it, joins the first search result and destroys
+ * the joined session again. If a menu class is loaded, every cycle sets up a fresh menu, hosts and searches
+ * by clicking its buttons with its travel stubbed out, and tears it down at the end. The join the menu starts
+ * from its own search is refused while the process still hosts, the soak joins the remembered result once
+ * its session is destroyed. Steps are chained on the core ticker, so the run spans many frames and the
+ * game keeps ticking. Meant for the null online subsystem, where a search finds the session hosted by the
+ * same process.
+ *
+ * The run starts with the pooled menu closed and fails if any other menu is still open.
+ * Metrics, SLO checks and funnel events are suspended for its duration, so the flood of operations does
+ * not reach dashboards or trip objectives. Every `SampleInterval` cycles garbage is collected and allocator
+ * heap, object count, subscription count and per-step latency are sampled. At the end of every cycle the
+ * subsystem must hold no online delegate handles. The run fails if any of these grew over the baseline
+ * taken after the warmup, if a step's p95 latency drifted upwards, if any step failed or if no cycle
+ * reached the join. The report states how many cycles ran every step.
+ */
+class DUSTLINK_API FDustLinkSoakTest : public TSharedFromThis<FDustLinkSoakTest>
+{
+public:
+	/**
+	 * @brief Constructs a soak run against the given subsystem.
+	 *
+	 * @param InSubsystem The subsystem whose session lifecycle is exercised.
+	 * @param InSettings The length and tolerances of the run.
+	 */
+	FDustLinkSoakTest(UDustLinkSubsystem* InSubsystem, const FDustLinkSoakSettings& InSettings);
+
+	~FDustLinkSoakTest();
+
+	/**
+	 * @brief Subscribes to the subsystem and starts the first cycle.
+	 */
+	void Start();
+
+	/**
+	 * @brief Aborts the run, reporting it as failed.
+	 *
+	 * @param Reason Why the run was aborted.
+	 */
+	void Abort(const FString& Reason);
+
+	/**
+	 * @brief Returns `true` between `Start` and the end of the run.
+	 */
+	bool IsRunning() const { return bIsRunning; }
+
+	/**
+	 * @brief Returns the number of completed cycles.
+	 */
+	int32 GetNumCompletedCycles() const { return NumCompletedCycles; }
+
+	/**
+	 * @brief Returns the number of completed cycles in which every step ran and succeeded.
+	 */
+	int32 GetNumFullCycles() const { return NumFullCycles; }
+
+	/**
+	 * @brief Delegate triggered once the run passed, failed or was aborted.
+	 */
+	FDustLinkOnSoakComplete OnComplete;
+
+private:
+	/**
+	 * @brief Steps of one session lifecycle, in order.
+	 */
+	enum class EStep : uint8
+	{
+		Create,
+		Start,
+		Find,
+		Destroy,
+		Join,
+		LeaveJoined,
+		Done
+	};
+
+	/** Number of steps in a cycle. */
+	static constexpr int32 NumSteps { static_cast<int32>(EStep::Done) };
+
+	/**
+	 * @brief Issues a step on the next tick, so completions never re-enter the subsystem from its own broadcast.
+	 *
+	 * @param Step The step to issue.
+	 */
+	void ScheduleStep(const EStep Step);
+
+	/**
+	 * @brief Issues a step now.
+	 *
+	 * @param Step The step to issue.
+	 */
+	void RunStep(const EStep Step);
+
+	/**
+	 * @brief Completes the current step and moves on to the next one.
+	 *
+	 * @param Step The step that completed, ignored if it is not the current one.
+	 * @param bWasSuccessful Whether the step succeeded.
+	 */
+	void CompleteStep(const EStep Step, const bool bWasSuccessful);
+
+	/**
+	 * @brief Finishes a cycle, samples resource usage when due and starts the next cycle or ends the run.
+	 */
+	void CompleteCycle();
+
+	/**
+	 * @brief Sets up a fresh menu with its travel stubbed out, if a menu class is loaded and a player controller exists.
+	 */
+	void SetupMenu();
+
+	/**
+	 * @brief Tears down and releases the menu of the current cycle.
+	 */
+	void TearDownMenu();
+
+	/**
+	 * @brief Collects garbage and measures resource usage.
+	 */
+	FDustLinkSoakSample TakeSample();
+
+	/**
+	 * @brief Compares the samples against the baseline and ends the run.
+	 */
+	void Finish();
+
+	/**
+	 * @brief Ends the run and reports its outcome.
+	 *
+	 * @param bPassed Whether the run passed.
+	 * @param Verdict Why the run passed or failed.
+	 */
+	void End(const bool bPassed, const FString& Verdict);
+
+	/**
+	 * @brief Ticker callback that aborts the run if the current step stalled.
+	 */
+	bool CheckStepTimeout(float DeltaTime);
+
+	/**
+	 * @brief Returns the name of a step, for the report.
+	 */
+	static const TCHAR* GetStepName(const EStep Step);
+
+	/** Subsystem whose session lifecycle is exercised. */
+	TWeakObjectPtr<UDustLinkSubsystem> Subsystem;
+
+	/** Length and tolerances of the run. */
+	FDustLinkSoakSettings Settings;
+
+	/** Step waiting for its completion. */
+	EStep CurrentStep { EStep::Done };
+
+	/** Time the current step was issued. */
+	double StepStartTime { 0.0 };
+
+	/** Time the current cycle started. */
+	double CycleStartTime { 0.0 };
+
+	/** Search result joined by the current cycle. */
+	TOptional<FOnlineSessionSearchResult> JoinCandidate;
+
+	/** Cycle times since the previous sample. */
+	FDustLinkLatencyHistogram CycleTimes;
+
+	/** Latencies of each step since the previous sample. */
+	FDustLinkLatencyHistogram StepTimes[NumSteps];
+
+	/** Menu whose buttons the current cycle clicks, kept alive by the run until the cycle ends. */
+	TStrongObjectPtr<UDustLinkMenu> Menu;
+
+	/** Samples taken so far, the first one is the baseline. */
+	TArray<FDustLinkSoakSample> Samples;
+
+	/** Number of completed cycles. */
+	int32 NumCompletedCycles { 0 };
+
+	/** Number of steps that reported a failure. */
+	int32 NumFailedSteps { 0 };
+
+	/** Number of steps of the current cycle that succeeded. */
+	int32 NumSucceededCycleSteps { 0 };
+
+	/** Number of cycles in which every step ran and succeeded. */
+	int32 NumFullCycles { 0 };
+
+	/** Number of cycles that reached the join step. */
+	int32 NumJoinedCycles { 0 };
+
+	/** Largest number of online delegate handles held at the end of a cycle. */
+	int32 MaxLeakedOnlineHandles { 0 };
+
+	/** Whether the run is in progress. */
+	bool bIsRunning { false };
+
+	/** Handle of the stall check on the core ticker. */
+	FTSTicker::FDelegateHandle TimeoutTickerHandle;
+};
@@ -0,0 +1,50 @@
+// Copyright Dustbyte Software. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+
+/**
+ * @class FDustLinkSubscription
+ * @brief Move-only handle that unbinds a delegate subscription when it is destroyed or reset.
+ *
+ * Returned by `UDustLinkSubsystem::Subscribe` and `UDustLinkSubsystem::SubscribeDynamic`. Subscribers keep
+ * their handles as members so the bindings go away together with the subscriber, no matter how often
+ * it subscribes.
+ */
+class DUSTLINK_API FDustLinkSubscription
+{
+public:
+	FDustLinkSubscription() = default;
+
+	/**
+	 * @brief Constructs an active subscription.
+	 *
+	 * @param InUnsubscribe Removes the binding, called at most once.
+	 */
+	explicit FDustLinkSubscription(TFunction<void()>&& InUnsubscribe): Unsubscribe(MoveTemp(InUnsubscribe)) {}
+
+	FDustLinkSubscription(FDustLinkSubscription&& Other) noexcept: Unsubscribe(MoveTemp(Other.Unsubscribe)) { Other.Unsubscribe = nullptr; }
+
+	FDustLinkSubscription& operator=(FDustLinkSubscription&& Other) noexcept;
+
+	FDustLinkSubscription(const FDustLinkSubscription&) = delete;
+	FDustLinkSubscription& operator=(const FDustLinkSubscription&) = delete;
+
+	~FDustLinkSubscription() { Reset(); }
+
+	/**
+	 * @brief Removes the binding now, if it is still active.
+	 */
+	void Reset();
+
+	/**
+	 * @brief Returns `true` while the subscription holds a binding.
+	 */
+	bool IsActive() const { return static_cast<bool>(Unsubscribe); }
+
+private:
+	/** Removes the binding, unset once the subscription is inactive. */
+	TFunction<void()> Unsubscribe;
+};
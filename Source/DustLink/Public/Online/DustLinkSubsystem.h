@@ -7,28 +7,94 @@
 #include "CoreMinimal.h"
 #include "OnlineSubsystem.h"
 #include "Subsystems/GameInstanceSubsystem.h"
+#include "UObject/ObjectKey.h"
 #include "Interfaces/OnlineSessionInterface.h"
+#include "DustLinkAdmissionController.h"
+#include "DustLinkAnalytics.h"
+#include "DustLinkFriendSessionFinder.h"
+#include "DustLinkListingProvider.h"
+#include "DustLinkListingServer.h"
+#include "DustLinkLoadMonitor.h"
+#include "DustLinkMetrics.h"
+#include "DustLinkMetricsServer.h"
+#include "DustLinkNetworkProfile.h"
+#include "DustLinkSloWatchdog.h"
+#include "DustLinkSoakTest.h"
+#include "DustLinkPingScheduler.h"
+#include "DustLinkRefreshPolicy.h"
+#include "DustLinkSessionDiff.h"
+#include "DustLinkSubscription.h"
+#include "DustLink/Public/Fleet/DustLinkServerControl.h"
+#include "DustLink/Public/Lobby/DustLinkContentWarmup.h"
+#include "DustLink/Public/Travel/DustLinkTravelMemoryScheduler.h"
 
 #include "DustLinkSubsystem.generated.h"
 
+class AGameModeBase;
+class UPendingNetGame;
+struct FUniqueNetIdRepl;
+
+
 /**
  * Notifies subscribers about the result of the session creation process.
  * @param bWasSuccessful Indicates whether the session creation was successful.
  */
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FDustLinkOnCreateSessionComplete, const bool, bWasSuccessful);
 
+/**
+ * Native counterpart of `FDustLinkOnCreateSessionComplete` for C++ subscribers, broadcast without reflection.
+ * @param bWasSuccessful Indicates whether the operation was successful.
+ */
+DECLARE_MULTICAST_DELEGATE_OneParam(FDustLinkOnCreateSessionCompleteNative, const bool bWasSuccessful);
+
 /**
  * Notifies subscribers about the result of the session destruction process.
  * @param bWasSuccessful Indicates whether the session was successfully destroyed.
  */
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FDustLinkOnDestroySessionComplete, const bool, bWasSuccessful);
 
+/**
+ * Native counterpart of `FDustLinkOnDestroySessionComplete` for C++ subscribers, broadcast without reflection.
+ * @param bWasSuccessful Indicates whether the operation was successful.
+ */
+DECLARE_MULTICAST_DELEGATE_OneParam(FDustLinkOnDestroySessionCompleteNative, const bool bWasSuccessful);
+
 /**
  * Notifies subscribers about the result of the session start process.
  * @param bWasSuccessful Indicates whether the session was successfully started.
  */
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FDustLinkOnStartSessionComplete, const bool, bWasSuccessful);
 
+/**
+ * Native counterpart of `FDustLinkOnStartSessionComplete` for C++ subscribers, broadcast without reflection.
+ * @param bWasSuccessful Indicates whether the operation was successful.
+ */
+DECLARE_MULTICAST_DELEGATE_OneParam(FDustLinkOnStartSessionCompleteNative, const bool bWasSuccessful);
+
+/**
+ * Notifies subscribers about the result of the session end process.
+ * @param bWasSuccessful Indicates whether the session was successfully ended.
+ */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FDustLinkOnEndSessionComplete, const bool, bWasSuccessful);
+
+/**
+ * Native counterpart of `FDustLinkOnEndSessionComplete` for C++ subscribers, broadcast without reflection.
+ * @param bWasSuccessful Indicates whether the operation was successful.
+ */
+DECLARE_MULTICAST_DELEGATE_OneParam(FDustLinkOnEndSessionCompleteNative, const bool bWasSuccessful);
+
+/**
+ * Notifies subscribers about the result of the session update process.
+ * @param bWasSuccessful Indicates whether the session settings were successfully updated.
+ */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FDustLinkOnUpdateSessionComplete, const bool, bWasSuccessful);
+
+/**
+ * Native counterpart of `FDustLinkOnUpdateSessionComplete` for C++ subscribers, broadcast without reflection.
+ * @param bWasSuccessful Indicates whether the operation was successful.
+ */
+DECLARE_MULTICAST_DELEGATE_OneParam(FDustLinkOnUpdateSessionCompleteNative, const bool bWasSuccessful);
+
 /**
  * Notifies subscribers about the result of the session search process and provides
  * a list of found session results.
@@ -43,6 +109,40 @@ DECLARE_MULTICAST_DELEGATE_TwoParams(FDustLinkOnFindSessionsComplete, const TArr
  */
 DECLARE_MULTICAST_DELEGATE_OneParam(FDustLinkOnJoinSessionComplete, const EOnJoinSessionCompleteResult::Type Result);
 
+/**
+ * Notifies subscribers about the sessions that were added, removed or changed since the previous search.
+ * @param Diff The difference between the previous and the new session result stores.
+ */
+DECLARE_MULTICAST_DELEGATE_OneParam(FDustLinkOnSessionListChanged, const FDustLinkSessionDiff& Diff);
+
+/**
+ * Notifies subscribers about a fresh ping measurement of a session from the result store.
+ * @param SessionId The identifier of the probed session.
+ * @param PingInMs The measured round trip time in milliseconds.
+ */
+DECLARE_MULTICAST_DELEGATE_TwoParams(FDustLinkOnSessionPingUpdated, const FString& SessionId, const int32 PingInMs);
+
+/**
+ * Notifies subscribers about the registration of the hosted session's join code with the listing provider.
+ * @param JoinCode The short code players can enter to join the hosted session.
+ * @param bWasSuccessful Indicates whether the listing provider accepted the code.
+ */
+DECLARE_MULTICAST_DELEGATE_TwoParams(FDustLinkOnJoinCodeRegistered, const FString& JoinCode, const bool bWasSuccessful);
+
+/**
+ * Notifies subscribers about the result of resolving a join code or a direct address to connect info.
+ * @param ConnectInfo The address to travel to, empty if it could not be resolved.
+ * @param bWasSuccessful Indicates whether the connect info was resolved.
+ */
+DECLARE_MULTICAST_DELEGATE_TwoParams(FDustLinkOnConnectInfoResolved, const FString& ConnectInfo, const bool bWasSuccessful);
+
+/**
+ * Notifies subscribers about the sessions of the local player's friends.
+ * @param SessionResults An array of `FOnlineSessionSearchResult` containing the sessions friends are in.
+ * @param bWasSuccessful Indicates whether the friends list could be read.
+ */
+DECLARE_MULTICAST_DELEGATE_TwoParams(FDustLinkOnFindFriendSessionsComplete, const TArray<FOnlineSessionSearchResult>& SessionResults, const bool bWasSuccessful);
+
 
 /**
  * @class UDustLinkSubsystem
@@ -69,11 +169,37 @@ public:
 	 * or variables before the subsystem is fully initialized by the game instance.
 	 */
 	UDustLinkSubsystem();
+
+	/**
+	 * @brief Sets up optional services requested on the command line.
+	 *
+	 * `-DustLinkListingUrl=<Url>` selects the HTTP listing provider used for join codes and
+	 * `-DustLinkListingServerPort=<Port>` starts the local master server stand-in in this process.
+	 * `-DustLinkMockPresence[=<File>]` replaces the online presence provider with `FDustLinkMockPresenceProvider`, seeded from the file.
+	 * `-DustLinkControlPort=<Port>` opens the control channel a fleet agent uses to hand this dedicated server a match.
+	 * `-DustLinkMetricsPort=<Port>` serves the session metrics to local monitoring agents.
+	 * `-DustLinkSloTrace` lets the SLO watchdog write the tail of the Unreal Insights trace on a breach.
+	 * `-DustLinkAnalyticsFile` exports session funnel events to `FDustLinkFileAnalyticsProvider`.
+	 * `-DustLinkNetProfile=<Name>` emulates one of the built-in `FDustLinkNetworkProfile` link conditions, except in shipping builds.
+	 * `-DustLinkSoak=<Cycles>` runs a soak test once the world begins play and exits with its outcome.
+	 *
+	 * @param Collection The subsystem collection the subsystem is initialized in.
+	 */
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	/**
+	 * @brief Releases timers and bindings owned by the subsystem.
+	 *
+	 * Called by the game instance when the subsystem is about to be destroyed.
+	 */
+	virtual void Deinitialize() override;
 	
 	/**
 	 * @brief Creates a new online session.
 	 * 
 	 * This method initializes a new session with the specified number of public connections and match type.
+	 * If the local player already hosts a session that is not in progress, its settings are updated
+	 * instead of destroying and recreating it.
 	 * 
 	 * @param NumPublicConnections The number of available slots for players in the session.
 	 * @param MatchType A string identifier for the type of match (e.g., "Deathmatch", "Coop").
@@ -124,232 +250,1326 @@ public:
 	void StartSession();
 
 	/**
-	 * @brief Delegate triggered when session creation is complete.
+	 * @brief Ends the current session without destroying it.
 	 *
-	 * This delegate is called to notify subscribers about the result of the session creation process.
-	 * It encapsulates custom logic for handling session creation success or failure within the DustLink subsystem.
+	 * Marks the match as over while keeping the backend session, so it can be started again
+	 * for the next match.
 	 */
-	FDustLinkOnCreateSessionComplete DustLinkOnCreateSessionComplete;
+	void EndSession();
 
-	
 	/**
-	 * @brief Delegate triggered when the session search is complete.
+	 * @brief Pushes the settings stored in `LastSessionSettings` to the current session.
+	 */
+	void UpdateSession();
+
+	/**
+	 * @brief Ends the current match and brings the party back to the lobby, keeping the same backend session.
 	 *
-	 * This delegate notifies subscribers about the result of a session search, providing
-	 * the found sessions and the success status. It is used to process and display available sessions.
+	 * Ends the session, re-opens it for joining through `UpdateSession` and travels to the lobby. Compared to
+	 * destroying and recreating the session this saves two backend round trips, and with seamless travel
+	 * enabled on the game mode the party stays connected. Call `StartSession` again when the next match begins.
+	 *
+	 * @param LobbyPath The path to the lobby level, e.g. "/Game/ThirdPerson/Maps/Lobby".
 	 */
-	FDustLinkOnFindSessionsComplete DustLinkOnFindSessionsComplete;
+	void ReturnToLobby(const FString& LobbyPath);
 
 	/**
-	 * @brief Delegate triggered when joining a session is complete.
+	 * @brief Advertises the map of the next match in the session settings.
 	 *
-	 * This delegate notifies subscribers about the result of an attempt to join a session.
-	 * It provides the session name and the result status, indicating success or failure.
+	 * Lobbies read it to travel to the match and to preload its content during the countdown.
+	 * If a session is already hosted, its settings are updated.
+	 *
+	 * @param MapPath The path to the match level, e.g. "/Game/ThirdPerson/Maps/ThirdPerson".
 	 */
-	FDustLinkOnJoinSessionComplete DustLinkOnJoinSessionComplete;
+	void SetMatchMap(const FString& MapPath);
 
 	/**
-	 * @brief Delegate triggered when session destruction is complete.
+	 * @brief Marks whether the player idles in a menu or lobby, where garbage is collected on a timer.
 	 *
-	 * This delegate notifies subscribers about the result of a session destruction process.
-	 * It provides the session name and success status, allowing for post-destruction cleanup or logging.
+	 * Menus and lobbies set it when they open, it is cleared on join, on session start and whenever a map starts loading.
+	 *
+	 * @param bIsIdle Whether the player is idle.
 	 */
-	FDustLinkOnDestroySessionComplete DustLinkOnDestroySessionComplete;
+	void SetIdle(const bool bIsIdle);
 
 	/**
-	 * @brief Delegate triggered when starting a session is complete.
+	 * @brief Starts warming up the content of the next match, e.g. when the lobby countdown starts.
 	 *
-	 * This delegate notifies subscribers about the result of starting a session.
-	 * It provides the session name and success status, confirming whether the session is ready for gameplay.
+	 * The warmup outlives the lobby world, so the preloaded map stays resident through travel
+	 * and is only released once the next map finished loading.
+	 *
+	 * @param MapPath The path to the match level, optionally followed by URL options.
 	 */
-	FDustLinkOnStartSessionComplete DustLinkOnStartSessionComplete;
-	
-protected:
+	void BeginContentWarmup(const FString& MapPath);
+
 	/**
-	 * @brief Initializes the OnlineSessionInterface.
+	 * @brief Stops warming up and releases the preloaded match content, e.g. when the countdown was cancelled.
+	 */
+	void CancelContentWarmup();
+
+	/**
+	 * @brief Looks up a session from the most recent search by its identifier.
 	 *
-	 * This function retrieves the world context and attempts to initialize the OnlineSubsystem session interface.
-	 * Logs warnings if any steps fail.
+	 * Intended for widgets that patch individual rows in response to `DustLinkOnSessionListChanged`.
+	 *
+	 * @param SessionId The identifier reported by the session list diff.
+	 * @return The stored search result, or `nullptr` if the session is not part of the current result store.
 	 */
-	void InitializeOnlineSessionInterface();
+	const FOnlineSessionSearchResult* FindSessionResult(const FString& SessionId) const;
 
 	/**
-	 * @brief Callback for when session creation is complete.
+	 * @brief Returns the most recent ping of a session from the result store.
 	 *
-	 * This method is triggered by the `FOnCreateSessionCompleteDelegate` when the session creation process finishes.
-	 * 
-	 * @param SessionName The name of the session that was created.
-	 * @param bWasSuccessful Whether the session creation was successful.
+	 * @param SessionId The identifier reported by the session list diff.
+	 * @return The latest probe of the session if it was probed, otherwise the ping reported by the search, or `-1` if unknown.
 	 */
-	void OnCreateSessionComplete(FName SessionName, const bool bWasSuccessful);
+	int32 GetSessionPing(const FString& SessionId) const;
 
 	/**
-	 * @brief Callback for when session search is complete.
+	 * @brief Returns the identifiers of the current result store in the order reported by the online subsystem.
+	 */
+	const TArray<FString>& GetSessionResultOrder() const { return SessionResultOrder; }
+
+	/**
+	 * @brief Enables the adaptive background refresh of the server list.
 	 *
-	 * This method is triggered by the `FOnFindSessionsCompleteDelegate` when the session search process finishes.
-	 * 
-	 * @param bWasSuccessful Whether the session search was successful.
+	 * Re-queries sessions on an interval computed by `FDustLinkRefreshPolicy` from the churn seen in recent
+	 * diffs. The interval backs off while the list is stable or the window is unfocused and shrinks while
+	 * sessions are turning over. Results are delivered through the regular search delegates.
+	 *
+	 * @param MaxSearchResults The maximum number of results to retrieve on every refresh.
+	 * @param Settings Tuning parameters for the refresh interval.
 	 */
-	void OnFindSessionComplete(bool bWasSuccessful);
+	void StartAutoRefresh(const int32 MaxSearchResults, const FDustLinkRefreshPolicySettings& Settings = FDustLinkRefreshPolicySettings());
 
 	/**
-	 * @brief Callback for when joining a session is complete.
+	 * @brief Disables the adaptive background refresh of the server list.
+	 */
+	void StopAutoRefresh();
+
+	/**
+	 * @brief Returns `true` while the adaptive background refresh is enabled.
+	 */
+	bool IsAutoRefreshEnabled() const { return bAutoRefreshEnabled; }
+
+	/**
+	 * @brief Reports which server browser rows are currently visible.
 	 *
-	 * This method is triggered by the `FOnJoinSessionCompleteDelegate` when joining a session finishes.
-	 * 
-	 * @param SessionName The name of the session that was joined.
-	 * @param Result The result of the join operation, indicating success or the type of failure.
+	 * Only these sessions, plus a small lookahead following the last visible row, are re-probed on a
+	 * rolling schedule with limited concurrency. Passing an empty array stops probing.
+	 *
+	 * @param VisibleSessionIds The identifiers of the sessions displayed by the server browser.
 	 */
-	void OnJoinSessionComplete(FName SessionName, EOnJoinSessionCompleteResult::Type Result);
+	void SetVisibleSessions(const TArray<FString>& VisibleSessionIds);
 
 	/**
-	 * @brief Callback for when session destruction is complete.
+	 * @brief Replaces the tuning parameters used to re-probe visible sessions.
 	 *
-	 * This method is triggered by the `FOnDestroySessionCompleteDelegate` when the session destruction process finishes.
-	 * 
-	 * @param SessionName The name of the session that was destroyed.
-	 * @param bWasSuccessful Whether the session was successfully destroyed.
+	 * @param Settings The lookahead, concurrency and scheduling parameters to use.
 	 */
-	void OnDestroySessionComplete(FName SessionName, const bool bWasSuccessful);
+	void SetPingSettings(const FDustLinkPingSettings& Settings) { PingScheduler.SetSettings(Settings); }
 
 	/**
-	 * @brief Callback for when session start is complete.
+	 * @brief Returns the smoothed load of this host in percent, where 100 means tick time, CPU or bandwidth is at its budget.
 	 *
-	 * This method is triggered by the `FOnStartSessionCompleteDelegate` when the session start process finishes.
-	 * 
-	 * @param SessionName The name of the session that was started.
-	 * @param bWasSuccessful Whether the session was successfully started.
+	 * Only sampled while this machine hosts a session.
 	 */
-	void OnStartSessionComplete(FName SessionName, bool bWasSuccessful);
-	
-private:
+	int32 GetHostLoad() const { return LoadMonitor.GetLoad(); }
+
 	/**
-	 * @brief Weak pointer to the OnlineSession interface.
+	 * @brief Replaces the tuning parameters used to measure, advertise and rank host load.
 	 *
-	 * This pointer provides access to session management functionality from
-	 * the OnlineSubsystem.
+	 * @param Settings The budgets, smoothing and advertisement parameters to use.
 	 */
-	IOnlineSessionPtr OnlineSessionInterface;
+	void SetLoadSettings(const FDustLinkLoadSettings& Settings) { LoadMonitor = FDustLinkLoadMonitor(Settings); }
 
 	/**
-	 * @brief Stores the settings of the most recently created or joined session.
+	 * @brief Orders search results by preference, lowest ping first with lightly loaded hosts ahead of overloaded ones.
 	 *
-	 * This shared pointer holds the configuration details for the last active session.
-	 * It includes information such as the number of public connections, session type,
-	 * and custom settings. The pointer ensures the data remains valid as long as it is referenced.
+	 * @param SessionResults The search results to sort in place.
+	 */
+	void RankSessions(TArray<FOnlineSessionSearchResult>& SessionResults) const { FDustLinkLoadMonitor::RankSessions(SessionResults, LoadMonitor.GetSettings()); }
+
+	/**
+	 * @brief Returns `true` while this host accepts new players.
 	 *
-	 * Usage:
-	 * - Use this field to retain session settings for future references, such as rejoining
-	 *   or recreating a session with the same configuration.
-	 * - Ensure the pointer is properly set when creating or joining a session.
+	 * A host whose tick time exceeds its budget stops advertising its session and closes until it recovered.
 	 */
-	TSharedPtr<FOnlineSessionSettings> LastSessionSettings;
+	bool IsAdmittingPlayers() const { return AdmissionController.IsAdmitting(); }
 
 	/**
-	 * @brief Stores the results of the most recent session search.
+	 * @brief Checks whether a connecting player may join, called for the pre-login of every game mode.
 	 *
-	 * This shared pointer contains the details of all sessions found during the last search operation.
-	 * It includes session metadata, player counts, and any custom search criteria.
+	 * Players are refused while the host is over its tick budget and, on servers that were handed a
+	 * match with a player list, unless they present the admission token the allocator issued for them.
+	 * A token admits its player once and is consumed by the admission. Matches without tokens admit the
+	 * listed players by unique net ID.
+	 *
+	 * @param Options The URL options of the connecting player, which may carry `DustLinkPlayer=<Id>?DustLinkToken=<Token>`.
+	 * @param UniqueId The unique net ID of the connecting player.
+	 * @param OutErrorMessage Set to the reason the player is refused.
+	 * @return `true` if the player may join.
 	 */
-	TSharedPtr<FOnlineSessionSearch> LastSessionSearch;
-	
+	bool CanAdmitPlayer(const FString& Options, const FUniqueNetIdRepl& UniqueId, FString& OutErrorMessage);
+
 	/**
-	 * @brief Delegate triggered when a session creation process is complete.
+	 * @brief Replaces the tuning parameters used to close and reopen a struggling host.
 	 *
-	 * Bound to the OnlineSubsystem's `FOnCreateSessionCompleteDelegate` to notify success or failure.
+	 * @param Settings The thresholds to use.
 	 */
-	FOnCreateSessionCompleteDelegate CreateSessionCompleteDelegate;
+	void SetAdmissionSettings(const FDustLinkAdmissionSettings& Settings) { AdmissionController = FDustLinkAdmissionController(Settings); }
 
 	/**
-	 * @brief Delegate triggered when a session search is complete.
+	 * @brief Returns the session operation counters, latencies and gauges of this process.
 	 *
-	 * Bound to the OnlineSubsystem's `FOnFindSessionsCompleteDelegate` to process session search results.
+	 * Gauges are only refreshed by `CollectMetrics`, which the metrics endpoint calls before serving them.
 	 */
-	FOnFindSessionsCompleteDelegate FindSessionsCompleteDelegate;
+	const FDustLinkMetrics& GetMetrics() const { return *Metrics; }
 
 	/**
-	 * @brief Delegate triggered when joining a session is complete.
+	 * @brief Forgets the recorded latencies of all session operations and phases, e.g. before a benchmark run.
+	 */
+	void ResetLatencies() { Metrics->ResetLatencies(); }
+
+	/**
+	 * @brief Stops or resumes recording metrics, SLO checks, benchmark latencies and funnel events, e.g. during a soak run.
 	 *
-	 * Bound to the OnlineSubsystem's `FOnJoinSessionCompleteDelegate` to handle success or failure.
+	 * @param bSuspended Whether recording stops.
 	 */
-	FOnJoinSessionCompleteDelegate JoinSessionCompleteDelegate;
+	void SetTelemetrySuspended(const bool bSuspended) { Metrics->SetSuspended(bSuspended); }
 
 	/**
-	 * @brief Delegate triggered when a session destruction process is complete.
+	 * @brief Replaces the latency objectives watched by the SLO watchdog and its capture parameters.
 	 *
-	 * Bound to the OnlineSubsystem's `FOnDestroySessionCompleteDelegate` to clean up resources.
+	 * @param Settings The objectives and capture parameters to use.
 	 */
-	FOnDestroySessionCompleteDelegate DestroySessionCompleteDelegate;
+	void SetSloSettings(const FDustLinkSloSettings& Settings) { if (SloWatchdog) SloWatchdog->SetSettings(Settings); }
 
 	/**
-	 * @brief Delegate triggered when starting a session is complete.
+	 * @brief Samples player counts, admission state and queue depths into the gauges of the metrics.
+	 */
+	void CollectMetrics();
+
+	/**
+	 * @brief Replaces the analytics provider session funnel events are exported to.
 	 *
-	 * Bound to the OnlineSubsystem's `FOnStartSessionCompleteDelegate` to confirm the session is ready for gameplay.
+	 * Events buffered for the previous provider are flushed to it and its session is ended.
+	 *
+	 * @param Provider The provider to use, or `nullptr` to stop recording funnel events.
+	 * @param Settings The batching parameters to use.
 	 */
-	FOnStartSessionCompleteDelegate StartSessionCompleteDelegate;
+	void SetAnalyticsProvider(const TSharedPtr<IAnalyticsProvider>& Provider, const FDustLinkAnalyticsSettings& Settings = FDustLinkAnalyticsSettings());
 
 	/**
-	 * @brief Handle for the CreateSessionComplete delegate.
+	 * @brief Records a session funnel event if an analytics provider is set and telemetry is not suspended.
 	 *
-	 * Used to store and manage the binding of the `FOnCreateSessionCompleteDelegate` to the OnlineSubsystem.
-	 * Allows unbinding when the delegate is no longer needed.
+	 * Search, join, travel and arrival are recorded by the subsystem itself, menus record `MenuOpened`.
+	 *
+	 * @param Event The funnel stage that was reached.
+	 * @param bWasSuccessful Whether the stage succeeded.
+	 * @param Value A stage specific count.
 	 */
-	FDelegateHandle CreateSessionCompleteDelegateHandle;
+	void RecordFunnelEvent(const EDustLinkFunnelEvent Event, const bool bWasSuccessful = true, const int32 Value = 0);
 
 	/**
-	 * @brief Handle for the FindSessionsComplete delegate.
+	 * @brief Replaces the listing provider used to register and resolve join codes.
 	 *
-	 * Used to store and manage the binding of the `FOnFindSessionsCompleteDelegate` to the OnlineSubsystem.
-	 * Allows unbinding when the delegate is no longer needed.
+	 * @param Provider The provider to use, or `nullptr` to disable join codes.
 	 */
-	FDelegateHandle FindSessionsCompleteDelegateHandle;
+	void SetListingProvider(const TSharedPtr<IDustLinkListingProvider>& Provider) { ListingProvider = Provider; }
 
 	/**
-	 * @brief Handle for the JoinSessionComplete delegate.
+	 * @brief Returns the join code of the hosted session, empty if no session is hosted.
+	 */
+	const FString& GetJoinCode() const { return JoinCode; }
+
+	/**
+	 * @brief Resolves a join code straight to connect info, skipping the session search.
 	 *
-	 * Used to store and manage the binding of the `FOnJoinSessionCompleteDelegate` to the OnlineSubsystem.
-	 * Allows unbinding when the delegate is no longer needed.
+	 * The result is delivered through `DustLinkOnConnectInfoResolved`.
+	 *
+	 * @param Code The join code as entered by the player.
 	 */
-	FDelegateHandle JoinSessionCompleteDelegateHandle;
+	void JoinSessionByCode(const FString& Code);
 
 	/**
-	 * @brief Handle for the DestroySessionComplete delegate.
+	 * @brief Resolves a direct address entered by the player, skipping the session search.
 	 *
-	 * Used to store and manage the binding of the `FOnDestroySessionCompleteDelegate` to the OnlineSubsystem.
-	 * Allows unbinding when the delegate is no longer needed.
+	 * Host names are resolved asynchronously. The result is delivered through `DustLinkOnConnectInfoResolved`.
+	 *
+	 * @param Address A host name or IP address, optionally followed by ":<Port>".
 	 */
-	FDelegateHandle DestroySessionCompleteDelegateHandle;
+	void ConnectToAddress(const FString& Address);
 
 	/**
-	 * @brief Handle for the StartSessionComplete delegate.
+	 * @brief Creates a session for a match handed to this dedicated server and travels to its map.
 	 *
-	 * Used to store and manage the binding of the `FOnStartSessionCompleteDelegate` to the OnlineSubsystem.
-	 * Allows unbinding when the delegate is no longer needed.
+	 * Called by the control channel. The fleet agent receives the connect info once the session exists and the match map loaded.
+	 *
+	 * @param Config The match to host.
 	 */
-	FDelegateHandle StartSessionCompleteDelegateHandle;
+	void HostMatch(const FDustLinkMatchConfig& Config);
 
 	/**
-	 * @brief Flag indicating whether to create a new session after destroying the current one.
+	 * @brief Ends the match handed to this dedicated server and travels back to the map it idles on.
 	 *
-	 * This boolean determines if the system should automatically create a new session
-	 * when the current session is destroyed. Useful for scenarios like restarting a session
-	 * or transitioning to a new session seamlessly.
+	 * Called by the control channel when the fleet agent releases the server. The release is answered
+	 * once the session was destroyed and the idle map loaded.
 	 */
-	bool bCreateSessionOnDestroy { false };
+	void ReleaseMatch();
 
 	/**
-	 * @brief Stores the number of public connections for the last session.
+	 * @brief Discovers the sessions of the local player's friends without a global search.
 	 *
-	 * This field keeps track of the maximum number of players allowed (excluding the host)
-	 * in the last session. It is typically updated when creating or joining a session.
+	 * Only friends whose presence reports a joinable session are queried, directly and in parallel with
+	 * bounded concurrency. Answers are cached briefly. The result is delivered through
+	 * `DustLinkOnFindFriendSessionsComplete`.
+	 *
+	 * @param MaxConcurrentQueries The maximum number of friend session queries in flight.
+	 * @param CacheLifetime How long a friend's session stays cached, in seconds.
 	 */
-	int32 LastNumPublicConnections { 0 };
+	void FindFriendSessions(const int32 MaxConcurrentQueries = 8, const float CacheLifetime = 30.f);
 
 	/**
-	 * @brief Stores the match type for the last session.
+	 * @brief Replaces the source of friends and their sessions, e.g. with `FDustLinkMockPresenceProvider` in local tests.
 	 *
-	 * This string contains the identifier for the type of match (e.g., "Deathmatch", "Coop")
-	 * for the most recently created or joined session.
+	 * @param Provider The provider to query.
 	 */
-	FString LastMatchType { TEXT("") };
+	void SetPresenceProvider(const TSharedPtr<IDustLinkPresenceProvider>& Provider);
+
+	/**
+	 * @brief Returns the mock presence backend, installing an empty one as the provider if another is in use.
+	 *
+	 * Cached friend sessions are dropped, as the caller is about to change the fake friends.
+	 */
+	TSharedRef<FDustLinkMockPresenceProvider> UseMockPresenceProvider();
+
+	/**
+	 * @brief Emulates the link conditions of a built-in network profile.
+	 *
+	 * The profile is applied to the net driver of the current world, to the net drivers of later joins and
+	 * travel, to the completions of session searches and joins, and to the mock presence backend. Phase
+	 * latencies from now on are recorded for `GetNetworkProfileReport` under this profile, apart from the
+	 * histograms of `GetMetrics`.
+	 *
+	 * @param ProfileName The name of the profile, e.g. `Loopback`, `Broadband` or `Mobile`.
+	 * @return `true` if a profile with this name exists, always `false` in shipping builds.
+	 */
+	bool SetNetworkProfile(const FString& ProfileName);
+
+	/**
+	 * @brief Returns the link conditions currently emulated.
+	 */
+	const FDustLinkNetworkProfile& GetNetworkProfile() const { return NetworkProfile; }
+
+	/**
+	 * @brief Starts a soak test cycling sessions and a menu through this subsystem, see `FDustLinkSoakTest`.
+	 *
+	 * @param Settings The length and tolerances of the run.
+	 * @return The run, or `nullptr` if one is already in progress.
+	 */
+	TSharedPtr<FDustLinkSoakTest> StartSoakTest(const FDustLinkSoakSettings& Settings = FDustLinkSoakSettings());
+
+	/**
+	 * @brief Returns the soak test in progress or last run, if any.
+	 */
+	TSharedPtr<FDustLinkSoakTest> GetSoakTest() const { return SoakTest; }
+
+	/**
+	 * @brief Returns the number of active subscriptions made through `Subscribe` and `SubscribeDynamic`.
+	 */
+	int32 GetNumSubscriptions() const { return NumSubscriptions; }
+
+	/**
+	 * @brief Returns the number of completion delegates still bound on the online session interface.
+	 *
+	 * Every operation clears its binding once it completes, so this is zero whenever no operation is in flight.
+	 */
+	int32 GetNumOnlineDelegateHandles() const;
+
+	/**
+	 * @brief Reports how the latency of every phase degraded under each profile run so far.
+	 *
+	 * Latencies recorded under the current profile are included. The first profile run is the baseline.
+	 */
+	FString GetNetworkProfileReport() const { return NetworkBenchmark.ToReport(); }
+
+	/**
+	 * @brief Forgets the phase latencies of every profile run so far, e.g. before a profile sweep.
+	 */
+	void ResetNetworkProfileReport() { NetworkBenchmark.Reset(); }
+
+	/**
+	 * @brief Binds an object's method to one of the subsystem's native delegates.
+	 *
+	 * The binding lives as long as the returned subscription. Binding the same method of the same object to
+	 * the same delegate twice is rejected, so repeated setup calls cannot stack up callbacks, while different
+	 * methods of one object may subscribe to the same delegate.
+	 *
+	 * @param Delegate One of the subsystem's native multicast delegates, e.g. `DustLinkOnFindSessionsComplete`.
+	 * @param Object The object to call back.
+	 * @param Method The method of `Object` to call.
+	 * @return The subscription, inactive if the method was already bound.
+	 */
+	template <typename DelegateType, typename UserClass, typename MethodType>
+	FDustLinkSubscription Subscribe(DelegateType& Delegate, UserClass* Object, MethodType Method)
+	{
+		// Native delegates cannot report their bound function, so the subsystem remembers what it bound
+		FSubscriptionKey Key { &Delegate, FObjectKey(Object) };
+		Key.Method.Append(reinterpret_cast<const uint8*>(&Method), sizeof(Method));
+
+		if (SubscriptionKeys.Contains(Key))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("%s: %s is already subscribed with this method, ignoring the duplicate."), *GetClass()->GetName(), *GetNameSafe(Object));
+			return FDustLinkSubscription();
+		}
+
+		const FDelegateHandle Handle = Delegate.AddUObject(Object, Method);
+		SubscriptionKeys.Add(Key);
+		++NumSubscriptions;
+
+		return FDustLinkSubscription([WeakThis = TWeakObjectPtr<UDustLinkSubsystem>(this), &Delegate, Handle, Key = MoveTemp(Key)]()
+		{
+			if (!WeakThis.IsValid()) return;
+
+			Delegate.Remove(Handle);
+			WeakThis->SubscriptionKeys.RemoveSingleSwap(Key);
+			--WeakThis->NumSubscriptions;
+		});
+	}
+
+	/**
+	 * @brief Binds a `UFUNCTION` to one of the subsystem's dynamic delegates.
+	 *
+	 * The binding lives as long as the returned subscription. Binding the same function twice is rejected.
+	 *
+	 * @param Delegate One of the subsystem's dynamic multicast delegates, e.g. `DustLinkOnCreateSessionComplete`.
+	 * @param Object The object to call back.
+	 * @param FunctionName The name of the `UFUNCTION` to call, e.g. from `GET_FUNCTION_NAME_CHECKED`.
+	 * @return The subscription, inactive if the function was already bound.
+	 */
+	template <typename DelegateType>
+	FDustLinkSubscription SubscribeDynamic(DelegateType& Delegate, UObject* Object, const FName FunctionName)
+	{
+		typename DelegateType::FDelegate Binding;
+		Binding.BindUFunction(Object, FunctionName);
+
+		if (Delegate.Contains(Binding))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("%s: %s::%s is already subscribed, ignoring the duplicate."), *GetClass()->GetName(), *GetNameSafe(Object), *FunctionName.ToString());
+			return FDustLinkSubscription();
+		}
+
+		Delegate.Add(Binding);
+		++NumSubscriptions;
+
+		return FDustLinkSubscription([WeakThis = TWeakObjectPtr<UDustLinkSubsystem>(this), &Delegate, WeakObject = TWeakObjectPtr<UObject>(Object), FunctionName]()
+		{
+			if (!WeakThis.IsValid()) return;
+
+			Delegate.Remove(WeakObject.Get(), FunctionName);
+			--WeakThis->NumSubscriptions;
+		});
+	}
+
+	/**
+	 * @brief Delegate triggered when session creation is complete.
+	 *
+	 * This delegate is called to notify subscribers about the result of the session creation process.
+	 * It encapsulates custom logic for handling session creation success or failure within the DustLink subsystem.
+	 */
+	FDustLinkOnCreateSessionComplete DustLinkOnCreateSessionComplete;
+
+	/**
+	 * @brief Native counterpart of `DustLinkOnCreateSessionComplete`, preferred by C++ subscribers.
+	 */
+	FDustLinkOnCreateSessionCompleteNative DustLinkOnCreateSessionCompleteNative;
+
+	
+	/**
+	 * @brief Delegate triggered when the session search is complete.
+	 *
+	 * This delegate notifies subscribers about the result of a session search, providing
+	 * the found sessions and the success status. It is used to process and display available sessions.
+	 */
+	FDustLinkOnFindSessionsComplete DustLinkOnFindSessionsComplete;
+
+	/**
+	 * @brief Delegate triggered when a background refresh of the server list is complete.
+	 *
+	 * Refreshes never broadcast `DustLinkOnFindSessionsComplete`, so subscribers that act on a player's
+	 * search, e.g. by joining its first result, are not triggered by a search the player did not start.
+	 */
+	FDustLinkOnFindSessionsComplete DustLinkOnSessionsRefreshed;
+
+	/**
+	 * @brief Delegate triggered when joining a session is complete.
+	 *
+	 * This delegate notifies subscribers about the result of an attempt to join a session.
+	 * It provides the session name and the result status, indicating success or failure.
+	 */
+	FDustLinkOnJoinSessionComplete DustLinkOnJoinSessionComplete;
+
+	/**
+	 * @brief Delegate triggered when session destruction is complete.
+	 *
+	 * This delegate notifies subscribers about the result of a session destruction process.
+	 * It provides the session name and success status, allowing for post-destruction cleanup or logging.
+	 */
+	FDustLinkOnDestroySessionComplete DustLinkOnDestroySessionComplete;
+
+	/**
+	 * @brief Native counterpart of `DustLinkOnDestroySessionComplete`, preferred by C++ subscribers.
+	 */
+	FDustLinkOnDestroySessionCompleteNative DustLinkOnDestroySessionCompleteNative;
+
+	/**
+	 * @brief Delegate triggered when starting a session is complete.
+	 *
+	 * This delegate notifies subscribers about the result of starting a session.
+	 * It provides the session name and success status, confirming whether the session is ready for gameplay.
+	 */
+	FDustLinkOnStartSessionComplete DustLinkOnStartSessionComplete;
+
+	/**
+	 * @brief Native counterpart of `DustLinkOnStartSessionComplete`, preferred by C++ subscribers.
+	 */
+	FDustLinkOnStartSessionCompleteNative DustLinkOnStartSessionCompleteNative;
+
+	/**
+	 * @brief Delegate triggered when ending a session is complete.
+	 *
+	 * This delegate notifies subscribers that the match is over while the backend session is kept.
+	 */
+	FDustLinkOnEndSessionComplete DustLinkOnEndSessionComplete;
+
+	/**
+	 * @brief Native counterpart of `DustLinkOnEndSessionComplete`, preferred by C++ subscribers.
+	 */
+	FDustLinkOnEndSessionCompleteNative DustLinkOnEndSessionCompleteNative;
+
+	/**
+	 * @brief Delegate triggered when updating the session settings is complete.
+	 *
+	 * This delegate notifies subscribers whether the backend accepted the new session settings.
+	 */
+	FDustLinkOnUpdateSessionComplete DustLinkOnUpdateSessionComplete;
+
+	/**
+	 * @brief Native counterpart of `DustLinkOnUpdateSessionComplete`, preferred by C++ subscribers.
+	 */
+	FDustLinkOnUpdateSessionCompleteNative DustLinkOnUpdateSessionCompleteNative;
+
+	/**
+	 * @brief Delegate triggered when a successful search changes the session result store.
+	 *
+	 * This delegate notifies subscribers about the sessions that were added, removed or changed since the
+	 * previous search, so browser widgets can patch only the affected rows instead of rebuilding their lists.
+	 * It is not broadcast when the new search produced exactly the same results.
+	 */
+	FDustLinkOnSessionListChanged DustLinkOnSessionListChanged;
+
+	/**
+	 * @brief Delegate triggered when a visible session was re-probed successfully.
+	 *
+	 * `GetSessionPing` returns the new value from the broadcast on, so browser widgets only need to refresh
+	 * the ping column of the affected row.
+	 */
+	FDustLinkOnSessionPingUpdated DustLinkOnSessionPingUpdated;
+
+	/**
+	 * @brief Delegate triggered when the hosted session's join code was registered with the listing provider.
+	 *
+	 * Hosts display the code so friends can join the private lobby without searching for it.
+	 */
+	FDustLinkOnJoinCodeRegistered DustLinkOnJoinCodeRegistered;
+
+	/**
+	 * @brief Delegate triggered when a join code or a direct address was resolved to connect info.
+	 *
+	 * Subscribers travel to the provided address to join the session.
+	 */
+	FDustLinkOnConnectInfoResolved DustLinkOnConnectInfoResolved;
+
+	/**
+	 * @brief Delegate triggered when friend-session discovery is complete.
+	 *
+	 * This delegate provides the sessions the local player's friends are in, ready to be joined
+	 * through `JoinSession`.
+	 */
+	FDustLinkOnFindFriendSessionsComplete DustLinkOnFindFriendSessionsComplete;
+
+	/**
+	 * @brief Delegate triggered right before a map is loaded by `ServerTravel` or `ClientTravel`.
+	 *
+	 * Menus tear themselves down here so their assets are freed by the purge of the map load
+	 * instead of lingering into the match.
+	 */
+	FDustLinkOnPreTravel DustLinkOnPreTravel;
+
+	/**
+	 * @brief Delegate triggered when a session operation breached its latency objective.
+	 *
+	 * A snapshot of the recent telemetry has been written to disk by then.
+	 */
+	FDustLinkOnSloBreached DustLinkOnSloBreached;
+	
+protected:
+	/**
+	 * @brief Broadcasts a session event to its native subscribers, then to its Blueprint subscribers.
+	 *
+	 * The dynamic broadcast is skipped when nothing is bound to it, so C++-only listeners never pay for reflection.
+	 *
+	 * @param NativeDelegate The native counterpart of the event.
+	 * @param DynamicDelegate The dynamic delegate of the event.
+	 * @param bWasSuccessful Whether the operation was successful.
+	 */
+	template <typename NativeDelegateType, typename DynamicDelegateType>
+	static void BroadcastSessionEvent(NativeDelegateType& NativeDelegate, DynamicDelegateType& DynamicDelegate, const bool bWasSuccessful)
+	{
+		NativeDelegate.Broadcast(bWasSuccessful);
+
+		if (DynamicDelegate.IsBound()) DynamicDelegate.Broadcast(bWasSuccessful);
+	}
+
+	/**
+	 * @brief Initializes the OnlineSessionInterface.
+	 *
+	 * This function retrieves the world context and attempts to initialize the OnlineSubsystem session interface.
+	 * Logs warnings if any steps fail.
+	 */
+	void InitializeOnlineSessionInterface();
+
+	/**
+	 * @brief Callback for when session creation is complete.
+	 *
+	 * This method is triggered by the `FOnCreateSessionCompleteDelegate` when the session creation process finishes.
+	 * 
+	 * @param SessionName The name of the session that was created.
+	 * @param bWasSuccessful Whether the session creation was successful.
+	 */
+	void OnCreateSessionComplete(FName SessionName, const bool bWasSuccessful);
+
+	/**
+	 * @brief Callback for when session search is complete.
+	 *
+	 * This method is triggered by the `FOnFindSessionsCompleteDelegate` when the session search process finishes.
+	 * 
+	 * @param bWasSuccessful Whether the session search was successful.
+	 */
+	void OnFindSessionComplete(bool bWasSuccessful);
+
+	/**
+	 * @brief Processes the results of a session search once they crossed the emulated network.
+	 *
+	 * @param bWasSuccessful Whether the session search was successful.
+	 */
+	void CompleteFindSessions(bool bWasSuccessful);
+
+	/**
+	 * @brief Callback for when joining a session is complete.
+	 *
+	 * This method is triggered by the `FOnJoinSessionCompleteDelegate` when joining a session finishes.
+	 * 
+	 * @param SessionName The name of the session that was joined.
+	 * @param Result The result of the join operation, indicating success or the type of failure.
+	 */
+	void OnJoinSessionComplete(FName SessionName, EOnJoinSessionCompleteResult::Type Result);
+
+	/**
+	 * @brief Processes the outcome of a join once it crossed the emulated network.
+	 *
+	 * @param SessionName The name of the session that was joined.
+	 * @param Result The result of the join operation, indicating success or the type of failure.
+	 */
+	void CompleteJoinSession(FName SessionName, EOnJoinSessionCompleteResult::Type Result);
+
+	/**
+	 * @brief Callback for when session destruction is complete.
+	 *
+	 * This method is triggered by the `FOnDestroySessionCompleteDelegate` when the session destruction process finishes.
+	 * 
+	 * @param SessionName The name of the session that was destroyed.
+	 * @param bWasSuccessful Whether the session was successfully destroyed.
+	 */
+	void OnDestroySessionComplete(FName SessionName, const bool bWasSuccessful);
+
+	/**
+	 * @brief Callback for when session start is complete.
+	 *
+	 * This method is triggered by the `FOnStartSessionCompleteDelegate` when the session start process finishes.
+	 * 
+	 * @param SessionName The name of the session that was started.
+	 * @param bWasSuccessful Whether the session was successfully started.
+	 */
+	void OnStartSessionComplete(FName SessionName, bool bWasSuccessful);
+
+	/**
+	 * @brief Callback for when session end is complete.
+	 *
+	 * This method is triggered by the `FOnEndSessionCompleteDelegate` when the session end process finishes.
+	 * 
+	 * @param SessionName The name of the session that was ended.
+	 * @param bWasSuccessful Whether the session was successfully ended.
+	 */
+	void OnEndSessionComplete(FName SessionName, bool bWasSuccessful);
+
+	/**
+	 * @brief Callback for when session update is complete.
+	 *
+	 * This method is triggered by the `FOnUpdateSessionCompleteDelegate` when the session update process finishes.
+	 * 
+	 * @param SessionName The name of the session that was updated.
+	 * @param bWasSuccessful Whether the session settings were successfully updated.
+	 */
+	void OnUpdateSessionComplete(FName SessionName, bool bWasSuccessful);
+
+	/**
+	 * @brief Replaces the session result store with the results of the most recent search.
+	 *
+	 * Computes the difference against the previous store and broadcasts it through `DustLinkOnSessionListChanged`.
+	 *
+	 * @param SearchResults The results of the most recent successful search.
+	 * @return The difference between the previous and the new result store.
+	 */
+	FDustLinkSessionDiff UpdateSessionResultStore(const TArray<FOnlineSessionSearchResult>& SearchResults);
+
+	/**
+	 * @brief Schedules the next background refresh based on the outcome of the last search.
+	 *
+	 * @param Churn Fraction of sessions that appeared or disappeared in the last search.
+	 */
+	void ScheduleAutoRefresh(const float Churn);
+
+	/**
+	 * @brief Ends the join phase and, once the player has somewhere to go, starts the travel phase.
+	 *
+	 * @param bWasSuccessful Whether the player obtained connect info.
+	 */
+	void OnJoinPhaseComplete(const bool bWasSuccessful);
+
+	/**
+	 * @brief Queries the online subsystem for sessions, shared by player searches and background refreshes.
+	 *
+	 * @param MaxSearchResults The maximum number of results to retrieve.
+	 * @param bIsBackgroundRefresh Whether the search is a background refresh rather than a player's search.
+	 */
+	void StartSessionSearch(const int32 MaxSearchResults, const bool bIsBackgroundRefresh);
+
+	/**
+	 * @brief Broadcasts the outcome of a search to the delegate matching its origin.
+	 *
+	 * @param SessionResults The found sessions.
+	 * @param bWasSuccessful Whether the search succeeded.
+	 */
+	void BroadcastSearchComplete(const TArray<FOnlineSessionSearchResult>& SessionResults, const bool bWasSuccessful);
+
+	/**
+	 * @brief Timer callback that issues a background refresh.
+	 *
+	 * Skips the refresh while a search is still in flight, that search's completion schedules the next one.
+	 */
+	void OnAutoRefreshTimer();
+
+	/**
+	 * @brief Returns `true` if the game window has focus or no window exists (e.g. dedicated servers).
+	 */
+	static bool IsApplicationFocused();
+
+	/**
+	 * @brief Timer callback that starts the probes that are due on the rolling ping schedule.
+	 */
+	void OnPingTimer();
+
+	/**
+	 * @brief Callback for when a ping probe of a session finishes.
+	 *
+	 * @param SessionId The identifier of the probed session.
+	 * @param bWasSuccessful Whether the probe received a reply.
+	 * @param bIsUnpingable Whether the address of the session cannot be probed at all.
+	 * @param PingInMs The measured round trip time in milliseconds.
+	 */
+	void OnPingProbeComplete(const FString& SessionId, const bool bWasSuccessful, const bool bIsUnpingable, const int32 PingInMs);
+
+	/**
+	 * @brief Applies `CanAdmitPlayer` to the pre-login of any game mode of this game instance.
+	 *
+	 * The URL options of the player are read from its pending connection, as the event does not carry them.
+	 *
+	 * @param GameMode The game mode the player logs in to.
+	 * @param UniqueId The unique net ID of the connecting player.
+	 * @param ErrorMessage Set to the reason the player is refused.
+	 */
+	void OnGameModePreLogin(AGameModeBase* GameMode, const FUniqueNetIdRepl& UniqueId, FString& ErrorMessage);
+
+	/**
+	 * @brief Answers the control channel once the match was torn down: its session destroyed and the idle map loaded.
+	 */
+	void CompleteReleaseIfDone();
+
+	/**
+	 * @brief Travels to the map of a handed over match once its session was created, and answers the control
+	 * channel right away if there is nothing to travel to.
+	 *
+	 * Otherwise the answer is sent once the match map finished loading.
+	 *
+	 * @param bWasSuccessful Whether the session was created.
+	 */
+	void OnHostedMatchCreated(const bool bWasSuccessful);
+
+	/**
+	 * @brief Starts sampling the load of this host, called once it hosts a session.
+	 */
+	void StartLoadMonitor();
+
+	/**
+	 * @brief Stops sampling the load of this host.
+	 */
+	void StopLoadMonitor();
+
+	/**
+	 * @brief Ticker callback that accumulates the tick time and CPU usage of every frame towards the next load sample.
+	 *
+	 * @param DeltaTime Time since the last frame, in seconds.
+	 * @return Always `true` to keep ticking.
+	 */
+	bool OnLoadFrameTick(float DeltaTime);
+
+	/**
+	 * @brief Timer callback that samples the frames since the last sample and bandwidth usage, and advertises the load when it moved.
+	 */
+	void OnLoadSampleTimer();
+
+	/**
+	 * @brief Records finished phases for the network benchmark and translates phase events into session funnel events.
+	 *
+	 * @param Event The recorded telemetry event.
+	 */
+	void OnTelemetryEvent(const FDustLinkTelemetryEvent& Event);
+
+	/**
+	 * @brief Timer callback that exports the buffered funnel events.
+	 */
+	void OnAnalyticsFlushTimer();
+
+	/**
+	 * @brief Applies the emulated link conditions to the current net driver and the mock backend.
+	 */
+	void ApplyNetworkProfile();
+
+	/**
+	 * @brief Applies the emulated link conditions to one net driver, remembering the conditions the user gave it.
+	 *
+	 * @param NetDriver The net driver to configure.
+	 */
+	void ApplyNetworkProfileToNetDriver(UNetDriver* NetDriver);
+
+	/**
+	 * @brief Callback for every connection a pending join opens, applies the emulated link conditions to it.
+	 *
+	 * @param PendingNetGame The pending join that created its net driver.
+	 */
+	void OnPendingNetGameConnectionCreated(UPendingNetGame* PendingNetGame);
+
+	/**
+	 * @brief Runs a completion after the lag and transfer time of the emulated network profile.
+	 *
+	 * Runs the completion right away if the profile does not change the link, and always in shipping builds.
+	 *
+	 * @param PayloadBytes Approximate size of the answer's entries on the wire.
+	 * @param bCanBeLost Whether the answer may be lost with the profile's loss probability.
+	 * @param Completion The completion, told whether the answer arrived.
+	 */
+	void DelayThroughNetworkProfile(const int32 PayloadBytes, const bool bCanBeLost, TFunction<void(bool)>&& Completion);
+
+	/**
+	 * @brief Publishes the current load in the `HostLoad` setting of the hosted session and hides
+	 * the session from searches while the host does not admit players.
+	 *
+	 * Skipped while another session update is in flight, the next sample retries.
+	 */
+	void AdvertiseLoad();
+
+	/**
+	 * @brief Registers the hosted session's join code and connect info with the listing provider.
+	 *
+	 * A code already held by another host is replaced by a freshly generated one, up to `MaxAttempts` times.
+	 *
+	 * @param Attempt The number of this attempt, starting at 1.
+	 */
+	void RegisterJoinCode(const int32 Attempt = 1);
+
+	/**
+	 * @brief Removes the hosted session's join code from the listing provider.
+	 */
+	void UnregisterJoinCode();
+
+	/**
+	 * @brief Callback for when the local user accepted a platform session invite.
+	 *
+	 * This method is triggered by the `FOnSessionUserInviteAcceptedDelegate`. It joins straight from the
+	 * invite's search result, leaving the current session first if needed.
+	 * Leaving for the invite does not broadcast the destroy delegates, so the menu does not travel away.
+	 *
+	 * @param bWasSuccessful Whether the invite could be accepted.
+	 * @param ControllerId The controller of the local user who accepted the invite.
+	 * @param UserId The local user who accepted the invite.
+	 * @param InviteResult The session the user was invited to.
+	 */
+	void OnSessionUserInviteAccepted(const bool bWasSuccessful, const int32 ControllerId, FUniqueNetIdPtr UserId, const FOnlineSessionSearchResult& InviteResult);
+	
+private:
+	/**
+	 * @brief Weak pointer to the OnlineSession interface.
+	 *
+	 * This pointer provides access to session management functionality from
+	 * the OnlineSubsystem.
+	 */
+	IOnlineSessionPtr OnlineSessionInterface;
+
+	/**
+	 * @brief Stores the settings of the most recently created or joined session.
+	 *
+	 * This shared pointer holds the configuration details for the last active session.
+	 * It includes information such as the number of public connections, session type,
+	 * and custom settings. The pointer ensures the data remains valid as long as it is referenced.
+	 *
+	 * Usage:
+	 * - Use this field to retain session settings for future references, such as rejoining
+	 *   or recreating a session with the same configuration.
+	 * - Ensure the pointer is properly set when creating or joining a session.
+	 */
+	TSharedPtr<FOnlineSessionSettings> LastSessionSettings;
+
+	/**
+	 * @brief Stores the results of the most recent session search.
+	 *
+	 * This shared pointer contains the details of all sessions found during the last search operation.
+	 * It includes session metadata, player counts, and any custom search criteria.
+	 */
+	TSharedPtr<FOnlineSessionSearch> LastSessionSearch;
+
+	/**
+	 * @brief Results of the most recent successful search, keyed by session identifier.
+	 *
+	 * Unlike `LastSessionSearch`, which is replaced on every search, this store is diffed against each
+	 * new set of results to produce incremental updates for subscribers.
+	 */
+	FDustLinkSessionResultStore SessionResultStore;
+
+	/**
+	 * @brief Identifiers of the session result store in the order reported by the online subsystem.
+	 */
+	TArray<FString> SessionResultOrder;
+
+	/**
+	 * @brief Latest ping probes of the sessions in the result store, kept apart from the search results.
+	 */
+	TDustLinkSessionIdMap<int32> ProbedPings;
+	
+	/**
+	 * @brief Delegate triggered when a session creation process is complete.
+	 *
+	 * Bound to the OnlineSubsystem's `FOnCreateSessionCompleteDelegate` to notify success or failure.
+	 */
+	FOnCreateSessionCompleteDelegate CreateSessionCompleteDelegate;
+
+	/**
+	 * @brief Delegate triggered when a session search is complete.
+	 *
+	 * Bound to the OnlineSubsystem's `FOnFindSessionsCompleteDelegate` to process session search results.
+	 */
+	FOnFindSessionsCompleteDelegate FindSessionsCompleteDelegate;
+
+	/**
+	 * @brief Delegate triggered when joining a session is complete.
+	 *
+	 * Bound to the OnlineSubsystem's `FOnJoinSessionCompleteDelegate` to handle success or failure.
+	 */
+	FOnJoinSessionCompleteDelegate JoinSessionCompleteDelegate;
+
+	/**
+	 * @brief Delegate triggered when a session destruction process is complete.
+	 *
+	 * Bound to the OnlineSubsystem's `FOnDestroySessionCompleteDelegate` to clean up resources.
+	 */
+	FOnDestroySessionCompleteDelegate DestroySessionCompleteDelegate;
+
+	/**
+	 * @brief Delegate triggered when starting a session is complete.
+	 *
+	 * Bound to the OnlineSubsystem's `FOnStartSessionCompleteDelegate` to confirm the session is ready for gameplay.
+	 */
+	FOnStartSessionCompleteDelegate StartSessionCompleteDelegate;
+
+	/**
+	 * @brief Delegate triggered when the local user accepts a platform session invite.
+	 *
+	 * Bound to the OnlineSubsystem's `FOnSessionUserInviteAcceptedDelegate` for the lifetime of the subsystem.
+	 */
+	FOnSessionUserInviteAcceptedDelegate SessionUserInviteAcceptedDelegate;
+
+	/**
+	 * @brief Delegate triggered when ending a session is complete.
+	 *
+	 * Bound to the OnlineSubsystem's `FOnEndSessionCompleteDelegate` to continue the return-to-lobby flow.
+	 */
+	FOnEndSessionCompleteDelegate EndSessionCompleteDelegate;
+
+	/**
+	 * @brief Delegate triggered when updating a session is complete.
+	 *
+	 * Bound to the OnlineSubsystem's `FOnUpdateSessionCompleteDelegate` to confirm the new settings.
+	 */
+	FOnUpdateSessionCompleteDelegate UpdateSessionCompleteDelegate;
+
+	/**
+	 * @brief Handle for the CreateSessionComplete delegate.
+	 *
+	 * Used to store and manage the binding of the `FOnCreateSessionCompleteDelegate` to the OnlineSubsystem.
+	 * Allows unbinding when the delegate is no longer needed.
+	 */
+	FDelegateHandle CreateSessionCompleteDelegateHandle;
+
+	/**
+	 * @brief Handle for the FindSessionsComplete delegate.
+	 *
+	 * Used to store and manage the binding of the `FOnFindSessionsCompleteDelegate` to the OnlineSubsystem.
+	 * Allows unbinding when the delegate is no longer needed.
+	 */
+	FDelegateHandle FindSessionsCompleteDelegateHandle;
+
+	/**
+	 * @brief Handle for the JoinSessionComplete delegate.
+	 *
+	 * Used to store and manage the binding of the `FOnJoinSessionCompleteDelegate` to the OnlineSubsystem.
+	 * Allows unbinding when the delegate is no longer needed.
+	 */
+	FDelegateHandle JoinSessionCompleteDelegateHandle;
+
+	/**
+	 * @brief Handle for the DestroySessionComplete delegate.
+	 *
+	 * Used to store and manage the binding of the `FOnDestroySessionCompleteDelegate` to the OnlineSubsystem.
+	 * Allows unbinding when the delegate is no longer needed.
+	 */
+	FDelegateHandle DestroySessionCompleteDelegateHandle;
+
+	/**
+	 * @brief Handle for the StartSessionComplete delegate.
+	 *
+	 * Used to store and manage the binding of the `FOnStartSessionCompleteDelegate` to the OnlineSubsystem.
+	 * Allows unbinding when the delegate is no longer needed.
+	 */
+	FDelegateHandle StartSessionCompleteDelegateHandle;
+
+	/**
+	 * @brief Handle for the SessionUserInviteAccepted delegate.
+	 *
+	 * Used to store and manage the binding of the `FOnSessionUserInviteAcceptedDelegate` to the OnlineSubsystem.
+	 * Allows unbinding when the subsystem is deinitialized.
+	 */
+	FDelegateHandle SessionUserInviteAcceptedDelegateHandle;
+
+	/**
+	 * @brief Handle for the EndSessionComplete delegate.
+	 *
+	 * Used to store and manage the binding of the `FOnEndSessionCompleteDelegate` to the OnlineSubsystem.
+	 * Allows unbinding when the delegate is no longer needed.
+	 */
+	FDelegateHandle EndSessionCompleteDelegateHandle;
+
+	/**
+	 * @brief Handle for the UpdateSessionComplete delegate.
+	 *
+	 * Used to store and manage the binding of the `FOnUpdateSessionCompleteDelegate` to the OnlineSubsystem.
+	 * Allows unbinding when the delegate is no longer needed.
+	 */
+	FDelegateHandle UpdateSessionCompleteDelegateHandle;
+
+	/**
+	 * @brief Flag indicating whether to create a new session after destroying the current one.
+	 *
+	 * This boolean determines if the system should automatically create a new session
+	 * when the current session is destroyed. Useful for scenarios like restarting a session
+	 * or transitioning to a new session seamlessly.
+	 */
+	bool bCreateSessionOnDestroy { false };
+
+	/**
+	 * @brief Stores the number of public connections for the last session.
+	 *
+	 * This field keeps track of the maximum number of players allowed (excluding the host)
+	 * in the last session. It is typically updated when creating or joining a session.
+	 */
+	int32 LastNumPublicConnections { 0 };
+
+	/**
+	 * @brief Stores the match type for the last session.
+	 *
+	 * This string contains the identifier for the type of match (e.g., "Deathmatch", "Coop")
+	 * for the most recently created or joined session.
+	 */
+	FString LastMatchType { TEXT("") };
+
+	/**
+	 * @brief Map of the next match, advertised in the session settings as `MatchMap`.
+	 */
+	FString MatchMap { TEXT("") };
+
+	/**
+	 * @brief Accepted invite to join once the current session has been destroyed.
+	 *
+	 * Set when an invite is accepted while the local player is still part of another session.
+	 */
+	TOptional<FOnlineSessionSearchResult> PendingInviteResult;
+
+	/**
+	 * @brief Flag indicating whether a session update stands in for a session creation.
+	 *
+	 * Set when `CreateSession` reuses the hosted session, so the update result is reported
+	 * through `DustLinkOnCreateSessionComplete`.
+	 */
+	bool bCreateSessionOnUpdate { false };
+
+	/**
+	 * @brief Lobby level to travel to once the return-to-lobby flow re-opened the session, empty if no return is pending.
+	 */
+	FString PendingLobbyPath { TEXT("") };
+
+	/**
+	 * @brief Policy computing the interval of the adaptive background refresh.
+	 */
+	FDustLinkRefreshPolicy AutoRefreshPolicy;
+
+	/**
+	 * @brief Handle of the timer that triggers the next background refresh.
+	 */
+	FTimerHandle AutoRefreshTimerHandle;
+
+	/**
+	 * @brief Flag indicating whether the adaptive background refresh is enabled.
+	 */
+	bool bAutoRefreshEnabled { false };
+
+	/**
+	 * @brief Whether the search in flight is a background refresh.
+	 */
+	bool bIsBackgroundSearch { false };
+
+	/**
+	 * @brief Maximum number of results retrieved by every background refresh.
+	 */
+	int32 AutoRefreshMaxSearchResults { 0 };
+
+	/**
+	 * @brief Scheduler deciding which visible sessions to re-probe.
+	 */
+	FDustLinkPingScheduler PingScheduler;
+
+	/**
+	 * @brief Handle of the looping timer driving the rolling ping schedule.
+	 */
+	FTimerHandle PingTimerHandle;
+
+	/**
+	 * @brief Smooths and rate-limits the load advertised by this host.
+	 */
+	FDustLinkLoadMonitor LoadMonitor;
+
+	/**
+	 * @brief Handle of the looping timer sampling the host load.
+	 */
+	FTimerHandle LoadSampleTimerHandle;
+
+	/**
+	 * @brief Handle of the ticker accumulating every frame of the current load sample interval.
+	 */
+	FTSTicker::FDelegateHandle LoadFrameTickerHandle;
+
+	/**
+	 * @brief Closes this host to new players while it is over its tick budget.
+	 */
+	FDustLinkAdmissionController AdmissionController;
+
+	/**
+	 * @brief Flag indicating whether the admission state changed and still has to be published.
+	 */
+	bool bIsAdmissionStateDirty { false };
+
+	/**
+	 * @brief Master server mapping join codes to connect info.
+	 */
+	TSharedPtr<IDustLinkListingProvider> ListingProvider;
+
+	/**
+	 * @brief Local master server stand-in, only running when requested on the command line.
+	 */
+	TUniquePtr<FDustLinkListingServer> ListingServer;
+
+	/**
+	 * @brief Control channel of a pooled dedicated server, only running when requested on the command line.
+	 */
+	TUniquePtr<FDustLinkServerControl> ServerControl;
+
+	/**
+	 * @brief Players the handed over match was assigned to, empty to admit anyone.
+	 */
+	TArray<FString> ExpectedPlayers;
+
+	/**
+	 * @brief Admission tokens of the players the handed over match was assigned to and who did not join yet, keyed by player identifier.
+	 */
+	TMap<FString, FString> ExpectedPlayerTokens;
+
+	/**
+	 * @brief Whether the handed over match admits its players by token, even once every token was consumed.
+	 */
+	bool bIsTokenAdmission { false };
+
+	/**
+	 * @brief Map this dedicated server idled on before it was handed a match.
+	 */
+	FString IdleMapPath { TEXT("") };
+
+	/**
+	 * @brief Address players reach this dedicated server on, from `-DustLinkPublicAddress=<Host>[:<Port>]`.
+	 *
+	 * Reported to the fleet agent instead of the online subsystem's connect string, which behind NAT only
+	 * knows the bound address.
+	 */
+	FString PublicAddress;
+
+	/**
+	 * @brief Connect info of the handed over match, held until this dedicated server arrived on the match map.
+	 */
+	TOptional<FString> PendingMatchConnectInfo;
+
+	/**
+	 * @brief Flag indicating whether a released match still waits for its session to be destroyed.
+	 */
+	bool bIsReleaseAwaitingDestroy { false };
+
+	/**
+	 * @brief Flag indicating whether a released match still waits for the idle map to load.
+	 */
+	bool bIsReleaseAwaitingIdleMap { false };
+
+	/**
+	 * @brief Handle of the binding to the pre-login event of all game modes.
+	 */
+	FDelegateHandle GameModePreLoginHandle;
+
+	/**
+	 * @brief Counters, latencies and gauges of the session operations issued by this subsystem.
+	 */
+	TSharedRef<FDustLinkMetrics> Metrics;
+
+	/**
+	 * @brief Local metrics endpoint, only running when requested on the command line.
+	 */
+	TUniquePtr<FDustLinkMetricsServer> MetricsServer;
+
+	/**
+	 * @brief Captures diagnostics when session operations breach their latency objectives.
+	 */
+	TUniquePtr<FDustLinkSloWatchdog> SloWatchdog;
+
+	/**
+	 * @brief Provider session funnel events are exported to, if any.
+	 */
+	TSharedPtr<IAnalyticsProvider> AnalyticsProvider;
+
+	/**
+	 * @brief Buffers session funnel events for the analytics provider, only set while a provider is.
+	 */
+	TUniquePtr<FDustLinkAnalytics> Analytics;
+
+	/**
+	 * @brief Handle of the looping timer exporting the funnel events.
+	 */
+	FTimerHandle AnalyticsFlushTimerHandle;
+
+	/**
+	 * @brief Join code of the hosted session, generated when the session is created.
+	 */
+	FString JoinCode { TEXT("") };
+
+	/**
+	 * @brief Secret returned by the listing provider for the join code, required to remove it again.
+	 */
+	FString JoinCodeSecret;
+
+	/**
+	 * @brief Discovers and caches the sessions of the local player's friends.
+	 */
+	TSharedRef<FDustLinkFriendSessionFinder> FriendSessionFinder;
+
+	/**
+	 * @brief Mock presence backend of local tests, only set while it is the provider of the friend session finder.
+	 */
+	TSharedPtr<FDustLinkMockPresenceProvider> MockPresenceProvider;
+
+	/**
+	 * @brief Link conditions currently emulated.
+	 */
+	FDustLinkNetworkProfile NetworkProfile;
+
+	/**
+	 * @brief Phase latencies recorded under each network profile.
+	 */
+	FDustLinkNetworkBenchmark NetworkBenchmark;
+
+	/**
+	 * @brief Lag and loss each emulated net driver had before a profile was first applied to it.
+	 */
+	TMap<TObjectKey<UNetDriver>, FDustLinkNetworkProfile> NetDriverUserConditions;
+
+	/**
+	 * @brief Binding to the connection creation of pending joins, which is global to all game instances.
+	 */
+	FDelegateHandle PendingNetGameConnectionCreatedHandle;
+
+	/**
+	 * @brief Soak test in progress or last run, if any.
+	 */
+	TSharedPtr<FDustLinkSoakTest> SoakTest;
+
+	/**
+	 * @brief Number of active subscriptions made through `Subscribe` and `SubscribeDynamic`.
+	 */
+	int32 NumSubscriptions { 0 };
+
+	/**
+	 * @struct FSubscriptionKey
+	 * @brief Identifies a binding made through `Subscribe` by its delegate, object and method.
+	 */
+	struct FSubscriptionKey
+	{
+		/** Delegate the method is bound to. */
+		const void* Delegate { nullptr };
+
+		/** Object the method is called on. */
+		FObjectKey Object;
+
+		/** Bytes of the member function pointer, compared instead of the pointer so any method type fits. */
+		TArray<uint8, TInlineAllocator<16>> Method;
+
+		bool operator==(const FSubscriptionKey& Other) const { return Delegate == Other.Delegate && Object == Other.Object && Method == Other.Method; }
+	};
+
+	/**
+	 * @brief Bindings made through `Subscribe` that are still active.
+	 */
+	TArray<FSubscriptionKey> SubscriptionKeys;
+
+	/**
+	 * @brief Schedules garbage collection around session travel, created when the subsystem is initialized.
+	 */
+	TUniquePtr<FDustLinkTravelMemoryScheduler> TravelMemoryScheduler;
+
+	/**
+	 * @brief Preloads the match content during the lobby countdown, held until the match map loaded.
+	 */
+	TSharedPtr<FDustLinkContentWarmup> ContentWarmup;
 };
\ No newline at end of file
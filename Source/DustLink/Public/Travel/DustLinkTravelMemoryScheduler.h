@@ -0,0 +1,142 @@
+// Copyright Dustbyte Software. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+
+class UGameInstance;
+struct FWorldContext;
+
+
+/**
+ * Notifies subscribers that a map is about to be loaded, so menu-only assets can be released first.
+ * @param MapName The name of the map being loaded.
+ */
+DECLARE_MULTICAST_DELEGATE_OneParam(FDustLinkOnPreTravel, const FString& MapName);
+
+/**
+ * Notifies subscribers that a map finished loading.
+ * @param World The world of the loaded map.
+ */
+DECLARE_MULTICAST_DELEGATE_OneParam(FDustLinkOnPostTravel, UWorld* World);
+
+
+/**
+ * @struct FDustLinkTravelMemorySettings
+ * @brief Tuning parameters for scheduling garbage collection around session travel.
+ */
+struct DUSTLINK_API FDustLinkTravelMemorySettings
+{
+	/** Interval between garbage collection passes while idle in menus or lobbies, in seconds. Zero disables them. */
+	float IdleCollectionInterval { 60.f };
+
+	/** Time after arriving on a new map during which garbage collection is deferred, in seconds. */
+	float ArrivalQuietPeriod { 10.f };
+};
+
+/**
+ * @class FDustLinkTravelMemoryScheduler
+ * @brief Moves garbage collection and memory trimming away from the moments around session travel.
+ *
+ * Collects garbage on a timer while the player idles in menus or lobbies, broadcasts a pre-travel
+ * notification and a memory trim before a map loads so menu-only assets are released by the load's
+ * own purge, and defers garbage collection for a few seconds after arrival so the first frames on
+ * the new map are not interrupted.
+ *
+ * Only map loads of the owning game instance are handled, so play-in-editor clients sharing the
+ * process do not trigger each other. Every map load ends idling, menus and lobbies declare it again.
+ */
+class DUSTLINK_API FDustLinkTravelMemoryScheduler
+{
+public:
+	/**
+	 * @brief Constructs the scheduler and hooks the engine's map load notifications.
+	 *
+	 * @param InGameInstance The game instance whose map loads are handled.
+	 * @param InSettings The tuning parameters to use.
+	 */
+	explicit FDustLinkTravelMemoryScheduler(const UGameInstance* InGameInstance, const FDustLinkTravelMemorySettings& InSettings = FDustLinkTravelMemorySettings());
+
+	~FDustLinkTravelMemoryScheduler();
+
+	/**
+	 * @brief Sets whether the player is currently idle in a menu or lobby.
+	 *
+	 * Idle collection only runs while this is `true`. It is cleared whenever a map starts loading.
+	 *
+	 * @param bInIsIdle Whether the player is idle.
+	 */
+	void SetIdle(const bool bInIsIdle) { bIsIdle = bInIsIdle; }
+
+	/**
+	 * @brief Returns `true` while garbage collection is deferred after arriving on a new map.
+	 */
+	bool IsInArrivalQuietPeriod() const { return ArrivalQuietTickerHandle.IsValid(); }
+
+	/**
+	 * @brief Delegate triggered right before a map is loaded.
+	 */
+	FDustLinkOnPreTravel OnPreTravel;
+
+	/**
+	 * @brief Delegate triggered right after a map finished loading.
+	 */
+	FDustLinkOnPostTravel OnPostTravel;
+
+private:
+	/**
+	 * @brief Callback for when a map is about to be loaded.
+	 *
+	 * @param WorldContext The context of the world the map is loaded into.
+	 * @param MapName The name of the map being loaded.
+	 */
+	void HandlePreLoadMap(const FWorldContext& WorldContext, const FString& MapName);
+
+	/**
+	 * @brief Callback for when a map finished loading.
+	 *
+	 * @param World The world of the loaded map.
+	 */
+	void HandlePostLoadMap(UWorld* World);
+
+	/**
+	 * @brief Ticker callback that collects garbage while idle.
+	 *
+	 * @param DeltaTime Time since the last call, in seconds.
+	 * @return Always `true` to keep ticking.
+	 */
+	bool TickIdleCollection(float DeltaTime);
+
+	/**
+	 * @brief Ticker callback that defers garbage collection during the arrival quiet period.
+	 *
+	 * @param DeltaTime Time since the last call, in seconds.
+	 * @return `true` until the quiet period is over.
+	 */
+	bool TickArrivalQuietPeriod(float DeltaTime);
+
+	/** Game instance whose map loads are handled. */
+	TWeakObjectPtr<const UGameInstance> GameInstance;
+
+	/** Tuning parameters of the scheduler. */
+	FDustLinkTravelMemorySettings Settings;
+
+	/** Handle of the idle collection ticker. */
+	FTSTicker::FDelegateHandle IdleTickerHandle;
+
+	/** Handle of the arrival quiet period ticker, valid while the period lasts. */
+	FTSTicker::FDelegateHandle ArrivalQuietTickerHandle;
+
+	/** Handle of the pre-load map binding. */
+	FDelegateHandle PreLoadMapHandle;
+
+	/** Handle of the post-load map binding. */
+	FDelegateHandle PostLoadMapHandle;
+
+	/** Seconds left in the arrival quiet period. */
+	float ArrivalQuietTimeLeft { 0.f };
+
+	/** Whether the player is idle in a menu or lobby. */
+	bool bIsIdle { false };
+};